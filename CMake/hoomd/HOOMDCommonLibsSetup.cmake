@@ -17,9 +17,13 @@ if (UNIX AND NOT APPLE)
     endif (DL_LIB AND UTIL_LIB)
 endif (UNIX AND NOT APPLE)
 
+## std::thread is used for background file output
+find_package(Threads REQUIRED)
+
 set(HOOMD_COMMON_LIBS
         ${HOOMD_PYTHON_LIBRARY}
         ${ADDITIONAL_LIBS}
+        ${CMAKE_THREAD_LIBS_INIT}
         )
 
 if (ENABLE_CUDA)
@@ -33,3 +37,43 @@ endif (ENABLE_CUDA)
 if (ENABLE_MPI)
     list(APPEND HOOMD_COMMON_LIBS ${MPI_CXX_LIBRARIES})
 endif (ENABLE_MPI)
+
+if (ENABLE_TBB)
+    find_path(TBB_INCLUDE_DIR tbb/tbb.h
+              HINTS $ENV{TBB_ROOT}/include $ENV{TBBROOT}/include)
+    find_library(TBB_LIBRARY tbb
+                 HINTS $ENV{TBB_ROOT}/lib $ENV{TBBROOT}/lib)
+
+    if (NOT TBB_INCLUDE_DIR OR NOT TBB_LIBRARY)
+        message(FATAL_ERROR "ENABLE_TBB is set, but TBB was not found. Set TBB_ROOT to the TBB installation prefix.")
+    endif()
+
+    message(STATUS "Found TBB: ${TBB_LIBRARY}")
+    mark_as_advanced(TBB_INCLUDE_DIR TBB_LIBRARY)
+    include_directories(${TBB_INCLUDE_DIR})
+    list(APPEND HOOMD_COMMON_LIBS ${TBB_LIBRARY})
+endif (ENABLE_TBB)
+
+if (ENABLE_FFTW)
+    # single precision FFTW, kiss_fft is used when it is not found
+    find_path(FFTW_INCLUDE_DIR fftw3.h
+              HINTS $ENV{FFTW_ROOT}/include $ENV{FFTW_DIR}/include)
+    find_library(FFTW_LIBRARY fftw3f
+                 HINTS $ENV{FFTW_ROOT}/lib $ENV{FFTW_DIR}/lib)
+    find_library(FFTW_THREADS_LIBRARY fftw3f_threads
+                 HINTS $ENV{FFTW_ROOT}/lib $ENV{FFTW_DIR}/lib)
+    mark_as_advanced(FFTW_INCLUDE_DIR FFTW_LIBRARY FFTW_THREADS_LIBRARY)
+
+    if (FFTW_INCLUDE_DIR AND FFTW_LIBRARY)
+        message(STATUS "Found FFTW: ${FFTW_LIBRARY}")
+        include_directories(${FFTW_INCLUDE_DIR})
+        if (FFTW_THREADS_LIBRARY)
+            set(ENABLE_FFTW_THREADS TRUE)
+            list(APPEND HOOMD_COMMON_LIBS ${FFTW_THREADS_LIBRARY})
+        endif()
+        list(APPEND HOOMD_COMMON_LIBS ${FFTW_LIBRARY})
+    else()
+        message(STATUS "FFTW not found, using kiss_fft for CPU FFTs. Set FFTW_ROOT to the FFTW installation prefix.")
+        set(ENABLE_FFTW FALSE)
+    endif()
+endif (ENABLE_FFTW)
@@ -38,6 +38,14 @@ else ()
 option (ENABLE_MPI "Enable the compilation of the MPI communication code" off)
 endif ()
 
+############################
+## TBB related options
+option(ENABLE_TBB "Enable support for Threading Building Blocks (TBB)" off)
+
+############################
+## FFTW related options
+option(ENABLE_FFTW "Use FFTW for CPU FFTs when it is found" on)
+
 #################################
 ## Optionally enable documentation build
 OPTION(ENABLE_DOXYGEN "Enables building of documentation with doxygen" OFF)
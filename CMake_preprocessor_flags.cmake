@@ -28,6 +28,18 @@ if (ENABLE_MPI)
     endif(ENABLE_MPI_CUDA)
 endif(ENABLE_MPI)
 
+if (ENABLE_TBB)
+    add_definitions (-DENABLE_TBB)
+endif(ENABLE_TBB)
+
+if (ENABLE_FFTW)
+    add_definitions (-DENABLE_FFTW)
+
+    if (ENABLE_FFTW_THREADS)
+        add_definitions (-DENABLE_FFTW_THREADS)
+    endif()
+endif(ENABLE_FFTW)
+
 # define Eigen should be MPL 2 only
 add_definitions(-DEIGEN_MPL2_ONLY)
 
@@ -91,6 +91,12 @@ class Analyzer
         */
         virtual void resetStats(){}
 
+        //! Complete any pending output
+        /*! Derived classes that buffer their output should write it out completely in flush(). System calls
+            flush() on all Analyzers at the end of every run().
+        */
+        virtual void flush(){}
+
         //! Get needed pdata flags
         /*! Not all fields in ParticleData are computed by default. When derived classes need one of these optional
             fields, they must return the requested fields in getRequestedPDataFlags().
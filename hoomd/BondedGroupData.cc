@@ -15,6 +15,9 @@
 
 #include "hoomd/extern/num_util.h"
 
+#include <algorithm>
+#include <unordered_map>
+
 #ifdef ENABLE_CUDA
 #include "BondedGroupData.cuh"
 #include "CachedAllocator.h"
@@ -44,7 +47,8 @@ template<unsigned int group_size, typename Group, const char *name, bool has_typ
 BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     std::shared_ptr<ParticleData> pdata,
     unsigned int n_group_types)
-    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0), m_groups_dirty(true)
+    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0), m_groups_dirty(true),
+      m_colors_dirty(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondedGroupData (" << name<< "s, n=" << group_size << ") "
         << endl;
@@ -94,7 +98,8 @@ template<unsigned int group_size, typename Group, const char *name, bool has_typ
 BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     std::shared_ptr<ParticleData> pdata,
     const Snapshot& snapshot)
-    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0), m_groups_dirty(true)
+    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0), m_groups_dirty(true),
+      m_colors_dirty(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondedGroupData (" << name << ") " << endl;
 
@@ -146,6 +151,9 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::initialize()
     // reset local number of ghost groups
     m_n_ghost = 0;
 
+    // the coloring refers to the old groups
+    m_colors_dirty = true;
+
     // clear set of active tags
     m_tag_set.clear();
     m_invalid_cached_tags = true;
@@ -841,6 +849,72 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTable
         }
     }
 
+/*! The local groups are colored greedily in index order, every group gets the lowest color that is not yet used
+    by a group sharing one of its particles. Particles are identified by tag, so the coloring stays valid when
+    particles are sorted and only needs to be rebuilt when the groups change.
+ */
+template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildColoring()
+    {
+    if (m_prof) m_prof->push("color " + std::string(name) + "s");
+
+    std::vector<unsigned int> group_color(m_n_groups);
+    unsigned int n_colors = 0;
+
+    // colors used by the groups of every particle, by tag
+    std::unordered_map<unsigned int, std::vector<unsigned int> > ptl_colors;
+
+        {
+        ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::read);
+
+        for (unsigned int cur_group = 0; cur_group < m_n_groups; ++cur_group)
+            {
+            const members_t& g = h_groups.data[cur_group];
+
+            // find the lowest color not used by any member
+            unsigned int color = 0;
+            bool conflict = true;
+            while (conflict)
+                {
+                conflict = false;
+                for (unsigned int i = 0; i < group_size; ++i)
+                    {
+                    const std::vector<unsigned int>& used = ptl_colors[g.tag[i]];
+                    if (std::find(used.begin(), used.end(), color) != used.end())
+                        {
+                        conflict = true;
+                        color++;
+                        break;
+                        }
+                    }
+                }
+
+            for (unsigned int i = 0; i < group_size; ++i)
+                ptl_colors[g.tag[i]].push_back(color);
+
+            group_color[cur_group] = color;
+            n_colors = std::max(n_colors, color+1);
+            }
+        }
+
+    // sort the groups by color, keeping the index order within a color
+    m_color_offset.assign(n_colors+1, 0);
+    for (unsigned int cur_group = 0; cur_group < m_n_groups; ++cur_group)
+        m_color_offset[group_color[cur_group]+1]++;
+    for (unsigned int color = 0; color < n_colors; ++color)
+        m_color_offset[color+1] += m_color_offset[color];
+
+    m_colored_groups.resize(m_n_groups);
+    std::vector<unsigned int> cursor(m_color_offset.begin(), m_color_offset.end()-1);
+    for (unsigned int cur_group = 0; cur_group < m_n_groups; ++cur_group)
+        m_colored_groups[cursor[group_color[cur_group]]++] = cur_group;
+
+    m_exec_conf->msg->notice(7) << "BondedGroupData: " << m_n_groups << " " << name << "s in " << n_colors
+        << " colors" << endl;
+
+    if (m_prof) m_prof->pop();
+    }
+
 #ifdef ENABLE_CUDA
 template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
 void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTableGPU()
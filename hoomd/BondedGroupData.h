@@ -32,6 +32,10 @@ const unsigned int GROUP_NOT_LOCAL ((unsigned int) 0xffffffff);
 
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#include <atomic>
+#endif
 #ifndef NVCC
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
 #endif
@@ -332,6 +336,7 @@ class BondedGroupData
             unsigned int new_size = m_n_groups + ngroup;
             reallocate(new_size);
             m_n_groups += ngroup;
+            m_colors_dirty = true;
             }
 
         //! Remove local groups
@@ -345,6 +350,7 @@ class BondedGroupData
             unsigned int new_size = m_n_groups - nremove;
             reallocate(new_size);
             m_n_groups -= nremove;
+            m_colors_dirty = true;
             }
 
         //! Return group table (const)
@@ -559,6 +565,72 @@ class BondedGroupData
             return m_group_num_change_signal;
             }
 
+        /*
+         * Group coloring for threaded force computation on the CPU
+         */
+
+        //! Rebuild the coloring of the local groups if the groups have changed
+        /*! Groups of the same color have no particle in common. The coloring must be up to date before
+            forEachGroup() can process groups concurrently, call this method before acquiring the group members.
+         */
+        void updateColoring()
+            {
+            if (m_colors_dirty)
+                {
+                rebuildColoring();
+                m_colors_dirty = false;
+                }
+            }
+
+        //! Call a function for every local group
+        /*! \param num_threads Number of CPU threads to use
+            \param f Function object called with the index of a group, returns false if the group can not be computed
+            \returns The lowest index of a group for which \a f failed, or GROUP_NOT_LOCAL if there is none
+
+            With more than one thread and an up to date coloring, the groups of one color are processed
+            concurrently, and the colors one after the other. \a f may therefore add to per-particle arrays of all
+            members of its group without synchronization. Otherwise, the groups are processed in index order until
+            the first failure.
+
+            \a f must not report errors or throw, since it may run on a worker thread. The caller reports the
+            failed group after this method returns.
+         */
+        template<class Func>
+        unsigned int forEachGroup(unsigned int num_threads, const Func& f) const
+            {
+            #ifdef ENABLE_TBB
+            if (num_threads > 1 && !m_colors_dirty)
+                {
+                std::atomic<unsigned int> failed(GROUP_NOT_LOCAL);
+                for (unsigned int color = 0; color+1 < m_color_offset.size(); ++color)
+                    {
+                    tbb::parallel_for(tbb::blocked_range<unsigned int>(m_color_offset[color], m_color_offset[color+1]),
+                        [&](const tbb::blocked_range<unsigned int>& r)
+                            {
+                            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                {
+                                unsigned int group = m_colored_groups[i];
+                                if (!f(group))
+                                    {
+                                    // keep the lowest failed index, so that the same group is reported as in serial
+                                    unsigned int cur = failed.load();
+                                    while (group < cur && !failed.compare_exchange_weak(cur, group));
+                                    }
+                                }
+                            });
+                    }
+                return failed.load();
+                }
+            #endif
+
+            for (unsigned int i = 0; i < m_n_groups; ++i)
+                {
+                if (!f(i))
+                    return i;
+                }
+            return GROUP_NOT_LOCAL;
+            }
+
         //! Connects a function to be called every time the local number of bonded groups changes
         Nano::Signal<void()>& getGroupReorderSignal()
             {
@@ -572,6 +644,9 @@ class BondedGroupData
             // set flag to trigger rebuild of GPU table
             m_groups_dirty = true;
 
+            // group membership may have changed, the coloring needs to be rebuilt
+            m_colors_dirty = true;
+
             // notify subscribers
             m_group_reorder_signal.emit();
             }
@@ -629,6 +704,9 @@ class BondedGroupData
 
     private:
         bool m_groups_dirty;                         //!< Is it necessary to rebuild the lookup-by-index table?
+        bool m_colors_dirty;                         //!< Is it necessary to rebuild the group coloring?
+        std::vector<unsigned int> m_colored_groups;  //!< Local group indices, sorted by color
+        std::vector<unsigned int> m_color_offset;    //!< Offset of every color in m_colored_groups
 
         Nano::Signal<void ()> m_group_num_change_signal; //!< Signal that is triggered when groups are added or deleted (globally)
         Nano::Signal<void ()> m_group_reorder_signal;    //!< Signal that is triggered when groups are added or deleted locally
@@ -642,6 +720,9 @@ class BondedGroupData
         //! Helper function to rebuild lookup by index table
         void rebuildGPUTable();
 
+        //! Helper function to color the local groups
+        void rebuildColoring();
+
         //! Resize internal tables
         /*! \param new_size New size of local group tables, new_size = n_local + n_ghost
          */
@@ -13,6 +13,10 @@
 
 #include <algorithm>
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 using namespace std;
 namespace py = pybind11;
 
@@ -468,16 +472,17 @@ void CellList::computeCellList()
     // get periodic flags
     uchar3 periodic = box.getPeriodic();
 
-    // for each particle
-    unsigned n_tot_particles = m_pdata->getN() + m_pdata->getNGhosts();
+    // marks particles that are not placed in any bin
+    const unsigned int invalid_bin = ci.getNumElements();
 
-    for (unsigned int n = 0; n < n_tot_particles; n++)
+    // find the bin particle n belongs in, set the error conditions and return invalid_bin if there is none
+    auto find_bin = [&](unsigned int n, uint3& cond) -> unsigned int
         {
         Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
         if (std::isnan(p.x) || std::isnan(p.y) || std::isnan(p.z))
             {
-            conditions.y = n+1;
-            continue;
+            cond.y = n+1;
+            return invalid_bin;
             }
 
 
@@ -494,8 +499,8 @@ void CellList::computeCellList()
             {
             // if a ghost particle is out of bounds, silently ignore it
             if (n < m_pdata->getN())
-                conditions.z = n+1;
-            continue;
+                cond.z = n+1;
+            return invalid_bin;
             }
 
         // need to handle the case where the particle is exactly at the box hi
@@ -509,9 +514,6 @@ void CellList::computeCellList()
         // sanity check
         assert((ib < (int)(m_dim.x) && jb < (int)(m_dim.y) && kb < (int)(m_dim.z)) || n>=m_pdata->getN());
 
-        // record its bin
-        unsigned int bin = ci(ib, jb, kb);
-
         // all particles should be in a valid cell
         if (ib < 0 || ib >= (int)m_dim.x ||
             jb < 0 || jb >= (int)m_dim.y ||
@@ -519,10 +521,17 @@ void CellList::computeCellList()
             {
             // but ghost particles that are out of range should not produce an error
             if (n < m_pdata->getN())
-                conditions.z = n+1;
-            continue;
+                cond.z = n+1;
+            return invalid_bin;
             }
 
+        // record its bin
+        return ci(ib, jb, kb);
+        };
+
+    // store particle n at the given offset in its bin, or record the overflow
+    auto store_particle = [&](unsigned int n, unsigned int bin, unsigned int offset, uint3& cond)
+        {
         // setup the flag value to store
         Scalar flag;
         if (m_flag_charge)
@@ -533,8 +542,6 @@ void CellList::computeCellList()
             flag = __int_as_scalar(n);
 
         // store the bin entries
-        unsigned int offset = h_cell_size.data[bin];
-
         if (offset < m_Nmax)
             {
             h_xyzf.data[cli(offset, bin)] = make_scalar4(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z, flag);
@@ -558,12 +565,92 @@ void CellList::computeCellList()
             }
         else
             {
-            conditions.x = max(conditions.x, offset+1);
+            cond.x = max(cond.x, offset+1);
+            }
+        };
+
+    // for each particle
+    unsigned n_tot_particles = m_pdata->getN() + m_pdata->getNGhosts();
+    const unsigned int num_threads = m_exec_conf->getNumThreads();
+
+    if (num_threads == 1)
+        {
+        for (unsigned int n = 0; n < n_tot_particles; n++)
+            {
+            unsigned int bin = find_bin(n, conditions);
+            if (bin == invalid_bin)
+                continue;
+
+            store_particle(n, bin, h_cell_size.data[bin], conditions);
+
+            // increment the cell occupancy counter
+            h_cell_size.data[bin]++;
             }
+        }
+    #ifdef ENABLE_TBB
+    else
+        {
+        // counting sort over one fixed range of particles per thread: count the bin occupancy per range, convert the
+        // counts into per-range offsets with a prefix sum over the ranges, then scatter. Particles are stored in each
+        // cell in index order, exactly like in the serial loop.
+        const unsigned int n_cells = ci.getNumElements();
+        if (m_particle_bin.size() < n_tot_particles)
+            m_particle_bin.resize(n_tot_particles);
+        if (m_thread_cell_offset.size() < (size_t)num_threads*n_cells)
+            m_thread_cell_offset.resize(num_threads*n_cells);
+        std::vector<uint3> thread_conditions(num_threads, make_uint3(0,0,0));
+
+        tbb::parallel_for((unsigned int)0, num_threads, [&](unsigned int chunk)
+            {
+            unsigned int *count = &m_thread_cell_offset[chunk*n_cells];
+            memset(count, 0, sizeof(unsigned int)*n_cells);
+
+            for (unsigned int n = chunk*n_tot_particles/num_threads; n < (chunk+1)*n_tot_particles/num_threads; n++)
+                {
+                unsigned int bin = find_bin(n, thread_conditions[chunk]);
+                m_particle_bin[n] = bin;
+                if (bin != invalid_bin)
+                    count[bin]++;
+                }
+            });
 
-        // increment the cell occupancy counter
-        h_cell_size.data[bin]++;
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_cells),
+            [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                for (unsigned int bin = r.begin(); bin != r.end(); ++bin)
+                    {
+                    unsigned int sum = 0;
+                    for (unsigned int chunk = 0; chunk < num_threads; ++chunk)
+                        {
+                        unsigned int count = m_thread_cell_offset[chunk*n_cells+bin];
+                        m_thread_cell_offset[chunk*n_cells+bin] = sum;
+                        sum += count;
+                        }
+                    h_cell_size.data[bin] = sum;
+                    }
+                });
+
+        tbb::parallel_for((unsigned int)0, num_threads, [&](unsigned int chunk)
+            {
+            unsigned int *offset = &m_thread_cell_offset[chunk*n_cells];
+
+            for (unsigned int n = chunk*n_tot_particles/num_threads; n < (chunk+1)*n_tot_particles/num_threads; n++)
+                {
+                unsigned int bin = m_particle_bin[n];
+                if (bin != invalid_bin)
+                    store_particle(n, bin, offset[bin]++, thread_conditions[chunk]);
+                }
+            });
+
+        // flags are set to the largest value, which is also the last one written by the serial loop
+        for (unsigned int chunk = 0; chunk < num_threads; ++chunk)
+            {
+            conditions.x = max(conditions.x, thread_conditions[chunk].x);
+            conditions.y = max(conditions.y, thread_conditions[chunk].y);
+            conditions.z = max(conditions.z, thread_conditions[chunk].z);
+            }
         }
+    #endif
 
     // write out conditions
     m_conditions.resetFlags(conditions);
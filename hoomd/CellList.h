@@ -12,6 +12,7 @@
 #include "Compute.h"
 
 #include <memory>
+#include <vector>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 
 /*! \file CellList.h
@@ -95,6 +96,11 @@
     Condition flags are to be set during the computeCellList() call and will be checked by compute() which will then
     take the appropriate action. If possible, flags 1 and 2 should be set to the index of the particle causing the
     flag plus 1.
+
+    <b>Threading:</b>
+    With more than one CPU thread, computeCellList() bins the particles with a counting sort. Every thread counts the
+    occupancy of each cell for a fixed range of particles, a prefix sum over the threads turns the counts into offsets,
+    and the threads then scatter their particles. Cell contents are ordered by particle index as in the serial code.
 */
 class CellList : public Compute
     {
@@ -358,6 +364,9 @@ class CellList : public Compute
         bool m_sort_cell_list;               //!< If true, sort cell list
         bool m_compute_adj_list;            //!< If true, compute the cell adjacency lists
 
+        std::vector<unsigned int> m_particle_bin;       //!< Bin of each particle (threaded computeCellList() only)
+        std::vector<unsigned int> m_thread_cell_offset; //!< Per-thread cell offsets (threaded computeCellList() only)
+
         //! Computes what the dimensions should me
         uint3 computeDimensions();
 
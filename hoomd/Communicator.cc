@@ -12,6 +12,7 @@
 
 #include "Communicator.h"
 #include "System.h"
+#include "StepTimer.h"
 
 #include <algorithm>
 #include <hoomd/extern/pybind/include/pybind11/stl.h>
@@ -53,8 +54,9 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
         m_gdata->removeAllGhostGroups();
 
         // send map for rank updates
-        typedef std::multimap<unsigned int, rank_element_t> map_t;
-        map_t send_map;
+        typedef std::multimap<unsigned int, rank_element_t, std::less<unsigned int>,
+            PooledAllocator< std::pair<const unsigned int, rank_element_t> > > map_t;
+        map_t send_map(std::less<unsigned int>(), m_exec_conf->getHostBufferPool());
 
             {
             ArrayHandle<unsigned int> h_comm_flags(m_comm.m_pdata->getCommFlags(), access_location::host, access_mode::read);
@@ -276,7 +278,7 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
 
             if (m_comm.m_prof) m_comm.m_prof->push("MPI send/recv");
 
-            std::vector<MPI_Request> reqs;
+            pooled_vector<MPI_Request> reqs(m_exec_conf->getHostBufferPool());
             MPI_Request req;
 
             unsigned int send_bytes = 0;
@@ -316,7 +318,7 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
                 recv_bytes += n_recv_groups[ineigh]*sizeof(rank_element_t);
                 }
 
-            std::vector<MPI_Status> stats(reqs.size());
+            pooled_vector<MPI_Status> stats(reqs.size(), MPI_Status(), m_exec_conf->getHostBufferPool());
             MPI_Waitall(reqs.size(), &reqs.front(), &stats.front());
 
             if (m_comm.m_prof) m_comm.m_prof->pop(0,send_bytes+recv_bytes);
@@ -350,8 +352,9 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
             }
 
         // send map for groups
-        typedef std::multimap<unsigned int, group_element_t> group_map_t;
-        group_map_t group_send_map;
+        typedef std::multimap<unsigned int, group_element_t, std::less<unsigned int>,
+            PooledAllocator< std::pair<const unsigned int, group_element_t> > > group_map_t;
+        group_map_t group_send_map(std::less<unsigned int>(), m_exec_conf->getHostBufferPool());
 
             {
             ArrayHandle<typename group_data::members_t> h_groups(m_gdata->getMembersArray(), access_location::host, access_mode::read);
@@ -557,7 +560,7 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
 
             if (m_comm.m_prof) m_comm.m_prof->push("MPI send/recv");
 
-            std::vector<MPI_Request> reqs;
+            pooled_vector<MPI_Request> reqs(m_exec_conf->getHostBufferPool());
             MPI_Request req;
 
             unsigned int send_bytes = 0;
@@ -597,15 +600,16 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
                 recv_bytes += n_recv_groups[ineigh]*sizeof(group_element_t);
                 }
 
-            std::vector<MPI_Status> stats(reqs.size());
+            pooled_vector<MPI_Status> stats(reqs.size(), MPI_Status(), m_exec_conf->getHostBufferPool());
             MPI_Waitall(reqs.size(), &reqs.front(), &stats.front());
 
             if (m_comm.m_prof) m_comm.m_prof->pop(0,send_bytes+recv_bytes);
             }
 
         // use a std::map, i.e. single-key, to filter out duplicate groups in input buffer
-        typedef std::map<unsigned int, group_element_t> recv_map_t;
-        recv_map_t recv_map;
+        typedef std::map<unsigned int, group_element_t, std::less<unsigned int>,
+            PooledAllocator< std::pair<const unsigned int, group_element_t> > > recv_map_t;
+        recv_map_t recv_map(std::less<unsigned int>(), m_exec_conf->getHostBufferPool());
 
         for (unsigned int recv_idx = 0; recv_idx < n_recv_tot; recv_idx++)
             {
@@ -801,7 +805,7 @@ void Communicator::GroupCommunicator<group_data>::exchangeGhostGroups(
         if (m_comm.m_prof) m_comm.m_prof->push(m_exec_conf, m_gdata->getName());
 
         // send plan for groups
-        std::vector<unsigned int> group_plan(m_gdata->getN(), 0);
+        pooled_vector<unsigned int> group_plan(m_gdata->getN(), 0, m_exec_conf->getHostBufferPool());
 
             {
             ArrayHandle<typename group_data::members_t> h_groups(m_gdata->getMembersArray(), access_location::host, access_mode::read);
@@ -866,7 +870,7 @@ void Communicator::GroupCommunicator<group_data>::exchangeGhostGroups(
              */
 
             // resize buffers
-            std::vector<unsigned int> plan_copybuf(m_gdata->getN(),0);
+            pooled_vector<unsigned int> plan_copybuf(m_gdata->getN(), 0, m_exec_conf->getHostBufferPool());
             m_groups_sendbuf.resize(m_gdata->getN());
             unsigned int num_copy_ghosts;
             unsigned int num_recv_ghosts;
@@ -1057,6 +1061,9 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
             m_exec_conf(m_pdata->getExecConf()),
             m_mpi_comm(m_exec_conf->getMPICommunicator()),
             m_decomposition(decomposition),
+            m_migrate_timer(0),
+            m_exchange_ghosts_timer(0),
+            m_update_ghosts_timer(0),
             m_is_communicating(false),
             m_force_migrate(false),
             m_nneigh(0),
@@ -1074,11 +1081,16 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
             m_nettorque_copybuf(m_exec_conf),
             m_netvirial_copybuf(m_exec_conf),
             m_netvirial_recvbuf(m_exec_conf),
+            m_ghost_reqs_valid(false),
+            m_ghost_all_neighbors(false),
+            m_ghost_all_neighbors_requested(false),
             m_r_ghost_max(Scalar(0.0)),
             m_r_extra_ghost_max(Scalar(0.0)),
             m_ghosts_added(0),
             m_has_ghost_particles(false),
             m_plan(m_exec_conf),
+            m_ghost_update_overlap(false),
+            m_has_local_bodies(false),
             m_last_flags(0),
             m_comm_pending(false),
             m_bond_comm(*this, m_sysdef->getBondData()),
@@ -1099,12 +1111,15 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
         m_is_at_boundary[dir] = m_decomposition->isAtBoundary(dir) ? 1 : 0;
         }
 
-    for (unsigned int dir = 0; dir < 6; dir ++)
+    for (unsigned int ch = 0; ch < 26; ch ++)
         {
         GPUVector<unsigned int> copy_ghosts(m_exec_conf);
-        m_copy_ghosts[dir].swap(copy_ghosts);
-        m_num_copy_ghosts[dir] = 0;
-        m_num_recv_ghosts[dir] = 0;
+        m_copy_ghosts[ch].swap(copy_ghosts);
+        m_num_copy_ghosts[ch] = 0;
+        m_num_recv_ghosts[ch] = 0;
+        m_num_copy_local[ch] = 0;
+        m_num_recv_local[ch] = 0;
+        m_copy_offset[ch] = 0;
         }
 
     // connect to particle sort signal
@@ -1162,12 +1177,19 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
     m_end.swap(end);
 
     initializeNeighborArrays();
+    initializeGhostChannels();
     }
 
 //! Destructor
 Communicator::~Communicator()
     {
     m_exec_conf->msg->notice(5) << "Destroying Communicator" << std::endl;
+
+    int finalized;
+    MPI_Finalized(&finalized);
+    if (! finalized)
+        freeGhostUpdateRequests();
+
     m_pdata->getParticleSortSignal().disconnect<Communicator, &Communicator::forceMigrate>(this);
     m_pdata->getGhostParticlesRemovedSignal().disconnect<Communicator, &Communicator::slotGhostParticlesRemoved>(this);
     m_pdata->getNumTypesChangeSignal().disconnect<Communicator, &Communicator::slotNumTypesChanged>(this);
@@ -1272,6 +1294,86 @@ void Communicator::initializeNeighborArrays()
         }
     }
 
+/*! In the default mode, channel \a dir sends to the neighbor in direction \a dir and receives from the opposite
+    direction. When exchanging with all neighbors, the channels are the neighbor offsets in the same order as in
+    initializeNeighborArrays(), which is the same on all ranks. A particle is sent through a channel if its plan
+    contains all directions the offset is composed of.
+*/
+void Communicator::initializeGhostChannels()
+    {
+    if (! m_ghost_all_neighbors)
+        {
+        for (unsigned int dir = 0; dir < 6; dir++)
+            {
+            m_ghost_send_rank[dir] = m_decomposition->getNeighborRank(dir);
+            m_ghost_recv_rank[dir] = m_decomposition->getNeighborRank(dir % 2 == 0 ? dir+1 : dir-1);
+            m_ghost_plan_mask[dir] = 1 << dir;
+            }
+        return;
+        }
+
+    Index3D di = m_decomposition->getDomainIndexer();
+    uint3 mypos = m_decomposition->getGridPos();
+    ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(), access_location::host, access_mode::read);
+
+    unsigned int nch = 0;
+    for (int ix=-1; ix <= 1; ix++)
+        {
+        if (ix && di.getW() == 1) continue;
+        for (int iy=-1; iy <= 1; iy++)
+            {
+            if (iy && di.getH() == 1) continue;
+            for (int iz=-1; iz <= 1; iz++)
+                {
+                if (iz && di.getD() == 1) continue;
+                if (!ix && !iy && !iz) continue;
+
+                // ranks at the offset and at the opposite offset, with periodic wrapping
+                int3 send_pos = make_int3(((int)mypos.x+ix+di.getW()) % di.getW(),
+                                          ((int)mypos.y+iy+di.getH()) % di.getH(),
+                                          ((int)mypos.z+iz+di.getD()) % di.getD());
+                int3 recv_pos = make_int3(((int)mypos.x-ix+di.getW()) % di.getW(),
+                                          ((int)mypos.y-iy+di.getH()) % di.getH(),
+                                          ((int)mypos.z-iz+di.getD()) % di.getD());
+                m_ghost_send_rank[nch] = h_cart_ranks.data[di(send_pos.x, send_pos.y, send_pos.z)];
+                m_ghost_recv_rank[nch] = h_cart_ranks.data[di(recv_pos.x, recv_pos.y, recv_pos.z)];
+
+                unsigned int mask = 0;
+                if (ix > 0) mask |= send_east;
+                if (ix < 0) mask |= send_west;
+                if (iy > 0) mask |= send_north;
+                if (iy < 0) mask |= send_south;
+                if (iz > 0) mask |= send_up;
+                if (iz < 0) mask |= send_down;
+                m_ghost_plan_mask[nch] = mask;
+                nch++;
+                }
+            }
+        }
+    assert(nch == m_nneigh);
+    }
+
+/*! \param enable Set to true to exchange ghosts with all neighbors in a single stage
+
+    The new mode takes effect with the next ghost exchange, which is forced, so that pending ghost updates still use
+    the copy lists of the old mode. Only supported on the CPU.
+*/
+void Communicator::setGhostExchangeAllNeighbors(bool enable)
+    {
+    if (enable && m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->warning() << "comm: Exchanging ghosts with all neighbors at once is only supported on the CPU, ignoring" << endl;
+        return;
+        }
+
+    if (enable == m_ghost_all_neighbors_requested)
+        return;
+
+    // the copy lists are specific to the mode, rebuild them
+    m_ghost_all_neighbors_requested = enable;
+    m_force_migrate = true;
+    }
+
 //! Interface to the communication methods.
 void Communicator::communicate(unsigned int timestep)
     {
@@ -1289,8 +1391,7 @@ void Communicator::communicate(unsigned int timestep)
     if (!m_compute_callbacks.empty() && m_has_ghost_particles)
         {
         // do an obligatory update before determining whether to migrate
-        beginUpdateGhosts(timestep);
-        finishUpdateGhosts(timestep);
+        updateGhosts(timestep);
 
         // call subscribers after ghost update, but before distance check
         m_compute_callbacks.emit(timestep);
@@ -1316,9 +1417,7 @@ void Communicator::communicate(unsigned int timestep)
     // Update ghosts if we are not migrating
     if (!migrate && m_compute_callbacks.empty())
         {
-        beginUpdateGhosts(timestep);
-
-        finishUpdateGhosts(timestep);
+        updateGhosts(timestep);
         }
 
     // Check if migration of particles is requested
@@ -1327,10 +1426,14 @@ void Communicator::communicate(unsigned int timestep)
         m_force_migrate = false;
 
         // If so, migrate atoms
+        if (m_step_timer) m_step_timer->start(m_migrate_timer);
         migrateParticles();
+        if (m_step_timer) m_step_timer->stop(m_migrate_timer);
 
         // Construct ghost send lists, exchange ghost atom data
+        if (m_step_timer) m_step_timer->start(m_exchange_ghosts_timer);
         exchangeGhosts();
+        if (m_step_timer) m_step_timer->stop(m_exchange_ghosts_timer);
 
         // update particle data now that ghosts are available
         m_compute_callbacks.emit(timestep);
@@ -1341,6 +1444,54 @@ void Communicator::communicate(unsigned int timestep)
     m_is_communicating = false;
     }
 
+/*! \param timestep Current time step
+
+    Starts the ghost update, calls the interior compute call-backs if overlap is enabled, and finishes the update.
+    The call-backs are skipped on ranks with rigid bodies, because the compute call-backs change the positions of
+    local constituent particles after the ghost update.
+*/
+void Communicator::updateGhosts(unsigned int timestep)
+    {
+    if (m_step_timer) m_step_timer->start(m_update_ghosts_timer);
+    beginUpdateGhosts(timestep);
+    if (m_step_timer) m_step_timer->stop(m_update_ghosts_timer);
+
+    if (m_ghost_update_overlap && !m_has_local_bodies)
+        m_interior_compute_callbacks.emit(timestep);
+
+    if (m_step_timer) m_step_timer->start(m_update_ghosts_timer);
+    finishUpdateGhosts(timestep);
+    if (m_step_timer) m_step_timer->stop(m_update_ghosts_timer);
+    }
+
+/*! \param enable Set to true to compute forces on interior particles while ghost particles are updated
+
+    Overlap is only supported on the CPU.
+*/
+void Communicator::setGhostUpdateOverlap(bool enable)
+    {
+    if (enable && m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->warning() << "comm: Overlapping ghost updates with computation is only supported on the CPU, ignoring" << endl;
+        return;
+        }
+
+    m_ghost_update_overlap = enable;
+    }
+
+/*! \param timer Step timer to record the communication phases in. Set to NULL to stop timing.
+*/
+void Communicator::setStepTimer(std::shared_ptr<StepTimer> timer)
+    {
+    m_step_timer = timer;
+    if (m_step_timer)
+        {
+        m_migrate_timer = m_step_timer->registerTimer("comm_migrate");
+        m_exchange_ghosts_timer = m_step_timer->registerTimer("comm_exchange_ghosts");
+        m_update_ghosts_timer = m_step_timer->registerTimer("comm_update_ghosts");
+        }
+    }
+
 //! Transfer particles between neighboring domains
 void Communicator::migrateParticles()
     {
@@ -1419,8 +1570,7 @@ void Communicator::migrateParticles()
         m_constraints_changed = false;
 
         // fill send buffer
-        std::vector<unsigned int> comm_flag_out; // not currently used
-        m_pdata->removeParticles(m_sendbuf, comm_flag_out);
+        m_pdata->removeParticles(m_sendbuf, m_comm_flag_out);
 
         unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
 
@@ -1542,6 +1692,16 @@ void Communicator::exchangeGhosts()
 
     m_exec_conf->msg->notice(7) << "Communicator: exchange ghosts" << std::endl;
 
+    // the copy lists change, the ghost update requests need to be recreated
+    m_ghost_reqs_valid = false;
+
+    // switch the exchange mode, if requested
+    if (m_ghost_all_neighbors != m_ghost_all_neighbors_requested)
+        {
+        m_ghost_all_neighbors = m_ghost_all_neighbors_requested;
+        initializeGhostChannels();
+        }
+
     const BoxDim& box = m_pdata->getBox();
 
     // Sending ghosts proceeds in two stages:
@@ -1568,8 +1728,8 @@ void Communicator::exchangeGhosts()
     ArrayHandle<Scalar> h_r_ghost(m_r_ghost, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_r_ghost_body(m_r_ghost_body, access_location::host, access_mode::read);
     const Scalar3 box_dist = box.getNearestPlaneDistance();
-    std::vector<Scalar3> ghost_fractions(m_pdata->getNTypes());
-    std::vector<Scalar3> ghost_fractions_body(m_pdata->getNTypes());
+    pooled_vector<Scalar3> ghost_fractions(m_pdata->getNTypes(), Scalar3(), m_exec_conf->getHostBufferPool());
+    pooled_vector<Scalar3> ghost_fractions_body(m_pdata->getNTypes(), Scalar3(), m_exec_conf->getHostBufferPool());
     for (unsigned int cur_type = 0; cur_type < m_pdata->getNTypes(); ++cur_type)
         {
         ghost_fractions[cur_type] = h_r_ghost.data[cur_type] / box_dist;
@@ -1582,6 +1742,8 @@ void Communicator::exchangeGhosts()
         ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
         ArrayHandle<unsigned int> h_plan(m_plan, access_location::host, access_mode::readwrite);
 
+        m_has_local_bodies = false;
+
         for (unsigned int idx = 0; idx < m_pdata->getN(); idx++)
             {
             Scalar4 postype = h_pos.data[idx];
@@ -1593,6 +1755,7 @@ void Communicator::exchangeGhosts()
 
             if (h_body.data[idx] != NO_BODY)
                 {
+                m_has_local_bodies = true;
                 ghost_fraction = make_scalar3(std::max(ghost_fraction.x, ghost_fractions_body[type].x),
                                               std::max(ghost_fraction.y, ghost_fractions_body[type].y),
                                               std::max(ghost_fraction.z, ghost_fractions_body[type].z));
@@ -1650,62 +1813,81 @@ void Communicator::exchangeGhosts()
     // ghost particle flags
     CommFlags flags = getFlags();
 
-    // resize buffers
-    m_plan_copybuf.resize(m_pdata->getN());
-    if (flags[comm_flag::position])
-        m_pos_copybuf.resize(m_pdata->getN());
-
-    if (flags[comm_flag::charge])
-        m_charge_copybuf.resize(m_pdata->getN());
+    // In the default mode, ghosts are exchanged in six stages, one per direction, and the ghosts received in one stage
+    // are forwarded in the later stages. When exchanging with all neighbors, local particles are sent directly
+    // to all their destinations in a single stage.
+    const unsigned int nstages = m_ghost_all_neighbors ? 1 : 6;
 
-    if (flags[comm_flag::body])
-        m_body_copybuf.resize(m_pdata->getN());
+    for (unsigned int stage = 0; stage < nstages; ++stage)
+        {
+        const unsigned int first_ch = m_ghost_all_neighbors ? 0 : stage;
+        const unsigned int last_ch = m_ghost_all_neighbors ? getNumGhostChannels() : stage + 1;
 
-    if (flags[comm_flag::image])
-        m_image_copybuf.resize(m_pdata->getN());
+        // ghosts received in this stage are appended at the end of the particle data arrays
+        const unsigned int max_copy_ghosts = m_ghost_all_neighbors ? m_pdata->getN() : m_pdata->getN() + m_pdata->getNGhosts();
 
-    if (flags[comm_flag::diameter])
-        m_diameter_copybuf.resize(m_pdata->getN());
+        for (unsigned int ch = first_ch; ch < last_ch; ++ch)
+            {
+            m_num_copy_ghosts[ch] = 0;
+            m_num_copy_local[ch] = 0;
+            }
 
-    if (flags[comm_flag::velocity])
-        m_velocity_copybuf.resize(m_pdata->getN());
+        // count the particles to send through every channel
+            {
+            ArrayHandle<unsigned int>  h_plan(m_plan, access_location::host, access_mode::read);
 
-    if (flags[comm_flag::orientation])
-        m_orientation_copybuf.resize(m_pdata->getN());
+            for (unsigned int idx = 0; idx < max_copy_ghosts; idx++)
+                {
+                unsigned int plan = h_plan.data[idx];
+                if (! plan) continue;
 
-    for (unsigned int dir = 0; dir < 6; dir ++)
-        {
-        if (! isCommunicating(dir) ) continue;
+                for (unsigned int ch = first_ch; ch < last_ch; ++ch)
+                    {
+                    if (isGhostChannelActive(ch) && (plan & m_ghost_plan_mask[ch]) == m_ghost_plan_mask[ch])
+                        {
+                        m_num_copy_ghosts[ch]++;
 
-        m_num_copy_ghosts[dir] = 0;
+                        // local particles come first, they are sent without waiting for other directions in updates
+                        if (idx < m_pdata->getN())
+                            m_num_copy_local[ch]++;
+                        }
+                    }
+                }
+            }
 
-        // resize array of ghost particle tags
-        unsigned int max_copy_ghosts = m_pdata->getN() + m_pdata->getNGhosts();
-        m_copy_ghosts[dir].resize(max_copy_ghosts);
+        // every channel has its own section of the send buffers
+        unsigned int num_copy_stage = 0;
+        for (unsigned int ch = first_ch; ch < last_ch; ++ch)
+            {
+            m_copy_offset[ch] = num_copy_stage;
+            num_copy_stage += m_num_copy_ghosts[ch];
+            m_copy_ghosts[ch].resize(m_num_copy_ghosts[ch]);
+            }
 
         // resize buffers
-        m_plan_copybuf.resize(max_copy_ghosts);
+        m_plan_copybuf.resize(num_copy_stage);
+        m_tag_copybuf.resize(num_copy_stage);
 
         if (flags[comm_flag::position])
-            m_pos_copybuf.resize(max_copy_ghosts);
+            m_pos_copybuf.resize(num_copy_stage);
 
         if (flags[comm_flag::charge])
-            m_charge_copybuf.resize(max_copy_ghosts);
+            m_charge_copybuf.resize(num_copy_stage);
 
         if (flags[comm_flag::body])
-            m_body_copybuf.resize(max_copy_ghosts);
+            m_body_copybuf.resize(num_copy_stage);
 
         if (flags[comm_flag::image])
-            m_image_copybuf.resize(max_copy_ghosts);
+            m_image_copybuf.resize(num_copy_stage);
 
         if (flags[comm_flag::diameter])
-            m_diameter_copybuf.resize(max_copy_ghosts);
+            m_diameter_copybuf.resize(num_copy_stage);
 
         if (flags[comm_flag::velocity])
-            m_velocity_copybuf.resize(max_copy_ghosts);
+            m_velocity_copybuf.resize(num_copy_stage);
 
         if (flags[comm_flag::orientation])
-            m_orientation_copybuf.resize(max_copy_ghosts);
+            m_orientation_copybuf.resize(num_copy_stage);
 
             {
             // we fill all fields, but send only those that are requested by the CommFlags bitset
@@ -1719,7 +1901,7 @@ void Communicator::exchangeGhosts()
             ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
             ArrayHandle<unsigned int>  h_plan(m_plan, access_location::host, access_mode::read);
 
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::overwrite);
+            ArrayHandle<unsigned int> h_tag_copybuf(m_tag_copybuf, access_location::host, access_mode::overwrite);
             ArrayHandle<unsigned int> h_plan_copybuf(m_plan_copybuf, access_location::host, access_mode::overwrite);
             ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::overwrite);
             ArrayHandle<Scalar> h_charge_copybuf(m_charge_copybuf, access_location::host, access_mode::overwrite);
@@ -1729,66 +1911,91 @@ void Communicator::exchangeGhosts()
             ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf, access_location::host, access_mode::overwrite);
             ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::overwrite);
 
-            for (unsigned int idx = 0; idx < m_pdata->getN() + m_pdata->getNGhosts(); idx++)
+            unsigned int n_packed[26];
+            for (unsigned int ch = first_ch; ch < last_ch; ++ch)
+                n_packed[ch] = 0;
+
+            for (unsigned int idx = 0; idx < max_copy_ghosts; idx++)
                 {
+                unsigned int plan = h_plan.data[idx];
+                if (! plan) continue;
 
-                if (h_plan.data[idx] & (1 << dir))
+                for (unsigned int ch = first_ch; ch < last_ch; ++ch)
                     {
+                    if (! isGhostChannelActive(ch) || (plan & m_ghost_plan_mask[ch]) != m_ghost_plan_mask[ch])
+                        continue;
+
                     // send with next message
-                    if (flags[comm_flag::position]) h_pos_copybuf.data[m_num_copy_ghosts[dir]] = h_pos.data[idx];
-                    if (flags[comm_flag::charge]) h_charge_copybuf.data[m_num_copy_ghosts[dir]] = h_charge.data[idx];
-                    if (flags[comm_flag::diameter]) h_diameter_copybuf.data[m_num_copy_ghosts[dir]] = h_diameter.data[idx];
-                    if (flags[comm_flag::body]) h_body_copybuf.data[m_num_copy_ghosts[dir]] = h_body.data[idx];
-                    if (flags[comm_flag::image]) h_image_copybuf.data[m_num_copy_ghosts[dir]] = h_image.data[idx];
-                    if (flags[comm_flag::velocity]) h_velocity_copybuf.data[m_num_copy_ghosts[dir]] = h_vel.data[idx];
-                    if (flags[comm_flag::orientation]) h_orientation_copybuf.data[m_num_copy_ghosts[dir]] = h_orientation.data[idx];
-                    h_plan_copybuf.data[m_num_copy_ghosts[dir]] = h_plan.data[idx];
-
-                    h_copy_ghosts.data[m_num_copy_ghosts[dir]] = h_tag.data[idx];
-                    m_num_copy_ghosts[dir]++;
+                    unsigned int i = m_copy_offset[ch] + n_packed[ch]++;
+                    if (flags[comm_flag::position]) h_pos_copybuf.data[i] = h_pos.data[idx];
+                    if (flags[comm_flag::charge]) h_charge_copybuf.data[i] = h_charge.data[idx];
+                    if (flags[comm_flag::diameter]) h_diameter_copybuf.data[i] = h_diameter.data[idx];
+                    if (flags[comm_flag::body]) h_body_copybuf.data[i] = h_body.data[idx];
+                    if (flags[comm_flag::image]) h_image_copybuf.data[i] = h_image.data[idx];
+                    if (flags[comm_flag::velocity]) h_velocity_copybuf.data[i] = h_vel.data[idx];
+                    if (flags[comm_flag::orientation]) h_orientation_copybuf.data[i] = h_orientation.data[idx];
+                    h_plan_copybuf.data[i] = plan;
+                    h_tag_copybuf.data[i] = h_tag.data[idx];
                     }
                 }
-            }
-        unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
 
-        // we receive from the direction opposite to the one we send to
-        unsigned int recv_neighbor;
-        if (dir % 2 == 0)
-            recv_neighbor = m_decomposition->getNeighborRank(dir+1);
-        else
-            recv_neighbor = m_decomposition->getNeighborRank(dir-1);
+            // the copy lists hold the tags of the sent particles, for ghost updates
+            for (unsigned int ch = first_ch; ch < last_ch; ++ch)
+                {
+                ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[ch], access_location::host, access_mode::overwrite);
+                std::copy(h_tag_copybuf.data + m_copy_offset[ch],
+                    h_tag_copybuf.data + m_copy_offset[ch] + m_num_copy_ghosts[ch],
+                    h_copy_ghosts.data);
+                }
+            }
 
         if (m_prof)
             m_prof->push("MPI send/recv");
 
-        // communicate size of the message that will contain the particle data
-        MPI_Request reqs[14];
-        MPI_Status status[14];
-
-        MPI_Isend(&m_num_copy_ghosts[dir],
-            sizeof(unsigned int),
-            MPI_BYTE,
-            send_neighbor,
-            0,
-            m_mpi_comm,
-            &reqs[0]);
-        MPI_Irecv(&m_num_recv_ghosts[dir],
-            sizeof(unsigned int),
-            MPI_BYTE,
-            recv_neighbor,
-            0,
-            m_mpi_comm,
-            &reqs[1]);
-        MPI_Waitall(2, reqs, status);
+        // communicate size of the messages that will contain the particle data,
+        // and how many of the particles are local on the sending rank
+        pooled_vector<MPI_Request> reqs(m_exec_conf->getHostBufferPool());
+        reqs.reserve(2*10*(last_ch - first_ch));
+
+        unsigned int send_counts[26][2];
+        unsigned int recv_counts[26][2];
+        for (unsigned int ch = first_ch; ch < last_ch; ++ch)
+            {
+            if (! isGhostChannelActive(ch)) continue;
+
+            send_counts[ch][0] = m_num_copy_ghosts[ch];
+            send_counts[ch][1] = m_num_copy_local[ch];
+
+            reqs.resize(reqs.size()+2);
+            MPI_Isend(send_counts[ch], 2*sizeof(unsigned int), MPI_BYTE, m_ghost_send_rank[ch], ch, m_mpi_comm, &reqs[reqs.size()-2]);
+            MPI_Irecv(recv_counts[ch], 2*sizeof(unsigned int), MPI_BYTE, m_ghost_recv_rank[ch], ch, m_mpi_comm, &reqs[reqs.size()-1]);
+            }
+        if (reqs.size())
+            MPI_Waitall(reqs.size(), &reqs.front(), MPI_STATUSES_IGNORE);
+        reqs.clear();
 
         if (m_prof)
             m_prof->pop();
 
-        // append ghosts at the end of particle data array
+        // ghosts of every channel are appended at the end of particle data array, in channel order
         unsigned int start_idx = m_pdata->getN() + m_pdata->getNGhosts();
+        unsigned int recv_start[26];
+        unsigned int num_recv_stage = 0;
+        for (unsigned int ch = first_ch; ch < last_ch; ++ch)
+            {
+            m_num_recv_ghosts[ch] = 0;
+            m_num_recv_local[ch] = 0;
+            if (isGhostChannelActive(ch))
+                {
+                m_num_recv_ghosts[ch] = recv_counts[ch][0];
+                m_num_recv_local[ch] = recv_counts[ch][1];
+                }
+            recv_start[ch] = start_idx + num_recv_stage;
+            num_recv_stage += m_num_recv_ghosts[ch];
+            }
 
         // accommodate new ghost particles
-        m_pdata->addGhostParticles(m_num_recv_ghosts[dir]);
+        m_pdata->addGhostParticles(num_recv_stage);
 
         // resize plan array
         m_plan.resize(m_pdata->getN() + m_pdata->getNGhosts());
@@ -1798,7 +2005,7 @@ void Communicator::exchangeGhosts()
             m_prof->push("MPI send/recv");
 
             {
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_tag_copybuf(m_tag_copybuf, access_location::host, access_mode::read);
             ArrayHandle<unsigned int> h_plan_copybuf(m_plan_copybuf, access_location::host, access_mode::read);
             ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::read);
             ArrayHandle<Scalar> h_charge_copybuf(m_charge_copybuf, access_location::host, access_mode::read);
@@ -1818,166 +2025,50 @@ void Communicator::exchangeGhosts()
             ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
             ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::readwrite);
 
-            unsigned int nreq = 0;
+            for (unsigned int ch = first_ch; ch < last_ch; ++ch)
+                {
+                if (! isGhostChannelActive(ch)) continue;
 
-            MPI_Isend(h_plan_copybuf.data,
-                m_num_copy_ghosts[dir]*sizeof(unsigned int),
-                MPI_BYTE,
-                send_neighbor,
-                1,
-                m_mpi_comm,
-                &reqs[nreq++]);
-            MPI_Irecv(h_plan.data + start_idx,
-                m_num_recv_ghosts[dir]*sizeof(unsigned int),
-                MPI_BYTE,
-                recv_neighbor,
-                1,
-                m_mpi_comm,
-                &reqs[nreq++]);
+                // every field and channel has its own tag, because all messages may be in flight at the same time
+                auto post = [&](void *send_data, void *recv_data, size_t size, unsigned int field)
+                    {
+                    reqs.resize(reqs.size()+2);
+                    MPI_Isend(send_data, m_num_copy_ghosts[ch]*size, MPI_BYTE, m_ghost_send_rank[ch],
+                        32*field + ch, m_mpi_comm, &reqs[reqs.size()-2]);
+                    MPI_Irecv(recv_data, m_num_recv_ghosts[ch]*size, MPI_BYTE, m_ghost_recv_rank[ch],
+                        32*field + ch, m_mpi_comm, &reqs[reqs.size()-1]);
+                    };
 
-            MPI_Isend(h_copy_ghosts.data,
-                m_num_copy_ghosts[dir]*sizeof(unsigned int),
-                MPI_BYTE,
-                send_neighbor,
-                2,
-                m_mpi_comm,
-                &reqs[nreq++]);
-            MPI_Irecv(h_tag.data + start_idx,
-                m_num_recv_ghosts[dir]*sizeof(unsigned int),
-                MPI_BYTE,
-                recv_neighbor,
-                2,
-                m_mpi_comm,
-                &reqs[nreq++]);
+                const unsigned int first = m_copy_offset[ch];
+                const unsigned int recv = recv_start[ch];
 
-            if (flags[comm_flag::position])
-                {
-                MPI_Isend(h_pos_copybuf.data,
-                    m_num_copy_ghosts[dir]*sizeof(Scalar4),
-                    MPI_BYTE,
-                    send_neighbor,
-                    3,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                MPI_Irecv(h_pos.data + start_idx,
-                    m_num_recv_ghosts[dir]*sizeof(Scalar4),
-                    MPI_BYTE,
-                    recv_neighbor,
-                    3,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                }
+                post(h_plan_copybuf.data + first, h_plan.data + recv, sizeof(unsigned int), 1);
+                post(h_tag_copybuf.data + first, h_tag.data + recv, sizeof(unsigned int), 2);
 
-            if (flags[comm_flag::charge])
-                {
-                MPI_Isend(h_charge_copybuf.data,
-                    m_num_copy_ghosts[dir]*sizeof(Scalar),
-                    MPI_BYTE,
-                    send_neighbor,
-                    4,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                MPI_Irecv(h_charge.data + start_idx,
-                    m_num_recv_ghosts[dir]*sizeof(Scalar),
-                    MPI_BYTE,
-                    recv_neighbor,
-                    4,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                }
+                if (flags[comm_flag::position])
+                    post(h_pos_copybuf.data + first, h_pos.data + recv, sizeof(Scalar4), 3);
 
-            if (flags[comm_flag::diameter])
-                {
-                MPI_Isend(h_diameter_copybuf.data,
-                    m_num_copy_ghosts[dir]*sizeof(Scalar),
-                    MPI_BYTE,
-                    send_neighbor,
-                    5,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                MPI_Irecv(h_diameter.data + start_idx,
-                    m_num_recv_ghosts[dir]*sizeof(Scalar),
-                    MPI_BYTE,
-                    recv_neighbor,
-                    5,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                }
+                if (flags[comm_flag::charge])
+                    post(h_charge_copybuf.data + first, h_charge.data + recv, sizeof(Scalar), 4);
 
-            if (flags[comm_flag::velocity])
-                {
-                MPI_Isend(h_velocity_copybuf.data,
-                    m_num_copy_ghosts[dir]*sizeof(Scalar4),
-                    MPI_BYTE,
-                    send_neighbor,
-                    6,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                MPI_Irecv(h_vel.data + start_idx,
-                    m_num_recv_ghosts[dir]*sizeof(Scalar4),
-                    MPI_BYTE,
-                    recv_neighbor,
-                    6,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                }
+                if (flags[comm_flag::diameter])
+                    post(h_diameter_copybuf.data + first, h_diameter.data + recv, sizeof(Scalar), 5);
 
+                if (flags[comm_flag::velocity])
+                    post(h_velocity_copybuf.data + first, h_vel.data + recv, sizeof(Scalar4), 6);
 
-            if (flags[comm_flag::orientation])
-                {
-                MPI_Isend(h_orientation_copybuf.data,
-                    m_num_copy_ghosts[dir]*sizeof(Scalar4),
-                    MPI_BYTE,
-                    send_neighbor,
-                    7,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                MPI_Irecv(h_orientation.data + start_idx,
-                    m_num_recv_ghosts[dir]*sizeof(Scalar4),
-                    MPI_BYTE,
-                    recv_neighbor,
-                    7,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                }
+                if (flags[comm_flag::orientation])
+                    post(h_orientation_copybuf.data + first, h_orientation.data + recv, sizeof(Scalar4), 7);
 
-            if (flags[comm_flag::body])
-                {
-                MPI_Isend(h_body_copybuf.data,
-                    m_num_copy_ghosts[dir]*sizeof(unsigned int),
-                    MPI_BYTE,
-                    send_neighbor,
-                    8,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                MPI_Irecv(h_body.data + start_idx,
-                    m_num_recv_ghosts[dir]*sizeof(unsigned int),
-                    MPI_BYTE,
-                    recv_neighbor,
-                    8,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                }
+                if (flags[comm_flag::body])
+                    post(h_body_copybuf.data + first, h_body.data + recv, sizeof(unsigned int), 8);
 
-            if (flags[comm_flag::image])
-                {
-                MPI_Isend(h_image_copybuf.data,
-                    m_num_copy_ghosts[dir]*sizeof(int3),
-                    MPI_BYTE,
-                    send_neighbor,
-                    9,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
-                MPI_Irecv(h_image.data + start_idx,
-                    m_num_recv_ghosts[dir]*sizeof(int3),
-                    MPI_BYTE,
-                    recv_neighbor,
-                    9,
-                    m_mpi_comm,
-                    &reqs[nreq++]);
+                if (flags[comm_flag::image])
+                    post(h_image_copybuf.data + first, h_image.data + recv, sizeof(int3), 9);
                 }
 
-            MPI_Waitall(nreq, reqs, status);
+            if (reqs.size())
+                MPI_Waitall(reqs.size(), &reqs.front(), MPI_STATUSES_IGNORE);
             }
 
         if (m_prof)
@@ -1991,7 +2082,7 @@ void Communicator::exchangeGhosts()
 
             const BoxDim shifted_box = getShiftedBox();
 
-            for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[dir]; idx++)
+            for (unsigned int idx = start_idx; idx < start_idx + num_recv_stage; idx++)
                 {
                 Scalar4& pos = h_pos.data[idx];
 
@@ -2006,7 +2097,7 @@ void Communicator::exchangeGhosts()
             ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
             ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::readwrite);
 
-            for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[dir]; idx++)
+            for (unsigned int idx = start_idx; idx < start_idx + num_recv_stage; idx++)
                 {
                 assert(h_tag.data[idx] <= m_pdata->getMaximumTag());
                 assert(h_rtag.data[h_tag.data[idx]] == NOT_LOCAL);
@@ -2014,7 +2105,7 @@ void Communicator::exchangeGhosts()
                 }
 
             }
-        } // end dir loop
+        } // end stage loop
 
     m_ghosts_added = m_pdata->getNGhosts();
 
@@ -2037,168 +2128,281 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
 
     m_exec_conf->msg->notice(7) << "Communicator: update ghosts" << std::endl;
 
-    // update data in these arrays
+    // the persistent requests are bound to the send buffers and to the particle data arrays
+    if (m_ghost_reqs_valid && getFlags() == m_ghost_reqs_flags)
+        getGhostUpdateBuffers(m_ghost_bufs);
+    if (! m_ghost_reqs_valid || getFlags() != m_ghost_reqs_flags || m_ghost_bufs != m_ghost_reqs_bufs)
+        initGhostUpdateRequests();
+
+    // ghosts that are local particles on this rank do not depend on other directions, send them all now
+    for (unsigned int ch = 0; ch < getNumGhostChannels(); ch ++)
+        {
+        if (! isGhostChannelActive(ch) ) continue;
+
+        startGhostUpdate(ch, false);
+        }
+
+    m_comm_pending = true;
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param timestep The time step
+
+    Ghosts that were themselves received as ghosts (at the edges and corners of the domain) are forwarded direction
+    by direction, after the direction they were received from has completed. When exchanging with all neighbors,
+    there are no forwarded ghosts and this only waits for the messages to complete.
+*/
+void Communicator::finishUpdateGhosts(unsigned int timestep)
+    {
+    if (! m_comm_pending)
+        return;
+
+    if (m_prof)
+        m_prof->push("comm_ghost_update");
+
+    CommFlags flags = getFlags();
+
+    size_t sz = 0;
+    if (flags[comm_flag::position]) sz += sizeof(Scalar4);
+    if (flags[comm_flag::velocity]) sz += sizeof(Scalar4);
+    if (flags[comm_flag::orientation]) sz += sizeof(Scalar4);
 
     unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
+    size_t num_bytes = 0;
 
-    for (unsigned int dir = 0; dir < 6; dir ++)
+    for (unsigned int ch = 0; ch < getNumGhostChannels(); ch ++)
         {
-        if (! isCommunicating(dir) ) continue;
+        if (! isGhostChannelActive(ch) ) continue;
 
-        CommFlags flags = getFlags();
+        // the ghosts received in previous directions are current now, forward them
+        startGhostUpdate(ch, true);
 
-        if (flags[comm_flag::position])
+        if (m_prof)
+            m_prof->push("MPI send/recv");
+
+        // completed persistent requests become inactive and can be restarted in the next update
+        for (unsigned int part = 0; part < 2; part++)
             {
-            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-            ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::overwrite);
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+            std::vector<MPI_Request>& reqs = m_ghost_reqs[ch][part];
+            if (reqs.size())
+                MPI_Waitall(reqs.size(), &reqs.front(), MPI_STATUSES_IGNORE);
+            }
 
-            // copy positions of ghost particles
-            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
-                {
-                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+        if (m_prof)
+            m_prof->pop(0, (m_num_recv_ghosts[ch]+m_num_copy_ghosts[ch])*sz);
 
-                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+        num_bytes += (m_num_recv_ghosts[ch]+m_num_copy_ghosts[ch])*sz;
 
-                // copy position into send buffer
-                h_pos_copybuf.data[ghost_idx] = h_pos.data[idx];
-                }
-            }
+        unsigned int start_idx = m_pdata->getN() + num_tot_recv_ghosts;
+        num_tot_recv_ghosts += m_num_recv_ghosts[ch];
 
-        if (flags[comm_flag::velocity])
+        // wrap particle positions (only if copying positions)
+        if (flags[comm_flag::position])
             {
-            ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
-            ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf, access_location::host, access_mode::overwrite);
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
 
-            // copy velocity of ghost particles
-            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+            const BoxDim shifted_box = getShiftedBox();
+            for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[ch]; idx++)
                 {
-                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
-
-                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+                Scalar4& pos = h_pos.data[idx];
 
-                // copy velocityition into send buffer
-                h_velocity_copybuf.data[ghost_idx] = h_vel.data[idx];
+                // wrap particles received across a global boundary
+                int3 img = make_int3(0,0,0);
+                shifted_box.wrap(pos, img);
                 }
             }
+        }
 
-        if (flags[comm_flag::orientation])
-            {
-            ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
-            ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::overwrite);
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    m_comm_pending = false;
 
-            // copy orientation of ghost particles
-            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
-                {
-                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+    if (m_prof)
+        m_prof->pop();
+    }
 
-                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+/*! \param bufs Vector to fill with the base pointers of all arrays the ghost update requests are bound to
 
-                // copy orientation into send buffer
-                h_orientation_copybuf.data[ghost_idx] = h_orientation.data[idx];
-                }
-            }
+    The particle data arrays may be swapped or reallocated between ghost exchanges, e.g. when particles are sorted.
+*/
+void Communicator::getGhostUpdateBuffers(std::vector<void *>& bufs)
+    {
+    bufs.clear();
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::read);
+
+    bufs.push_back(h_pos.data);
+    bufs.push_back(h_vel.data);
+    bufs.push_back(h_orientation.data);
+    bufs.push_back(h_pos_copybuf.data);
+    bufs.push_back(h_velocity_copybuf.data);
+    bufs.push_back(h_orientation_copybuf.data);
+    }
 
+/*! The copy lists only change when ghosts are exchanged. For every channel, persistent send and receive requests
+    are created once for the local and for the forwarded ghosts, bound to the channel's section of the send buffers
+    and to its range of the ghost particles. Every ghost update then only packs the send buffers and starts the
+    requests.
+*/
+void Communicator::initGhostUpdateRequests()
+    {
+    freeGhostUpdateRequests();
 
-        unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
+    CommFlags flags = getFlags();
 
-        // we receive from the direction opposite to the one we send to
-        unsigned int recv_neighbor;
-        if (dir % 2 == 0)
-            recv_neighbor = m_decomposition->getNeighborRank(dir+1);
-        else
-            recv_neighbor = m_decomposition->getNeighborRank(dir-1);
+    // every channel has its own section of the send buffers, so that all messages can be in flight at once
+    unsigned int num_tot_copy_ghosts = 0;
+    for (unsigned int ch = 0; ch < getNumGhostChannels(); ch ++)
+        {
+        m_copy_offset[ch] = num_tot_copy_ghosts;
+        if (isGhostChannelActive(ch))
+            num_tot_copy_ghosts += m_num_copy_ghosts[ch];
+        }
 
+    if (flags[comm_flag::position])
+        m_pos_copybuf.resize(num_tot_copy_ghosts);
 
-        unsigned int start_idx;
+    if (flags[comm_flag::velocity])
+        m_velocity_copybuf.resize(num_tot_copy_ghosts);
 
-        if (m_prof)
-            m_prof->push("MPI send/recv");
+    if (flags[comm_flag::orientation])
+        m_orientation_copybuf.resize(num_tot_copy_ghosts);
 
-        start_idx = m_pdata->getN() + num_tot_recv_ghosts;
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::readwrite);
 
-        num_tot_recv_ghosts += m_num_recv_ghosts[dir];
+        // ghosts are received in channel order
+        unsigned int start_ch = m_pdata->getN();
 
-        size_t sz = 0;
-        // only non-permanent fields (position, velocity, orientation) need to be considered here
-        // charge, body, image and diameter are not updated between neighbor list builds
-        if (flags[comm_flag::position])
+        for (unsigned int ch = 0; ch < getNumGhostChannels(); ch ++)
             {
-            MPI_Request reqs[2];
-            MPI_Status status[2];
+            if (! isGhostChannelActive(ch) ) continue;
 
-            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
-            ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::read);
+            for (unsigned int part = 0; part < 2; part++)
+                {
+                // ranges of the copy list and of the received ghosts in this part of the message
+                bool forwarded = part == 1;
+                unsigned int first_copy = forwarded ? m_num_copy_local[ch] : 0;
+                unsigned int last_copy = forwarded ? m_num_copy_ghosts[ch] : m_num_copy_local[ch];
+                unsigned int first_recv = forwarded ? m_num_recv_local[ch] : 0;
+                unsigned int last_recv = forwarded ? m_num_recv_ghosts[ch] : m_num_recv_local[ch];
+
+                const unsigned int send_idx = m_copy_offset[ch] + first_copy;
+                const unsigned int recv_idx = start_ch + first_recv;
+
+                // every channel and part has its own tags, because all messages may be in flight at the same time
+                // only non-permanent fields (position, velocity, orientation) need to be considered here
+                // charge, body, image and diameter are not updated between neighbor list builds
+                const int tag = 1 + 3*ch + (forwarded ? 3*26 : 0);
+
+                // empty parts are not sent, the receiving rank knows their size
+                std::vector<MPI_Request>& reqs = m_ghost_reqs[ch][part];
+                auto init = [&](Scalar4 *send_buf, Scalar4 *recv_buf, int field_tag)
+                    {
+                    if (last_copy > first_copy)
+                        {
+                        reqs.resize(reqs.size()+1);
+                        MPI_Send_init(send_buf + send_idx, (last_copy-first_copy)*sizeof(Scalar4), MPI_BYTE,
+                            m_ghost_send_rank[ch], field_tag, m_mpi_comm, &reqs.back());
+                        }
+                    if (last_recv > first_recv)
+                        {
+                        reqs.resize(reqs.size()+1);
+                        MPI_Recv_init(recv_buf + recv_idx, (last_recv-first_recv)*sizeof(Scalar4), MPI_BYTE,
+                            m_ghost_recv_rank[ch], field_tag, m_mpi_comm, &reqs.back());
+                        }
+                    };
 
-            // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_pos_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 1, m_mpi_comm, &reqs[0]);
-            MPI_Irecv(h_pos.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 1, m_mpi_comm, &reqs[1]);
-            MPI_Waitall(2, reqs, status);
+                if (flags[comm_flag::position])
+                    init(h_pos_copybuf.data, h_pos.data, tag);
 
-            sz += sizeof(Scalar4);
-            }
+                if (flags[comm_flag::velocity])
+                    init(h_velocity_copybuf.data, h_vel.data, tag+1);
 
-        if (flags[comm_flag::velocity])
-            {
-            MPI_Request reqs[2];
-            MPI_Status status[2];
+                if (flags[comm_flag::orientation])
+                    init(h_orientation_copybuf.data, h_orientation.data, tag+2);
+                }
 
-            ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
-            ArrayHandle<Scalar4> h_vel_copybuf(m_velocity_copybuf, access_location::host, access_mode::read);
+            start_ch += m_num_recv_ghosts[ch];
+            }
+        }
 
-            // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_vel_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 2, m_mpi_comm, &reqs[0]);
-            MPI_Irecv(h_vel.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 2, m_mpi_comm, &reqs[1]);
-            MPI_Waitall(2, reqs, status);
+    m_ghost_reqs_flags = flags;
+    getGhostUpdateBuffers(m_ghost_reqs_bufs);
+    m_ghost_reqs_valid = true;
+    }
 
-            sz += sizeof(Scalar4);
+//! Free the persistent ghost update requests
+void Communicator::freeGhostUpdateRequests()
+    {
+    for (unsigned int ch = 0; ch < 26; ch++)
+        for (unsigned int part = 0; part < 2; part++)
+            {
+            for (unsigned int i = 0; i < m_ghost_reqs[ch][part].size(); ++i)
+                MPI_Request_free(&m_ghost_reqs[ch][part][i]);
+            m_ghost_reqs[ch][part].clear();
             }
 
-        if (flags[comm_flag::orientation])
-            {
-            MPI_Request reqs[2];
-            MPI_Status status[2];
+    m_ghost_reqs_valid = false;
+    }
 
-            ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
-            ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::read);
+/*! \param ch Channel to send through
+    \param forwarded If false, start the messages for the ghosts that are local particles of the sending rank,
+           otherwise for the ghosts that the sending rank received from other directions
 
-            // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_orientation_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 3, m_mpi_comm, &reqs[0]);
-            MPI_Irecv(h_orientation.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 3, m_mpi_comm, &reqs[1]);
-            MPI_Waitall(2, reqs, status);
+    The send buffer section of \a ch is filled and the persistent requests of this part are started.
+*/
+void Communicator::startGhostUpdate(unsigned int ch, bool forwarded)
+    {
+    CommFlags flags = getFlags();
 
-            sz += sizeof(Scalar4);
-            }
+    // range of the copy list in this part of the message
+    unsigned int first_copy = forwarded ? m_num_copy_local[ch] : 0;
+    unsigned int last_copy = forwarded ? m_num_copy_ghosts[ch] : m_num_copy_local[ch];
 
-        if (m_prof)
-            m_prof->pop(0, (m_num_recv_ghosts[dir]+m_num_copy_ghosts[dir])*sz);
+    const unsigned int offset = m_copy_offset[ch];
 
+        {
+        ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[ch], access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
-        // wrap particle positions (only if copying positions)
-        if (flags[comm_flag::position])
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::readwrite);
+
+        const bool copy_pos = flags[comm_flag::position];
+        const bool copy_vel = flags[comm_flag::velocity];
+        const bool copy_orientation = flags[comm_flag::orientation];
+
+        // gather all requested fields of the ghost particles in one pass over the copy list
+        for (unsigned int ghost_idx = first_copy; ghost_idx < last_copy; ghost_idx++)
             {
-            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+            unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
 
-            const BoxDim shifted_box = getShiftedBox();
-            for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[dir]; idx++)
-                {
-                Scalar4& pos = h_pos.data[idx];
+            assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
 
-                // wrap particles received across a global boundary
-                int3 img = make_int3(0,0,0);
-                shifted_box.wrap(pos, img);
-                }
+            if (copy_pos) h_pos_copybuf.data[offset + ghost_idx] = h_pos.data[idx];
+            if (copy_vel) h_velocity_copybuf.data[offset + ghost_idx] = h_vel.data[idx];
+            if (copy_orientation) h_orientation_copybuf.data[offset + ghost_idx] = h_orientation.data[idx];
             }
+        }
 
-        } // end dir loop
-
-        if (m_prof)
-            m_prof->pop();
+    std::vector<MPI_Request>& reqs = m_ghost_reqs[ch][forwarded ? 1 : 0];
+    if (reqs.size())
+        MPI_Startall(reqs.size(), &reqs.front());
     }
 
 void Communicator::updateNetForce(unsigned int timestep)
@@ -2245,34 +2449,34 @@ void Communicator::updateNetForce(unsigned int timestep)
         m_netvirial_copybuf.clear();
         }
 
-    for (unsigned int dir = 0; dir < 6; dir ++)
+    for (unsigned int ch = 0; ch < getNumGhostChannels(); ch ++)
         {
-        if (! isCommunicating(dir) ) continue;
+        if (! isGhostChannelActive(ch) ) continue;
 
         // resize send buffer
         unsigned int old_size = m_netforce_copybuf.size();
-        m_netforce_copybuf.resize(old_size+m_num_copy_ghosts[dir]);
+        m_netforce_copybuf.resize(old_size+m_num_copy_ghosts[ch]);
 
         if (flags[comm_flag::net_torque])
             {
             old_size = m_nettorque_copybuf.size();
-            m_nettorque_copybuf.resize(old_size+m_num_copy_ghosts[dir]);
+            m_nettorque_copybuf.resize(old_size+m_num_copy_ghosts[ch]);
             }
 
         if (flags[comm_flag::net_virial])
             {
             old_size = m_netvirial_copybuf.size();
-            m_netvirial_copybuf.resize(old_size+6*m_num_copy_ghosts[dir]);
+            m_netvirial_copybuf.resize(old_size+6*m_num_copy_ghosts[ch]);
             }
 
             {
             ArrayHandle<Scalar4> h_netforce(m_pdata->getNetForce(), access_location::host, access_mode::read);
             ArrayHandle<Scalar4> h_netforce_copybuf(m_netforce_copybuf, access_location::host, access_mode::overwrite);
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[ch], access_location::host, access_mode::read);
             ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
             // copy net forces of ghost particles
-            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[ch]; ghost_idx++)
                 {
                 unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
 
@@ -2288,7 +2492,7 @@ void Communicator::updateNetForce(unsigned int timestep)
                 ArrayHandle<Scalar4> h_nettorque_copybuf(m_nettorque_copybuf, access_location::host, access_mode::overwrite);
 
                 // copy net torques of ghost particles
-                for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+                for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[ch]; ghost_idx++)
                     {
                     unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
 
@@ -2306,7 +2510,7 @@ void Communicator::updateNetForce(unsigned int timestep)
                 unsigned int pitch = m_pdata->getNetVirial().getPitch();
 
                 // copy net torques of ghost particles
-                for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+                for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[ch]; ghost_idx++)
                     {
                     unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
 
@@ -2324,14 +2528,11 @@ void Communicator::updateNetForce(unsigned int timestep)
 
             }
 
-        unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
+        unsigned int send_neighbor = m_ghost_send_rank[ch];
+        unsigned int recv_neighbor = m_ghost_recv_rank[ch];
 
-        // we receive from the direction opposite to the one we send to
-        unsigned int recv_neighbor;
-        if (dir % 2 == 0)
-            recv_neighbor = m_decomposition->getNeighborRank(dir+1);
-        else
-            recv_neighbor = m_decomposition->getNeighborRank(dir-1);
+        // several channels may connect the same pair of ranks
+        const int tag = 1 + 3*ch;
 
         unsigned int start_idx;
 
@@ -2340,7 +2541,7 @@ void Communicator::updateNetForce(unsigned int timestep)
 
         start_idx = m_pdata->getN() + num_tot_recv_ghosts;
 
-        num_tot_recv_ghosts += m_num_recv_ghosts[dir];
+        num_tot_recv_ghosts += m_num_recv_ghosts[ch];
 
         size_t sz = 0;
             {
@@ -2351,8 +2552,8 @@ void Communicator::updateNetForce(unsigned int timestep)
             ArrayHandle<Scalar4> h_netforce_copybuf(m_netforce_copybuf, access_location::host, access_mode::read);
 
             // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_netforce_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 1, m_mpi_comm, &reqs[0]);
-            MPI_Irecv(h_netforce.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 1, m_mpi_comm, &reqs[1]);
+            MPI_Isend(h_netforce_copybuf.data, m_num_copy_ghosts[ch]*sizeof(Scalar4), MPI_BYTE, send_neighbor, tag, m_mpi_comm, &reqs[0]);
+            MPI_Irecv(h_netforce.data + start_idx, m_num_recv_ghosts[ch]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, tag, m_mpi_comm, &reqs[1]);
             MPI_Waitall(2, reqs, status);
 
             sz += sizeof(Scalar4);
@@ -2366,8 +2567,8 @@ void Communicator::updateNetForce(unsigned int timestep)
             ArrayHandle<Scalar4> h_nettorque(m_pdata->getNetTorqueArray(), access_location::host, access_mode::readwrite);
             ArrayHandle<Scalar4> h_nettorque_copybuf(m_nettorque_copybuf, access_location::host, access_mode::read);
 
-            MPI_Isend(h_nettorque_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 2, m_mpi_comm, &reqs[0]);
-            MPI_Irecv(h_nettorque.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 2, m_mpi_comm, &reqs[1]);
+            MPI_Isend(h_nettorque_copybuf.data, m_num_copy_ghosts[ch]*sizeof(Scalar4), MPI_BYTE, send_neighbor, tag+1, m_mpi_comm, &reqs[0]);
+            MPI_Irecv(h_nettorque.data + start_idx, m_num_recv_ghosts[ch]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, tag+1, m_mpi_comm, &reqs[1]);
             MPI_Waitall(2, reqs, status);
 
             sz += sizeof(Scalar4);
@@ -2375,22 +2576,22 @@ void Communicator::updateNetForce(unsigned int timestep)
 
         if (flags[comm_flag::net_virial])
             {
-            m_netvirial_recvbuf.resize(6*m_num_recv_ghosts[dir]);
+            m_netvirial_recvbuf.resize(6*m_num_recv_ghosts[ch]);
             MPI_Request reqs[2];
             MPI_Status status[2];
 
             ArrayHandle<Scalar> h_netvirial_recvbuf(m_netvirial_recvbuf, access_location::host, access_mode::overwrite);
             ArrayHandle<Scalar> h_netvirial_copybuf(m_netvirial_copybuf, access_location::host, access_mode::read);
 
-            MPI_Isend(h_netvirial_copybuf.data, 6*m_num_copy_ghosts[dir]*sizeof(Scalar), MPI_BYTE, send_neighbor, 3, m_mpi_comm, &reqs[0]);
-            MPI_Irecv(h_netvirial_recvbuf.data, 6*m_num_recv_ghosts[dir]*sizeof(Scalar), MPI_BYTE, recv_neighbor, 3, m_mpi_comm, &reqs[1]);
+            MPI_Isend(h_netvirial_copybuf.data, 6*m_num_copy_ghosts[ch]*sizeof(Scalar), MPI_BYTE, send_neighbor, tag+2, m_mpi_comm, &reqs[0]);
+            MPI_Irecv(h_netvirial_recvbuf.data, 6*m_num_recv_ghosts[ch]*sizeof(Scalar), MPI_BYTE, recv_neighbor, tag+2, m_mpi_comm, &reqs[1]);
             MPI_Waitall(2, reqs, status);
 
             sz += 6*sizeof(Scalar);
             }
 
         if (m_prof)
-            m_prof->pop(0, (m_num_recv_ghosts[dir]+m_num_copy_ghosts[dir])*sz);
+            m_prof->pop(0, (m_num_recv_ghosts[ch]+m_num_copy_ghosts[ch])*sz);
 
         if (flags[comm_flag::net_virial])
             {
@@ -2400,7 +2601,7 @@ void Communicator::updateNetForce(unsigned int timestep)
             ArrayHandle<Scalar> h_netvirial_recvbuf(m_netvirial_recvbuf, access_location::host, access_mode::read);
             ArrayHandle<Scalar> h_netvirial(m_pdata->getNetVirial(), access_location::host, access_mode::read);
 
-            for (unsigned int i = 0; i < m_num_recv_ghosts[dir]; ++i)
+            for (unsigned int i = 0; i < m_num_recv_ghosts[ch]; ++i)
                 {
                 h_netvirial.data[0*pitch+start_idx+i] = h_netvirial_recvbuf.data[6*i+0];
                 h_netvirial.data[1*pitch+start_idx+i] = h_netvirial_recvbuf.data[6*i+1];
@@ -2410,13 +2611,76 @@ void Communicator::updateNetForce(unsigned int timestep)
                 h_netvirial.data[5*pitch+start_idx+i] = h_netvirial_recvbuf.data[6*i+5];
                 }
             }
-        } // end dir loop
+        } // end channel loop
 
         if (m_prof)
             m_prof->pop();
     }
 
 
+void Communicator::updateGhostField(GPUArray<Scalar>& field)
+    {
+    assert(field.getNumElements() >= m_pdata->getN() + m_pdata->getNGhosts());
+
+    if (m_prof)
+        m_prof->push("comm_ghost_field");
+
+    m_exec_conf->msg->notice(7) << "Communicator: update ghost field" << std::endl;
+
+    unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
+
+    for (unsigned int ch = 0; ch < getNumGhostChannels(); ch ++)
+        {
+        if (! isGhostChannelActive(ch) ) continue;
+
+        // the send buffer only lives for one channel
+        pooled_vector<Scalar> copybuf(m_num_copy_ghosts[ch], Scalar(0.0), m_exec_conf->getHostBufferPool());
+
+        ArrayHandle<Scalar> h_field(field, access_location::host, access_mode::readwrite);
+
+            {
+            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[ch], access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[ch]; ghost_idx++)
+                {
+                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+
+                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+
+                copybuf[ghost_idx] = h_field.data[idx];
+                }
+            }
+
+        unsigned int send_neighbor = m_ghost_send_rank[ch];
+        unsigned int recv_neighbor = m_ghost_recv_rank[ch];
+
+        // several channels may connect the same pair of ranks
+        const int tag = 1 + 3*ch;
+
+        unsigned int start_idx = m_pdata->getN() + num_tot_recv_ghosts;
+        num_tot_recv_ghosts += m_num_recv_ghosts[ch];
+
+        if (m_prof)
+            m_prof->push("MPI send/recv");
+
+        MPI_Request reqs[2];
+        MPI_Status status[2];
+
+        MPI_Isend(copybuf.empty() ? NULL : &copybuf.front(), m_num_copy_ghosts[ch]*sizeof(Scalar), MPI_BYTE,
+            send_neighbor, tag, m_mpi_comm, &reqs[0]);
+        MPI_Irecv(h_field.data + start_idx, m_num_recv_ghosts[ch]*sizeof(Scalar), MPI_BYTE,
+            recv_neighbor, tag, m_mpi_comm, &reqs[1]);
+        MPI_Waitall(2, reqs, status);
+
+        if (m_prof)
+            m_prof->pop(0, (m_num_recv_ghosts[ch]+m_num_copy_ghosts[ch])*sizeof(Scalar));
+        } // end channel loop
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
 void Communicator::removeGhostParticleTags()
     {
     // wipe out reverse-lookup tag -> idx for old ghost atoms
@@ -2519,6 +2783,11 @@ const BoxDim Communicator::getShiftedBox() const
 void export_Communicator(py::module& m)
     {
     py::class_<Communicator, std::shared_ptr<Communicator> >(m,"Communicator")
-    .def(py::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<DomainDecomposition> >());
+    .def(py::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<DomainDecomposition> >())
+    .def("setGhostUpdateOverlap", &Communicator::setGhostUpdateOverlap)
+    .def("getGhostUpdateOverlap", &Communicator::getGhostUpdateOverlap)
+    .def("setGhostExchangeAllNeighbors", &Communicator::setGhostExchangeAllNeighbors)
+    .def("getGhostExchangeAllNeighbors", &Communicator::getGhostExchangeAllNeighbors)
+    ;
     }
 #endif // ENABLE_MPI
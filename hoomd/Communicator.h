@@ -52,6 +52,7 @@
 //! Forward declarations for some classes
 class SystemDefinition;
 class Profiler;
+class StepTimer;
 struct BoxDim;
 class ParticleData;
 
@@ -122,6 +123,12 @@ struct rank_element
  * Stages \b one and \b two are performed before every neighbor list build, stage \b three is executed in all other steps (before the calculation
  * of forces).
  *
+ * Ghost updates are split into two phases. beginUpdateGhosts() posts the messages for all ghosts that are local particles
+ * on the sending rank, in all directions at once. finishUpdateGhosts() forwards the ghosts received from other ranks
+ * (the edge and corner ghosts) direction by direction and waits for completion. When setGhostUpdateOverlap() is
+ * enabled, the subscribers to getInteriorComputeCallbackSignal() are called between the two phases, so that forces
+ * on particles that do not interact with ghost particles are computed while the messages are in flight.
+ *
  * <b>Implementation details:</b>
  *
  * In every stage, particles are subsequently exchanged in six directions:
@@ -146,6 +153,12 @@ struct rank_element
  * In stage two and three, ghost atoms received from a neighboring processor are always included in the local
  * ghost atom lists, and they maybe replicated to more neighboring processors by the communication pattern
  * described above.
+ *
+ * Alternatively, with setGhostExchangeAllNeighbors(), ghosts are exchanged with all (up to 26) neighboring
+ * processors in a single stage. Every ghost is sent directly from the processor that owns it to all of its
+ * destinations, e.g. a particle near the north-east edge goes to the eastern, northern and north-eastern neighbors
+ * at once. This replaces six consecutive message rounds per ghost update by one, which pays off when latency
+ * dominates, i.e. for small domains. Particle migration always uses the six stages.
  * \ingroup communication
  */
 class Communicator
@@ -171,6 +184,9 @@ class Communicator
             m_prof = prof;
             }
 
+        //! Set the step timer
+        void setStepTimer(std::shared_ptr<StepTimer> timer);
+
         //! Subscribe to list of functions that determine when the particles are migrated
         /*! This method keeps track of all functions that may request particle migration.
          * \return A Nano::Signal object reference to be used for connect and disconnect calls.
@@ -237,6 +253,37 @@ class Communicator
             return m_compute_callbacks;
             }
 
+        //! Subscribe to list of call-backs for computation that does not use ghost particles
+        /*!
+         * When ghost update overlap is enabled, the call-backs are called after the ghost update has been started,
+         * but before it is finished. Subscribers may only access local particle data. If particles migrate in the
+         * same time step, the results of the call-backs are invalid and must be discarded.
+         *
+         * \return A Nano::Signal object reference to be used for connect and disconnect calls.
+         */
+        Nano::Signal<void (unsigned int timestep)>& getInteriorComputeCallbackSignal()
+            {
+            return m_interior_compute_callbacks;
+            }
+
+        //! Enable or disable overlapping ghost updates with computation
+        void setGhostUpdateOverlap(bool enable);
+
+        //! Test if ghost updates are overlapped with computation
+        bool getGhostUpdateOverlap() const
+            {
+            return m_ghost_update_overlap;
+            }
+
+        //! Enable or disable exchanging ghosts with all neighbors in a single stage
+        void setGhostExchangeAllNeighbors(bool enable);
+
+        //! Test if ghosts are exchanged with all neighbors in a single stage
+        bool getGhostExchangeAllNeighbors() const
+            {
+            return m_ghost_all_neighbors_requested;
+            }
+
         //! Get the ghost communication flags
         CommFlags getFlags() { return m_flags; }
 
@@ -309,17 +356,21 @@ class Communicator
          *
          * \param timestep The time step
          */
-        virtual void finishUpdateGhosts(unsigned int timestep)
-            {
-            // the base class implementation is currently empty
-            m_comm_pending = false;
-            }
+        virtual void finishUpdateGhosts(unsigned int timestep);
 
         /*! Communicate the net particle force
          * \parm timestep The time step
          */
         virtual void updateNetForce(unsigned int timestep);
 
+        /*! Communicate a per-particle scalar field to the ghost particles
+         * \param field Array with one value per local and ghost particle
+         *
+         * The values of the local particles are sent along the current ghost exchange plan and overwrite
+         * the values of the ghost particles. Uses the host ghost plan, i.e. the CPU communicator only.
+         */
+        void updateGhostField(GPUArray<Scalar>& field);
+
         /*! This methods finds all the particles that are no longer inside the domain
          * boundaries and transfers them to neighboring processors.
          *
@@ -452,6 +503,23 @@ class Communicator
             return res;
             }
 
+        //! Returns the number of channels ghosts are exchanged through
+        /*! In the default mode, channels are the six directions. When exchanging with all neighbors, there is one
+            channel per neighbor in m_neighbors.
+         */
+        unsigned int getNumGhostChannels() const
+            {
+            return m_ghost_all_neighbors ? m_nneigh : 6;
+            }
+
+        //! Returns true if ghosts are exchanged through a given channel
+        /*! \param ch Channel index
+         */
+        bool isGhostChannelActive(unsigned int ch) const
+            {
+            return m_ghost_all_neighbors || isCommunicating(ch);
+            }
+
         //! Helper function to update the shifted box for ghost particle PBC
         const BoxDim getShiftedBox() const;
 
@@ -461,6 +529,10 @@ class Communicator
         const MPI_Comm m_mpi_comm; //!< MPI communciator
         std::shared_ptr<DomainDecomposition> m_decomposition;       //!< Domain decomposition information
         std::shared_ptr<Profiler> m_prof;                           //!< Profiler
+        std::shared_ptr<StepTimer> m_step_timer;                    //!< Step timer
+        unsigned int m_migrate_timer;                               //!< Step timer slot of particle migration
+        unsigned int m_exchange_ghosts_timer;                       //!< Step timer slot of the ghost exchange
+        unsigned int m_update_ghosts_timer;                         //!< Step timer slot of ghost updates
 
         bool m_is_communicating;               //!< Whether we are currently communicating
         bool m_force_migrate;                  //!< True if particle migration is forced
@@ -489,9 +561,23 @@ class Communicator
         GPUVector<Scalar> m_netvirial_copybuf;   //!< Buffer for net virial
         GPUVector<Scalar> m_netvirial_recvbuf;   //!< Buffer for net virial (receive)
 
-        GPUVector<unsigned int> m_copy_ghosts[6]; //!< Per-direction list of indices of particles to send as ghosts
-        unsigned int m_num_copy_ghosts[6];       //!< Number of local particles that are sent to neighboring processors
-        unsigned int m_num_recv_ghosts[6];       //!< Number of ghosts received per direction
+        GPUVector<unsigned int> m_copy_ghosts[26]; //!< Per-channel list of indices of particles to send as ghosts
+        unsigned int m_num_copy_ghosts[26];      //!< Number of local particles that are sent to neighboring processors
+        unsigned int m_num_recv_ghosts[26];      //!< Number of ghosts received per channel
+        unsigned int m_num_copy_local[26];       //!< Number of local particles at the beginning of m_copy_ghosts
+        unsigned int m_num_recv_local[26];       //!< Number of ghosts received per channel that are local on the sender
+        unsigned int m_copy_offset[26];          //!< Offset of every channel in the ghost send buffers
+        std::vector<MPI_Request> m_ghost_reqs[26][2]; //!< Persistent ghost update requests per channel, for local and forwarded ghosts
+        bool m_ghost_reqs_valid;                 //!< False if the ghost update requests need to be recreated
+        CommFlags m_ghost_reqs_flags;            //!< Flags the ghost update requests were created for
+        std::vector<void *> m_ghost_reqs_bufs;   //!< Arrays the ghost update requests are bound to
+        std::vector<void *> m_ghost_bufs;        //!< Current base pointers of the arrays, compared to m_ghost_reqs_bufs
+
+        bool m_ghost_all_neighbors;              //!< True if ghosts are exchanged with all neighbors in a single stage
+        bool m_ghost_all_neighbors_requested;    //!< Exchange mode to switch to with the next ghost exchange
+        unsigned int m_ghost_send_rank[26];      //!< Rank every ghost channel sends to
+        unsigned int m_ghost_recv_rank[26];      //!< Rank every ghost channel receives from
+        unsigned int m_ghost_plan_mask[26];      //!< Plan bits a particle needs to be sent through a channel
 
         BoxDim m_global_box;                     //!< Global simulation box
         GPUArray<Scalar> m_r_ghost;              //!< Width of ghost layer
@@ -525,6 +611,27 @@ class Communicator
         Nano::Signal<void (const GPUArray<unsigned int>& )>
             m_comm_callbacks;   //!< List of functions that are called after the compute callbacks
 
+        Nano::Signal<void (unsigned int timestep)>
+            m_interior_compute_callbacks;   //!< List of functions that are called during the ghost update
+
+        bool m_ghost_update_overlap;             //!< True if computation is overlapped with ghost updates
+        bool m_has_local_bodies;                 //!< True if any local particle belongs to a rigid body
+
+        //! Update the ghost particles, overlapping with the interior computation if enabled
+        void updateGhosts(unsigned int timestep);
+
+        //! Pack the ghost update send buffer of one channel and start its requests
+        void startGhostUpdate(unsigned int ch, bool forwarded);
+
+        //! Create the persistent ghost update requests for the current copy lists
+        void initGhostUpdateRequests();
+
+        //! Free the persistent ghost update requests
+        void freeGhostUpdateRequests();
+
+        //! Get the arrays the ghost update requests are bound to
+        void getGhostUpdateBuffers(std::vector<void *>& bufs);
+
         CommFlags m_flags;                       //!< The ghost communication flags
         CommFlags m_last_flags;                       //!< Flags of last ghost exchange
 
@@ -595,6 +702,7 @@ class Communicator
     private:
         std::vector<pdata_element> m_sendbuf;  //!< Buffer for particles that are sent
         std::vector<pdata_element> m_recvbuf;  //!< Buffer for particles that are received
+        std::vector<unsigned int> m_comm_flag_out; //!< Communication flags of the particles that are sent (not used)
 
         /* Communication of bonded groups */
         GroupCommunicator<BondData> m_bond_comm;    //!< Communication helper for bonds
@@ -635,6 +743,9 @@ class Communicator
         //! Helper function to initialize adjacency arrays
         void initializeNeighborArrays();
 
+        //! Helper function to initialize the ranks and plan masks of the ghost channels
+        void initializeGhostChannels();
+
         //! Method that is called when ghost particles are requested to be removed
         void slotGhostParticlesRemoved()
             {
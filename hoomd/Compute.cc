@@ -7,6 +7,7 @@
 
 
 #include "Compute.h"
+#include "StepTimer.h"
 
 namespace py = pybind11;
 
@@ -23,7 +24,8 @@ using namespace std;
     \post The Compute is constructed with the given particle data and a NULL profiler.
 */
 Compute::Compute(std::shared_ptr<SystemDefinition> sysdef) : m_sysdef(sysdef), m_pdata(m_sysdef->getParticleData()),
-        exec_conf(m_pdata->getExecConf()), m_force_compute(false), m_last_computed(0), m_first_compute(true)
+        m_timer_slot(0), exec_conf(m_pdata->getExecConf()), m_force_compute(false), m_last_computed(0),
+        m_first_compute(true)
     {
     // sanity check
     assert(m_sysdef);
@@ -55,6 +57,21 @@ void Compute::setProfiler(std::shared_ptr<Profiler> prof)
     m_prof = prof;
     }
 
+/*! \param timer Step timer to record the time of this compute in. Set to NULL to stop timing.
+    \param name Name of the timer
+
+    Like the profiler, the step timer is only used by derived classes that time themselves. They bracket the work
+    done in compute() with start() and stop() calls on m_timer_slot.
+
+    \note Derived classes MUST check if m_step_timer is set before calling any timer methods.
+*/
+void Compute::setStepTimer(std::shared_ptr<StepTimer> timer, const std::string& name)
+    {
+    m_step_timer = timer;
+    if (m_step_timer)
+        m_timer_slot = m_step_timer->registerTimer(name);
+    }
+
 /*! \param timestep Current time step
     \returns true if computations should be performed, false if they have already been done
         at this \a timestep.
@@ -14,6 +14,9 @@
 #ifndef __COMPUTE_H__
 #define __COMPUTE_H__
 
+// forward declaration
+class StepTimer;
+
 /*! \file Compute.h
     \brief Declares a base class for all computes
 */
@@ -90,6 +93,9 @@ class Compute
         //! Sets the profiler for the compute to use
         void setProfiler(std::shared_ptr<Profiler> prof);
 
+        //! Sets the step timer and timer name for the compute to use
+        void setStepTimer(std::shared_ptr<StepTimer> timer, const std::string& name);
+
         //! Set autotuner parameters
         /*! \param enable Enable/disable autotuning
             \param period period (approximate) in time steps when returning occurs
@@ -176,6 +182,8 @@ class Compute
         const std::shared_ptr<SystemDefinition> m_sysdef; //!< The system definition this compute is associated with
         const std::shared_ptr<ParticleData> m_pdata;      //!< The particle data this compute is associated with
         std::shared_ptr<Profiler> m_prof;                 //!< The profiler this compute is to use
+        std::shared_ptr<StepTimer> m_step_timer;          //!< The step timer this compute is to record its time in
+        unsigned int m_timer_slot;                        //!< Slot of this compute in m_step_timer
         std::shared_ptr<const ExecutionConfiguration> exec_conf; //!< Stored shared ptr to the execution configuration
 #ifdef ENABLE_MPI
         std::shared_ptr<Communicator> m_comm;             //!< The communicator this compute is to use
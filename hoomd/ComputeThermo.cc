@@ -10,15 +10,22 @@
 
 #include "ComputeThermo.h"
 #include "VectorMath.h"
+#include "HostBufferPool.h"
+#include "StepTimer.h"
 
 #ifdef ENABLE_MPI
 #include "Communicator.h"
 #include "HOOMDMPI.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 namespace py = pybind11;
 
 #include <iostream>
+#include <algorithm>
 using namespace std;
 
 /*! \param sysdef System for which to compute thermodynamic properties
@@ -57,12 +64,21 @@ ComputeThermo::ComputeThermo(std::shared_ptr<SystemDefinition> sysdef,
 
     #ifdef ENABLE_MPI
     m_properties_reduced = true;
+    m_reduction_pending = false;
     #endif
     }
 
 ComputeThermo::~ComputeThermo()
     {
     m_exec_conf->msg->notice(5) << "Destroying ComputeThermo" << endl;
+
+    #ifdef ENABLE_MPI
+    // complete an outstanding reduction, unless MPI has already been shut down
+    int finalized;
+    MPI_Finalized(&finalized);
+    if (m_reduction_pending && !finalized)
+        MPI_Wait(&m_reduction_req, MPI_STATUS_IGNORE);
+    #endif
     }
 
 /*! \param ndof Number of degrees of freedom to set
@@ -87,7 +103,9 @@ void ComputeThermo::compute(unsigned int timestep)
     if (!shouldCompute(timestep))
         return;
 
+    if (m_step_timer) m_step_timer->start(m_timer_slot);
     computeProperties();
+    if (m_step_timer) m_step_timer->stop(m_timer_slot);
     }
 
 std::vector< std::string > ComputeThermo::getProvidedLogQuantities()
@@ -184,7 +202,56 @@ Scalar ComputeThermo::getLogValue(const std::string& quantity, unsigned int time
         }
     }
 
+namespace
+{
+
+//! Number of group members summed by one task in ComputeThermo::computeProperties()
+/*! The partial sums of the blocks are added up in order, so the result does not depend on the number of threads.
+*/
+const unsigned int thermo_block_size = 1024;
+
+//! Partial sums of the extensive properties accumulated by ComputeThermo
+struct thermo_sums
+    {
+    //! Default constructor, zeroes all sums
+    thermo_sums()
+        : ke_xx(0.0), ke_xy(0.0), ke_xz(0.0), ke_yy(0.0), ke_yz(0.0), ke_zz(0.0), ke_rot(0.0), pe(0.0),
+          virial_xx(0.0), virial_xy(0.0), virial_xz(0.0), virial_yy(0.0), virial_yz(0.0), virial_zz(0.0)
+        { }
+
+    //! Add another set of partial sums
+    thermo_sums& operator+=(const thermo_sums& other)
+        {
+        ke_xx += other.ke_xx;
+        ke_xy += other.ke_xy;
+        ke_xz += other.ke_xz;
+        ke_yy += other.ke_yy;
+        ke_yz += other.ke_yz;
+        ke_zz += other.ke_zz;
+        ke_rot += other.ke_rot;
+        pe += other.pe;
+        virial_xx += other.virial_xx;
+        virial_xy += other.virial_xy;
+        virial_xz += other.virial_xz;
+        virial_yy += other.virial_yy;
+        virial_yz += other.virial_yz;
+        virial_zz += other.virial_zz;
+        return *this;
+        }
+
+    double ke_xx, ke_xy, ke_xz, ke_yy, ke_yz, ke_zz;   //!< Kinetic part of the pressure tensor (m v_i v_j)
+    double ke_rot;                                      //!< Twice the rotational kinetic energy
+    double pe;                                          //!< Potential energy
+    double virial_xx, virial_xy, virial_xz, virial_yy, virial_yz, virial_zz; //!< Virial tensor
+    };
+
+} // end anonymous namespace
+
 /*! Computes all thermodynamic properties of the system in one fell swoop.
+
+    Only the properties requested by the particle data flags are summed, in a single pass over the group members.
+    The group is split into blocks of thermo_block_size members that are summed in parallel when more than one
+    thread is configured.
 */
 void ComputeThermo::computeProperties()
     {
@@ -199,7 +266,14 @@ void ComputeThermo::computeProperties()
     assert(m_pdata);
     assert(m_ndof != 0);
 
+    PDataFlags flags = m_pdata->getFlags();
+    bool compute_pressure_tensor = flags[pdata_flag::pressure_tensor];
+    bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
+    bool compute_ke_rot = flags[pdata_flag::rotational_kinetic_energy];
+    bool compute_pe = flags[pdata_flag::potential_energy];
+
     // access the particle data
+    ArrayHandle<unsigned int> h_index(m_group->getIndexArray(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
 
     // access the net force, pe, and virial
@@ -207,98 +281,138 @@ void ComputeThermo::computeProperties()
     const GPUArray< Scalar >& net_virial = m_pdata->getNetVirial();
     ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::read);
+    unsigned int virial_pitch = net_virial.getPitch();
 
-    // total kinetic energy
-    double ke_trans_total = 0.0;
-
-    PDataFlags flags = m_pdata->getFlags();
-
-    double pressure_kinetic_xx = 0.0;
-    double pressure_kinetic_xy = 0.0;
-    double pressure_kinetic_xz = 0.0;
-    double pressure_kinetic_yy = 0.0;
-    double pressure_kinetic_yz = 0.0;
-    double pressure_kinetic_zz = 0.0;
-
-    if (flags[pdata_flag::pressure_tensor])
+    // the rotational degrees of freedom are only accessed when needed
+    std::unique_ptr< ArrayHandle<Scalar4> > h_orientation;
+    std::unique_ptr< ArrayHandle<Scalar4> > h_angmom;
+    std::unique_ptr< ArrayHandle<Scalar3> > h_inertia;
+    if (compute_ke_rot)
         {
-        // Calculate kinetic part of pressure tensor
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            double mass = h_vel.data[j].w;
-            pressure_kinetic_xx += mass*(  (double)h_vel.data[j].x * (double)h_vel.data[j].x );
-            pressure_kinetic_xy += mass*(  (double)h_vel.data[j].x * (double)h_vel.data[j].y );
-            pressure_kinetic_xz += mass*(  (double)h_vel.data[j].x * (double)h_vel.data[j].z );
-            pressure_kinetic_yy += mass*(  (double)h_vel.data[j].y * (double)h_vel.data[j].y );
-            pressure_kinetic_yz += mass*(  (double)h_vel.data[j].y * (double)h_vel.data[j].z );
-            pressure_kinetic_zz += mass*(  (double)h_vel.data[j].z * (double)h_vel.data[j].z );
-            }
-        // kinetic energy = 1/2 trace of kinetic part of pressure tensor
-        ke_trans_total = Scalar(0.5)*(pressure_kinetic_xx + pressure_kinetic_yy + pressure_kinetic_zz);
-        }
-    else
-        {
-        // total kinetic energy
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            ke_trans_total += (double)h_vel.data[j].w*( (double)h_vel.data[j].x * (double)h_vel.data[j].x
-                                                + (double)h_vel.data[j].y * (double)h_vel.data[j].y
-                                                + (double)h_vel.data[j].z * (double)h_vel.data[j].z);
-
-            }
-
-        ke_trans_total *= Scalar(0.5);
+        h_orientation.reset(new ArrayHandle<Scalar4>(m_pdata->getOrientationArray(), access_location::host,
+            access_mode::read));
+        h_angmom.reset(new ArrayHandle<Scalar4>(m_pdata->getAngularMomentumArray(), access_location::host,
+            access_mode::read));
+        h_inertia.reset(new ArrayHandle<Scalar3>(m_pdata->getMomentsOfInertiaArray(), access_location::host,
+            access_mode::read));
         }
 
-    // total rotational kinetic energy
-    double ke_rot_total = 0.0;
+    // sum up one block of group members
+    unsigned int n_blocks = (group_size + thermo_block_size - 1)/thermo_block_size;
+    pooled_vector<thermo_sums> block_sums(n_blocks, thermo_sums(), m_exec_conf->getHostBufferPool());
 
-    if (flags[pdata_flag::rotational_kinetic_energy])
+    auto sum_block = [&](unsigned int block)
         {
-        // Calculate rotational part of kinetic energy
-        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
-        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::read);
-        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::read);
-
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        thermo_sums s;
+        unsigned int end = std::min(group_size, (block+1)*thermo_block_size);
+        for (unsigned int group_idx = block*thermo_block_size; group_idx < end; group_idx++)
             {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            Scalar3 I = h_inertia.data[j];
-            quat<Scalar> q(h_orientation.data[j]);
-            quat<Scalar> p(h_angmom.data[j]);
-            quat<Scalar> s(Scalar(0.5)*conj(q)*p);
-
-            // only if the moment of inertia along one principal axis is non-zero, that axis carries angular momentum
-            if (I.x >= EPSILON)
+            unsigned int j = h_index.data[group_idx];
+
+            // kinetic part of the pressure tensor, its trace is twice the kinetic energy
+            double mass = h_vel.data[j].w;
+            double vx = h_vel.data[j].x;
+            double vy = h_vel.data[j].y;
+            double vz = h_vel.data[j].z;
+            s.ke_xx += mass*vx*vx;
+            s.ke_yy += mass*vy*vy;
+            s.ke_zz += mass*vz*vz;
+            if (compute_pressure_tensor)
                 {
-                ke_rot_total += s.v.x*s.v.x/I.x;
+                s.ke_xy += mass*vx*vy;
+                s.ke_xz += mass*vx*vz;
+                s.ke_yz += mass*vy*vz;
                 }
-            if (I.y >= EPSILON)
+
+            if (compute_ke_rot)
                 {
-                ke_rot_total += s.v.y*s.v.y/I.y;
+                Scalar3 I = h_inertia->data[j];
+                quat<Scalar> q(h_orientation->data[j]);
+                quat<Scalar> p(h_angmom->data[j]);
+                quat<Scalar> t(Scalar(0.5)*conj(q)*p);
+
+                // only if the moment of inertia along one principal axis is non-zero, that axis carries angular momentum
+                if (I.x >= EPSILON)
+                    {
+                    s.ke_rot += t.v.x*t.v.x/I.x;
+                    }
+                if (I.y >= EPSILON)
+                    {
+                    s.ke_rot += t.v.y*t.v.y/I.y;
+                    }
+                if (I.z >= EPSILON)
+                    {
+                    s.ke_rot += t.v.z*t.v.z/I.z;
+                    }
                 }
-            if (I.z >= EPSILON)
+
+            if (compute_pe)
+                s.pe += (double)h_net_force.data[j].w;
+
+            if (compute_virial)
                 {
-                ke_rot_total += s.v.z*s.v.z/I.z;
+                s.virial_xx += (double)h_net_virial.data[j+0*virial_pitch];
+                s.virial_yy += (double)h_net_virial.data[j+3*virial_pitch];
+                s.virial_zz += (double)h_net_virial.data[j+5*virial_pitch];
+                if (compute_pressure_tensor)
+                    {
+                    s.virial_xy += (double)h_net_virial.data[j+1*virial_pitch];
+                    s.virial_xz += (double)h_net_virial.data[j+2*virial_pitch];
+                    s.virial_yz += (double)h_net_virial.data[j+4*virial_pitch];
+                    }
                 }
             }
+        block_sums[block] = s;
+        };
 
-        ke_rot_total /= Scalar(2.0);
+    if (m_exec_conf->getNumThreads() == 1)
+        {
+        for (unsigned int block = 0; block < n_blocks; ++block)
+            sum_block(block);
         }
+    #ifdef ENABLE_TBB
+    else
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_blocks),
+            [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                for (unsigned int block = r.begin(); block != r.end(); ++block)
+                    sum_block(block);
+                });
+        }
+    #endif
+
+    thermo_sums total;
+    for (unsigned int block = 0; block < n_blocks; ++block)
+        total += block_sums[block];
+
+    // kinetic energy = 1/2 trace of kinetic part of pressure tensor
+    double ke_trans_total = 0.5*(total.ke_xx + total.ke_yy + total.ke_zz);
+
+    double pressure_kinetic_xx = 0.0;
+    double pressure_kinetic_xy = 0.0;
+    double pressure_kinetic_xz = 0.0;
+    double pressure_kinetic_yy = 0.0;
+    double pressure_kinetic_yz = 0.0;
+    double pressure_kinetic_zz = 0.0;
+    if (compute_pressure_tensor)
+        {
+        pressure_kinetic_xx = total.ke_xx;
+        pressure_kinetic_xy = total.ke_xy;
+        pressure_kinetic_xz = total.ke_xz;
+        pressure_kinetic_yy = total.ke_yy;
+        pressure_kinetic_yz = total.ke_yz;
+        pressure_kinetic_zz = total.ke_zz;
+        }
+
+    // total rotational kinetic energy
+    double ke_rot_total = total.ke_rot/2.0;
 
     // total potential energy
     double pe_total = 0.0;
-    if (flags[pdata_flag::potential_energy])
+    if (compute_pe)
         {
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            pe_total += (double)h_net_force.data[j].w;
-            }
-
-        pe_total += m_pdata->getExternalEnergy();
+        pe_total = total.pe + m_pdata->getExternalEnergy();
         }
 
     double W = 0.0;
@@ -309,20 +423,14 @@ void ComputeThermo::computeProperties()
     double virial_yz = m_pdata->getExternalVirial(4);
     double virial_zz = m_pdata->getExternalVirial(5);
 
-    if (flags[pdata_flag::pressure_tensor])
+    if (compute_pressure_tensor)
         {
-        // Calculate upper triangular virial tensor
-        unsigned int virial_pitch = net_virial.getPitch();
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            virial_xx += (double)h_net_virial.data[j+0*virial_pitch];
-            virial_xy += (double)h_net_virial.data[j+1*virial_pitch];
-            virial_xz += (double)h_net_virial.data[j+2*virial_pitch];
-            virial_yy += (double)h_net_virial.data[j+3*virial_pitch];
-            virial_yz += (double)h_net_virial.data[j+4*virial_pitch];
-            virial_zz += (double)h_net_virial.data[j+5*virial_pitch];
-            }
+        virial_xx += total.virial_xx;
+        virial_xy += total.virial_xy;
+        virial_xz += total.virial_xz;
+        virial_yy += total.virial_yy;
+        virial_yz += total.virial_yz;
+        virial_zz += total.virial_zz;
 
         if (flags[pdata_flag::isotropic_virial])
             {
@@ -330,17 +438,10 @@ void ComputeThermo::computeProperties()
             W = Scalar(1./3.) * (virial_xx + virial_yy + virial_zz);
             }
         }
-     else if (flags[pdata_flag::isotropic_virial])
+    else if (flags[pdata_flag::isotropic_virial])
         {
         // only sum up isotropic part of virial tensor
-        unsigned int virial_pitch = net_virial.getPitch();
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            W += Scalar(1./3.)* ((double)h_net_virial.data[j+0*virial_pitch] +
-                                 (double)h_net_virial.data[j+3*virial_pitch] +
-                                 (double)h_net_virial.data[j+5*virial_pitch] );
-            }
+        W = Scalar(1./3.) * (total.virial_xx + total.virial_yy + total.virial_zz);
         }
 
     // compute the pressure
@@ -374,35 +475,62 @@ void ComputeThermo::computeProperties()
     Scalar pressure_zz = (pressure_kinetic_zz + virial_zz) / volume;
 
     // fill out the GPUArray
-    ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::overwrite);
-    h_properties.data[thermo_index::translational_kinetic_energy] = Scalar(ke_trans_total);
-    h_properties.data[thermo_index::rotational_kinetic_energy] = Scalar(ke_rot_total);
-    h_properties.data[thermo_index::potential_energy] = Scalar(pe_total);
-    h_properties.data[thermo_index::pressure] = pressure;
-    h_properties.data[thermo_index::pressure_xx] = pressure_xx;
-    h_properties.data[thermo_index::pressure_xy] = pressure_xy;
-    h_properties.data[thermo_index::pressure_xz] = pressure_xz;
-    h_properties.data[thermo_index::pressure_yy] = pressure_yy;
-    h_properties.data[thermo_index::pressure_yz] = pressure_yz;
-    h_properties.data[thermo_index::pressure_zz] = pressure_zz;
+        {
+        ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::overwrite);
+        h_properties.data[thermo_index::translational_kinetic_energy] = Scalar(ke_trans_total);
+        h_properties.data[thermo_index::rotational_kinetic_energy] = Scalar(ke_rot_total);
+        h_properties.data[thermo_index::potential_energy] = Scalar(pe_total);
+        h_properties.data[thermo_index::pressure] = pressure;
+        h_properties.data[thermo_index::pressure_xx] = pressure_xx;
+        h_properties.data[thermo_index::pressure_xy] = pressure_xy;
+        h_properties.data[thermo_index::pressure_xz] = pressure_xz;
+        h_properties.data[thermo_index::pressure_yy] = pressure_yy;
+        h_properties.data[thermo_index::pressure_yz] = pressure_yz;
+        h_properties.data[thermo_index::pressure_zz] = pressure_zz;
+        }
 
     #ifdef ENABLE_MPI
-    // in MPI, reduce extensive quantities only when they're needed
+    // in MPI, the extensive quantities are reduced in the background and the result is only waited for when needed
     m_properties_reduced = !m_pdata->getDomainDecomposition();
+    if (!m_properties_reduced)
+        beginReduceProperties();
     #endif // ENABLE_MPI
 
     if (m_prof) m_prof->pop();
     }
 
 #ifdef ENABLE_MPI
+/*! Posts an MPI_Iallreduce of the local properties. reduceProperties() waits for it to complete.
+*/
+void ComputeThermo::beginReduceProperties()
+    {
+    // complete a previous reduction that was never waited for
+    if (m_reduction_pending)
+        MPI_Wait(&m_reduction_req, MPI_STATUS_IGNORE);
+
+        {
+        ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::read);
+        std::copy(h_properties.data, h_properties.data + thermo_index::num_quantities, m_local_properties);
+        }
+
+    MPI_Iallreduce(m_local_properties, m_reduced_properties, thermo_index::num_quantities, MPI_HOOMD_SCALAR,
+            MPI_SUM, m_exec_conf->getMPICommunicator(), &m_reduction_req);
+    m_reduction_pending = true;
+    }
+
 void ComputeThermo::reduceProperties()
     {
     if (m_properties_reduced) return;
 
-    // reduce properties
-    ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::readwrite);
-    MPI_Allreduce(MPI_IN_PLACE, h_properties.data, thermo_index::num_quantities, MPI_HOOMD_SCALAR,
-            MPI_SUM, m_exec_conf->getMPICommunicator());
+    if (!m_reduction_pending)
+        beginReduceProperties();
+
+    // wait for the reduction to finish
+    MPI_Wait(&m_reduction_req, MPI_STATUS_IGNORE);
+    m_reduction_pending = false;
+
+    ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::overwrite);
+    std::copy(m_reduced_properties, m_reduced_properties + thermo_index::num_quantities, h_properties.data);
 
     m_properties_reduced = true;
     }
@@ -65,7 +65,12 @@ class ComputeThermo : public Compute
         //! Destructor
         virtual ~ComputeThermo();
 
-        //! Compute the temperature
+        //! Compute the thermodynamic properties
+        /*! All properties requested by the particle data flags are computed in a single pass over the group, and
+            the result is cached until the time step changes. With domain decomposition, the reduction over the
+            ranks is started here but only completed when a value is first read, so the communication overlaps with
+            whatever the caller does in between.
+        */
         virtual void compute(unsigned int timestep);
 
         //! Change the number of degrees of freedom
@@ -315,6 +320,13 @@ class ComputeThermo : public Compute
 
         #ifdef ENABLE_MPI
         bool m_properties_reduced;      //!< True if properties have been reduced across MPI
+        bool m_reduction_pending;       //!< True if a non-blocking reduction has been posted
+        MPI_Request m_reduction_req;    //!< Request for the non-blocking reduction
+        Scalar m_local_properties[thermo_index::num_quantities];   //!< Send buffer for the reduction
+        Scalar m_reduced_properties[thermo_index::num_quantities]; //!< Receive buffer for the reduction
+
+        //! Start a non-blocking reduction of the properties over MPI
+        void beginReduceProperties();
 
         //! Reduce properties over MPI
         virtual void reduceProperties();
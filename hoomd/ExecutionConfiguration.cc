@@ -14,6 +14,14 @@
 #ifdef ENABLE_MPI
 #include "HOOMDMPI.h"
 #endif
+
+#ifdef ENABLE_TBB
+#include <tbb/task_arena.h>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#endif
+
+#include <hoomd/extern/pybind/include/pybind11/stl.h>
 namespace py = pybind11;
 
 #include <stdexcept>
@@ -21,6 +29,12 @@ namespace py = pybind11;
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <string.h>
+#include <stdlib.h>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 
 using namespace std;
 
@@ -48,7 +62,8 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
                                                bool ignore_display,
                                                std::shared_ptr<Messenger> _msg,
                                                unsigned int n_ranks)
-    : m_cuda_error_checking(false), msg(_msg)
+    : m_cuda_error_checking(false), msg(_msg), m_num_threads(1), m_host_alloc_policy(host_alloc_default),
+      m_first_touch(false), m_huge_page_warned(false)
     {
     if (!msg)
         msg = std::shared_ptr<Messenger>(new Messenger());
@@ -103,6 +118,23 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
     initializeMPI();
     #endif
 
+    #ifdef ENABLE_TBB
+    // default to the hardware threads available to this process, shared evenly by the ranks on this node
+    unsigned int num_threads = tbb::this_task_arena::max_concurrency();
+
+    #ifdef ENABLE_MPI
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+    int n_node_ranks;
+    MPI_Comm_size(node_comm, &n_node_ranks);
+    MPI_Comm_free(&node_comm);
+
+    num_threads = std::max(num_threads / (unsigned int)n_node_ranks, 1u);
+    #endif
+
+    setNumThreads(num_threads);
+    #endif
+
     setupStats();
 
     #ifdef ENABLE_CUDA
@@ -167,6 +199,11 @@ ExecutionConfiguration::~ExecutionConfiguration()
     {
     msg->notice(5) << "Destroying ExecutionConfiguration" << endl;
 
+    if (m_host_buffer_pool.getNumAllocations())
+        msg->notice(4) << "Host buffer pool: " << m_host_buffer_pool.getNumAllocations() << " allocations, "
+                       << float(m_host_buffer_pool.getMaxBytesInUse())/1024.0f/1024.0f << " MB peak use, "
+                       << float(m_host_buffer_pool.getMaxBytesAllocated())/1024.0f/1024.0f << " MB peak size" << endl;
+
     #if defined(ENABLE_CUDA)
     if (exec_mode == GPU)
         {
@@ -224,6 +261,178 @@ void ExecutionConfiguration::initializeMPI()
     }
 #endif
 
+/*! \param num_threads Number of CPU threads to use in threaded compute kernels
+
+    Threaded kernels partition their work into getNumThreads() pieces where the result depends on the partitioning,
+    so results are reproducible for a fixed number of threads. Without TBB support, the only valid value is 1.
+*/
+void ExecutionConfiguration::setNumThreads(unsigned int num_threads)
+    {
+    if (num_threads == 0)
+        {
+        msg->error() << "The number of threads must be positive" << endl;
+        throw runtime_error("Error setting number of threads");
+        }
+
+    #ifdef ENABLE_TBB
+    m_tbb_control.reset(new tbb::global_control(tbb::global_control::max_allowed_parallelism, num_threads));
+    #else
+    if (num_threads > 1)
+        {
+        msg->warning() << "This build of hoomd was compiled without TBB support, ignoring request for "
+                       << num_threads << " threads" << endl;
+        num_threads = 1;
+        }
+    #endif
+
+    m_num_threads = num_threads;
+    if (exec_mode == CPU)
+        n_cpu = m_num_threads;
+
+    msg->notice(3) << "Using " << m_num_threads << " CPU thread(s)" << endl;
+    }
+
+//! Size of a huge page
+static const size_t huge_page_size = 2*1024*1024;
+
+/*! \param bytes Number of bytes to allocate
+    \param name Name of the array the memory is for, used for accounting
+    \returns Pointer to the allocated memory, aligned to at least 64 bytes
+
+    Allocations of at least one huge page follow the policy set with setHostAllocPolicy(). With host_alloc_huge_pages,
+    the memory is 2MB aligned and marked for transparent huge pages. With host_alloc_huge_pages_explicit, the memory
+    is mapped from the huge page pool reserved by the administrator (vm.nr_hugepages), and falls back to transparent
+    huge pages when the pool is exhausted. Smaller allocations are always 64 byte aligned.
+*/
+void *ExecutionConfiguration::allocateHost(size_t bytes, const std::string& name) const
+    {
+    void *ptr = NULL;
+    size_t map_bytes = 0;
+    bool huge = m_host_alloc_policy != host_alloc_default && bytes >= huge_page_size;
+
+    #ifdef __linux__
+    if (huge && m_host_alloc_policy == host_alloc_huge_pages_explicit)
+        {
+        map_bytes = (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+        ptr = mmap(NULL, map_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (ptr == MAP_FAILED)
+            {
+            ptr = NULL;
+            map_bytes = 0;
+
+            std::lock_guard<std::mutex> lock(m_host_alloc_mutex);
+            if (!m_huge_page_warned)
+                {
+                msg->warning() << "Unable to map explicit huge pages, falling back to transparent huge pages" << endl;
+                m_huge_page_warned = true;
+                }
+            }
+        }
+    #endif
+
+    if (!ptr)
+        {
+        int retval = posix_memalign(&ptr, huge ? huge_page_size : 64, bytes);
+        if (retval != 0)
+            {
+            msg->error() << "Error allocating aligned memory" << endl;
+            throw runtime_error("Error allocating GPUArray.");
+            }
+
+        #ifdef MADV_HUGEPAGE
+        if (huge)
+            madvise(ptr, bytes, MADV_HUGEPAGE);
+        #endif
+        }
+
+    std::lock_guard<std::mutex> lock(m_host_alloc_mutex);
+    m_host_bytes[name] += bytes;
+    if (map_bytes)
+        m_huge_page_maps[ptr] = map_bytes;
+    return ptr;
+    }
+
+/*! \param ptr Pointer returned by allocateHost()
+    \param bytes Number of bytes passed to allocateHost()
+    \param name Name of the array the memory was accounted to
+*/
+void ExecutionConfiguration::freeHost(void *ptr, size_t bytes, const std::string& name) const
+    {
+    size_t map_bytes = 0;
+        {
+        std::lock_guard<std::mutex> lock(m_host_alloc_mutex);
+        std::map<std::string, uint64_t>::iterator it = m_host_bytes.find(name);
+        if (it != m_host_bytes.end())
+            {
+            it->second -= std::min<uint64_t>(it->second, bytes);
+            if (it->second == 0)
+                m_host_bytes.erase(it);
+            }
+
+        std::map<void *, size_t>::iterator map_it = m_huge_page_maps.find(ptr);
+        if (map_it != m_huge_page_maps.end())
+            {
+            map_bytes = map_it->second;
+            m_huge_page_maps.erase(map_it);
+            }
+        }
+
+    #ifdef __linux__
+    if (map_bytes)
+        {
+        munmap(ptr, map_bytes);
+        return;
+        }
+    #endif
+
+    free(ptr);
+    }
+
+/*! \param ptr Pointer to the memory to clear
+    \param bytes Number of bytes to clear
+
+    With first touch enabled, the pages are cleared in contiguous blocks by the threads of the thread pool. The
+    operating system places each page on the NUMA node of the thread that touches it first, so threaded kernels that
+    split arrays into contiguous ranges mostly access memory local to their socket.
+*/
+void ExecutionConfiguration::clearHost(void *ptr, size_t bytes) const
+    {
+    #ifdef ENABLE_TBB
+    const size_t page_size = 4096;
+    if (m_first_touch && m_num_threads > 1 && bytes >= m_num_threads*page_size)
+        {
+        char *data = (char *)ptr;
+        size_t n_pages = (bytes + page_size - 1) / page_size;
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, n_pages), [=](const tbb::blocked_range<size_t>& r)
+            {
+            size_t begin = r.begin()*page_size;
+            size_t end = std::min(r.end()*page_size, bytes);
+            memset(data + begin, 0, end - begin);
+            }, tbb::static_partitioner());
+        return;
+        }
+    #endif
+
+    memset(ptr, 0, bytes);
+    }
+
+/*! \param bytes Number of bytes to move
+    \param old_name Name of the array the memory is currently accounted to
+    \param new_name Name of the array to account the memory to
+*/
+void ExecutionConfiguration::renameHost(size_t bytes, const std::string& old_name, const std::string& new_name) const
+    {
+    std::lock_guard<std::mutex> lock(m_host_alloc_mutex);
+    std::map<std::string, uint64_t>::iterator it = m_host_bytes.find(old_name);
+    if (it != m_host_bytes.end())
+        {
+        it->second -= std::min<uint64_t>(it->second, bytes);
+        if (it->second == 0)
+            m_host_bytes.erase(it);
+        }
+    m_host_bytes[new_name] += bytes;
+    }
+
 std::string ExecutionConfiguration::getGPUName() const
     {
     #ifdef ENABLE_CUDA
@@ -668,9 +877,15 @@ void ExecutionConfiguration::setupStats()
 
     if (exec_mode == CPU)
         {
+        n_cpu = m_num_threads;
+
         ostringstream s;
 
-        s << "HOOMD-blue is running on the CPU" << endl;
+        s << "HOOMD-blue is running on the CPU";
+        #ifdef ENABLE_TBB
+        s << " with " << m_num_threads << " thread(s)";
+        #endif
+        s << endl;
         msg->collectiveNoticeStr(1,s.str());
         }
     }
@@ -687,11 +902,26 @@ unsigned int ExecutionConfiguration::getNRanks() const
 
 void export_ExecutionConfiguration(py::module& m)
     {
+    py::class_<HostBufferPool>(m,"HostBufferPool")
+        .def("getMaxBytesInUse", &HostBufferPool::getMaxBytesInUse)
+        .def("getMaxBytesAllocated", &HostBufferPool::getMaxBytesAllocated)
+        .def("getNumAllocations", &HostBufferPool::getNumAllocations)
+        .def("trim", &HostBufferPool::trim)
+    ;
+
     py::class_<ExecutionConfiguration, std::shared_ptr<ExecutionConfiguration> > executionconfiguration(m,"ExecutionConfiguration");
     executionconfiguration.def(py::init< ExecutionConfiguration::executionMode, int, bool, bool, std::shared_ptr<Messenger>, unsigned int >())
          .def("isCUDAEnabled", &ExecutionConfiguration::isCUDAEnabled)
          .def("setCUDAErrorChecking", &ExecutionConfiguration::setCUDAErrorChecking)
          .def("getGPUName", &ExecutionConfiguration::getGPUName)
+         .def("setNumThreads", &ExecutionConfiguration::setNumThreads)
+         .def("getNumThreads", &ExecutionConfiguration::getNumThreads)
+         .def("setHostAllocPolicy", &ExecutionConfiguration::setHostAllocPolicy)
+         .def("getHostAllocPolicy", &ExecutionConfiguration::getHostAllocPolicy)
+         .def("setFirstTouch", &ExecutionConfiguration::setFirstTouch)
+         .def("getFirstTouch", &ExecutionConfiguration::getFirstTouch)
+         .def("getHostMemoryUsage", &ExecutionConfiguration::getHostMemoryUsage)
+         .def("getHostBufferPool", &ExecutionConfiguration::getHostBufferPool, py::return_value_policy::reference_internal)
          .def_readonly("n_cpu", &ExecutionConfiguration::n_cpu)
          .def_readonly("msg", &ExecutionConfiguration::msg)
 #ifdef ENABLE_CUDA
@@ -716,4 +946,11 @@ void export_ExecutionConfiguration(py::module& m)
         .value("AUTO", ExecutionConfiguration::executionMode::AUTO)
         .export_values()
     ;
+
+    py::enum_<ExecutionConfiguration::hostAllocPolicy>(executionconfiguration,"hostAllocPolicy")
+        .value("host_alloc_default", ExecutionConfiguration::hostAllocPolicy::host_alloc_default)
+        .value("host_alloc_huge_pages", ExecutionConfiguration::hostAllocPolicy::host_alloc_huge_pages)
+        .value("host_alloc_huge_pages_explicit", ExecutionConfiguration::hostAllocPolicy::host_alloc_huge_pages_explicit)
+        .export_values()
+    ;
     }
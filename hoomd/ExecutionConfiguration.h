@@ -16,6 +16,9 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <map>
+#include <mutex>
+#include <stdint.h>
 
 #ifdef ENABLE_CUDA
 #include <cuda.h>
@@ -23,6 +26,11 @@
 #endif
 
 #include "Messenger.h"
+#include "HostBufferPool.h"
+
+#ifdef ENABLE_TBB
+#include <tbb/global_control.h>
+#endif
 
 /*! \file ExecutionConfiguration.h
     \brief Declares ExecutionConfiguration and related classes
@@ -69,6 +77,14 @@ struct ExecutionConfiguration
         AUTO,   //!< Auto select between GPU and CPU
         };
 
+    //! Policies for allocating the host memory of GPUArrays
+    enum hostAllocPolicy
+        {
+        host_alloc_default = 0,     //!< 64 byte aligned allocations
+        host_alloc_huge_pages,      //!< Large allocations are 2MB aligned and backed by transparent huge pages
+        host_alloc_huge_pages_explicit  //!< Large allocations are mapped from the reserved huge page pool
+        };
+
     //! Constructor
     ExecutionConfiguration(executionMode mode=AUTO,
                            int gpu_id=-1,
@@ -120,6 +136,65 @@ struct ExecutionConfiguration
         m_cuda_error_checking = cuda_error_checking;
         }
 
+    //! Set the number of CPU threads used by threaded compute kernels
+    void setNumThreads(unsigned int num_threads);
+
+    //! Get the number of CPU threads used by threaded compute kernels
+    /*! \returns 1 in builds without TBB support
+    */
+    unsigned int getNumThreads() const
+        {
+        return m_num_threads;
+        }
+
+    //! Set the policy for allocating the host memory of GPUArrays
+    /*! \param policy Policy to apply to all subsequent allocations
+    */
+    void setHostAllocPolicy(hostAllocPolicy policy)
+        {
+        m_host_alloc_policy = policy;
+        }
+
+    //! Get the policy for allocating the host memory of GPUArrays
+    hostAllocPolicy getHostAllocPolicy() const
+        {
+        return m_host_alloc_policy;
+        }
+
+    //! Set whether newly allocated host memory is first touched by the threads of the thread pool
+    /*! \param first_touch True to clear new memory in parallel, so that its pages are placed on the NUMA nodes of
+                the threads that will process them
+    */
+    void setFirstTouch(bool first_touch)
+        {
+        m_first_touch = first_touch;
+        }
+
+    //! Get whether newly allocated host memory is first touched by the threads of the thread pool
+    bool getFirstTouch() const
+        {
+        return m_first_touch;
+        }
+
+    //! Allocate host memory for a GPUArray according to the host allocation policy
+    void *allocateHost(size_t bytes, const std::string& name) const;
+
+    //! Free host memory allocated with allocateHost()
+    void freeHost(void *ptr, size_t bytes, const std::string& name) const;
+
+    //! Set host memory to zero
+    void clearHost(void *ptr, size_t bytes) const;
+
+    //! Move the accounting of allocated host memory from one array name to another
+    void renameHost(size_t bytes, const std::string& old_name, const std::string& new_name) const;
+
+    //! Get the number of bytes of host memory currently allocated for each array name
+    std::map<std::string, uint64_t> getHostMemoryUsage() const
+        {
+        std::lock_guard<std::mutex> lock(m_host_alloc_mutex);
+        return m_host_bytes;
+        }
+
     //! Get the name of the executing GPU (or the empty string)
     std::string getGPUName() const;
 #ifdef ENABLE_CUDA
@@ -201,6 +276,12 @@ struct ExecutionConfiguration
         }
     #endif
 
+    //! Returns the pool for transient host buffers
+    HostBufferPool *getHostBufferPool() const
+        {
+        return &m_host_buffer_pool;
+        }
+
 private:
 #ifdef ENABLE_CUDA
     //! Initialize the GPU with the given id
@@ -237,6 +318,20 @@ private:
 #endif
 
     unsigned int m_rank;                   //!< Rank of this processor (0 if running in single-processor mode)
+    unsigned int m_num_threads;            //!< Number of CPU threads for threaded kernels
+
+    #ifdef ENABLE_TBB
+    std::unique_ptr<tbb::global_control> m_tbb_control; //!< Limits the size of the TBB thread pool
+    #endif
+
+    hostAllocPolicy m_host_alloc_policy;   //!< Policy for host memory allocations
+    bool m_first_touch;                    //!< True if new host memory is cleared by the thread pool
+    mutable std::mutex m_host_alloc_mutex; //!< Protects the host memory bookkeeping
+    mutable std::map<std::string, uint64_t> m_host_bytes; //!< Bytes of host memory allocated per array name
+    mutable std::map<void *, size_t> m_huge_page_maps;  //!< Allocations mapped from the explicit huge page pool
+    mutable bool m_huge_page_warned;       //!< True after warning that the huge page pool is exhausted
+
+    mutable HostBufferPool m_host_buffer_pool; //!< Pool for transient host buffers
 
     #ifdef ENABLE_CUDA
     CachedAllocator *m_cached_alloc;       //!< Cached allocator for temporary allocations
@@ -11,6 +11,7 @@
 
 
 #include "ForceCompute.h"
+#include "StepTimer.h"
 
 #ifdef ENABLE_MPI
 #include "Communicator.h"
@@ -140,8 +141,12 @@ void ForceCompute::compute(unsigned int timestep)
     if (!m_particles_sorted && !shouldCompute(timestep))
         return;
 
+    if (m_step_timer) m_step_timer->start(m_timer_slot);
+
     computeForces(timestep);
     m_particles_sorted = false;
+
+    if (m_step_timer) m_step_timer->stop(m_timer_slot);
     }
 
 /*! \param num_iters Number of iterations to average for the benchmark
@@ -66,6 +66,14 @@ class ForceCompute : public Compute
          * and can be used to overlap computation with communication
          */
         virtual void preCompute(unsigned int timestep){}
+
+        //! Compute the forces on particles that do not interact with ghosts
+        /*! This method is called in MPI simulations while the ghost positions are being updated, if the
+         * Communicator overlaps the ghost update with computation. Forces computed here must remain valid for
+         * the following call to compute() at the same time step, which then only needs to add the remaining
+         * contributions.
+         */
+        virtual void computeInterior(unsigned int timestep){}
         #endif
 
         //! Computes the forces
@@ -29,6 +29,7 @@
 #include <stdexcept>
 #include <algorithm>
 #include <stdlib.h>
+#include <string>
 
 //! Specifies where to acquire the data
 struct access_location
@@ -262,6 +263,22 @@ template<class T> class GPUArray
             return m_height;
             }
 
+        //! Set the name under which the host memory of the array is accounted
+        /*! \param name Name of the array, see ExecutionConfiguration::getHostMemoryUsage()
+        */
+        void setName(const std::string& name)
+            {
+            if (m_exec_conf && !isNull())
+                m_exec_conf->renameHost(sizeof(T)*m_num_elements, m_name, name);
+            m_name = name;
+            }
+
+        //! Get the name under which the host memory of the array is accounted
+        const std::string& getName() const
+            {
+            return m_name;
+            }
+
         //! Resize the GPUArray
         /*! This method resizes the array by allocating a new array and copying over the elements
             from the old array. This is a slow process.
@@ -298,6 +315,7 @@ template<class T> class GPUArray
         mutable unsigned int m_height;                  //!< Number of allocated rows
 
         mutable bool m_acquired;                //!< Tracks whether the data has been aquired
+        mutable std::string m_name;                     //!< Name for the accounting of host memory
         mutable data_location::Enum m_data_location;    //!< Tracks the current location of the data
 #ifdef ENABLE_CUDA
         mutable bool m_mapped;                          //!< True if we are using mapped memory
@@ -313,6 +331,13 @@ template<class T> class GPUArray
 
         mutable std::shared_ptr<const ExecutionConfiguration> m_exec_conf;    //!< execution configuration for working with CUDA
     private:
+        //! Helper function to allocate host memory
+        inline T* allocateHost(unsigned int num_elements);
+        //! Helper function to free host memory
+        inline void freeHost(T* ptr, unsigned int num_elements);
+        //! Helper function to clear host memory
+        inline void clearHost(T* ptr, unsigned int num_elements);
+
         //! Helper function to allocate memory
         inline void allocate();
         //! Helper function to free memory
@@ -487,6 +512,8 @@ template<class T> GPUArray<T>::GPUArray(const GPUArray& from) : m_num_elements(f
         h_data(NULL),
         m_exec_conf(from.m_exec_conf)
     {
+    m_name = from.m_name;
+
     // allocate and clear new memory the same size as the data in from
     allocate();
     memclear();
@@ -559,6 +586,7 @@ template<class T> void GPUArray<T>::swap(GPUArray& from)
     std::swap(m_acquired, from.m_acquired);
     std::swap(m_data_location, from.m_data_location);
     std::swap(m_exec_conf, from.m_exec_conf);
+    std::swap(m_name, from.m_name);
 #ifdef ENABLE_CUDA
     std::swap(d_data, from.d_data);
     std::swap(m_mapped, from.m_mapped);
@@ -578,6 +606,7 @@ template<class T> void GPUArray<T>::swap(GPUArray& from) const
     std::swap(m_exec_conf, from.m_exec_conf);
     std::swap(m_acquired, from.m_acquired);
     std::swap(m_data_location, from.m_data_location);
+    std::swap(m_name, from.m_name);
 #ifdef ENABLE_CUDA
     std::swap(d_data, from.d_data);
     std::swap(m_mapped, from.m_mapped);
@@ -585,6 +614,46 @@ template<class T> void GPUArray<T>::swap(GPUArray& from) const
     std::swap(h_data, from.h_data);
     }
 
+/*! \param num_elements Number of elements to allocate
+    \returns Pointer to host memory aligned to at least 64 bytes (a cache line)
+
+    The memory is allocated according to the host allocation policy of the execution configuration and accounted to
+    the name of the array.
+*/
+template<class T> T* GPUArray<T>::allocateHost(unsigned int num_elements)
+    {
+    if (m_exec_conf)
+        return (T*)m_exec_conf->allocateHost(sizeof(T)*num_elements, m_name);
+
+    T *ptr = NULL;
+    int retval = posix_memalign((void**)&ptr, 64, num_elements*sizeof(T));
+    if (retval != 0)
+        throw std::runtime_error("Error allocating GPUArray.");
+    return ptr;
+    }
+
+/*! \param ptr Pointer returned by allocateHost()
+    \param num_elements Number of elements passed to allocateHost()
+*/
+template<class T> void GPUArray<T>::freeHost(T* ptr, unsigned int num_elements)
+    {
+    if (m_exec_conf)
+        m_exec_conf->freeHost(ptr, sizeof(T)*num_elements, m_name);
+    else
+        free(ptr);
+    }
+
+/*! \param ptr Pointer to the first element to clear
+    \param num_elements Number of elements to clear
+*/
+template<class T> void GPUArray<T>::clearHost(T* ptr, unsigned int num_elements)
+    {
+    if (m_exec_conf)
+        m_exec_conf->clearHost(ptr, sizeof(T)*num_elements);
+    else
+        memset(ptr, 0, sizeof(T)*num_elements);
+    }
+
 /*! \pre m_num_elements is set
     \pre pointers are not allocated
     \post All memory pointers needed for GPUArray are allocated
@@ -618,14 +687,7 @@ template<class T> void GPUArray<T>::allocate()
     assert(h_data == NULL);
 
     // allocate host memory
-    // at minimum, alignment needs to be 32 bytes for AVX
-    int retval = posix_memalign((void**)&h_data, 32, m_num_elements*sizeof(T));
-    if (retval != 0)
-        {
-        if (m_exec_conf)
-            m_exec_conf->msg->error() << "Error allocating aligned memory" << std::endl;
-        throw std::runtime_error("Error allocating GPUArray.");
-        }
+    h_data = allocateHost(m_num_elements);
 
 #ifdef ENABLE_CUDA
     assert(d_data == NULL);
@@ -679,7 +741,7 @@ template<class T> void GPUArray<T>::deallocate()
         }
 #endif
 
-    free(h_data);
+    freeHost(h_data, m_num_elements);
 
     // set pointers to NULL
     h_data = NULL;
@@ -701,7 +763,7 @@ template<class T> void GPUArray<T>::memclear(unsigned int first)
     assert(first < m_num_elements);
 
     // clear memory
-    memset(h_data+first, 0, sizeof(T)*(m_num_elements-first));
+    clearHost(h_data+first, m_num_elements-first);
 
 #ifdef ENABLE_CUDA
     if (m_exec_conf && m_exec_conf->isCUDAEnabled())
@@ -957,14 +1019,7 @@ template<class T> T* GPUArray<T>::resizeHostArray(unsigned int num_elements)
     T *h_tmp = NULL;
 
     // allocate host memory
-    // at minimum, alignment needs to be 32 bytes for AVX
-    int retval = posix_memalign((void**)&h_tmp, 32, num_elements*sizeof(T));
-    if (retval != 0)
-        {
-        if (m_exec_conf)
-            m_exec_conf->msg->error() << "Error allocating aligned memory" << std::endl;
-        throw std::runtime_error("Error allocating GPUArray.");
-        }
+    h_tmp = allocateHost(num_elements);
 
 #ifdef ENABLE_CUDA
     if (m_exec_conf && m_exec_conf->isCUDAEnabled())
@@ -973,7 +1028,7 @@ template<class T> T* GPUArray<T>::resizeHostArray(unsigned int num_elements)
         }
 #endif
     // clear memory
-    memset(h_tmp, 0, sizeof(T)*num_elements);
+    clearHost(h_tmp, num_elements);
 
     // copy over data
     unsigned int num_copy_elements = m_num_elements > num_elements ? num_elements : m_num_elements;
@@ -988,7 +1043,7 @@ template<class T> T* GPUArray<T>::resizeHostArray(unsigned int num_elements)
         }
 #endif
 
-    free(h_data);
+    freeHost(h_data, m_num_elements);
     h_data = h_tmp;
 
 #ifdef ENABLE_CUDA
@@ -1010,17 +1065,10 @@ template<class T> T* GPUArray<T>::resize2DHostArray(unsigned int pitch, unsigned
     T *h_tmp = NULL;
 
     // allocate host memory
-    // at minimum, alignment needs to be 32 bytes for AVX
-    unsigned int size = new_pitch*new_height*sizeof(T);
-    int retval = posix_memalign((void**)&h_tmp, 32, size);
-    if (retval != 0)
-        {
-        if (m_exec_conf)
-            m_exec_conf->msg->error() << "Error allocating aligned memory" << std::endl;
-        throw std::runtime_error("Error allocating GPUArray.");
-        }
+    h_tmp = allocateHost(new_pitch*new_height);
 
 #ifdef ENABLE_CUDA
+    unsigned int size = new_pitch*new_height*sizeof(T);
     if (m_exec_conf && m_exec_conf->isCUDAEnabled())
         {
         cudaHostRegister(h_tmp, size, cudaHostRegisterDefault);
@@ -1028,7 +1076,7 @@ template<class T> T* GPUArray<T>::resize2DHostArray(unsigned int pitch, unsigned
 #endif
 
     // clear memory
-    memset(h_tmp, 0, sizeof(T)*new_pitch*new_height);
+    clearHost(h_tmp, new_pitch*new_height);
 
     // copy over data
     // every column is copied separately such as to align with the new pitch
@@ -1046,7 +1094,7 @@ template<class T> T* GPUArray<T>::resize2DHostArray(unsigned int pitch, unsigned
         }
 #endif
 
-    free(h_data);
+    freeHost(h_data, pitch*height);
     h_data = h_tmp;
 
 #ifdef ENABLE_CUDA
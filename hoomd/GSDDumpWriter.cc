@@ -18,6 +18,7 @@
 
 #include <string.h>
 #include <stdexcept>
+#include <algorithm>
 using namespace std;
 namespace py = pybind11;
 
@@ -40,6 +41,12 @@ GSDDumpWriter::GSDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
     : Analyzer(sysdef), m_fname(fname), m_overwrite(overwrite),
                         m_truncate(truncate),
                         m_is_initialized(false),
+                        m_distributed(false),
+                        m_nframes(0),
+                        m_queue_depth(0),
+                        m_stage(false),
+                        m_writer_busy(false),
+                        m_writer_exit(false),
                         m_group(group)
     {
     m_exec_conf->msg->notice(5) << "Constructing GSDDumpWriter: " << m_fname << " " << overwrite << " " << truncate << endl;
@@ -129,6 +136,7 @@ void GSDDumpWriter::initFileIO()
         throw runtime_error("Error opening GSD file");
         }
 
+    m_nframes = gsd_get_nframes(&m_handle);
     m_is_initialized = true;
     }
 
@@ -141,6 +149,9 @@ GSDDumpWriter::~GSDDumpWriter()
     root = m_exec_conf->isRoot();
     #endif
 
+    // write out all pending frames
+    stopWriter();
+
     if (root && m_is_initialized)
         {
         m_exec_conf->msg->notice(5) << "dump.gsd: close gsd file " << m_fname << endl;
@@ -148,6 +159,253 @@ GSDDumpWriter::~GSDDumpWriter()
         }
     }
 
+/*! \param depth Maximum number of frames pending in the background writer, including the one being written
+
+    With \a depth 0, frames are written synchronously in analyze().
+*/
+void GSDDumpWriter::setQueueDepth(unsigned int depth)
+    {
+    if (depth == 0)
+        {
+        stopWriter();
+        checkWriterError();
+        }
+
+    m_queue_depth = depth;
+    }
+
+/*! Blocks until the background writer has written all pending frames to the file. Errors that occurred in the
+    background writer are raised here.
+*/
+void GSDDumpWriter::flush()
+    {
+    if (m_writer_thread.joinable())
+        {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait(lock, [this]{ return m_queue.empty() && !m_writer_busy; });
+        }
+
+    checkWriterError();
+    }
+
+void GSDDumpWriter::startWriter()
+    {
+    if (m_writer_thread.joinable())
+        return;
+
+    m_exec_conf->msg->notice(5) << "dump.gsd: starting background writer" << endl;
+    m_writer_exit = false;
+    m_writer_thread = std::thread(&GSDDumpWriter::writerLoop, this);
+    }
+
+/*! The writer thread writes out all pending frames before it exits.
+*/
+void GSDDumpWriter::stopWriter()
+    {
+    if (m_writer_thread.joinable())
+        {
+            {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_writer_exit = true;
+            }
+        m_cond.notify_all();
+        m_writer_thread.join();
+        }
+    }
+
+void GSDDumpWriter::writerLoop()
+    {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+        {
+        m_cond.wait(lock, [this]{ return m_writer_exit || !m_queue.empty(); });
+
+        // exit only after all pending frames are written
+        if (m_queue.empty())
+            break;
+
+        std::unique_ptr<StagedFrame> frame = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_writer_busy = true;
+
+        // write without holding the lock so that the simulation can stage the next frame
+        lock.unlock();
+        std::string error = writeStagedFrame(*frame);
+        lock.lock();
+
+        if (! error.empty() && m_writer_error.empty())
+            m_writer_error = error;
+
+        m_writer_busy = false;
+        m_free_frames.push_back(std::move(frame));
+        m_cond.notify_all();
+        }
+    }
+
+/*! \param frame Frame to write
+    \returns An empty string on success, or a description of the error
+
+    Called from the background writer thread, which must not use the Messenger.
+*/
+std::string GSDDumpWriter::writeStagedFrame(const StagedFrame& frame)
+    {
+    int retval = 0;
+
+    if (frame.truncate)
+        {
+        retval = gsd_truncate(&m_handle);
+        if (retval == -1)
+            return string(strerror(errno));
+        else if (retval != 0)
+            return string("Unable to truncate file");
+        }
+
+    for (unsigned int i = 0; i < frame.num_chunks; i++)
+        {
+        const StagedChunk& chunk = frame.chunks[i];
+        retval = gsd_write_chunk(&m_handle, chunk.name.c_str(), chunk.type, chunk.N, chunk.M, 0, &chunk.data[0]);
+        if (retval == -1)
+            return string(strerror(errno));
+        else if (retval != 0)
+            return string("Unknown error writing ") + chunk.name;
+        }
+
+    retval = gsd_end_frame(&m_handle);
+    if (retval == -1)
+        return string(strerror(errno));
+    else if (retval != 0)
+        return string("Unknown error ending frame");
+
+    return string();
+    }
+
+void GSDDumpWriter::checkWriterError()
+    {
+    std::string error;
+        {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        error.swap(m_writer_error);
+        }
+
+    if (! error.empty())
+        {
+        m_exec_conf->msg->error() << "dump.gsd: " << error << " - " << m_fname << endl;
+        throw runtime_error("Error writing GSD file");
+        }
+    }
+
+/*! \param name Name of the data chunk
+    \param type Type of the data
+    \param N Number of rows
+    \param M Number of columns
+    \param flags Flags passed to gsd_write_chunk()
+    \param data Data buffer
+
+    When staging a frame for the background writer, copy the data into the staging buffer. Otherwise, write it to
+    the file immediately.
+
+    \returns The gsd_write_chunk() error code
+*/
+int GSDDumpWriter::writeChunk(const char *name,
+                              enum gsd_type type,
+                              uint64_t N,
+                              uint32_t M,
+                              uint8_t flags,
+                              const void *data)
+    {
+    if (! m_stage)
+        return gsd_write_chunk(&m_handle, name, type, N, M, flags, data);
+
+    // validate the input here, where errors can be reported
+    if (data == NULL || N == 0 || M == 0)
+        return -2;
+
+    StagedFrame& frame = *m_staged_frame;
+    if (frame.num_chunks == frame.chunks.size())
+        frame.chunks.resize(frame.num_chunks + 1);
+
+    StagedChunk& chunk = frame.chunks[frame.num_chunks];
+    frame.num_chunks++;
+
+    size_t size = N * M * gsd_sizeof_type(type);
+    chunk.name = name;
+    chunk.type = type;
+    chunk.N = N;
+    chunk.M = M;
+    chunk.data.resize(size);
+    memcpy(&chunk.data[0], data, size);
+    return 0;
+    }
+
+/*! Ends the frame in the file, or hands the staged frame to the background writer. Blocks while the queue is full.
+*/
+void GSDDumpWriter::endFrame()
+    {
+    m_exec_conf->msg->notice(10) << "dump.gsd: ending frame" << endl;
+    m_nframes++;
+
+    if (! m_stage)
+        {
+        int retval = gsd_end_frame(&m_handle);
+        checkError(retval);
+        return;
+        }
+
+    m_stage = false;
+    startWriter();
+
+        {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait(lock, [this]{ return m_queue.size() + (m_writer_busy ? 1 : 0) < m_queue_depth; });
+        m_queue.push_back(std::move(m_staged_frame));
+        }
+    m_cond.notify_all();
+    }
+
+void GSDDumpWriter::truncateFile()
+    {
+    m_exec_conf->msg->notice(10) << "dump.gsd: truncating file" << endl;
+    m_nframes = 0;
+
+    if (m_stage)
+        {
+        m_staged_frame->truncate = true;
+        return;
+        }
+
+    int retval = gsd_truncate(&m_handle);
+    if (retval == -1)
+        {
+        m_exec_conf->msg->error() << "dump.gsd: " << strerror(errno) << " - " << m_fname << endl;
+        throw runtime_error("Error opening GSD file");
+        }
+    else if (retval == -2)
+        {
+        m_exec_conf->msg->error() << "dump.gsd: " << m_fname << " is not a valid GSD file" << endl;
+        throw runtime_error("Error opening GSD file");
+        }
+    else if (retval == -3)
+        {
+        m_exec_conf->msg->error() << "dump.gsd: " << "Invalid GSD file version in " << m_fname << endl;
+        throw runtime_error("Error opening GSD file");
+        }
+    else if (retval == -4)
+        {
+        m_exec_conf->msg->error() << "dump.gsd: " << "Corrupt GSD file: " << m_fname << endl;
+        throw runtime_error("Error opening GSD file");
+        }
+    else if (retval == -5)
+        {
+        m_exec_conf->msg->error() << "dump.gsd: " << "Out of memory opening: " << m_fname << endl;
+        throw runtime_error("Error opening GSD file");
+        }
+    else if (retval != 0)
+        {
+        m_exec_conf->msg->error() << "dump.gsd: " << "Unknown error opening: " << m_fname << endl;
+        throw runtime_error("Error opening GSD file");
+        }
+    }
+
 /*! \param timestep Current time step of the simulation
 
     The first call to analyze() will create or overwrite the file and write out the current system configuration
@@ -155,16 +413,25 @@ GSDDumpWriter::~GSDDumpWriter()
 */
 void GSDDumpWriter::analyze(unsigned int timestep)
     {
-    int retval;
     bool root=true;
 
     if (m_prof)
         m_prof->push("Dump GSD");
 
+    // in distributed mode, every rank writes its own particles and no snapshot is needed
+    bool distributed = false;
+#ifdef ENABLE_MPI
+    distributed = m_distributed && m_pdata->getDomainDecomposition();
+#endif
+
     // take particle data snapshot
-    m_exec_conf->msg->notice(10) << "dump.gsd: taking particle data snapshot" << endl;
     SnapshotParticleData<float> snapshot;
-    const std::map<unsigned int, unsigned int>& map = m_pdata->takeSnapshot<float>(snapshot);
+    std::map<unsigned int, unsigned int> map;
+    if (! distributed)
+        {
+        m_exec_conf->msg->notice(10) << "dump.gsd: taking particle data snapshot" << endl;
+        map = m_pdata->takeSnapshot<float>(snapshot);
+        }
 
 #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
@@ -175,47 +442,41 @@ void GSDDumpWriter::analyze(unsigned int timestep)
     if (! m_is_initialized && root)
         initFileIO();
 
-    // truncate the file if requested
-    if (m_truncate && root)
+    if (root)
         {
-        m_exec_conf->msg->notice(10) << "dump.gsd: truncating file" << endl;
-        retval = gsd_truncate(&m_handle);
-        if (retval == -1)
-            {
-            m_exec_conf->msg->error() << "dump.gsd: " << strerror(errno) << " - " << m_fname << endl;
-            throw runtime_error("Error opening GSD file");
-            }
-        else if (retval == -2)
-            {
-            m_exec_conf->msg->error() << "dump.gsd: " << m_fname << " is not a valid GSD file" << endl;
-            throw runtime_error("Error opening GSD file");
-            }
-        else if (retval == -3)
-            {
-            m_exec_conf->msg->error() << "dump.gsd: " << "Invalid GSD file version in " << m_fname << endl;
-            throw runtime_error("Error opening GSD file");
-            }
-        else if (retval == -4)
-            {
-            m_exec_conf->msg->error() << "dump.gsd: " << "Corrupt GSD file: " << m_fname << endl;
-            throw runtime_error("Error opening GSD file");
-            }
-        else if (retval == -5)
-            {
-            m_exec_conf->msg->error() << "dump.gsd: " << "Out of memory opening: " << m_fname << endl;
-            throw runtime_error("Error opening GSD file");
-            }
-        else if (retval != 0)
+        checkWriterError();
+
+        // stage the frame for the background writer, unless particles are written collectively
+        if (m_queue_depth > 0 && distributed)
+            flush();
+
+        m_stage = m_queue_depth > 0 && ! distributed;
+        if (m_stage)
             {
-            m_exec_conf->msg->error() << "dump.gsd: " << "Unknown error opening: " << m_fname << endl;
-            throw runtime_error("Error opening GSD file");
+                {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (! m_free_frames.empty())
+                    {
+                    m_staged_frame = std::move(m_free_frames.back());
+                    m_free_frames.pop_back();
+                    }
+                }
+
+            if (! m_staged_frame)
+                m_staged_frame = std::unique_ptr<StagedFrame>(new StagedFrame());
+            m_staged_frame->truncate = false;
+            m_staged_frame->num_chunks = 0;
             }
         }
 
+    // truncate the file if requested
+    if (m_truncate && root)
+        truncateFile();
+
     uint64_t nframes = 0;
     if (root)
         {
-        nframes = gsd_get_nframes(&m_handle);
+        nframes = m_nframes;
         m_exec_conf->msg->notice(10) << "dump.gsd: " << m_fname << " has " << nframes << " frames" << endl;
         }
 
@@ -223,11 +484,17 @@ void GSDDumpWriter::analyze(unsigned int timestep)
     bcast(nframes, 0, m_exec_conf->getMPICommunicator());
     #endif
 
+    // write out the frame header on all frames
     if (root)
-        {
-        // write out the frame header on all frames
         writeFrameHeader(timestep);
 
+    #ifdef ENABLE_MPI
+    if (distributed)
+        writeParticlesDistributed(nframes);
+    #endif
+
+    if (root && ! distributed)
+        {
         // only write out data chunk categories if requested, or if on frame 0
         if (m_write_attribute || nframes == 0)
             writeAttributes(snapshot, map);
@@ -263,11 +530,7 @@ void GSDDumpWriter::analyze(unsigned int timestep)
         }
 
     if (root)
-        {
-        m_exec_conf->msg->notice(10) << "dump.gsd: ending frame" << endl;
-        retval = gsd_end_frame(&m_handle);
-        checkError(retval);
-        }
+        endFrame();
 
     if (m_prof)
         m_prof->pop();
@@ -288,7 +551,7 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string
         std::vector<char> types(max_len * type_mapping.size());
         for (unsigned int i = 0; i < type_mapping.size(); i++)
             strncpy(&types[max_len*i], type_mapping[i].c_str(), max_len);
-        int retval = gsd_write_chunk(&m_handle, chunk.c_str(), GSD_TYPE_UINT8, type_mapping.size(), max_len, 0, (void *)&types[0]);
+        int retval = writeChunk(chunk.c_str(), GSD_TYPE_UINT8, type_mapping.size(), max_len, 0, (void *)&types[0]);
         checkError(retval);
         }
 
@@ -307,14 +570,14 @@ void GSDDumpWriter::writeFrameHeader(unsigned int timestep)
     int retval;
     m_exec_conf->msg->notice(10) << "dump.gsd: writing configuration/step" << endl;
     uint64_t step = timestep;
-    retval = gsd_write_chunk(&m_handle, "configuration/step", GSD_TYPE_UINT64, 1, 1, 0, (void *)&step);
+    retval = writeChunk("configuration/step", GSD_TYPE_UINT64, 1, 1, 0, (void *)&step);
     checkError(retval);
 
-    if (gsd_get_nframes(&m_handle) == 0)
+    if (m_nframes == 0)
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing configuration/dimensions" << endl;
         uint8_t dimensions = m_sysdef->getNDimensions();
-        retval = gsd_write_chunk(&m_handle, "configuration/dimensions", GSD_TYPE_UINT8, 1, 1, 0, (void *)&dimensions);
+        retval = writeChunk("configuration/dimensions", GSD_TYPE_UINT8, 1, 1, 0, (void *)&dimensions);
         checkError(retval);
         }
 
@@ -327,12 +590,12 @@ void GSDDumpWriter::writeFrameHeader(unsigned int timestep)
     box_a[3] = box.getTiltFactorXY();
     box_a[4] = box.getTiltFactorXZ();
     box_a[5] = box.getTiltFactorYZ();
-    retval = gsd_write_chunk(&m_handle, "configuration/box", GSD_TYPE_FLOAT, 6, 1, 0, (void *)box_a);
+    retval = writeChunk("configuration/box", GSD_TYPE_FLOAT, 6, 1, 0, (void *)box_a);
     checkError(retval);
 
     m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/N" << endl;
     uint32_t N = m_group->getNumMembersGlobal();
-    retval = gsd_write_chunk(&m_handle, "particles/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+    retval = writeChunk("particles/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
     checkError(retval);
     }
 
@@ -368,7 +631,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (! all_default)
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/typeid" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&type[0]);
+            retval = writeChunk("particles/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&type[0]);
             checkError(retval);
             }
         }
@@ -394,7 +657,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (! all_default)
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/mass" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/mass", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
+            retval = writeChunk("particles/mass", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
             checkError(retval);
             }
 
@@ -416,7 +679,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (! all_default)
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/charge" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/charge", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
+            retval = writeChunk("particles/charge", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
             checkError(retval);
             }
 
@@ -439,7 +702,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (! all_default)
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/diameter" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/diameter", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
+            retval = writeChunk("particles/diameter", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
             checkError(retval);
             }
         }
@@ -465,7 +728,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (! all_default)
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/body" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/body", GSD_TYPE_INT32, N, 1, 0, (void *)&body[0]);
+            retval = writeChunk("particles/body", GSD_TYPE_INT32, N, 1, 0, (void *)&body[0]);
             checkError(retval);
             }
         }
@@ -497,7 +760,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (! all_default)
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/moment_inertia" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/moment_inertia", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
+            retval = writeChunk("particles/moment_inertia", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
             checkError(retval);
             }
         }
@@ -529,7 +792,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
             }
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/position" << endl;
-        retval = gsd_write_chunk(&m_handle, "particles/position", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
+        retval = writeChunk("particles/position", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
         checkError(retval);
         }
 
@@ -562,7 +825,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
         if (! all_default)
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/orientation" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/orientation", GSD_TYPE_FLOAT, N, 4, 0, (void *)&data[0]);
+            retval = writeChunk("particles/orientation", GSD_TYPE_FLOAT, N, 4, 0, (void *)&data[0]);
             checkError(retval);
             }
         }
@@ -604,7 +867,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         if (! all_default)
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/velocity" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/velocity", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
+            retval = writeChunk("particles/velocity", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
             checkError(retval);
             }
         }
@@ -638,7 +901,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         if (! all_default)
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/angmom" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/angmom", GSD_TYPE_FLOAT, N, 4, 0, (void *)&data[0]);
+            retval = writeChunk("particles/angmom", GSD_TYPE_FLOAT, N, 4, 0, (void *)&data[0]);
             checkError(retval);
             }
         }
@@ -670,12 +933,352 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         if (! all_default)
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/image" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/image", GSD_TYPE_INT32, N, 3, 0, (void *)&data[0]);
+            retval = writeChunk("particles/image", GSD_TYPE_INT32, N, 3, 0, (void *)&data[0]);
             checkError(retval);
             }
         }
     }
 
+#ifdef ENABLE_MPI
+/*! \param nframes Number of frames in the file before this one
+
+    Writes the same particle chunks as writeAttributes(), writeProperties(), and writeMomenta(), without gathering a
+    snapshot. Every rank sorts its local group members by their position in the (tag sorted) group and writes them
+    directly into their rows of each chunk with collective MPI-IO. The root rank reserves each chunk in the gsd
+    index, so the resulting file is identical to one written serially.
+
+    Values are converted exactly as takeSnapshot<float>() would, including the wrap into the global box.
+*/
+void GSDDumpWriter::writeParticlesDistributed(uint64_t nframes)
+    {
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+
+    // all ranks write to the file that root created
+    std::string fname = m_fname;
+    bcast(fname, 0, mpi_comm);
+
+    MPI_File fh;
+    int retval = MPI_File_open(mpi_comm, (char *)fname.c_str(), MPI_MODE_WRONLY, MPI_INFO_NULL, &fh);
+    if (retval != MPI_SUCCESS)
+        {
+        m_exec_conf->msg->error() << "dump.gsd: Unable to open " << fname << " with MPI-IO" << endl;
+        throw runtime_error("Error writing GSD file");
+        }
+
+    // find the row of every local group member, sorted by row
+    unsigned int N = m_group->getNumMembersGlobal();
+    unsigned int n_local = m_group->getNumMembers();
+    std::vector< std::pair<int, unsigned int> > rows_idx(n_local);
+
+        {
+        ArrayHandle<unsigned int> h_member_idx(m_group->getIndexArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_member_tags(m_group->getMemberTagArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+        for (unsigned int j = 0; j < n_local; j++)
+            {
+            unsigned int idx = h_member_idx.data[j];
+            const unsigned int *it = std::lower_bound(h_member_tags.data, h_member_tags.data + N, h_tag.data[idx]);
+            assert(it != h_member_tags.data + N && *it == h_tag.data[idx]);
+            rows_idx[j] = std::make_pair(int(it - h_member_tags.data), idx);
+            }
+        }
+
+    std::sort(rows_idx.begin(), rows_idx.end());
+
+    std::vector<int> rows(n_local);
+    for (unsigned int j = 0; j < n_local; j++)
+        rows[j] = rows_idx[j].first;
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+
+    if (m_write_attribute || nframes == 0)
+        {
+        if (m_exec_conf->isRoot())
+            {
+            std::vector<std::string> type_mapping(m_pdata->getNTypes());
+            for (unsigned int i = 0; i < type_mapping.size(); i++)
+                type_mapping[i] = m_pdata->getNameByType(i);
+            writeTypeMapping("particles/types", type_mapping);
+            }
+
+            {
+            std::vector<uint32_t> type(n_local);
+            bool all_default = true;
+
+            for (unsigned int j = 0; j < n_local; j++)
+                {
+                unsigned int idx = rows_idx[j].second;
+                type[j] = uint32_t(__scalar_as_int(h_pos.data[idx].w));
+                if (type[j] != 0)
+                    all_default = false;
+                }
+
+            writeChunkDistributed(fh, "particles/typeid", GSD_TYPE_UINT32, 1, rows, type.data(), all_default);
+            }
+
+            {
+            std::vector<float> data(n_local);
+            bool all_default = true;
+
+            for (unsigned int j = 0; j < n_local; j++)
+                {
+                data[j] = float(h_vel.data[rows_idx[j].second].w);
+                if (data[j] != float(1.0))
+                    all_default = false;
+                }
+
+            writeChunkDistributed(fh, "particles/mass", GSD_TYPE_FLOAT, 1, rows, data.data(), all_default);
+
+            all_default = true;
+            for (unsigned int j = 0; j < n_local; j++)
+                {
+                data[j] = float(h_charge.data[rows_idx[j].second]);
+                if (data[j] != float(0.0))
+                    all_default = false;
+                }
+
+            writeChunkDistributed(fh, "particles/charge", GSD_TYPE_FLOAT, 1, rows, data.data(), all_default);
+
+            all_default = true;
+            for (unsigned int j = 0; j < n_local; j++)
+                {
+                data[j] = float(h_diameter.data[rows_idx[j].second]);
+                if (data[j] != float(1.0))
+                    all_default = false;
+                }
+
+            writeChunkDistributed(fh, "particles/diameter", GSD_TYPE_FLOAT, 1, rows, data.data(), all_default);
+            }
+
+            {
+            std::vector<int32_t> body(n_local);
+            bool all_default = true;
+
+            for (unsigned int j = 0; j < n_local; j++)
+                {
+                unsigned int b = h_body.data[rows_idx[j].second];
+                if (b != NO_BODY)
+                    all_default = false;
+                body[j] = int32_t(b);
+                }
+
+            writeChunkDistributed(fh, "particles/body", GSD_TYPE_INT32, 1, rows, body.data(), all_default);
+            }
+
+            {
+            std::vector<float> data(n_local*3);
+            bool all_default = true;
+
+            for (unsigned int j = 0; j < n_local; j++)
+                {
+                vec3<float> inertia(h_inertia.data[rows_idx[j].second]);
+                if (inertia.x != float(0.0) || inertia.y != float(0.0) || inertia.z != float(0.0))
+                    all_default = false;
+
+                data[j*3+0] = inertia.x;
+                data[j*3+1] = inertia.y;
+                data[j*3+2] = inertia.z;
+                }
+
+            writeChunkDistributed(fh, "particles/moment_inertia", GSD_TYPE_FLOAT, 3, rows, data.data(), all_default);
+            }
+        }
+
+    // positions and images are wrapped into the global box as in takeSnapshot()
+    bool write_property = m_write_property || nframes == 0;
+    bool write_momentum = m_write_momentum || nframes == 0;
+    std::vector<float> pos;
+    std::vector<int3> image;
+    if (write_property || write_momentum)
+        {
+        const BoxDim& global_box = m_pdata->getGlobalBox();
+        Scalar3 origin = m_pdata->getOrigin();
+        int3 o_image = m_pdata->getOriginImage();
+
+        pos.resize(n_local*3);
+        image.resize(n_local);
+        for (unsigned int j = 0; j < n_local; j++)
+            {
+            unsigned int idx = rows_idx[j].second;
+            vec3<float> p(make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - origin);
+            int3 img = h_image.data[idx];
+            img.x -= o_image.x;
+            img.y -= o_image.y;
+            img.z -= o_image.z;
+
+            Scalar3 tmp = vec_to_scalar3(p);
+            global_box.wrap(tmp, img);
+            p = vec3<float>(tmp);
+
+            pos[j*3+0] = p.x;
+            pos[j*3+1] = p.y;
+            pos[j*3+2] = p.z;
+            image[j] = img;
+            }
+        }
+
+    if (write_property)
+        {
+        writeChunkDistributed(fh, "particles/position", GSD_TYPE_FLOAT, 3, rows, pos.data(), false);
+
+        std::vector<float> data(n_local*4);
+        bool all_default = true;
+
+        for (unsigned int j = 0; j < n_local; j++)
+            {
+            quat<float> orientation(h_orientation.data[rows_idx[j].second]);
+            if (orientation.s != float(1.0) ||
+                orientation.v.x != float(0.0) ||
+                orientation.v.y != float(0.0) ||
+                orientation.v.z != float(0.0))
+                {
+                all_default = false;
+                }
+
+            data[j*4+0] = orientation.s;
+            data[j*4+1] = orientation.v.x;
+            data[j*4+2] = orientation.v.y;
+            data[j*4+3] = orientation.v.z;
+            }
+
+        writeChunkDistributed(fh, "particles/orientation", GSD_TYPE_FLOAT, 4, rows, data.data(), all_default);
+        }
+
+    if (write_momentum)
+        {
+            {
+            std::vector<float> data(n_local*3);
+            bool all_default = true;
+
+            for (unsigned int j = 0; j < n_local; j++)
+                {
+                const Scalar4& v = h_vel.data[rows_idx[j].second];
+                vec3<float> vel(make_scalar3(v.x, v.y, v.z));
+                if (vel.x != float(0.0) || vel.y != float(0.0) || vel.z != float(0.0))
+                    all_default = false;
+
+                data[j*3+0] = vel.x;
+                data[j*3+1] = vel.y;
+                data[j*3+2] = vel.z;
+                }
+
+            writeChunkDistributed(fh, "particles/velocity", GSD_TYPE_FLOAT, 3, rows, data.data(), all_default);
+            }
+
+            {
+            std::vector<float> data(n_local*4);
+            bool all_default = true;
+
+            for (unsigned int j = 0; j < n_local; j++)
+                {
+                quat<float> angmom(h_angmom.data[rows_idx[j].second]);
+                if (angmom.s != float(0.0) ||
+                    angmom.v.x != float(0.0) ||
+                    angmom.v.y != float(0.0) ||
+                    angmom.v.z != float(0.0))
+                    {
+                    all_default = false;
+                    }
+
+                data[j*4+0] = angmom.s;
+                data[j*4+1] = angmom.v.x;
+                data[j*4+2] = angmom.v.y;
+                data[j*4+3] = angmom.v.z;
+                }
+
+            writeChunkDistributed(fh, "particles/angmom", GSD_TYPE_FLOAT, 4, rows, data.data(), all_default);
+            }
+
+            {
+            std::vector<int32_t> data(n_local*3);
+            bool all_default = true;
+
+            for (unsigned int j = 0; j < n_local; j++)
+                {
+                if (image[j].x != 0 || image[j].y != 0 || image[j].z != 0)
+                    all_default = false;
+
+                data[j*3+0] = float(image[j].x);
+                data[j*3+1] = float(image[j].y);
+                data[j*3+2] = float(image[j].z);
+                }
+
+            writeChunkDistributed(fh, "particles/image", GSD_TYPE_INT32, 3, rows, data.data(), all_default);
+            }
+        }
+
+    // closing the file completes all writes before root writes the index
+    MPI_File_close(&fh);
+    }
+
+/*! \param fh MPI file handle opened on all ranks
+    \param name Name of the chunk
+    \param type Type of the chunk data
+    \param M Number of columns in the chunk
+    \param rows Sorted rows of the chunk that this rank owns
+    \param data Local data, rows.size() x M values of \a type
+    \param all_default True if all local values are the default
+
+    The chunk is skipped when all values on all ranks are the default. Otherwise, root reserves space for the chunk
+    and every rank writes its rows through an indexed file view.
+*/
+void GSDDumpWriter::writeChunkDistributed(MPI_File fh,
+                                          const char *name,
+                                          enum gsd_type type,
+                                          unsigned int M,
+                                          const std::vector<int>& rows,
+                                          const void *data,
+                                          bool all_default)
+    {
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+
+    int all_default_int = all_default ? 1 : 0;
+    MPI_Allreduce(MPI_IN_PLACE, &all_default_int, 1, MPI_INT, MPI_LAND, mpi_comm);
+    if (all_default_int)
+        return;
+
+    int64_t location = 0;
+    if (m_exec_conf->isRoot())
+        {
+        m_exec_conf->msg->notice(10) << "dump.gsd: writing " << name << endl;
+        int retval = gsd_reserve_chunk(&m_handle, name, type, m_group->getNumMembersGlobal(), M, 0, &location);
+        checkError(retval);
+        }
+    MPI_Bcast(&location, 1, MPI_INT64_T, 0, mpi_comm);
+
+    MPI_Datatype row_type, file_type;
+    MPI_Type_contiguous(M*gsd_sizeof_type(type), MPI_BYTE, &row_type);
+    MPI_Type_commit(&row_type);
+
+    if (rows.size() > 0)
+        MPI_Type_create_indexed_block(rows.size(), 1, (int *)&rows[0], row_type, &file_type);
+    else
+        MPI_Type_dup(row_type, &file_type);
+    MPI_Type_commit(&file_type);
+
+    MPI_File_set_view(fh, location, MPI_BYTE, file_type, (char *)"native", MPI_INFO_NULL);
+    int retval = MPI_File_write_all(fh, (void *)data, rows.size(), row_type, MPI_STATUS_IGNORE);
+
+    MPI_Type_free(&file_type);
+    MPI_Type_free(&row_type);
+
+    if (retval != MPI_SUCCESS)
+        {
+        m_exec_conf->msg->error() << "dump.gsd: MPI-IO error writing " << name << " to " << m_fname << endl;
+        throw runtime_error("Error writing GSD file");
+        }
+    }
+#endif
+
 /*! \param bond Bond data snapshot
     \param angle Angle data snapshot
     \param dihedral Dihedral data snapshot
@@ -696,68 +1299,68 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing bonds/N" << endl;
         uint32_t N = bond.size;
-        int retval = gsd_write_chunk(&m_handle, "bonds/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("bonds/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("bonds/types", bond.type_mapping);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing bonds/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "bonds/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&bond.type_id[0]);
+        retval = writeChunk("bonds/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&bond.type_id[0]);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing bonds/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "bonds/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&bond.groups[0]);
+        retval = writeChunk("bonds/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&bond.groups[0]);
         checkError(retval);
         }
     if (angle.size > 0)
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing angles/N" << endl;
         uint32_t N = angle.size;
-        int retval = gsd_write_chunk(&m_handle, "angles/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("angles/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("angles/types", angle.type_mapping);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing angles/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "angles/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&angle.type_id[0]);
+        retval = writeChunk("angles/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&angle.type_id[0]);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing angles/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "angles/group", GSD_TYPE_UINT32, N, 3, 0, (void *)&angle.groups[0]);
+        retval = writeChunk("angles/group", GSD_TYPE_UINT32, N, 3, 0, (void *)&angle.groups[0]);
         checkError(retval);
         }
     if (dihedral.size > 0)
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing dihedrals/N" << endl;
         uint32_t N = dihedral.size;
-        int retval = gsd_write_chunk(&m_handle, "dihedrals/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("dihedrals/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("dihedrals/types", dihedral.type_mapping);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing dihedrals/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "dihedrals/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&dihedral.type_id[0]);
+        retval = writeChunk("dihedrals/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&dihedral.type_id[0]);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing dihedrals/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "dihedrals/group", GSD_TYPE_UINT32, N, 4, 0, (void *)&dihedral.groups[0]);
+        retval = writeChunk("dihedrals/group", GSD_TYPE_UINT32, N, 4, 0, (void *)&dihedral.groups[0]);
         checkError(retval);
         }
     if (improper.size > 0)
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing impropers/N" << endl;
         uint32_t N = improper.size;
-        int retval = gsd_write_chunk(&m_handle, "impropers/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("impropers/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("impropers/types", improper.type_mapping);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing impropers/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "impropers/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&improper.type_id[0]);
+        retval = writeChunk("impropers/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&improper.type_id[0]);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing impropers/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "impropers/group", GSD_TYPE_UINT32, N, 4, 0, (void *)&improper.groups[0]);
+        retval = writeChunk("impropers/group", GSD_TYPE_UINT32, N, 4, 0, (void *)&improper.groups[0]);
         checkError(retval);
         }
 
@@ -765,7 +1368,7 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing constraints/N" << endl;
         uint32_t N = constraint.size;
-        int retval = gsd_write_chunk(&m_handle, "constraints/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("constraints/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing constraints/value" << endl;
@@ -774,12 +1377,12 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
             for (unsigned int i = 0; i < N; i++)
                 data[i] = float(constraint.val[i]);
 
-            retval = gsd_write_chunk(&m_handle, "constraints/value", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
+            retval = writeChunk("constraints/value", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
             checkError(retval);
             }
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing constraints/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "constraints/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&constraint.groups[0]);
+        retval = writeChunk("constraints/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&constraint.groups[0]);
         checkError(retval);
         }
 
@@ -787,17 +1390,17 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing pairs/N" << endl;
         uint32_t N = pair.size;
-        int retval = gsd_write_chunk(&m_handle, "pairs/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("pairs/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("pairs/types", pair.type_mapping);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing pairs/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "pairs/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&pair.type_id[0]);
+        retval = writeChunk("pairs/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&pair.type_id[0]);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing pairs/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "pairs/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&pair.groups[0]);
+        retval = writeChunk("pairs/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&pair.groups[0]);
         checkError(retval);
         }
     }
@@ -810,5 +1413,7 @@ void export_GSDDumpWriter(py::module& m)
         .def("setWriteProperty", &GSDDumpWriter::setWriteProperty)
         .def("setWriteMomentum", &GSDDumpWriter::setWriteMomentum)
         .def("setWriteTopology", &GSDDumpWriter::setWriteTopology)
+        .def("setDistributed", &GSDDumpWriter::setDistributed)
+        .def("setQueueDepth", &GSDDumpWriter::setQueueDepth)
     ;
     }
@@ -10,6 +10,10 @@
 
 #include <string>
 #include <memory>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include "hoomd/extern/gsd.h"
 
 /*! \file GSDDumpWriter.h
@@ -30,6 +34,11 @@
     On the first call to analyze() \a fname is created with a dcd header. If it already
     exists, append to the file (unless the user specifies overwrite=True).
 
+    When the queue depth is set larger than 0, analyze() copies the chunks of each frame into a staging buffer and
+    a background thread writes them to the file, so the simulation does not wait on the disk. At most queue depth
+    frames are pending at any time; analyze() blocks when the queue is full. flush() waits until all pending frames
+    are written. Staging buffers are reused from frame to frame.
+
     \ingroup analyzers
 */
 class GSDDumpWriter : public Analyzer
@@ -66,12 +75,27 @@ class GSDDumpWriter : public Analyzer
             m_write_topology = b;
             }
 
+        //! Control distributed writes
+        /*! \param b When true and the simulation is domain decomposed, every rank writes its own particles
+                     directly into the file with MPI-IO instead of gathering a snapshot on the root rank
+        */
+        void setDistributed(bool b)
+            {
+            m_distributed = b;
+            }
+
+        //! Set the number of frames that may be pending in the background writer
+        void setQueueDepth(unsigned int depth);
+
         //! Destructor
         ~GSDDumpWriter();
 
         //! Write out the data for the current timestep
         void analyze(unsigned int timestep);
 
+        //! Wait until all pending frames are written to the file
+        virtual void flush();
+
     private:
         std::string m_fname;                //!< The file name we are writing to
         bool m_overwrite;                   //!< True if file should be overwritten
@@ -81,10 +105,71 @@ class GSDDumpWriter : public Analyzer
         bool m_write_property;              //!< True if properties should be written
         bool m_write_momentum;              //!< True if momenta should be written
         bool m_write_topology;              //!< True if topology should be written
+        bool m_distributed;                 //!< True if particle data should be written by all ranks with MPI-IO
         gsd_handle m_handle;                //!< Handle to the file
+        uint64_t m_nframes;                 //!< Number of frames in the file, including pending frames
+
+        //! A data chunk staged for the background writer
+        struct StagedChunk
+            {
+            std::string name;               //!< Name of the chunk
+            enum gsd_type type;             //!< Type of the chunk data
+            uint64_t N;                     //!< Number of rows
+            uint32_t M;                     //!< Number of columns
+            std::vector<char> data;         //!< Chunk data
+            };
+
+        //! A frame staged for the background writer
+        struct StagedFrame
+            {
+            bool truncate;                  //!< True if the file should be truncated before writing this frame
+            unsigned int num_chunks;        //!< Number of valid entries in chunks
+            std::vector<StagedChunk> chunks;    //!< Chunks in the frame (buffers are kept for reuse)
+            };
+
+        unsigned int m_queue_depth;         //!< Maximum number of pending frames (0 writes synchronously)
+        bool m_stage;                       //!< True when writeChunk() stages chunks instead of writing them
+        std::unique_ptr<StagedFrame> m_staged_frame;                //!< Frame currently being staged
+        std::deque< std::unique_ptr<StagedFrame> > m_queue;         //!< Frames pending in the background writer
+        std::vector< std::unique_ptr<StagedFrame> > m_free_frames;  //!< Written frames available for reuse
+        std::thread m_writer_thread;        //!< Background writer thread
+        std::mutex m_mutex;                 //!< Protects the queue and writer state
+        std::condition_variable m_cond;     //!< Signals changes to the queue and writer state
+        bool m_writer_busy;                 //!< True while the writer thread writes a frame
+        bool m_writer_exit;                 //!< Set to request the writer thread to exit
+        std::string m_writer_error;         //!< Error reported by the writer thread
 
         std::shared_ptr<ParticleGroup> m_group;   //!< Group to write out to the file
 
+        //! Write a chunk to the file, or stage it for the background writer
+        int writeChunk(const char *name,
+                       enum gsd_type type,
+                       uint64_t N,
+                       uint32_t M,
+                       uint8_t flags,
+                       const void *data);
+
+        //! End the current frame
+        void endFrame();
+
+        //! Truncate the file
+        void truncateFile();
+
+        //! Start the background writer thread
+        void startWriter();
+
+        //! Stop the background writer thread
+        void stopWriter();
+
+        //! Main loop of the background writer thread
+        void writerLoop();
+
+        //! Write a staged frame to the file
+        std::string writeStagedFrame(const StagedFrame& frame);
+
+        //! Raise an exception if the background writer reported an error
+        void checkWriterError();
+
         //! Write a type mapping out to the file
         void writeTypeMapping(std::string chunk, std::vector< std::string > type_mapping);
 
@@ -103,6 +188,20 @@ class GSDDumpWriter : public Analyzer
         //! Write particle momenta
         void writeMomenta(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map);
 
+        #ifdef ENABLE_MPI
+        //! Write the per-particle chunks of this frame collectively from all ranks
+        void writeParticlesDistributed(uint64_t nframes);
+
+        //! Write one per-particle chunk collectively
+        void writeChunkDistributed(MPI_File fh,
+                                   const char *name,
+                                   enum gsd_type type,
+                                   unsigned int M,
+                                   const std::vector<int>& rows,
+                                   const void *data,
+                                   bool all_default);
+        #endif
+
         //! Write bond topology
         void writeTopology(BondData::Snapshot& bond,
                            AngleData::Snapshot& angle,
@@ -11,6 +11,7 @@
 #include "GSDReader.h"
 #include "SnapshotSystemData.h"
 #include "ExecutionConfiguration.h"
+#include "SystemDefinition.h"
 #include "hoomd/extern/gsd.h"
 #include <string.h>
 
@@ -22,20 +23,24 @@ namespace py = pybind11;
 /*! \param exec_conf The execution configuration
     \param name File name to read
     \param frame Frame index to read from the file
+    \param distributed Open the file on all ranks and defer reading the particles
 
     The GSDReader constructor opens the GSD file, initializes an empty snapshot, and reads the file into
-    memory (on the root rank).
+    memory (on the root rank). In distributed mode, all ranks open the file and read the header, and the
+    particles are read later by getSnapshot() or createSystemDefinition().
 */
 GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                      const std::string &name,
-                     const uint64_t frame)
-    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame)
+                     const uint64_t frame,
+                     bool distributed)
+    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame), m_distributed(distributed),
+      m_is_open(false), m_N(0), m_particles_read(false)
     {
     m_snapshot = std::shared_ptr< SnapshotSystemData<float> >(new SnapshotSystemData<float>);
 
     #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
-    if (!m_exec_conf->isRoot())
+    if (!m_exec_conf->isRoot() && !m_distributed)
         {
         return;
         }
@@ -74,6 +79,7 @@ GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
         m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Unknown error opening: " << name << endl;
         throw runtime_error("Error opening GSD file");
         }
+    m_is_open = true;
 
     // validate schema
     if (string(m_handle.header.schema) != string("hoomd"))
@@ -95,21 +101,36 @@ GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
         }
 
     readHeader();
-    readParticles();
-    readTopology();
+
+    if (!m_distributed)
+        {
+        readParticles();
+        readTopology();
+        }
+    else
+        {
+        // every rank needs the type names to initialize its particles
+        m_snapshot->particle_data.type_mapping = readTypes(m_frame, "particles/types");
+
+        if (m_exec_conf->isRoot())
+            readTopology();
+        }
     }
 
 GSDReader::~GSDReader()
     {
-    #ifdef ENABLE_MPI
-    // if we are not the root processor, do not perform file I/O
-    if (!m_exec_conf->isRoot())
-        {
-        return;
-        }
-    #endif
+    if (m_is_open)
+        gsd_close(&m_handle);
+    }
+
+/*! In distributed mode, the root rank reads the particles into the snapshot on the first call.
+*/
+std::shared_ptr< SnapshotSystemData<float> > GSDReader::getSnapshot()
+    {
+    if (m_is_open && !m_particles_read && m_exec_conf->isRoot())
+        readParticles();
 
-    gsd_close(&m_handle);
+    return m_snapshot;
     }
 
 /*! \param data Pointer to data to read into
@@ -173,6 +194,54 @@ bool GSDReader::readChunk(void *data, uint64_t frame, const char *name, size_t e
         }
     }
 
+/*! \param buffer Buffer to read the data into when the file is not memory mapped
+    \param frame Frame index to read from
+    \param name Name of the data chunk
+    \param exepected_size Expected size of the data chunk in bytes.
+    \param cur_n N in the current frame.
+
+    Finds the data chunk with the same rules as readChunk(). When the file is memory mapped, return a pointer to the
+    data in the mapping without copying it. Otherwise, read the chunk into \a buffer and return a pointer to that.
+
+    Return NULL if the chunk is not found.
+*/
+const void *GSDReader::mapChunk(std::vector<char>& buffer, uint64_t frame, const char *name, size_t expected_size,
+                                unsigned int cur_n)
+    {
+    if (m_handle.mapped_data == NULL)
+        {
+        buffer.resize(expected_size);
+        if (expected_size == 0 || !readChunk(&buffer[0], frame, name, expected_size, cur_n))
+            return NULL;
+        return &buffer[0];
+        }
+
+    const struct gsd_index_entry* entry = gsd_find_chunk(&m_handle, frame, name);
+    if (entry == NULL && frame != 0)
+        entry = gsd_find_chunk(&m_handle, 0, name);
+
+    if (entry == NULL || (cur_n != 0 && entry->N != cur_n))
+        {
+        m_exec_conf->msg->notice(10) << "data.gsd_snapshot: chunk not found " << name << endl;
+        return NULL;
+        }
+
+    m_exec_conf->msg->notice(7) << "data.gsd_snapshot: mapping chunk " << name << endl;
+    size_t actual_size = entry->N * entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+    if (actual_size != expected_size)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Expecting " << expected_size << " bytes in " << name << " but found " << actual_size << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+    if (entry->location < 0 || uint64_t(entry->location) + actual_size > uint64_t(m_handle.file_size))
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Invalid GSD file " << m_name << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    return (const char *)m_handle.mapped_data + entry->location;
+    }
+
 /*! \param frame Frame index to read from
     \param name Name of the data chunk
 
@@ -250,21 +319,22 @@ void GSDReader::readHeader()
     m_snapshot->global_box = BoxDim(box[0], box[1], box[2]);
     m_snapshot->global_box.setTiltFactors(box[3], box[4], box[5]);
 
-    unsigned int N = 0;
-    readChunk(&N, m_frame, "particles/N", 4);
-    if (N == 0)
+    m_N = 0;
+    readChunk(&m_N, m_frame, "particles/N", 4);
+    if (m_N == 0)
         {
         m_exec_conf->msg->error() << "data.gsd_snapshot: " << "cannot read a file with 0 particles" << endl;
         throw runtime_error("Error reading GSD file");
         }
-    m_snapshot->particle_data.resize(N);
     }
 
 /*! Read the same data chunks for particles
 */
 void GSDReader::readParticles()
     {
-    unsigned int N = m_snapshot->particle_data.size;
+    unsigned int N = m_N;
+    m_snapshot->particle_data.resize(N);
+    m_particles_read = true;
     m_snapshot->particle_data.type_mapping = readTypes(m_frame, "particles/types");
 
     // the snapshot already has default values, if a chunk is not found, the value
@@ -353,11 +423,168 @@ void GSDReader::readTopology()
         }
     }
 
+#ifdef ENABLE_MPI
+/*! \param exec_conf The execution configuration
+    \param decomposition The domain decomposition
+
+    Creates a system with the header of the file, lets every rank read the particles in its domain, and then
+    initializes the topology from the root rank. Must be called on all ranks of a reader in distributed mode.
+*/
+std::shared_ptr<SystemDefinition> GSDReader::createSystemDefinition(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                                                    std::shared_ptr<DomainDecomposition> decomposition)
+    {
+    if (!m_distributed)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "createSystemDefinition requires a distributed reader"
+                                  << endl;
+        throw runtime_error("Error initializing from GSD file");
+        }
+
+    // start with a system without particles and topology, the topology can only be added once the particles exist
+    std::shared_ptr< SnapshotSystemData<float> > header(new SnapshotSystemData<float>);
+    header->dimensions = m_snapshot->dimensions;
+    header->global_box = m_snapshot->global_box;
+    header->particle_data.type_mapping = m_snapshot->particle_data.type_mapping;
+    header->has_integrator_data = false;
+
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(header, exec_conf, decomposition));
+
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    if (pdata->getDomainDecomposition())
+        readLocalParticles(pdata);
+    else
+        {
+        // without domain decomposition, the root rank holds all particles anyway
+        if (m_exec_conf->isRoot() && !m_particles_read)
+            readParticles();
+        pdata->initializeFromSnapshot(m_snapshot->particle_data);
+        }
+
+    m_snapshot->has_particle_data = false;
+    m_snapshot->has_integrator_data = false;
+    sysdef->initializeFromSnapshot(m_snapshot);
+    return sysdef;
+    }
+
+/*! \param pdata Particle data to initialize
+
+    Scans the positions in the file and selects the particles placed in the domain of this rank, then reads the
+    remaining per-particle quantities of only those particles. Chunks that are not found keep the snapshot defaults.
+*/
+void GSDReader::readLocalParticles(std::shared_ptr<ParticleData> pdata)
+    {
+    unsigned int N = m_N;
+    unsigned int my_rank = m_exec_conf->getRank();
+    unsigned int n_ranks = m_exec_conf->getNRanks();
+
+    std::vector<char> pos_buffer, image_buffer, buffer;
+    const float *pos = (const float *)mapChunk(pos_buffer, m_frame, "particles/position", N*12, N);
+    const int32_t *image = (const int32_t *)mapChunk(image_buffer, m_frame, "particles/image", N*12, N);
+
+    // select the particles in the local domain
+    std::vector<unsigned int> tags;
+    std::vector<Scalar3> local_pos;
+    std::vector<int3> local_image;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        Scalar3 p = make_scalar3(0,0,0);
+        if (pos)
+            p = make_scalar3(pos[3*i], pos[3*i+1], pos[3*i+2]);
+        int3 img = make_int3(0,0,0);
+        if (image)
+            img = make_int3(image[3*i], image[3*i+1], image[3*i+2]);
+
+        unsigned int rank = pdata->placeSnapshotParticle(p, img);
+        if (rank >= n_ranks)
+            {
+            m_exec_conf->msg->error() << "init.*: Particle " << i << " out of bounds." << std::endl;
+            pdata->printOutOfBoundsParticle(p);
+            throw std::runtime_error("Error initializing from snapshot.");
+            }
+
+        if (rank == my_rank)
+            {
+            tags.push_back(i);
+            local_pos.push_back(p);
+            local_image.push_back(img);
+            }
+        }
+
+    unsigned int n_local = tags.size();
+    SnapshotParticleData<float> local(n_local);
+    local.type_mapping = m_snapshot->particle_data.type_mapping;
+    for (unsigned int n = 0; n < n_local; n++)
+        {
+        local.pos[n] = vec3<float>(local_pos[n]);
+        local.image[n] = local_image[n];
+        }
+
+    // read the other quantities of the local particles
+    if (const uint32_t *type = (const uint32_t *)mapChunk(buffer, m_frame, "particles/typeid", N*4, N))
+        for (unsigned int n = 0; n < n_local; n++)
+            local.type[n] = type[tags[n]];
+
+    if (const float *mass = (const float *)mapChunk(buffer, m_frame, "particles/mass", N*4, N))
+        for (unsigned int n = 0; n < n_local; n++)
+            local.mass[n] = mass[tags[n]];
+
+    if (const float *charge = (const float *)mapChunk(buffer, m_frame, "particles/charge", N*4, N))
+        for (unsigned int n = 0; n < n_local; n++)
+            local.charge[n] = charge[tags[n]];
+
+    if (const float *diameter = (const float *)mapChunk(buffer, m_frame, "particles/diameter", N*4, N))
+        for (unsigned int n = 0; n < n_local; n++)
+            local.diameter[n] = diameter[tags[n]];
+
+    if (const int32_t *body = (const int32_t *)mapChunk(buffer, m_frame, "particles/body", N*4, N))
+        for (unsigned int n = 0; n < n_local; n++)
+            local.body[n] = body[tags[n]];
+
+    if (const float *inertia = (const float *)mapChunk(buffer, m_frame, "particles/moment_inertia", N*12, N))
+        for (unsigned int n = 0; n < n_local; n++)
+            {
+            const float *I = inertia + 3*tags[n];
+            local.inertia[n] = vec3<float>(I[0], I[1], I[2]);
+            }
+
+    if (const float *orientation = (const float *)mapChunk(buffer, m_frame, "particles/orientation", N*16, N))
+        for (unsigned int n = 0; n < n_local; n++)
+            {
+            const float *q = orientation + 4*tags[n];
+            local.orientation[n] = quat<float>(q[0], vec3<float>(q[1], q[2], q[3]));
+            }
+
+    if (const float *vel = (const float *)mapChunk(buffer, m_frame, "particles/velocity", N*12, N))
+        for (unsigned int n = 0; n < n_local; n++)
+            {
+            const float *v = vel + 3*tags[n];
+            local.vel[n] = vec3<float>(v[0], v[1], v[2]);
+            }
+
+    if (const float *angmom = (const float *)mapChunk(buffer, m_frame, "particles/angmom", N*16, N))
+        for (unsigned int n = 0; n < n_local; n++)
+            {
+            const float *p = angmom + 4*tags[n];
+            local.angmom[n] = quat<float>(p[0], vec3<float>(p[1], p[2], p[3]));
+            }
+
+    m_exec_conf->msg->notice(4) << "data.gsd_snapshot: read " << n_local << " of " << N << " particles on rank "
+                                << my_rank << endl;
+
+    pdata->initializeFromLocalSnapshot(local, tags, N);
+    }
+#endif
+
 void export_GSDReader(py::module& m)
     {
     py::class_< GSDReader >(m,"GSDReader")
     .def(py::init<std::shared_ptr<const ExecutionConfiguration>, const string&, const uint64_t>())
+    .def(py::init<std::shared_ptr<const ExecutionConfiguration>, const string&, const uint64_t, bool>())
     .def("getTimeStep", &GSDReader::getTimeStep)
     .def("getSnapshot", &GSDReader::getSnapshot)
+    .def("getGlobalBox", &GSDReader::getGlobalBox, py::return_value_policy::copy)
+    #ifdef ENABLE_MPI
+    .def("createSystemDefinition", &GSDReader::createSystemDefinition)
+    #endif
     ;
     }
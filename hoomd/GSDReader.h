@@ -25,12 +25,18 @@
 
 //! Forward declarations
 class ExecutionConfiguation;
+class SystemDefinition;
 template <class Real> struct SnapshotSystemData;
 
 //! Reads a GSD input file
 /*! Read an input GSD file and generate a system snapshot. GSDReader can read any frame from a GSD
     file into the snapshot. For information on the GSD specification, see http://gsd.readthedocs.io/
 
+    In distributed mode, every rank opens the file. The header and the topology are still read into the snapshot on
+    the root rank, but the particles are only read into the snapshot when getSnapshot() is called. Instead,
+    createSystemDefinition() lets every rank scan the positions in the memory mapped file and read only the particles
+    in its own domain, so no rank holds the full particle data.
+
     \ingroup data_structs
 */
 class GSDReader
@@ -39,7 +45,8 @@ class GSDReader
         //! Loads in the file and parses the data
         GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                   const std::string &name,
-                  const uint64_t frame);
+                  const uint64_t frame,
+                  bool distributed=false);
 
         //! Destructor
         ~GSDReader();
@@ -59,11 +66,20 @@ class GSDReader
             }
 
         //! initializes a snapshot with the particle data
-        std::shared_ptr< SnapshotSystemData<float> > getSnapshot() const
+        std::shared_ptr< SnapshotSystemData<float> > getSnapshot();
+
+        //! Returns the global box, available on all ranks in distributed mode
+        const BoxDim& getGlobalBox() const
             {
-            return m_snapshot;
+            return m_snapshot->global_box;
             }
 
+        #ifdef ENABLE_MPI
+        //! Initialize a system with every rank reading the particles in its own domain
+        std::shared_ptr<SystemDefinition> createSystemDefinition(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                                                 std::shared_ptr<DomainDecomposition> decomposition);
+        #endif
+
     private:
         std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< The execution configuration
         uint64_t m_timestep;                                         //!< Timestep at the selected frame
@@ -71,9 +87,16 @@ class GSDReader
         uint64_t m_frame;                                            //!< Cached frame
         std::shared_ptr< SnapshotSystemData<float> > m_snapshot;   //!< The snapshot to read
         gsd_handle m_handle;                                         //!< Handle to the file
+        bool m_distributed;                                          //!< True if all ranks open the file
+        bool m_is_open;                                              //!< True if this rank opened the file
+        unsigned int m_N;                                            //!< Number of particles in the frame
+        bool m_particles_read;                                       //!< True once the particles are in the snapshot
 
         //! Helper function to read a quantity from the file
         bool readChunk(void *data, uint64_t frame, const char *name, size_t expected_size, unsigned int cur_n=0);
+        //! Helper function to access a quantity in the memory mapped file
+        const void *mapChunk(std::vector<char>& buffer, uint64_t frame, const char *name, size_t expected_size,
+                             unsigned int cur_n);
         //! Helper function to read a type list from the file
         std::vector<std::string> readTypes(uint64_t frame, const char *name);
 
@@ -81,6 +104,9 @@ class GSDReader
         void readHeader();
         void readParticles();
         void readTopology();
+        #ifdef ENABLE_MPI
+        void readLocalParticles(std::shared_ptr<ParticleData> pdata);
+        #endif
     };
 
 //! Exports GSDReader to python
@@ -0,0 +1,219 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file HostBufferPool.h
+    \brief Declares a pool for transient host buffers and an STL allocator that draws from it
+*/
+
+#ifndef __HOST_BUFFER_POOL_H__
+#define __HOST_BUFFER_POOL_H__
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <vector>
+#include <mutex>
+#include <new>
+#include <stdlib.h>
+#include <stddef.h>
+
+//! Pool of host memory blocks for transient buffers
+/*! HostBufferPool is the host side counterpart of CachedAllocator. Buffers that are created and destroyed every time
+    step, such as the temporary send and receive buffers of the Communicator, take their memory from the pool and
+    return it when they are destroyed. Freed blocks are kept in the pool and handed out again, so once the buffers
+    have reached their steady state sizes, no heap allocations are made.
+
+    Requests are rounded up to the next power of two (at least 64 bytes), and one free list is kept per size class.
+    All blocks are 64 byte aligned. The pool keeps freed blocks until it is destroyed or trim() is called.
+
+    The pool is thread safe. Use it through PooledAllocator, e.g. with the pooled_vector container.
+*/
+class HostBufferPool
+    {
+    public:
+        //! Constructor
+        HostBufferPool()
+            : m_bytes_in_use(0), m_bytes_allocated(0), m_max_bytes_in_use(0), m_max_bytes_allocated(0),
+              m_num_allocations(0)
+            { }
+
+        //! Destructor
+        ~HostBufferPool()
+            {
+            trim();
+            }
+
+        //! Get a block of at least \a num_bytes bytes
+        void *allocate(size_t num_bytes)
+            {
+            unsigned int size_class = getSizeClass(num_bytes);
+            size_t block_bytes = size_t(1) << size_class;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            void *ptr = NULL;
+            if (!m_free_blocks[size_class].empty())
+                {
+                ptr = m_free_blocks[size_class].back();
+                m_free_blocks[size_class].pop_back();
+                }
+            else
+                {
+                if (posix_memalign(&ptr, 64, block_bytes) != 0)
+                    throw std::bad_alloc();
+                m_bytes_allocated += block_bytes;
+                m_num_allocations++;
+                if (m_bytes_allocated > m_max_bytes_allocated)
+                    m_max_bytes_allocated = m_bytes_allocated;
+                }
+
+            m_bytes_in_use += block_bytes;
+            if (m_bytes_in_use > m_max_bytes_in_use)
+                m_max_bytes_in_use = m_bytes_in_use;
+            return ptr;
+            }
+
+        //! Return a block to the pool
+        /*! \param ptr Pointer returned by allocate()
+            \param num_bytes Number of bytes that were requested from allocate()
+        */
+        void deallocate(void *ptr, size_t num_bytes)
+            {
+            if (ptr == NULL)
+                return;
+
+            unsigned int size_class = getSizeClass(num_bytes);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_free_blocks[size_class].push_back(ptr);
+            m_bytes_in_use -= size_t(1) << size_class;
+            }
+
+        //! Free all blocks that are not in use
+        void trim()
+            {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (unsigned int size_class = 0; size_class < num_size_classes; ++size_class)
+                {
+                for (std::vector<void *>::iterator it = m_free_blocks[size_class].begin();
+                    it != m_free_blocks[size_class].end(); ++it)
+                    {
+                    free(*it);
+                    m_bytes_allocated -= size_t(1) << size_class;
+                    }
+                m_free_blocks[size_class].clear();
+                }
+            }
+
+        //! Get the largest number of bytes that were handed out at the same time
+        size_t getMaxBytesInUse() const
+            {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_max_bytes_in_use;
+            }
+
+        //! Get the largest number of bytes the pool held at the same time (in use or free)
+        size_t getMaxBytesAllocated() const
+            {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_max_bytes_allocated;
+            }
+
+        //! Get the number of blocks that were allocated from the heap
+        /*! This number stops growing once all buffers have reached their steady state sizes.
+        */
+        unsigned int getNumAllocations() const
+            {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_num_allocations;
+            }
+
+    private:
+        static const unsigned int num_size_classes = 8*sizeof(size_t); //!< One size class per power of two
+        static const unsigned int min_size_class = 6;                     //!< Smallest blocks are 64 bytes
+
+        mutable std::mutex m_mutex;                         //!< Protects the free lists and statistics
+        std::vector<void *> m_free_blocks[num_size_classes]; //!< Free blocks by size class
+        size_t m_bytes_in_use;                              //!< Bytes currently handed out
+        size_t m_bytes_allocated;                           //!< Bytes currently allocated from the heap
+        size_t m_max_bytes_in_use;                          //!< High-water mark of m_bytes_in_use
+        size_t m_max_bytes_allocated;                       //!< High-water mark of m_bytes_allocated
+        unsigned int m_num_allocations;                     //!< Number of heap allocations
+
+        //! Get the size class for a request, i.e. the base 2 logarithm of the block size
+        static unsigned int getSizeClass(size_t num_bytes)
+            {
+            unsigned int size_class = min_size_class;
+            while ((size_t(1) << size_class) < num_bytes)
+                size_class++;
+            return size_class;
+            }
+
+        // the pool holds raw pointers and cannot be copied
+        HostBufferPool(const HostBufferPool&);
+        HostBufferPool& operator=(const HostBufferPool&);
+    };
+
+//! STL allocator that takes its memory from a HostBufferPool
+template<class T>
+class PooledAllocator
+    {
+    public:
+        typedef T value_type;
+
+        //! Constructor
+        /*! \param pool Pool to allocate from
+        */
+        PooledAllocator(HostBufferPool *pool)
+            : m_pool(pool)
+            { }
+
+        //! Converting constructor for allocator rebinding
+        template<class U>
+        PooledAllocator(const PooledAllocator<U>& other)
+            : m_pool(other.getPool())
+            { }
+
+        //! Allocate storage for \a n elements
+        T *allocate(size_t n)
+            {
+            return (T *)m_pool->allocate(n*sizeof(T));
+            }
+
+        //! Free storage for \a n elements
+        void deallocate(T *ptr, size_t n)
+            {
+            m_pool->deallocate(ptr, n*sizeof(T));
+            }
+
+        //! Get the pool
+        HostBufferPool *getPool() const
+            {
+            return m_pool;
+            }
+
+    private:
+        HostBufferPool *m_pool;     //!< The pool to allocate from
+    };
+
+//! Allocators compare equal when they use the same pool
+template<class T, class U>
+bool operator==(const PooledAllocator<T>& a, const PooledAllocator<U>& b)
+    {
+    return a.getPool() == b.getPool();
+    }
+
+//! Allocators compare equal when they use the same pool
+template<class T, class U>
+bool operator!=(const PooledAllocator<T>& a, const PooledAllocator<U>& b)
+    {
+    return a.getPool() != b.getPool();
+    }
+
+//! std::vector that takes its memory from a HostBufferPool
+/*! Construct it with the pool, e.g. pooled_vector<MPI_Request> reqs(exec_conf->getHostBufferPool());
+*/
+template<class T>
+using pooled_vector = std::vector<T, PooledAllocator<T> >;
+
+#endif // __HOST_BUFFER_POOL_H__
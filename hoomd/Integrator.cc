@@ -20,6 +20,12 @@ namespace py = pybind11;
 #include "Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
+#include <memory>
+
 using namespace std;
 
 /*! \param sysdef System to update
@@ -38,7 +44,10 @@ Integrator::~Integrator()
     if (m_request_flags_connected && m_comm)
         m_comm->getCommFlagsRequestSignal().disconnect<Integrator, &Integrator::determineFlags>(this);
     if (m_signals_connected && m_comm)
+        {
         m_comm->getComputeCallbackSignal().disconnect<Integrator, &Integrator::computeCallback>(this);
+        m_comm->getInteriorComputeCallbackSignal().disconnect<Integrator, &Integrator::interiorComputeCallback>(this);
+        }
     #endif
     }
 
@@ -290,6 +299,114 @@ Scalar Integrator::computeTotalMomentum(unsigned int timestep)
     return Scalar(p_tot);
     }
 
+/*! \param forces Force computes to sum
+    \param accumulate If true, add to the current net force, torque and virial, otherwise overwrite them
+
+    All force computes are summed in a single pass over the particles, so that each net array element is read and
+    written once. Particles are independent, so the pass is split into ranges over the available threads. Every
+    particle sums the force computes in the order of the list, so the result does not depend on the number of
+    threads.
+*/
+void Integrator::sumNetForce(const std::vector<ForceCompute *>& forces, bool accumulate)
+    {
+    const GPUArray<Scalar4>& net_force  = m_pdata->getNetForce();
+    const GPUArray<Scalar>&  net_virial = m_pdata->getNetVirial();
+    const GPUArray<Scalar4>& net_torque = m_pdata->getNetTorqueArray();
+
+    const access_mode::Enum mode = accumulate ? access_mode::readwrite : access_mode::overwrite;
+    ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, mode);
+    ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, mode);
+    ArrayHandle<Scalar4> h_net_torque(net_torque, access_location::host, mode);
+
+    unsigned int nparticles = m_pdata->getN();
+    unsigned int net_virial_pitch = net_virial.getPitch();
+    assert(nparticles <= net_force.getNumElements());
+    assert(6*nparticles <= net_virial.getNumElements());
+    assert(nparticles <= net_torque.getNumElements());
+
+    // acquire the arrays of all force computes up front
+    const unsigned int nforces = forces.size();
+    std::vector< std::unique_ptr< ArrayHandle<Scalar4> > > h_force(nforces);
+    std::vector< std::unique_ptr< ArrayHandle<Scalar> > > h_virial(nforces);
+    std::vector< std::unique_ptr< ArrayHandle<Scalar4> > > h_torque(nforces);
+    std::vector<unsigned int> virial_pitch(nforces);
+
+    for (unsigned int i = 0; i < nforces; ++i)
+        {
+        h_force[i].reset(new ArrayHandle<Scalar4>(forces[i]->getForceArray(), access_location::host, access_mode::read));
+        h_virial[i].reset(new ArrayHandle<Scalar>(forces[i]->getVirialArray(), access_location::host, access_mode::read));
+        h_torque[i].reset(new ArrayHandle<Scalar4>(forces[i]->getTorqueArray(), access_location::host, access_mode::read));
+        virial_pitch[i] = forces[i]->getVirialArray().getPitch();
+        }
+
+    auto sum_range = [&](unsigned int begin, unsigned int end)
+        {
+        for (unsigned int j = begin; j < end; j++)
+            {
+            Scalar4 f = make_scalar4(0.0, 0.0, 0.0, 0.0);
+            Scalar4 t = make_scalar4(0.0, 0.0, 0.0, 0.0);
+            Scalar v[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+            if (accumulate)
+                {
+                f = h_net_force.data[j];
+                t = h_net_torque.data[j];
+                for (unsigned int k = 0; k < 6; k++)
+                    v[k] = h_net_virial.data[k*net_virial_pitch+j];
+                }
+
+            for (unsigned int i = 0; i < nforces; i++)
+                {
+                const Scalar4 fi = h_force[i]->data[j];
+                f.x += fi.x;
+                f.y += fi.y;
+                f.z += fi.z;
+                f.w += fi.w;
+
+                const Scalar4 ti = h_torque[i]->data[j];
+                t.x += ti.x;
+                t.y += ti.y;
+                t.z += ti.z;
+                t.w += ti.w;
+
+                const Scalar *vi = h_virial[i]->data;
+                for (unsigned int k = 0; k < 6; k++)
+                    v[k] += vi[k*virial_pitch[i]+j];
+                }
+
+            h_net_force.data[j] = f;
+            h_net_torque.data[j] = t;
+            for (unsigned int k = 0; k < 6; k++)
+                h_net_virial.data[k*net_virial_pitch+j] = v[k];
+            }
+        };
+
+    if (m_exec_conf->getNumThreads() == 1)
+        {
+        sum_range(0, nparticles);
+        }
+    #ifdef ENABLE_TBB
+    else
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, nparticles),
+            [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                sum_range(r.begin(), r.end());
+                });
+        }
+    #endif
+
+    if (! accumulate)
+        {
+        // zero the remainder of the arrays (ghost particles and padding)
+        memset((void *)(h_net_force.data + nparticles), 0, sizeof(Scalar4)*(net_force.getNumElements()-nparticles));
+        memset((void *)(h_net_torque.data + nparticles), 0, sizeof(Scalar4)*(net_torque.getNumElements()-nparticles));
+        for (unsigned int k = 0; k < 6; k++)
+            memset((void *)(h_net_virial.data + k*net_virial_pitch + nparticles), 0,
+                sizeof(Scalar)*(net_virial_pitch-nparticles));
+        }
+    }
+
 /*! \param timestep Current time step of the simulation
     \post All added force computes in \a m_forces are computed and totaled up in \a m_net_force and \a m_net_virial
     \note The summation step is performed <b>on the CPU</b> and will result in a lot of data traffic back and forth
@@ -307,70 +424,23 @@ void Integrator::computeNetForce(unsigned int timestep)
         m_prof->push("Net force");
         }
 
-    Scalar external_virial[6];
-    Scalar external_energy;
-        {
-        // access the net force and virial arrays
-        const GPUArray<Scalar4>& net_force  = m_pdata->getNetForce();
-        const GPUArray<Scalar>&  net_virial = m_pdata->getNetVirial();
-        const GPUArray<Scalar4>& net_torque = m_pdata->getNetTorqueArray();
-        ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar4> h_net_torque(net_torque, access_location::host, access_mode::overwrite);
-
-        // start by zeroing the net force and virial arrays
-        memset((void *)h_net_force.data, 0, sizeof(Scalar4)*net_force.getNumElements());
-        memset((void *)h_net_virial.data, 0, sizeof(Scalar)*net_virial.getNumElements());
-        memset((void *)h_net_torque.data, 0, sizeof(Scalar4)*net_torque.getNumElements());
-
-        for (unsigned int i = 0; i < 6; ++i)
-           external_virial[i] = Scalar(0.0);
-
-        external_energy = Scalar(0.0);
-
-        // now, add up the net forces
-        unsigned int nparticles = m_pdata->getN();
-        unsigned int net_virial_pitch = net_virial.getPitch();
-        assert(nparticles <= net_force.getNumElements());
-        assert(6*nparticles <= net_virial.getNumElements());
-        assert(nparticles <= net_torque.getNumElements());
-
-        for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-            {
-            //phasing out ForceDataArrays
-            //ForceDataArrays force_arrays = (*force_compute)->acquire();
-            GPUArray<Scalar4>& h_force_array = (*force_compute)->getForceArray();
-            GPUArray<Scalar>& h_virial_array = (*force_compute)->getVirialArray();
-            GPUArray<Scalar4>& h_torque_array = (*force_compute)->getTorqueArray();
-
-            ArrayHandle<Scalar4> h_force(h_force_array,access_location::host,access_mode::read);
-            ArrayHandle<Scalar> h_virial(h_virial_array,access_location::host,access_mode::read);
-            ArrayHandle<Scalar4> h_torque(h_torque_array,access_location::host,access_mode::read);
-
-            unsigned int virial_pitch = h_virial_array.getPitch();
-            for (unsigned int j = 0; j < nparticles; j++)
-                {
-                h_net_force.data[j].x += h_force.data[j].x;
-                h_net_force.data[j].y += h_force.data[j].y;
-                h_net_force.data[j].z += h_force.data[j].z;
-                h_net_force.data[j].w += h_force.data[j].w;
-
-                h_net_torque.data[j].x += h_torque.data[j].x;
-                h_net_torque.data[j].y += h_torque.data[j].y;
-                h_net_torque.data[j].z += h_torque.data[j].z;
-                h_net_torque.data[j].w += h_torque.data[j].w;
+    // add up the net forces
+    std::vector<ForceCompute *> forces;
+    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
+        forces.push_back(force_compute->get());
+    sumNetForce(forces, false);
 
-                for (unsigned int k = 0; k < 6; k++)
-                    {
-                    h_net_virial.data[k*net_virial_pitch+j] += h_virial.data[k*virial_pitch+j];
-                    }
-                }
+    Scalar external_virial[6];
+    for (unsigned int k = 0; k < 6; k++)
+        external_virial[k] = Scalar(0.0);
+    Scalar external_energy = Scalar(0.0);
 
-            for (unsigned int k = 0; k < 6; k++)
-                external_virial[k] += (*force_compute)->getExternalVirial(k);
+    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
+        {
+        for (unsigned int k = 0; k < 6; k++)
+            external_virial[k] += (*force_compute)->getExternalVirial(k);
 
-            external_energy += (*force_compute)->getExternalEnergy();
-            }
+        external_energy += (*force_compute)->getExternalEnergy();
         }
 
     for (unsigned int k = 0; k < 6; k++)
@@ -408,53 +478,18 @@ void Integrator::computeNetForce(unsigned int timestep)
         m_prof->push("Net force");
         }
 
-        {
-        // access the net force and virial arrays
-        const GPUArray< Scalar4 >& net_force = m_pdata->getNetForce();
-        const GPUArray< Scalar >& net_virial = m_pdata->getNetVirial();
-        const GPUArray<Scalar4>& net_torque = m_pdata->getNetTorqueArray();
-        ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::readwrite);
-        ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::readwrite);
-        ArrayHandle<Scalar4> h_net_torque(net_torque, access_location::host, access_mode::readwrite);
-        unsigned int net_virial_pitch = net_virial.getPitch();
-
-        // now, add up the net forces
-        unsigned int nparticles = m_pdata->getN();
-        assert(nparticles <= net_force.getNumElements());
-        assert(6*nparticles <= net_virial.getNumElements());
-        for (force_constraint = m_constraint_forces.begin(); force_constraint != m_constraint_forces.end(); ++force_constraint)
-            {
-            //phasing out ForceDataArrays
-            //ForceDataArrays force_arrays = (*force_compute)->acquire();
-            GPUArray<Scalar4>& h_force_array =(*force_constraint)->getForceArray();
-            GPUArray<Scalar>& h_virial_array =(*force_constraint)->getVirialArray();
-            GPUArray<Scalar4>& h_torque_array = (*force_constraint)->getTorqueArray();
-            ArrayHandle<Scalar4> h_force(h_force_array,access_location::host,access_mode::read);
-            ArrayHandle<Scalar> h_virial(h_virial_array,access_location::host,access_mode::read);
-            ArrayHandle<Scalar4> h_torque(h_torque_array,access_location::host,access_mode::read);
-            unsigned int virial_pitch = h_virial_array.getPitch();
-
-
-            for (unsigned int j = 0; j < nparticles; j++)
-                {
-                h_net_force.data[j].x += h_force.data[j].x;
-                h_net_force.data[j].y += h_force.data[j].y;
-                h_net_force.data[j].z += h_force.data[j].z;
-                h_net_force.data[j].w += h_force.data[j].w;
-
-                h_net_torque.data[j].x += h_torque.data[j].x;
-                h_net_torque.data[j].y += h_torque.data[j].y;
-                h_net_torque.data[j].z += h_torque.data[j].z;
-                h_net_torque.data[j].w += h_torque.data[j].w;
+    // add the constraint forces to the net forces
+    forces.clear();
+    for (force_constraint = m_constraint_forces.begin(); force_constraint != m_constraint_forces.end(); ++force_constraint)
+        forces.push_back(force_constraint->get());
+    sumNetForce(forces, true);
 
-                for (unsigned int k = 0; k < 6; k++)
-                    h_net_virial.data[k*net_virial_pitch+j] += h_virial.data[k*virial_pitch+j];
-                }
-            for (unsigned int k = 0; k < 6; k++)
-                external_virial[k] += (*force_constraint)->getExternalVirial(k);
+    for (force_constraint = m_constraint_forces.begin(); force_constraint != m_constraint_forces.end(); ++force_constraint)
+        {
+        for (unsigned int k = 0; k < 6; k++)
+            external_virial[k] += (*force_constraint)->getExternalVirial(k);
 
-            external_energy += (*force_constraint)->getExternalEnergy();
-            }
+        external_energy += (*force_constraint)->getExternalEnergy();
         }
 
     for (unsigned int k = 0; k < 6; k++)
@@ -874,7 +909,10 @@ void Integrator::setCommunicator(std::shared_ptr<Communicator> comm)
     m_request_flags_connected = true;
 
     if (! m_signals_connected && m_comm)
+        {
         comm->getComputeCallbackSignal().connect<Integrator, &Integrator::computeCallback>(this);
+        comm->getInteriorComputeCallbackSignal().connect<Integrator, &Integrator::interiorComputeCallback>(this);
+        }
 
     m_signals_connected = true;
     }
@@ -887,6 +925,15 @@ void Integrator::computeCallback(unsigned int timestep)
     for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
         (*force_compute)->preCompute(timestep);
     }
+
+void Integrator::interiorComputeCallback(unsigned int timestep)
+    {
+    // compute the forces that do not depend on ghost particles while the ghosts are updated
+    std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
+
+    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
+        (*force_compute)->computeInterior(timestep);
+    }
 #endif
 
 bool Integrator::getAnisotropic()
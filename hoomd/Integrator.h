@@ -130,6 +130,9 @@ class Integrator : public Updater
 
         //! Callback for pre-computing the forces
         void computeCallback(unsigned int timestep);
+
+        //! Callback for computing the interior forces during the ghost update
+        void interiorComputeCallback(unsigned int timestep);
         #endif
 
     protected:
@@ -144,6 +147,9 @@ class Integrator : public Updater
         //! helper function to compute net force/virial
         void computeNetForce(unsigned int timestep);
 
+        //! helper function to sum the forces, torques and virials of a list of force computes into the net arrays
+        void sumNetForce(const std::vector<ForceCompute *>& forces, bool accumulate);
+
 #ifdef ENABLE_CUDA
         //! helper function to compute net force/virial on the GPU
         void computeNetForceGPU(unsigned int timestep);
@@ -0,0 +1,407 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file LogBinary.cc
+    \brief Defines the LogBinary class
+*/
+
+#include "LogBinary.h"
+#include "Filesystem.h"
+
+#ifdef ENABLE_MPI
+#include "Communicator.h"
+#include "HOOMDMPI.h"
+#endif
+
+namespace py = pybind11;
+
+#include <stdexcept>
+#include <string.h>
+#include <stdint.h>
+using namespace std;
+
+//! Magic string at the start of every binary log file
+static const char log_binary_magic[8] = {'H','O','O','M','D','L','O','G'};
+
+//! Version of the binary log file format
+static const uint32_t log_binary_version = 1;
+
+/*! \param sysdef Specified for Logger, but not used directly by LogBinary
+    \param fname File name to write the log to
+    \param overwrite Will overwrite an exiting file if true (default is to append)
+    \param buffer_size Number of bytes to buffer before writing to the file
+*/
+LogBinary::LogBinary(std::shared_ptr<SystemDefinition> sysdef,
+                     const std::string& fname,
+                     bool overwrite,
+                     unsigned int buffer_size)
+    : Logger(sysdef), m_filename(fname), m_appending(!overwrite), m_buffer_size(buffer_size), m_file(NULL),
+      m_header_written(false), m_sources_valid(false)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing LogBinary: " << fname << " " << overwrite << " " << buffer_size
+                                << endl;
+
+    if (m_filename == string(""))
+        {
+        m_exec_conf->msg->error() << "analyze.log_binary: A file name is required" << endl;
+        throw runtime_error("Error initializing LogBinary");
+        }
+
+    // buffer at least one record
+    m_buffer.reserve(m_buffer_size/sizeof(double) + 1);
+    }
+
+LogBinary::~LogBinary()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying LogBinary" << endl;
+
+    if (m_file)
+        {
+        // write out what is left, errors cannot be reported any more at this point
+        if (!m_buffer.empty())
+            fwrite(&m_buffer[0], sizeof(double), m_buffer.size(), m_file);
+        fclose(m_file);
+        }
+    }
+
+bool LogBinary::isWriter()
+    {
+#ifdef ENABLE_MPI
+    // only output to file on root processor
+    if (m_pdata->getDomainDecomposition())
+        return m_exec_conf->isRoot();
+#endif
+    return true;
+    }
+
+void LogBinary::registerCompute(std::shared_ptr<Compute> compute)
+    {
+    Logger::registerCompute(compute);
+    m_sources_valid = false;
+    }
+
+void LogBinary::registerUpdater(std::shared_ptr<Updater> updater)
+    {
+    Logger::registerUpdater(updater);
+    m_sources_valid = false;
+    }
+
+void LogBinary::registerCallback(std::string name, py::object callback)
+    {
+    Logger::registerCallback(name, callback);
+    m_sources_valid = false;
+    }
+
+void LogBinary::removeAll()
+    {
+    Logger::removeAll();
+    m_sources_valid = false;
+    m_sources.clear();
+    }
+
+/*! \param quantities A list of quantities to log
+
+    The first call writes the header, or checks it when appending to an existing file. The quantities cannot be
+    changed after that, because the records in the file have a fixed width.
+*/
+void LogBinary::setLoggedQuantities(const std::vector< std::string >& quantities)
+    {
+    if (m_header_written)
+        {
+        if (quantities != m_logged_quantities)
+            {
+            m_exec_conf->msg->error() << "analyze.log_binary: The logged quantities cannot be changed "
+                                      << "after the file has been written to" << endl;
+            throw runtime_error("Error setting logged quantities");
+            }
+        return;
+        }
+
+    Logger::setLoggedQuantities(quantities);
+    m_sources_valid = false;
+
+    if (quantities.size() == 0)
+        m_exec_conf->msg->warning() << "analyze.log_binary: No quantities specified for logging" << endl;
+
+    m_columns.clear();
+    m_columns.push_back("timestep");
+    m_columns.insert(m_columns.end(), quantities.begin(), quantities.end());
+
+    // the root rank checks the header of an existing file, make sure all ranks fail together
+    bool success = true;
+    if (isWriter())
+        {
+        try
+            {
+            openOutputFile();
+            }
+        catch (std::runtime_error&)
+            {
+            success = false;
+            }
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        bcast(success, 0, m_exec_conf->getMPICommunicator());
+    #endif
+
+    if (!success)
+        {
+        if (m_file)
+            {
+            fclose(m_file);
+            m_file = NULL;
+            }
+        throw runtime_error("Error initializing LogBinary");
+        }
+
+    m_header_written = true;
+    }
+
+void LogBinary::openOutputFile()
+    {
+    if (filesystem::exists(m_filename) && m_appending)
+        {
+        m_exec_conf->msg->notice(3) << "analyze.log_binary: Appending log to existing file \"" << m_filename << "\""
+                                    << endl;
+        m_file = fopen(m_filename.c_str(), "r+b");
+        if (!m_file)
+            {
+            m_exec_conf->msg->error() << "analyze.log_binary: Error opening log file " << m_filename << endl;
+            throw runtime_error("Error initializing LogBinary");
+            }
+
+        // an empty file gets a new header
+        fseek(m_file, 0, SEEK_END);
+        if (ftell(m_file) > 0)
+            {
+            fseek(m_file, 0, SEEK_SET);
+            checkHeader();
+            fseek(m_file, 0, SEEK_END);
+            return;
+            }
+        }
+    else
+        {
+        m_exec_conf->msg->notice(3) << "analyze.log_binary: Creating new log in file \"" << m_filename << "\""
+                                    << endl;
+        m_file = fopen(m_filename.c_str(), "wb");
+        if (!m_file)
+            {
+            m_exec_conf->msg->error() << "analyze.log_binary: Error opening log file " << m_filename << endl;
+            throw runtime_error("Error initializing LogBinary");
+            }
+        }
+    m_appending = false;
+
+    // the column names, padded with zeros so that the records are 8 byte aligned
+    std::vector<char> names;
+    for (unsigned int i = 0; i < m_columns.size(); i++)
+        names.insert(names.end(), m_columns[i].c_str(), m_columns[i].c_str() + m_columns[i].size() + 1);
+    uint64_t data_offset = sizeof(log_binary_magic) + 2*sizeof(uint32_t) + sizeof(uint64_t) + names.size();
+    data_offset = (data_offset + 7) & ~uint64_t(7);
+    names.resize(data_offset - (sizeof(log_binary_magic) + 2*sizeof(uint32_t) + sizeof(uint64_t)), '\0');
+
+    uint32_t num_columns = m_columns.size();
+    fwrite(log_binary_magic, sizeof(log_binary_magic), 1, m_file);
+    fwrite(&log_binary_version, sizeof(uint32_t), 1, m_file);
+    fwrite(&num_columns, sizeof(uint32_t), 1, m_file);
+    fwrite(&data_offset, sizeof(uint64_t), 1, m_file);
+    fwrite(&names[0], 1, names.size(), m_file);
+    fflush(m_file);
+
+    if (ferror(m_file))
+        {
+        m_exec_conf->msg->error() << "analyze.log_binary: I/O error while writing log file" << endl;
+        throw runtime_error("Error writing log file");
+        }
+    }
+
+void LogBinary::checkHeader()
+    {
+    char magic[sizeof(log_binary_magic)];
+    uint32_t version = 0, num_columns = 0;
+    uint64_t data_offset = 0;
+
+    bool valid = fread(magic, sizeof(magic), 1, m_file) == 1
+                 && memcmp(magic, log_binary_magic, sizeof(magic)) == 0
+                 && fread(&version, sizeof(uint32_t), 1, m_file) == 1
+                 && version == log_binary_version
+                 && fread(&num_columns, sizeof(uint32_t), 1, m_file) == 1
+                 && fread(&data_offset, sizeof(uint64_t), 1, m_file) == 1
+                 && data_offset >= sizeof(magic) + 2*sizeof(uint32_t) + sizeof(uint64_t);
+
+    if (!valid)
+        {
+        m_exec_conf->msg->error() << "analyze.log_binary: " << m_filename << " is not a binary log file" << endl;
+        throw runtime_error("Error initializing LogBinary");
+        }
+
+    // read the column names
+    std::vector<char> names(data_offset - (sizeof(magic) + 2*sizeof(uint32_t) + sizeof(uint64_t)));
+    if (names.size() > 0 && fread(&names[0], 1, names.size(), m_file) != names.size())
+        {
+        m_exec_conf->msg->error() << "analyze.log_binary: " << m_filename << " is truncated" << endl;
+        throw runtime_error("Error initializing LogBinary");
+        }
+
+    // make sure the last name is terminated, even in a damaged file
+    names.push_back('\0');
+
+    std::vector<std::string> columns;
+    unsigned int pos = 0;
+    while (columns.size() < num_columns && pos < names.size())
+        {
+        columns.push_back(std::string(&names[pos]));
+        pos += columns.back().size() + 1;
+        }
+
+    if (columns != m_columns)
+        {
+        m_exec_conf->msg->error() << "analyze.log_binary: The logged quantities do not match the columns in "
+                                  << m_filename << ", specify overwrite=True to start a new file" << endl;
+        throw runtime_error("Error initializing LogBinary");
+        }
+
+    // the file must end on a record boundary
+    fseek(m_file, 0, SEEK_END);
+    uint64_t file_size = ftell(m_file);
+    if (file_size < data_offset || (file_size - data_offset) % (num_columns*sizeof(double)) != 0)
+        {
+        m_exec_conf->msg->error() << "analyze.log_binary: " << m_filename << " ends with an incomplete record"
+                                  << endl;
+        throw runtime_error("Error initializing LogBinary");
+        }
+    }
+
+/*! Looks up each logged quantity in the same order as Logger::getValue()
+*/
+void LogBinary::resolveSources()
+    {
+    m_sources.resize(m_logged_quantities.size());
+    for (unsigned int i = 0; i < m_logged_quantities.size(); i++)
+        {
+        const std::string& quantity = m_logged_quantities[i];
+        source& s = m_sources[i];
+        s.compute = NULL;
+        s.updater = NULL;
+        s.callback = NULL;
+
+        std::map< std::string, std::shared_ptr<Compute> >::iterator compute = m_compute_quantities.find(quantity);
+        std::map< std::string, std::shared_ptr<Updater> >::iterator updater = m_updater_quantities.find(quantity);
+        std::map< std::string, py::object >::iterator callback = m_callback_quantities.find(quantity);
+
+        if (quantity == "time")
+            {
+            s.kind = source_time;
+            }
+        else if (compute != m_compute_quantities.end())
+            {
+            s.kind = source_compute;
+            s.compute = compute->second.get();
+            }
+        else if (updater != m_updater_quantities.end())
+            {
+            s.kind = source_updater;
+            s.updater = updater->second.get();
+            }
+        else if (callback != m_callback_quantities.end())
+            {
+            s.kind = source_callback;
+            s.callback = &callback->second;
+            }
+        else
+            {
+            s.kind = source_none;
+            m_exec_conf->msg->warning() << "analyze.log_binary: Log quantity " << quantity
+                                        << " is not registered, logging a value of 0" << endl;
+            }
+        }
+
+    m_sources_valid = true;
+    }
+
+/*! \param i Index of the logged quantity
+    \param timestep Time step to compute value for (needed for Compute classes)
+*/
+Scalar LogBinary::getSourceValue(unsigned int i, unsigned int timestep)
+    {
+    const source& s = m_sources[i];
+    switch (s.kind)
+        {
+        case source_time:
+            return Scalar(double(m_clk.getTime())/1e9);
+        case source_compute:
+            s.compute->compute(timestep);
+            return s.compute->getLogValue(m_logged_quantities[i], timestep);
+        case source_updater:
+            return s.updater->getLogValue(m_logged_quantities[i], timestep);
+        case source_callback:
+            try
+                {
+                py::object rv = (*s.callback)(timestep);
+                return rv.cast<Scalar>();
+                }
+            catch (py::cast_error)
+                {
+                m_exec_conf->msg->warning() << "analyze.log_binary: Log callback " << m_logged_quantities[i]
+                                            << " returned invalid value, logging 0." << endl;
+                return Scalar(0.0);
+                }
+        default:
+            return Scalar(0.0);
+        }
+    }
+
+/*! \param timestep Time step to write out data for
+
+    Appends one record to the buffer, and writes the buffer to the file when it is full.
+*/
+void LogBinary::analyze(unsigned int timestep)
+    {
+    if (m_prof) m_prof->push("LogBinary");
+
+    if (!m_sources_valid)
+        resolveSources();
+
+    // update info in cache for later use and for immediate output
+    for (unsigned int i = 0; i < m_logged_quantities.size(); i++)
+        m_cached_quantities[i] = getSourceValue(i, timestep);
+    m_cached_timestep = timestep;
+
+    if (m_file)
+        {
+        m_buffer.push_back(double(timestep));
+        for (unsigned int i = 0; i < m_logged_quantities.size(); i++)
+            m_buffer.push_back(double(m_cached_quantities[i]));
+
+        if (m_buffer.size()*sizeof(double) >= m_buffer_size)
+            flush();
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
+void LogBinary::flush()
+    {
+    if (!m_file || m_buffer.empty())
+        return;
+
+    fwrite(&m_buffer[0], sizeof(double), m_buffer.size(), m_file);
+    fflush(m_file);
+    m_buffer.clear();
+
+    if (ferror(m_file))
+        {
+        m_exec_conf->msg->error() << "analyze.log_binary: I/O error while writing log file" << endl;
+        throw runtime_error("Error writing log file");
+        }
+    }
+
+void export_LogBinary(py::module& m)
+    {
+    py::class_<LogBinary, std::shared_ptr<LogBinary> >(m,"LogBinary", py::base<Logger>())
+    .def(py::init< std::shared_ptr<SystemDefinition>, const std::string&, bool, unsigned int >())
+    ;
+    }
@@ -0,0 +1,125 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file LogBinary.h
+    \brief Declares the LogBinary class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "Logger.h"
+
+#include <cstdio>
+
+#ifndef __LOGBINARY_H__
+#define __LOGBINARY_H__
+
+//! Logs registered quantities to a binary file of fixed width records
+/*! LogBinary is a high throughput alternative to LogPlainTXT. The source of each logged quantity is looked up once,
+    when the list of logged quantities or the set of registered computes, updaters and callbacks changes, instead of
+    once per quantity per call. Records are collected in a memory buffer that is written to the file in large blocks,
+    when it is full and at the end of every run.
+
+    The file is self describing and can be memory mapped without parsing:
+     - 8 bytes: the magic string "HOOMDLOG" (no terminating null)
+     - uint32: file format version (1)
+     - uint32: number of columns, including the time step
+     - uint64: offset of the first record from the start of the file, a multiple of 8
+     - the column names as null terminated strings, starting with "timestep"
+     - zero padding up to the first record
+     - the records, each with one float64 per column in native byte order
+
+    The time step is stored as a float64 too, so the records form a single 2D array.
+
+    When appending to an existing file, the logged quantities must match the columns in the file. The logged
+    quantities cannot be changed once the header has been written.
+
+    With MPI, all ranks evaluate the logged quantities and the root rank writes the file.
+
+    \ingroup analyzers
+*/
+class LogBinary : public Logger
+    {
+    public:
+        //! Constructs a logger
+        LogBinary(std::shared_ptr<SystemDefinition> sysdef,
+                  const std::string& fname,
+                  bool overwrite=false,
+                  unsigned int buffer_size=1048576);
+
+        //! Destructor
+        virtual ~LogBinary();
+
+        //! Registers a compute
+        virtual void registerCompute(std::shared_ptr<Compute> compute);
+
+        //! Registers an updater
+        virtual void registerUpdater(std::shared_ptr<Updater> updater);
+
+        //! Register a callback
+        virtual void registerCallback(std::string name, pybind11::object callback);
+
+        //! Clears all registered computes and updaters
+        virtual void removeAll();
+
+        //! Selects which quantities to log
+        virtual void setLoggedQuantities(const std::vector< std::string >& quantities);
+
+        //! Write out the data for the current timestep
+        virtual void analyze(unsigned int timestep);
+
+        //! Write the buffered records to the file
+        virtual void flush();
+
+    private:
+        //! Kinds of sources for logged quantities
+        enum source_kind
+            {
+            source_time = 0,
+            source_compute,
+            source_updater,
+            source_callback,
+            source_none
+            };
+
+        //! Resolved source of a logged quantity
+        struct source
+            {
+            source_kind kind;                   //!< Kind of source
+            Compute *compute;                   //!< Compute providing the quantity
+            Updater *updater;                   //!< Updater providing the quantity
+            pybind11::object *callback;         //!< Callback providing the quantity
+            };
+
+        std::string m_filename;                 //!< The output file name
+        bool m_appending;                       //!< True if an existing file is appended to
+        unsigned int m_buffer_size;             //!< Number of bytes to buffer before writing to the file
+        FILE *m_file;                           //!< The file we write out to
+        bool m_header_written;                  //!< True once the header has been written or checked
+        std::vector<std::string> m_columns;     //!< The columns in the file
+        std::vector<double> m_buffer;           //!< Records that have not been written yet
+        std::vector<source> m_sources;          //!< Resolved sources of the logged quantities
+        bool m_sources_valid;                   //!< False if m_sources needs to be rebuilt
+
+        //! Look up the source of each logged quantity
+        void resolveSources();
+
+        //! Get the value of a logged quantity from its source
+        Scalar getSourceValue(unsigned int i, unsigned int timestep);
+
+        //! Open the file and write or check the header
+        void openOutputFile();
+
+        //! Check that the logged quantities match the columns of an existing file
+        void checkHeader();
+
+        //! Returns true if this rank writes the file
+        bool isWriter();
+    };
+
+//! exports the LogBinary class to python
+void export_LogBinary(pybind11::module& m);
+
+#endif
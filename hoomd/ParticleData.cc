@@ -373,6 +373,40 @@ void ParticleData::allocate(unsigned int N)
     // allocate alternate particle data arrays (for swapping in-out)
     allocateAlternateArrays(N);
 
+    // account the host memory of the per-particle arrays by field, the alternate arrays share the names since they
+    // are swapped with the primary ones
+    m_pos.setName("pdata.pos");
+    m_pos_alt.setName("pdata.pos");
+    m_vel.setName("pdata.vel");
+    m_vel_alt.setName("pdata.vel");
+    m_accel.setName("pdata.accel");
+    m_accel_alt.setName("pdata.accel");
+    m_charge.setName("pdata.charge");
+    m_charge_alt.setName("pdata.charge");
+    m_diameter.setName("pdata.diameter");
+    m_diameter_alt.setName("pdata.diameter");
+    m_image.setName("pdata.image");
+    m_image_alt.setName("pdata.image");
+    m_tag.setName("pdata.tag");
+    m_tag_alt.setName("pdata.tag");
+    m_body.setName("pdata.body");
+    m_body_alt.setName("pdata.body");
+    m_orientation.setName("pdata.orientation");
+    m_orientation_alt.setName("pdata.orientation");
+    m_angmom.setName("pdata.angmom");
+    m_angmom_alt.setName("pdata.angmom");
+    m_inertia.setName("pdata.inertia");
+    m_inertia_alt.setName("pdata.inertia");
+    m_net_force.setName("pdata.net_force");
+    m_net_force_alt.setName("pdata.net_force");
+    m_net_virial.setName("pdata.net_virial");
+    m_net_virial_alt.setName("pdata.net_virial");
+    m_net_torque.setName("pdata.net_torque");
+    m_net_torque_alt.setName("pdata.net_torque");
+    #ifdef ENABLE_MPI
+    m_comm_flags.setName("pdata.comm_flags");
+    #endif
+
     // notify observers
     m_max_particle_num_signal.emit();
     }
@@ -680,11 +714,8 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
                 throw std::runtime_error("Error initializing ParticleData");
                 }
 
-            const Index3D& di = m_decomposition->getDomainIndexer();
             unsigned int n_ranks = m_exec_conf->getNRanks();
 
-            BoxDim global_box = m_global_box;
-
             // loop over particles in snapshot, place them into domains
             for (typename std::vector< vec3<Real> >::const_iterator it=snapshot.pos.begin(); it != snapshot.pos.end(); it++)
                 {
@@ -698,55 +729,13 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
 
                 // determine domain the particle is placed into
                 Scalar3 pos = vec_to_scalar3(*it);
-                Scalar3 f = m_global_box.makeFraction(pos);
-                int i= f.x * ((Scalar)di.getW());
-                int j= f.y * ((Scalar)di.getH());
-                int k= f.z * ((Scalar)di.getD());
-
-                // wrap particles that are exactly on a boundary
-                // we only need to wrap in the negative direction, since
-                // processor ids are rounded toward zero
-                char3 flags = make_char3(0,0,0);
-                if (i == (int) di.getW())
-                    {
-                    i = 0;
-                    flags.x = 1;
-                    }
-
-                if (j == (int) di.getH())
-                    {
-                    j = 0;
-                    flags.y = 1;
-                    }
-
-                if (k == (int) di.getD())
-                    {
-                    k = 0;
-                    flags.z = 1;
-                    }
-
                 int3 img = snapshot.image[snap_idx];
-
-                // only wrap if the particles is on one of the boundaries
-                uchar3 periodic = make_uchar3(flags.x,flags.y,flags.z);
-                global_box.setPeriodic(periodic);
-                global_box.wrap(pos, img, flags);
-
-                // place particle using actual domain fractions, not global box fraction
-                unsigned int rank = m_decomposition->placeParticle(m_global_box, pos);
+                unsigned int rank = placeSnapshotParticle(pos, img);
 
                 if (rank >= n_ranks)
                     {
                     m_exec_conf->msg->error() << "init.*: Particle " << snap_idx << " out of bounds." << std::endl;
-                    m_exec_conf->msg->error() << "Cartesian coordinates: " << std::endl;
-                    m_exec_conf->msg->error() << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
-                    m_exec_conf->msg->error() << "Fractional coordinates: " << std::endl;
-                    m_exec_conf->msg->error() << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
-                    Scalar3 lo = m_global_box.getLo();
-                    Scalar3 hi = m_global_box.getHi();
-                    m_exec_conf->msg->error() << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z << ")" << std::endl;
-                    m_exec_conf->msg->error() << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z << ")" << std::endl;
-
+                    printOutOfBoundsParticle(pos);
                     throw std::runtime_error("Error initializing from snapshot.");
                     }
 
@@ -971,6 +960,208 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
     m_num_types_signal.emit();
     }
 
+#ifdef ENABLE_MPI
+/*! \param pos Position of the particle, wrapped back into the box if it is exactly on a boundary
+    \param img Image flags of the particle, updated when the position is wrapped
+
+    \returns The rank whose domain the particle is placed into at initialization, or a value greater or equal to the
+             number of ranks if the particle is out of bounds
+*/
+unsigned int ParticleData::placeSnapshotParticle(Scalar3& pos, int3& img) const
+    {
+    assert(m_decomposition);
+    const Index3D& di = m_decomposition->getDomainIndexer();
+
+    Scalar3 f = m_global_box.makeFraction(pos);
+    int i= f.x * ((Scalar)di.getW());
+    int j= f.y * ((Scalar)di.getH());
+    int k= f.z * ((Scalar)di.getD());
+
+    // wrap particles that are exactly on a boundary
+    // we only need to wrap in the negative direction, since
+    // processor ids are rounded toward zero
+    char3 flags = make_char3(0,0,0);
+    if (i == (int) di.getW())
+        {
+        i = 0;
+        flags.x = 1;
+        }
+
+    if (j == (int) di.getH())
+        {
+        j = 0;
+        flags.y = 1;
+        }
+
+    if (k == (int) di.getD())
+        {
+        k = 0;
+        flags.z = 1;
+        }
+
+    // only wrap if the particles is on one of the boundaries
+    BoxDim global_box = m_global_box;
+    uchar3 periodic = make_uchar3(flags.x,flags.y,flags.z);
+    global_box.setPeriodic(periodic);
+    global_box.wrap(pos, img, flags);
+
+    // place particle using actual domain fractions, not global box fraction
+    return m_decomposition->placeParticle(m_global_box, pos);
+    }
+
+/*! \param pos Position of a particle that does not belong to any domain
+*/
+void ParticleData::printOutOfBoundsParticle(const Scalar3& pos) const
+    {
+    Scalar3 f = m_global_box.makeFraction(pos);
+    m_exec_conf->msg->error() << "Cartesian coordinates: " << std::endl;
+    m_exec_conf->msg->error() << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
+    m_exec_conf->msg->error() << "Fractional coordinates: " << std::endl;
+    m_exec_conf->msg->error() << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
+    Scalar3 lo = m_global_box.getLo();
+    Scalar3 hi = m_global_box.getHi();
+    m_exec_conf->msg->error() << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z << ")" << std::endl;
+    m_exec_conf->msg->error() << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z << ")" << std::endl;
+    }
+
+//! Initialize from the local part of a snapshot
+/*! \param snapshot The particles owned by this rank, with positions and images already wrapped by
+                    placeSnapshotParticle()
+    \param tags Global tags of the particles in \a snapshot
+    \param nglobal Global number of particles
+
+    Every rank passes its own particles, so no rank ever holds the full system. The tags of all ranks together
+    must be the numbers 0 to nglobal-1, and the type mapping must be the same on all ranks.
+
+    \pre The global box and the domain decomposition are set.
+*/
+template <class Real>
+void ParticleData::initializeFromLocalSnapshot(const SnapshotParticleData<Real>& snapshot,
+                                               const std::vector<unsigned int>& tags,
+                                               unsigned int nglobal)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: initializing from local snapshot" << std::endl;
+    assert(m_decomposition);
+
+    // remove all ghost particles
+    removeAllGhostParticles();
+
+    if (! snapshot.validate() || tags.size() != snapshot.size)
+        {
+        m_exec_conf->msg->error() << "init.*: invalid particle data snapshot."
+                                << std::endl << std::endl;
+        throw std::runtime_error("Error initializing particle data.");
+        }
+
+    if (snapshot.type_mapping.size() == 0)
+        {
+        m_exec_conf->msg->error() << "Number of particle types must be greater than 0." << endl;
+        throw std::runtime_error("Error initializing ParticleData");
+        }
+
+    // every particle must have been placed on exactly one rank
+    unsigned int nplaced = snapshot.size;
+    MPI_Allreduce(MPI_IN_PLACE, &nplaced, 1, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
+    if (nplaced != nglobal)
+        {
+        m_exec_conf->msg->error() << "init.*: " << nplaced << " of " << nglobal << " particles were placed on a rank."
+                                  << std::endl << std::endl;
+        throw std::runtime_error("Error initializing particle data.");
+        }
+
+    // clear set of active tags
+    m_tag_set.clear();
+
+    // clear reservoir of recycled tags
+    while (! m_recycled_tags.empty())
+        m_recycled_tags.pop();
+
+    m_type_mapping = snapshot.type_mapping;
+
+    // allocate array for reverse-lookup tags
+    GPUVector< unsigned int> rtag(nglobal, m_exec_conf);
+    m_rtag.swap(rtag);
+
+    m_nparticles = snapshot.size;
+
+        {
+        // reset all reverse lookup tags to NOT_LOCAL flag
+        ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::overwrite);
+        for (unsigned int tag = 0; tag < nglobal; tag++)
+            h_rtag.data[tag] = NOT_LOCAL;
+        }
+
+    // update list of active tags
+    for (unsigned int tag = 0; tag < nglobal; tag++)
+        {
+        m_tag_set.insert(tag);
+        }
+
+    // Now that active tag list has changed, invalidate the cache
+    m_invalid_cached_tags = true;
+
+    // we have to allocate even if the number of particles on a processor
+    // is zero, so that the arrays can be resized later
+    if (m_nparticles == 0)
+        allocate(1);
+    else
+        allocate(m_nparticles);
+
+        {
+        ArrayHandle< Scalar4 > h_pos(m_pos, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_vel(m_vel, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar3 > h_accel(m_accel, access_location::host, access_mode::overwrite);
+        ArrayHandle< int3 > h_image(m_image, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar > h_charge(m_charge, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar > h_diameter(m_diameter, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_body(m_body, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_orientation(m_orientation, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_angmom(m_angmom, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar3 > h_inertia(m_inertia, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_tag(m_tag, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_comm_flag(m_comm_flags, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+
+        for (unsigned int idx = 0; idx < m_nparticles; idx++)
+            {
+            h_pos.data[idx] = make_scalar4(snapshot.pos[idx].x,
+                                           snapshot.pos[idx].y,
+                                           snapshot.pos[idx].z,
+                                           __int_as_scalar(snapshot.type[idx]));
+            h_vel.data[idx] = make_scalar4(snapshot.vel[idx].x,
+                                           snapshot.vel[idx].y,
+                                           snapshot.vel[idx].z,
+                                           snapshot.mass[idx]);
+            h_accel.data[idx] = vec_to_scalar3(snapshot.accel[idx]);
+            h_charge.data[idx] = snapshot.charge[idx];
+            h_diameter.data[idx] = snapshot.diameter[idx];
+            h_image.data[idx] = snapshot.image[idx];
+            h_tag.data[idx] = tags[idx];
+            h_rtag.data[tags[idx]] = idx;
+            h_body.data[idx] = snapshot.body[idx];
+            h_orientation.data[idx] = quat_to_scalar4(snapshot.orientation[idx]);
+            h_angmom.data[idx] = quat_to_scalar4(snapshot.angmom[idx]);
+            h_inertia.data[idx] = vec_to_scalar3(snapshot.inertia[idx]);
+
+            h_comm_flag.data[idx] = 0; // initialize with zero
+            }
+        }
+
+    // set global number of particles
+    setNGlobal(nglobal);
+
+    // notify listeners about resorting of local particles
+    notifyParticleSort();
+
+    // zero the origin
+    m_origin = make_scalar3(0,0,0);
+    m_o_image = make_int3(0,0,0);
+
+    // notify listeners that number of types has changed
+    m_num_types_signal.emit();
+    }
+#endif
+
 //! take a particle data snapshot
 /* \param snapshot The snapshot to write to
    \returns a map to lookup the snapshot index from a particle tag
@@ -2252,6 +2443,15 @@ template ParticleData::ParticleData(const SnapshotParticleData<float>& snapshot,
 template void ParticleData::initializeFromSnapshot<float>(const SnapshotParticleData<float> & snapshot, bool ignore_bodies);
 template std::map<unsigned int, unsigned int> ParticleData::takeSnapshot<float>(SnapshotParticleData<float> &snapshot);
 
+#ifdef ENABLE_MPI
+template void ParticleData::initializeFromLocalSnapshot<float>(const SnapshotParticleData<float>& snapshot,
+                                                               const std::vector<unsigned int>& tags,
+                                                               unsigned int nglobal);
+template void ParticleData::initializeFromLocalSnapshot<double>(const SnapshotParticleData<double>& snapshot,
+                                                                const std::vector<unsigned int>& tags,
+                                                                unsigned int nglobal);
+#endif
+
 
 void export_ParticleData(py::module& m)
     {
@@ -874,6 +874,20 @@ class ParticleData
         template <class Real>
         void initializeFromSnapshot(const SnapshotParticleData<Real> & snapshot, bool ignore_bodies=false);
 
+        #ifdef ENABLE_MPI
+        //! Initialize from the particles of a snapshot that are owned by this rank
+        template <class Real>
+        void initializeFromLocalSnapshot(const SnapshotParticleData<Real>& snapshot,
+                                         const std::vector<unsigned int>& tags,
+                                         unsigned int nglobal);
+
+        //! Find the rank a snapshot particle is placed on at initialization
+        unsigned int placeSnapshotParticle(Scalar3& pos, int3& img) const;
+
+        //! Print the coordinates of a particle that could not be placed on any rank
+        void printOutOfBoundsParticle(const Scalar3& pos) const;
+        #endif
+
         //! Take a snapshot
         template <class Real>
         std::map<unsigned int, unsigned int> takeSnapshot(SnapshotParticleData<Real> &snapshot);
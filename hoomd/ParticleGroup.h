@@ -285,6 +285,17 @@ class ParticleGroup
             return m_member_idx;
             }
 
+        //! Direct access to the sorted list of member tags
+        /*! \returns A GPUArray of the getNumMembersGlobal() member tags in ascending order
+            \note The caller \b must \b not write to or change the array.
+        */
+        const GPUArray<unsigned int>& getMemberTagArray() const
+            {
+            checkRebuild();
+
+            return m_member_tags;
+            }
+
         // @}
         //! \name Analysis methods
         // @{
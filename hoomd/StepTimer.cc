@@ -0,0 +1,307 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "StepTimer.h"
+
+#include <hoomd/extern/pybind/include/pybind11/stl.h>
+
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace py = pybind11;
+
+using namespace std;
+
+/*! \file StepTimer.cc
+    \brief Contains code for the StepTimer class
+*/
+
+//! Quote a string for output in a JSON file
+static string json_string(const string& s)
+    {
+    string result = "\"";
+    for (string::const_iterator c = s.begin(); c != s.end(); ++c)
+        {
+        if (*c == '"' || *c == '\\')
+            result += '\\';
+        result += *c;
+        }
+    return result + "\"";
+    }
+
+/*! \param sysdef System definition
+    \param depth Number of steps to keep
+*/
+StepTimer::StepTimer(std::shared_ptr<SystemDefinition> sysdef, unsigned int depth)
+    : Compute(sysdef), m_in_step(false), m_sync_gpu(false), m_depth(0), m_next(0), m_num_records(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing StepTimer" << endl;
+    setDepth(depth);
+    }
+
+/*! \param name Name of the timer
+    \returns The slot to pass to start() and stop()
+
+    Registering a name that is already registered returns the existing slot, so that the time of all users of the
+    same name is added up.
+*/
+unsigned int StepTimer::registerTimer(const std::string& name)
+    {
+    map<string, unsigned int>::iterator it = m_slots.find(name);
+    if (it != m_slots.end())
+        return it->second;
+
+    unsigned int slot = m_names.size();
+    m_names.push_back(name);
+    m_slots[name] = slot;
+    m_start_time.push_back(0);
+    return slot;
+    }
+
+/*! \param slot Timer slot returned by registerTimer()
+*/
+void StepTimer::stop(unsigned int slot)
+    {
+    #ifdef ENABLE_CUDA
+    // include the GPU work queued by the timed code
+    if (m_sync_gpu && m_exec_conf->isCUDAEnabled())
+        cudaDeviceSynchronize();
+    #endif
+
+    int64_t t = m_clk.getTime();
+    if (!m_in_step)
+        return;
+
+    if (m_cur.elapsed.size() <= slot)
+        m_cur.elapsed.resize(m_names.size(), 0);
+
+    Event event;
+    event.slot = slot;
+    event.start = m_start_time[slot];
+    event.duration = t - m_start_time[slot];
+
+    m_cur.elapsed[slot] += event.duration;
+    m_cur.events.push_back(event);
+    }
+
+/*! \param timestep Current time step
+*/
+void StepTimer::beginStep(unsigned int timestep)
+    {
+    m_cur.timestep = timestep;
+    m_cur.start = m_clk.getTime();
+    m_cur.duration = 0;
+    m_cur.elapsed.assign(m_names.size(), 0);
+    m_cur.events.clear();
+    m_in_step = true;
+    }
+
+/*! The current step is stored in the ring buffer, replacing the oldest step when the buffer is full.
+*/
+void StepTimer::endStep()
+    {
+    if (!m_in_step)
+        return;
+
+    m_cur.duration = m_clk.getTime() - m_cur.start;
+    m_in_step = false;
+
+    // swap to reuse the memory of the replaced record
+    m_records[m_next].elapsed.swap(m_cur.elapsed);
+    m_records[m_next].events.swap(m_cur.events);
+    m_records[m_next].timestep = m_cur.timestep;
+    m_records[m_next].start = m_cur.start;
+    m_records[m_next].duration = m_cur.duration;
+
+    m_next = (m_next + 1) % m_depth;
+    if (m_num_records < m_depth)
+        m_num_records++;
+    }
+
+/*! \param depth Number of steps to keep
+
+    Changing the depth discards all stored steps.
+*/
+void StepTimer::setDepth(unsigned int depth)
+    {
+    if (depth == 0)
+        {
+        m_exec_conf->msg->error() << "timing: The number of steps to keep must be positive" << endl;
+        throw runtime_error("Error setting step timer depth");
+        }
+
+    m_depth = depth;
+    m_records.clear();
+    m_records.resize(m_depth);
+    m_next = 0;
+    m_num_records = 0;
+    }
+
+std::vector<unsigned int> StepTimer::getTimesteps() const
+    {
+    vector<unsigned int> timesteps(m_num_records);
+    for (unsigned int i = 0; i < m_num_records; i++)
+        timesteps[i] = getRecord(i).timestep;
+    return timesteps;
+    }
+
+/*! \param name Name of the timer
+    \returns The time in seconds spent in timer \a name in each stored step
+*/
+std::vector<double> StepTimer::getTimes(const std::string& name) const
+    {
+    map<string, unsigned int>::const_iterator it = m_slots.find(name);
+    if (it == m_slots.end())
+        {
+        m_exec_conf->msg->error() << "timing: " << name << " is not a timer" << endl;
+        throw runtime_error("Error getting timings");
+        }
+    unsigned int slot = it->second;
+
+    vector<double> times(m_num_records, 0.0);
+    for (unsigned int i = 0; i < m_num_records; i++)
+        {
+        const StepRecord& record = getRecord(i);
+        if (slot < record.elapsed.size())
+            times[i] = double(record.elapsed[slot]) * 1e-9;
+        }
+    return times;
+    }
+
+/*! \param fname File name to write
+
+    The file holds the list of timer names and, for every stored step, the time step, the duration of the step and
+    the time of each timer in seconds. Only the root rank writes the file.
+*/
+void StepTimer::writeJSON(const std::string& fname) const
+    {
+    if (m_exec_conf->getRank() != 0)
+        return;
+
+    ofstream f(fname.c_str());
+    if (!f.good())
+        {
+        m_exec_conf->msg->error() << "timing: Unable to open " << fname << " for writing" << endl;
+        throw runtime_error("Error writing timings");
+        }
+
+    f << setprecision(9);
+    f << "{\"timers\": [";
+    for (unsigned int slot = 0; slot < m_names.size(); slot++)
+        f << (slot ? ", " : "") << json_string(m_names[slot]);
+    f << "],\n \"steps\": [";
+
+    for (unsigned int i = 0; i < m_num_records; i++)
+        {
+        const StepRecord& record = getRecord(i);
+        f << (i ? ",\n  " : "\n  ");
+        f << "{\"timestep\": " << record.timestep << ", \"time\": " << double(record.duration)*1e-9 << ", \"timers\": {";
+        for (unsigned int slot = 0; slot < m_names.size(); slot++)
+            {
+            int64_t elapsed = slot < record.elapsed.size() ? record.elapsed[slot] : 0;
+            f << (slot ? ", " : "") << json_string(m_names[slot]) << ": " << double(elapsed)*1e-9;
+            }
+        f << "}}";
+        }
+    f << "]}\n";
+
+    if (!f.good())
+        {
+        m_exec_conf->msg->error() << "timing: Error writing " << fname << endl;
+        throw runtime_error("Error writing timings");
+        }
+    }
+
+/*! \param fname File name to write
+
+    Writes every stored step and every timed interval as a complete event in the Chrome trace event format, which
+    can be viewed with chrome://tracing or similar tools. Only the root rank writes the file.
+*/
+void StepTimer::writeTrace(const std::string& fname) const
+    {
+    if (m_exec_conf->getRank() != 0)
+        return;
+
+    ofstream f(fname.c_str());
+    if (!f.good())
+        {
+        m_exec_conf->msg->error() << "timing: Unable to open " << fname << " for writing" << endl;
+        throw runtime_error("Error writing timings");
+        }
+
+    // times in the trace format are in microseconds
+    f << fixed << setprecision(3);
+    f << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+
+    for (unsigned int i = 0; i < m_num_records; i++)
+        {
+        const StepRecord& record = getRecord(i);
+        f << (i ? ",\n  " : "\n  ");
+        f << "{\"name\": \"step\", \"ph\": \"X\", \"pid\": 0, \"tid\": 0, \"ts\": " << double(record.start)*1e-3
+          << ", \"dur\": " << double(record.duration)*1e-3 << ", \"args\": {\"timestep\": " << record.timestep << "}}";
+
+        for (vector<Event>::const_iterator event = record.events.begin(); event != record.events.end(); ++event)
+            {
+            f << ",\n  {\"name\": " << json_string(m_names[event->slot]) << ", \"ph\": \"X\", \"pid\": 0, \"tid\": 0"
+              << ", \"ts\": " << double(event->start)*1e-3 << ", \"dur\": " << double(event->duration)*1e-3
+              << ", \"args\": {\"timestep\": " << record.timestep << "}}";
+            }
+        }
+    f << "]}\n";
+
+    if (!f.good())
+        {
+        m_exec_conf->msg->error() << "timing: Error writing " << fname << endl;
+        throw runtime_error("Error writing timings");
+        }
+    }
+
+/*! Provides time_<name> for every registered timer
+*/
+std::vector< std::string > StepTimer::getProvidedLogQuantities()
+    {
+    vector<string> quantities;
+    for (unsigned int slot = 0; slot < m_names.size(); slot++)
+        quantities.push_back("time_" + m_names[slot]);
+    return quantities;
+    }
+
+/*! \param quantity Name of the log quantity to get
+    \param timestep Current time step of the simulation
+    \returns The time in seconds spent in the timer during the most recently completed step
+*/
+Scalar StepTimer::getLogValue(const std::string& quantity, unsigned int timestep)
+    {
+    map<string, unsigned int>::const_iterator it = m_slots.end();
+    if (quantity.compare(0, 5, "time_") == 0)
+        it = m_slots.find(quantity.substr(5));
+
+    if (it == m_slots.end())
+        {
+        m_exec_conf->msg->error() << "timing: " << quantity << " is not a valid log quantity" << endl;
+        throw runtime_error("Error getting log value");
+        }
+
+    if (m_num_records == 0)
+        return Scalar(0.0);
+
+    const StepRecord& record = getRecord(m_num_records-1);
+    if (it->second >= record.elapsed.size())
+        return Scalar(0.0);
+    return Scalar(double(record.elapsed[it->second]) * 1e-9);
+    }
+
+void export_StepTimer(py::module& m)
+    {
+    py::class_<StepTimer, std::shared_ptr<StepTimer> >(m,"StepTimer",py::base<Compute>())
+    .def(py::init< std::shared_ptr<SystemDefinition>, unsigned int >())
+    .def("setDepth", &StepTimer::setDepth)
+    .def("setSyncGPU", &StepTimer::setSyncGPU)
+    .def("getTimerNames", &StepTimer::getTimerNames)
+    .def("getTimesteps", &StepTimer::getTimesteps)
+    .def("getTimes", &StepTimer::getTimes)
+    .def("writeJSON", &StepTimer::writeJSON)
+    .def("writeTrace", &StepTimer::writeTrace)
+    ;
+    }
@@ -0,0 +1,157 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "Compute.h"
+#include "ClockSource.h"
+
+#include <string>
+#include <vector>
+#include <map>
+
+#ifndef __STEP_TIMER_H__
+#define __STEP_TIMER_H__
+
+/*! \file StepTimer.h
+    \brief Declares the StepTimer class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+//! Records the wall time spent in named parts of every time step
+/*! StepTimer keeps a set of named timers. Code that is to be timed registers a timer once with registerTimer()
+    and brackets the timed work with start() and stop() calls on the returned slot. System marks the beginning and
+    end of each time step with beginStep() and endStep(), and the time accumulated in each timer during the step
+    is stored in a ring buffer holding the most recent steps. Each start()/stop() pair is also kept as an event
+    so that the steps can be exported as a Chrome trace.
+
+    Unlike Profiler, StepTimer has a fixed, low cost per timed call and keeps per-step data, so it can be left
+    enabled in production runs. By default, it does not synchronize with the GPU, so the timers of GPU code measure
+    the time to queue the kernels and any work that waits for earlier kernels. setSyncGPU() makes every start() and
+    stop() wait for the GPU, which attributes the kernel time to the right timer but stalls the CPU/GPU overlap.
+
+    Timers nest and the time of an inner timer is also counted in every enclosing one. For example, the time of a
+    neighbor list build triggered by a pair force is included in both the neighbor list and the pair force timer,
+    so the sum of all timers can exceed the duration of the step.
+
+    The time of each timer in the most recently completed step is available to the Logger as the quantity
+    time_<name> in seconds.
+
+    A timer may not be started again before it is stopped. Time measured outside of a step (e.g. during
+    Integrator::prepRun()) is not recorded. All times are those measured on the local rank.
+
+    \ingroup utils
+*/
+class StepTimer : public Compute
+    {
+    public:
+        //! Constructs the timer
+        StepTimer(std::shared_ptr<SystemDefinition> sysdef, unsigned int depth);
+
+        //! Set whether start() and stop() wait for the GPU
+        /*! \param sync_gpu Set to true to synchronize with the GPU before reading the clock
+        */
+        void setSyncGPU(bool sync_gpu)
+            {
+            m_sync_gpu = sync_gpu;
+            }
+
+        //! Register a timer
+        unsigned int registerTimer(const std::string& name);
+
+        //! Start a timer
+        /*! \param slot Timer slot returned by registerTimer()
+        */
+        void start(unsigned int slot)
+            {
+            #ifdef ENABLE_CUDA
+            // wait for queued GPU work so that it is not counted in this timer
+            if (m_sync_gpu && m_exec_conf->isCUDAEnabled())
+                cudaDeviceSynchronize();
+            #endif
+            m_start_time[slot] = m_clk.getTime();
+            }
+
+        //! Stop a timer
+        void stop(unsigned int slot);
+
+        //! Mark the beginning of a time step
+        void beginStep(unsigned int timestep);
+
+        //! Mark the end of a time step
+        void endStep();
+
+        //! Set the number of steps to keep
+        void setDepth(unsigned int depth);
+
+        //! Get the names of all timers
+        std::vector<std::string> getTimerNames() const
+            {
+            return m_names;
+            }
+
+        //! Get the time steps stored in the buffer, oldest first
+        std::vector<unsigned int> getTimesteps() const;
+
+        //! Get the time of one timer in every stored step, oldest first
+        std::vector<double> getTimes(const std::string& name) const;
+
+        //! Write the stored steps to a JSON file
+        void writeJSON(const std::string& fname) const;
+
+        //! Write the stored steps to a file in the Chrome trace event format
+        void writeTrace(const std::string& fname) const;
+
+        //! Returns a list of log quantities this compute calculates
+        virtual std::vector< std::string > getProvidedLogQuantities();
+
+        //! Calculates the requested log value and returns it
+        virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
+
+    private:
+        //! A single start()/stop() interval
+        struct Event
+            {
+            unsigned int slot;      //!< Timer slot
+            int64_t start;          //!< Start time in ns
+            int64_t duration;       //!< Duration in ns
+            };
+
+        //! Timings of one time step
+        struct StepRecord
+            {
+            unsigned int timestep;          //!< Time step
+            int64_t start;                  //!< Start time of the step in ns
+            int64_t duration;               //!< Duration of the step in ns
+            std::vector<int64_t> elapsed;   //!< Accumulated time per timer slot in ns
+            std::vector<Event> events;      //!< All timed intervals in this step
+            };
+
+        ClockSource m_clk;                              //!< Clock for the timings
+        std::vector<std::string> m_names;               //!< Timer names by slot
+        std::map<std::string, unsigned int> m_slots;    //!< Timer slots by name
+        std::vector<int64_t> m_start_time;              //!< Last start time of each timer
+
+        StepRecord m_cur;               //!< Record of the current step
+        bool m_in_step;                 //!< True between beginStep() and endStep()
+        bool m_sync_gpu;                //!< True if start() and stop() synchronize with the GPU
+
+        std::vector<StepRecord> m_records;  //!< Ring buffer of completed steps
+        unsigned int m_depth;               //!< Maximum number of steps kept
+        unsigned int m_next;                //!< Index in m_records the next step is stored at
+        unsigned int m_num_records;         //!< Number of completed steps in m_records
+
+        //! Get the stored record with the given age (0 is the oldest)
+        const StepRecord& getRecord(unsigned int i) const
+            {
+            return m_records[(m_next + m_depth - m_num_records + i) % m_depth];
+            }
+    };
+
+//! Exports the StepTimer class to python
+void export_StepTimer(pybind11::module& m);
+
+#endif
@@ -33,9 +33,9 @@ PyObject* walltimeLimitExceptionTypeObj = 0;
     statistics are printed every 10 seconds.
 */
 System::System(std::shared_ptr<SystemDefinition> sysdef, unsigned int initial_tstep)
-        : m_sysdef(sysdef), m_start_tstep(initial_tstep), m_end_tstep(0), m_cur_tstep(initial_tstep), m_cur_tps(0),
-        m_med_tps(0), m_last_status_time(0), m_last_status_tstep(initial_tstep), m_quiet_run(false),
-        m_profile(false), m_stats_period(10)
+        : m_sysdef(sysdef), m_integrator_timer(0), m_start_tstep(initial_tstep), m_end_tstep(0),
+        m_cur_tstep(initial_tstep), m_cur_tps(0), m_med_tps(0), m_last_status_time(0),
+        m_last_status_tstep(initial_tstep), m_quiet_run(false), m_profile(false), m_stats_period(10)
     {
     // sanity check
     assert(m_sysdef);
@@ -416,6 +416,7 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
     int64_t initial_time = m_clk.getTime();
     m_last_status_time = initial_time;
     setupProfiling();
+    setupStepTimer();
 
     // preset the flags before the run loop so that any analyzers/updaters run on step 0 have the info they need
     // but set the flags before prepRun, as prepRun may remove some flags that it cannot generate on the first step
@@ -558,20 +559,28 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
             #endif
             }
 
+        if (m_step_timer) m_step_timer->beginStep(m_cur_tstep);
+
         // execute analyzers
-        vector<analyzer_item>::iterator analyzer;
-        for (analyzer =  m_analyzers.begin(); analyzer != m_analyzers.end(); ++analyzer)
+        for (unsigned int i = 0; i < m_analyzers.size(); i++)
             {
-            if (analyzer->shouldExecute(m_cur_tstep))
-                analyzer->m_analyzer->analyze(m_cur_tstep);
+            if (m_analyzers[i].shouldExecute(m_cur_tstep))
+                {
+                if (m_step_timer) m_step_timer->start(m_analyzer_timers[i]);
+                m_analyzers[i].m_analyzer->analyze(m_cur_tstep);
+                if (m_step_timer) m_step_timer->stop(m_analyzer_timers[i]);
+                }
             }
 
         // execute updaters
-        vector<updater_item>::iterator updater;
-        for (updater =  m_updaters.begin(); updater != m_updaters.end(); ++updater)
+        for (unsigned int i = 0; i < m_updaters.size(); i++)
             {
-            if (updater->shouldExecute(m_cur_tstep))
-                updater->m_updater->update(m_cur_tstep);
+            if (m_updaters[i].shouldExecute(m_cur_tstep))
+                {
+                if (m_step_timer) m_step_timer->start(m_updater_timers[i]);
+                m_updaters[i].m_updater->update(m_cur_tstep);
+                if (m_step_timer) m_step_timer->stop(m_updater_timers[i]);
+                }
             }
 
         // look ahead to the next time step and see which analyzers and updaters will be executed
@@ -580,7 +589,13 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
 
         // execute the integrator
         if (m_integrator)
+            {
+            if (m_step_timer) m_step_timer->start(m_integrator_timer);
             m_integrator->update(m_cur_tstep);
+            if (m_step_timer) m_step_timer->stop(m_integrator_timer);
+            }
+
+        if (m_step_timer) m_step_timer->endStep();
 
         // quit if cntrl-C was pressed
         if (g_sigint_recvd)
@@ -590,6 +605,10 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
             }
         }
 
+    // complete any output buffered by the analyzers
+    for (vector<analyzer_item>::iterator analyzer = m_analyzers.begin(); analyzer != m_analyzers.end(); ++analyzer)
+        analyzer->m_analyzer->flush();
+
     // generate a final status line
     generateStatusLine();
     m_last_status_tstep = m_cur_tstep;
@@ -636,11 +655,44 @@ void System::enableProfiler(bool enable)
     m_profile = enable;
     }
 
+/*! \param depth Number of steps to keep timings for. Set to 0 to disable step timing.
+
+    Step timing records the wall time spent in every analyzer, updater, and the integrator in each step. Computes that
+    time themselves (force computes, ComputeThermo, and NeighborList) and the Communicator phases are timed within
+    these. See StepTimer.
+*/
+void System::enableStepTimer(unsigned int depth)
+    {
+    if (depth == 0)
+        m_step_timer = std::shared_ptr<StepTimer>();
+    else if (m_step_timer)
+        m_step_timer->setDepth(depth);
+    else
+        m_step_timer = std::shared_ptr<StepTimer>(new StepTimer(m_sysdef, depth));
+    }
+
+/*! \param name Name of the Analyzer, Updater, or Compute
+    \param timer_name Name of its timer
+
+    The timer name defaults to \a name.
+*/
+void System::setTimerName(const std::string& name, const std::string& timer_name)
+    {
+    m_timer_names[name] = timer_name;
+    }
+
 /*! \param logger Logger to register computes and updaters with
     All computes and updaters registered with the system are also registerd with the logger.
 */
 void System::registerLogger(std::shared_ptr<Logger> logger)
     {
+    // register the step timer so that all timers are available
+    if (m_step_timer)
+        {
+        setupStepTimer();
+        logger->registerCompute(m_step_timer);
+        }
+
     // set the profiler on everything
     if (m_integrator)
         logger->registerUpdater(m_integrator);
@@ -735,6 +787,46 @@ void System::setupProfiling()
 #endif
     }
 
+void System::setupStepTimer()
+    {
+    m_analyzer_timers.resize(m_analyzers.size());
+    m_updater_timers.resize(m_updaters.size());
+
+    if (m_step_timer)
+        {
+        for (unsigned int i = 0; i < m_analyzers.size(); i++)
+            m_analyzer_timers[i] = m_step_timer->registerTimer(getTimerName(m_analyzers[i].m_name));
+
+        for (unsigned int i = 0; i < m_updaters.size(); i++)
+            m_updater_timers[i] = m_step_timer->registerTimer(getTimerName(m_updaters[i].m_name));
+
+        if (m_integrator)
+            m_integrator_timer = m_step_timer->registerTimer("integrator");
+        }
+
+    // computes time themselves
+    map< string, std::shared_ptr<Compute> >::iterator compute;
+    for (compute = m_computes.begin(); compute != m_computes.end(); ++compute)
+        compute->second->setStepTimer(m_step_timer, getTimerName(compute->first));
+
+#ifdef ENABLE_MPI
+    // communicator
+    if (m_comm)
+        m_comm->setStepTimer(m_step_timer);
+#endif
+    }
+
+/*! \param name Name of the Analyzer, Updater, or Compute
+    \returns The name of its timer
+*/
+std::string System::getTimerName(const std::string& name)
+    {
+    map<string, string>::iterator it = m_timer_names.find(name);
+    if (it != m_timer_names.end())
+        return it->second;
+    return name;
+    }
+
 void System::printStats()
     {
     m_exec_conf->msg->notice(1) << "---------" << endl;
@@ -900,6 +992,9 @@ void export_System(py::module& m)
     .def("setStatsPeriod", &System::setStatsPeriod)
     .def("setAutotunerParams", &System::setAutotunerParams)
     .def("enableProfiler", &System::enableProfiler)
+    .def("enableStepTimer", &System::enableStepTimer)
+    .def("getStepTimer", &System::getStepTimer)
+    .def("setTimerName", &System::setTimerName)
     .def("enableQuietRun", &System::enableQuietRun)
     .def("run", &System::run)
 
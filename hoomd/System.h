@@ -9,6 +9,7 @@
 #include "Compute.h"
 #include "Integrator.h"
 #include "Logger.h"
+#include "StepTimer.h"
 
 #include <string>
 #include <vector>
@@ -153,6 +154,18 @@ class System
             m_quiet_run = enable;
             }
 
+        //! Configures per-step timing of runs
+        void enableStepTimer(unsigned int depth);
+
+        //! Get the step timer
+        std::shared_ptr<StepTimer> getStepTimer()
+            {
+            return m_step_timer;
+            }
+
+        //! Set the timer name of an Analyzer, Updater, or Compute
+        void setTimerName(const std::string& name, const std::string& timer_name);
+
         //! Register logger
         void registerLogger(std::shared_ptr<Logger> logger);
 
@@ -401,6 +414,11 @@ class System
         std::shared_ptr<Integrator> m_integrator;     //!< Integrator that advances time in this System
         std::shared_ptr<SystemDefinition> m_sysdef;   //!< SystemDefinition for this System
         std::shared_ptr<Profiler> m_profiler;         //!< Profiler to profile runs
+        std::shared_ptr<StepTimer> m_step_timer;      //!< Timer recording the time of each step
+        std::map<std::string, std::string> m_timer_names;   //!< Timer names of analyzers, updaters, and computes
+        std::vector<unsigned int> m_analyzer_timers;  //!< Timer slot of each analyzer
+        std::vector<unsigned int> m_updater_timers;   //!< Timer slot of each updater
+        unsigned int m_integrator_timer;              //!< Timer slot of the integrator
 
 #ifdef ENABLE_MPI
         std::shared_ptr<Communicator> m_comm;         //!< Communicator to use
@@ -424,6 +442,12 @@ class System
         //! Sets up m_profiler and attaches/detaches to/from all computes, updaters, and analyzers
         void setupProfiling();
 
+        //! Registers all computes, updaters, and analyzers with m_step_timer
+        void setupStepTimer();
+
+        //! Get the timer name for an Analyzer, Updater, or Compute
+        std::string getTimerName(const std::string& name);
+
         //! Prints detailed statistics for all attached computes, updaters, and integrators
         void printStats();
 
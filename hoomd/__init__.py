@@ -58,6 +58,7 @@ from hoomd import group
 from hoomd import init
 from hoomd import integrate
 from hoomd import option
+from hoomd import timing
 from hoomd import update
 from hoomd import util
 from hoomd import variant
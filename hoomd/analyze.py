@@ -43,6 +43,7 @@ class _analyzer(hoomd.meta._metadata):
 
         self.analyzer_name = "analyzer%d" % (id);
         self.enabled = True;
+        hoomd.timing._set_timer_name(self.analyzer_name, self);
 
         # Store a reference in global simulation variables
         hoomd.context.current.analyzers.append(self)
@@ -549,6 +550,123 @@ class log(_analyzer):
 
         hoomd.context.current.loggers.append(self)
 
+class log_binary(log):
+    R""" Log a number of calculated quantities to a binary file.
+
+    Args:
+        filename (str): File to write the log to.
+        quantities (list): List of quantities to log.
+        period (int): Quantities are logged every *period* time steps.
+        overwrite (bool): When False (the default) an existing log will be appended to. When True, an existing log file will be overwritten instead.
+        buffer_size (int): Number of bytes to buffer in memory before writing to the file.
+        phase (int): When -1, start on the current time step. When >= 0, execute on steps where *(step + phase) % period == 0*.
+
+    :py:class:`hoomd.analyze.log_binary` logs the same quantities as :py:class:`hoomd.analyze.log`, but writes them
+    as fixed width binary records. The source of each quantity is looked up once per run instead of every time it
+    is logged, and the records are buffered in memory and written in large blocks, at the latest at the end of every
+    :py:func:`hoomd.run()`. Use it instead of :py:class:`hoomd.analyze.log` when logging many quantities frequently.
+
+    The file starts with the magic string ``HOOMDLOG``, a uint32 format version, the uint32 number of columns, the
+    uint64 offset of the first record, and the null terminated column names. The first column is the time step.
+    Every record holds one float64 per column, so the data can be memory mapped as a 2D array without parsing.
+    :py:func:`read_log_binary()` does exactly that.
+
+    The logged quantities cannot be changed once the file has been written to. When appending to an existing file,
+    *quantities* must match the columns in the file.
+
+    Examples::
+
+        logger = analyze.log_binary(filename='log.bin', period=10,
+                                    quantities=['potential_energy', 'temperature', 'pressure'])
+
+        names, data = analyze.read_log_binary('log.bin')
+        T = data[:, names.index('temperature')]
+    """
+
+    def __init__(self, filename, quantities, period, overwrite=False, buffer_size=1048576, phase=0):
+        hoomd.util.print_status_line();
+
+        # initialize base class
+        _analyzer.__init__(self);
+
+        # create the c++ mirror class
+        self.cpp_analyzer = _hoomd.LogBinary(hoomd.context.current.system_definition, filename, overwrite, int(buffer_size));
+
+        # set the logged quantities first, this checks the columns of an existing file
+        quantity_list = _hoomd.std_vector_string();
+        for item in quantities:
+            quantity_list.append(str(item));
+        self.cpp_analyzer.setLoggedQuantities(quantity_list);
+
+        self.setupAnalyzer(period, phase);
+
+        # add the logger to the list of loggers
+        hoomd.context.current.loggers.append(self);
+
+        # store metadata
+        self.metadata_fields = ['filename','period']
+        self.filename = filename
+        self.period = period
+
+    def set_params(self, quantities=None):
+        R""" Change the parameters of the log.
+
+        Args:
+            quantities (list): New list of quantities to log (if specified)
+
+        The quantities can only be set to the ones already logged, because the records in the file have a fixed
+        width.
+        """
+
+        hoomd.util.print_status_line();
+
+        if quantities is not None:
+            quantity_list = _hoomd.std_vector_string();
+            for item in quantities:
+                quantity_list.append(str(item));
+            self.cpp_analyzer.setLoggedQuantities(quantity_list);
+
+def read_log_binary(filename):
+    R""" Read a file written by :py:class:`hoomd.analyze.log_binary`.
+
+    Args:
+        filename (str): File to read.
+
+    Returns:
+        A tuple of the list of column names and a read only 2D :py:class:`numpy.memmap` with one row per record.
+
+    Only the records that have been written to the file are available. Records still buffered by an active
+    :py:class:`hoomd.analyze.log_binary` are written at the end of every :py:func:`hoomd.run()`.
+
+    Examples::
+
+        names, data = analyze.read_log_binary('log.bin')
+        timesteps = data[:, 0]
+        U = data[:, names.index('potential_energy')]
+    """
+
+    with open(filename, 'rb') as f:
+        header = f.read(24);
+        if len(header) < 24 or header[0:8] != b'HOOMDLOG':
+            raise RuntimeError('{0} is not a binary log file'.format(filename));
+
+        version, num_columns, data_offset = numpy.frombuffer(header[8:24], dtype=numpy.dtype('u4,u4,u8'))[0];
+        if version != 1:
+            raise RuntimeError('Unsupported binary log file version {0}'.format(version));
+
+        names = f.read(int(data_offset) - 24).split(b'\0')[0:num_columns];
+        names = [n.decode('utf-8') for n in names];
+
+        f.seek(0, 2);
+        num_records = (f.tell() - int(data_offset)) // (8*int(num_columns));
+
+    if num_records == 0:
+        return names, numpy.zeros(shape=(0, num_columns), dtype=numpy.float64);
+
+    data = numpy.memmap(filename, dtype=numpy.float64, mode='r', offset=int(data_offset),
+                        shape=(num_records, int(num_columns)));
+    return names, data;
+
 class callback(_analyzer):
     R""" Callback analyzer.
 
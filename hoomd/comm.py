@@ -82,6 +82,73 @@ def barrier():
     if _hoomd.is_MPI_available():
         hoomd.context.exec_conf.barrier()
 
+def set_overlap(enable=True):
+    """ Overlap the ghost particle updates with the computation of the pair forces.
+
+    Args:
+        enable (bool): Set to True to enable the overlap, False to disable it.
+
+    In MPI simulations, the positions of the ghost particles are sent to the neighboring ranks in every time step.
+    With the overlap enabled, the pair forces on all particles that have no ghost particles within the neighbor list
+    cutoff are computed while the ghost positions are in transit. Only the forces on the particles near the domain
+    boundary are computed after the ghost update has completed.
+
+    The overlap reduces the time spent waiting for communication when the domains are large compared to the ghost
+    layer. It is disabled by default.
+
+    Note:
+        Does nothing in non-MPI builds and in simulations on a single rank. The overlap is only implemented on the
+        CPU and is not used on ranks that hold rigid bodies.
+
+    Example::
+
+        comm.set_overlap()
+
+    """
+    hoomd.util.print_status_line();
+
+    if not hoomd.init.is_initialized():
+        hoomd.context.msg.error("Cannot set the communication overlap before initialization\n");
+        raise RuntimeError('Error setting communication overlap');
+
+    if hoomd.context.current.communicator is not None:
+        hoomd.context.current.communicator.setGhostUpdateOverlap(enable);
+
+def set_ghost_exchange(neighbors=26):
+    """ Set the communication pattern of the ghost particle exchange.
+
+    Args:
+        neighbors (int): Set to 26 to exchange ghosts with all neighboring ranks at once, or to 6 to exchange them
+                         along one direction after the other.
+
+    By default, ghost particles are exchanged in six consecutive stages, one per direction. Ghosts near an edge
+    or a corner of the domain are forwarded through two or three stages to reach the diagonal neighbors. With
+    *neighbors=26*, every rank sends its ghosts directly to all of its (up to 26) neighbors in a single stage, so
+    that only one message round is needed per ghost update. This reduces the communication latency when the domains
+    are small.
+
+    Note:
+        Does nothing in non-MPI builds and in simulations on a single rank. The single-stage exchange is only
+        implemented on the CPU. Particle migration always uses six stages.
+
+    Example::
+
+        comm.set_ghost_exchange(neighbors=26)
+
+    """
+    hoomd.util.print_status_line();
+
+    if not hoomd.init.is_initialized():
+        hoomd.context.msg.error("Cannot set the ghost exchange before initialization\n");
+        raise RuntimeError('Error setting ghost exchange');
+
+    if neighbors not in (6, 26):
+        hoomd.context.msg.error("comm.set_ghost_exchange: neighbors must be 6 or 26\n");
+        raise RuntimeError('Error setting ghost exchange');
+
+    if hoomd.context.current.communicator is not None:
+        hoomd.context.current.communicator.setGhostExchangeAllNeighbors(neighbors == 26);
+
 class decomposition(object):
     """ Set the domain decomposition.
 
@@ -42,6 +42,7 @@ class _compute:
 
         self.compute_name = "compute%d" % (id);
         self.enabled = True;
+        hoomd.timing._set_timer_name(self.compute_name, self);
 
     ## \var enabled
     # \internal
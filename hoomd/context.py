@@ -118,6 +118,9 @@ class SimulationContext(object):
         ## Global variable that holds the balanced domain decomposition in MPI runs if it is requested
         self.decomposition = None
 
+        ## Global variable that holds the Communicator in MPI runs
+        self.communicator = None
+
         ## Global variable that holds the sorter
         self.sorter = None;
 
@@ -283,6 +286,13 @@ def _create_exec_conf():
     if options.gpu_error_checking:
        exec_conf.setCUDAErrorChecking(True);
 
+    # limit the number of CPU threads if requested
+    if options.nthreads is not None:
+        exec_conf.setNumThreads(options.nthreads);
+
+    # set the host memory allocation policy
+    hoomd.option._apply_host_alloc(exec_conf, options.huge_pages, options.first_touch);
+
     exec_conf = exec_conf;
 
     return exec_conf;
@@ -502,6 +502,8 @@ class gsd(hoomd.analyze._analyzer):
         phase (int): When -1, start on the current time step. When >= 0, execute on steps where *(step + phase) % period == 0*.
         time_step (int): Time step to write to the file (only used when period is None)
         static (list): A list of quantity categories that are static.
+        distributed (bool): When True, each MPI rank writes its own particles directly to the file.
+        queue_depth (int): When larger than 0, write frames in a background thread with at most this many frames pending.
 
     Write a simulation snapshot to the specified GSD file at regular intervals.
     GSD is capable of storing all particle and bond data fields that hoomd stores,
@@ -559,6 +561,20 @@ class gsd(hoomd.analyze._analyzer):
     To write restart files with gsd, set `truncate=True`. This will cause :py:class:`gsd` to write a new frame 0
     to the file every period steps.
 
+    In MPI simulations, :py:class:`gsd` normally gathers all particles to the root rank before writing. Set
+    *distributed* to True to have every rank write its own particles into the file with collective MPI-IO instead.
+    This avoids the gather and the memory it needs on the root rank, and produces a file identical to one written
+    without *distributed*. Use it on large systems with a parallel file system. Topology is still gathered
+    to the root rank. *distributed* has no effect in single rank simulations.
+
+    By default, :py:class:`gsd` writes each frame before the simulation continues. Set *queue_depth* to a value
+    larger than 0 to copy each frame into a staging buffer and write it in a background thread while the simulation
+    continues. At most *queue_depth* frames are pending at any time, when the queue is full the simulation waits for
+    the oldest frame to be written. A *queue_depth* of 1 or 2 is sufficient to hide the write time in most cases,
+    larger values help on file systems with occasional long stalls. Each pending frame holds a copy of the frame data
+    in memory. All pending frames are written at the end of every :py:func:`hoomd.run()`, and on calls to
+    :py:meth:`flush` and :py:meth:`write_restart`. *queue_depth* has no effect when *distributed* is True.
+
     :py:class:`gsd` writes static quantities from frame 0 only. Even if they change, it will not write them to subsequent
     frames. Quantity categories **not** listed in *static* are dynamic. :py:class:`gsd` writes dynamic quantities to every frame.
     The default is only to write particle properties (position, orientation) on each frame, and hold all others fixed.
@@ -572,6 +588,8 @@ class gsd(hoomd.analyze._analyzer):
         dump.gsd(filename="restart.gsd", truncate=True, period=10000, group=group.all(), phase=0)
         dump.gsd(filename="configuration.gsd", overwrite=True, period=None, group=group.all(), time_step=0)
         dump.gsd(filename="saveall.gsd", overwrite=True, period=1000, group=group.all(), static=[])
+        dump.gsd(filename="large.gsd", period=1000, group=group.all(), distributed=True)
+        dump.gsd(filename="trajectory.gsd", period=100, group=group.all(), queue_depth=2)
 
     """
     def __init__(self,
@@ -582,7 +600,9 @@ class gsd(hoomd.analyze._analyzer):
                  truncate=False,
                  phase=0,
                  time_step=None,
-                 static=['attribute', 'momentum', 'topology']):
+                 static=['attribute', 'momentum', 'topology'],
+                 distributed=False,
+                 queue_depth=0):
         hoomd.util.print_status_line();
 
         for v in static:
@@ -598,6 +618,8 @@ class gsd(hoomd.analyze._analyzer):
         self.cpp_analyzer.setWriteProperty('property' not in static);
         self.cpp_analyzer.setWriteMomentum('momentum' not in static);
         self.cpp_analyzer.setWriteTopology('topology' not in static);
+        self.cpp_analyzer.setDistributed(distributed);
+        self.cpp_analyzer.setQueueDepth(int(queue_depth));
 
         if period is not None:
             self.setupAnalyzer(period, phase);
@@ -605,6 +627,7 @@ class gsd(hoomd.analyze._analyzer):
             if time_step is None:
                 time_step = hoomd.context.current.system.getCurrentTimeStep()
             self.cpp_analyzer.analyze(time_step);
+            self.cpp_analyzer.flush();
 
         # store metadata
         self.filename = filename
@@ -623,3 +646,13 @@ class gsd(hoomd.analyze._analyzer):
 
         time_step = hoomd.context.current.system.getCurrentTimeStep()
         self.cpp_analyzer.analyze(time_step);
+        self.cpp_analyzer.flush();
+
+    def flush(self):
+        """ Write all pending frames to the file.
+
+        When *queue_depth* is larger than 0, call :py:meth:`flush` to make sure that the file is complete before
+        reading it. :py:func:`hoomd.run()` flushes at the end of every run.
+        """
+
+        self.cpp_analyzer.flush();
@@ -2,7 +2,10 @@ find_package(MKL)
 find_package(ACML)
 
 option(ENABLE_HOST "CPU FFT support" ON)
-if (MKL_LIBRARIES)
+if (ENABLE_FFTW)
+    # FFTW is found and linked by hoomd
+    set(LOCAL_FFT_LIB LOCAL_LIB_FFTW)
+elseif (MKL_LIBRARIES)
     set(LOCAL_FFT_LIB LOCAL_LIB_MKL)
     set(LOCAL_FFT_LIBRARIES "${MKL_LIBRARIES}")
     include_directories(${MKL_INCLUDE_DIR})
@@ -11,6 +11,10 @@
 /* MKL, single precision is the default library*/
 #include "mkl_single_interface.h"
 
+#elif (LOCAL_FFT_LIB == LOCAL_LIB_FFTW)
+/* FFTW, single precision */
+#include "fftw_single_interface.h"
+
 #elif (LOCAL_FFT_LIB == LOCAL_LIB_ACML)
 /* ACML, single precision */
 #include "acml_single_interface.h"
@@ -0,0 +1,85 @@
+/* FFTW (single precision) backend for distributed FFT, implementation
+ */
+
+#include "fftw_single_interface.h"
+
+/* Initialize the library
+ */
+int dfft_init_local_fft()
+    {
+    return 0;
+    }
+
+/* De-initialize the library
+ *
+ * FFTW is shared with the rest of the application, do not call fftwf_cleanup() here
+ */
+void dfft_teardown_local_fft()
+    {
+    }
+
+/* Create a FFTW plan
+ *
+ * sign = 0 (forward) or 1 (inverse)
+ */
+int dfft_create_1d_plan(
+    plan_t *plan,
+    int dim,
+    int howmany,
+    int istride,
+    int idist,
+    int ostride,
+    int odist,
+    int dir)
+    {
+    /* plans are executed on other arrays with fftwf_execute_dft(), plan on temporary arrays and make no
+     * assumptions on the alignment */
+    size_t isize = (size_t)(howmany-1)*idist + (size_t)(dim-1)*istride + 1;
+    size_t osize = (size_t)(howmany-1)*odist + (size_t)(dim-1)*ostride + 1;
+    fftwf_complex *in = (fftwf_complex *) fftwf_malloc(sizeof(fftwf_complex)*isize);
+    fftwf_complex *out = (fftwf_complex *) fftwf_malloc(sizeof(fftwf_complex)*osize);
+    if (in == NULL || out == NULL)
+        {
+        fftwf_free(in);
+        fftwf_free(out);
+        return 1;
+        }
+
+    *plan = fftwf_plan_many_dft(1, &dim, howmany,
+        in, NULL, istride, idist,
+        out, NULL, ostride, odist,
+        dir ? FFTW_BACKWARD : FFTW_FORWARD,
+        FFTW_ESTIMATE | FFTW_UNALIGNED);
+
+    fftwf_free(in);
+    fftwf_free(out);
+    return (*plan == NULL);
+    }
+
+int dfft_allocate_aligned_memory(cpx_t **ptr, size_t size)
+    {
+    *ptr = (cpx_t *) fftwf_malloc(size);
+    return 0;
+    }
+
+void dfft_free_aligned_memory(cpx_t *ptr)
+    {
+    fftwf_free(ptr);
+    }
+
+/* Destroy a 1d plan */
+void dfft_destroy_1d_plan(plan_t *p)
+    {
+    fftwf_destroy_plan(*p);
+    }
+
+/* Excecute a local 1D FFT
+ */
+void dfft_local_1dfft(
+    cpx_t *in,
+    cpx_t *out,
+    plan_t p,
+    int dir)
+    {
+    fftwf_execute_dft(p, (fftwf_complex *) in, (fftwf_complex *) out);
+    }
@@ -614,6 +614,44 @@ int gsd_end_frame(struct gsd_handle* handle)
     return 0;
     }
 
+/*! \param handle Handle to an open GSD file
+    \param index_entry Entry to add to the in-memory index
+
+    Expands the index if necessary and stores \a index_entry in the next free slot.
+
+    \return 0 on success, -1 on a file IO failure
+*/
+static int __gsd_append_index_entry(struct gsd_handle *handle, const struct gsd_index_entry *index_entry)
+    {
+    // need to expand the index if it is already full
+    if (handle->index_num_entries >= handle->header.index_allocated_entries)
+        {
+        int retval = __gsd_expand_index(handle);
+        if (retval != 0)
+            return -1;
+        }
+
+    // once we get here, there is a free slot to add this entry to the index
+    size_t slot = handle->index_num_entries;
+
+    // in append mode, only unwritten entries are stored in memory
+    if (handle->open_flags == GSD_OPEN_APPEND)
+        {
+        slot -= handle->index_written_entries;
+        if (slot >= handle->append_index_size)
+            {
+            handle->append_index_size *= 2;
+            handle->index = (struct gsd_index_entry *)realloc(handle->index, handle->append_index_size*sizeof(struct gsd_index_entry));
+            if (handle->index == NULL)
+                return -1;
+            }
+        }
+    handle->index[slot] = *index_entry;
+    handle->index_num_entries++;
+
+    return 0;
+    }
+
 /*! \param handle Handle to an open GSD file
     \param name Name of the data chunk (truncated to 63 chars)
     \param type type ID that identifies the type of data in \a data
@@ -667,34 +705,65 @@ int gsd_write_chunk(struct gsd_handle* handle,
     // update the file_size in the handle
     handle->file_size += bytes_written;
 
-    // update the index entry in the index
-    // need to expand the index if it is already full
-    if (handle->index_num_entries >= handle->header.index_allocated_entries)
-        {
-        int retval = __gsd_expand_index(handle);
-        if (retval != 0)
-            return -1;
-        }
+    return __gsd_append_index_entry(handle, &index_entry);
+    }
 
-    // once we get here, there is a free slot to add this entry to the index
-    size_t slot = handle->index_num_entries;
+/*! \param handle Handle to an open GSD file
+    \param name Name of the data chunk (truncated to 63 chars)
+    \param type type ID that identifies the type of data in the chunk
+    \param N Number of rows in the data
+    \param M Number of columns in the data
+    \param flags set to 0, non-zero values reserved for future use
+    \param location [out] Byte offset in the file where the chunk data must be written
 
-    // in append mode, only unwritten entries are stored in memory
-    if (handle->open_flags == GSD_OPEN_APPEND)
-        {
-        slot -= handle->index_written_entries;
-        if (slot >= handle->append_index_size)
-            {
-            handle->append_index_size *= 2;
-            handle->index = (struct gsd_index_entry *)realloc(handle->index, handle->append_index_size*sizeof(struct gsd_index_entry));
-            if (handle->index == NULL)
-                return -1;
-            }
-        }
-    handle->index[slot] = index_entry;
-    handle->index_num_entries++;
+    \pre \a handle was opened by gsd_open().
+    \pre \a name is a unique name for data chunks in the given frame.
 
-    return 0;
+    \post Space for the data chunk is allocated at the end of the file and its location is updated in the in-memory
+          index, exactly as gsd_write_chunk() would. The caller is responsible for writing
+          `N * M * gsd_sizeof_type(type)` bytes of data at \a location before the file is read. This allows several
+          writers (i.e. MPI ranks) to fill in disjoint pieces of one chunk.
+
+    \return 0 on success, -1 on a file IO failure - see errno for details, and -2 on invalid input
+*/
+int gsd_reserve_chunk(struct gsd_handle* handle,
+                      const char *name,
+                      enum gsd_type type,
+                      uint64_t N,
+                      uint32_t M,
+                      uint8_t flags,
+                      int64_t *location)
+    {
+    // validate input
+    if (location == NULL)
+        return -2;
+    if (N == 0 || M == 0)
+        return -2;
+    if (handle->open_flags == GSD_OPEN_READONLY)
+        return -2;
+
+    // populate fields in the index_entry data
+    struct gsd_index_entry index_entry;
+    memset(&index_entry, 0, sizeof(index_entry));
+    index_entry.frame = handle->cur_frame;
+    index_entry.id = __gsd_get_id(handle, name, 1);
+    index_entry.type = (uint8_t)type;
+    index_entry.N = N;
+    index_entry.M = M;
+    size_t size = N * M * gsd_sizeof_type(type);
+
+    // find the location at the end of the file for the chunk
+    index_entry.location = handle->file_size;
+
+    // extend the file so that a later index expansion is placed after the reserved space
+    if (ftruncate(handle->fd, index_entry.location + size) != 0)
+        return -1;
+
+    // update the file_size in the handle
+    handle->file_size += size;
+    *location = index_entry.location;
+
+    return __gsd_append_index_entry(handle, &index_entry);
     }
 
 /*! \param handle Handle to an open GSD file
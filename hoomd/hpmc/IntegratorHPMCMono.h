@@ -41,6 +41,10 @@
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
 #endif
 
+#if defined(ENABLE_TBB) && !defined(NVCC)
+#include <tbb/tbb.h>
+#endif
+
 namespace hpmc
 {
 
@@ -118,6 +122,10 @@ class UpdateOrder
 //! HPMC on systems of mono-disperse shapes
 /*! Implement hard particle monte carlo for a single type of shape on the CPU.
 
+    By default, trial moves are made one particle after another in a shuffled order. When checkerboard mode is
+    enabled with setCheckerboard(), the box is divided into cells and trial moves in non-adjacent cells are performed
+    concurrently on all available CPU threads, see updateCheckerboard().
+
     TODO: I need better documentation
 
     \ingroup hpmc_integrators
@@ -157,6 +165,20 @@ class IntegratorHPMCMono : public IntegratorHPMC
         //! Set elements of the interaction matrix
         virtual void setOverlapChecks(unsigned int typi, unsigned int typj, bool check_overlaps);
 
+        //! Enable or disable concurrent trial moves on a checkerboard of cells
+        /*! \param checkerboard Set to true to use updateCheckerboard() for the trial moves
+        */
+        void setCheckerboard(bool checkerboard)
+            {
+            m_checkerboard = checkerboard;
+            }
+
+        //! Get whether concurrent trial moves on a checkerboard of cells are enabled
+        bool getCheckerboard()
+            {
+            return m_checkerboard;
+            }
+
         //! Set the external field for the integrator
         void setExternalField(std::shared_ptr< ExternalFieldMono<Shape> > external)
             {
@@ -299,6 +321,19 @@ class IntegratorHPMCMono : public IntegratorHPMC
 
         Index2D m_overlap_idx;                      //!!< Indexer for interaction matrix
 
+        bool m_checkerboard;                                 //!< True if trial moves are made on a checkerboard of cells
+        bool m_checkerboard_warning_issued;                  //!< True if the checkerboard fallback warning has been issued
+        detail::UpdateOrder m_checkerboard_set_order;        //!< Update order of the checkerboard cell sets
+        std::vector<unsigned int> m_checkerboard_cell_offset;    //!< Offset of the first particle of each cell
+        std::vector<unsigned int> m_checkerboard_cell_particles; //!< Particle indices sorted by cell
+        std::vector<unsigned int> m_checkerboard_particle_cell;  //!< Cell of each local particle
+        std::vector<unsigned char> m_checkerboard_moved;     //!< Flag for particles with an accepted move not yet committed
+        std::vector<Scalar4> m_checkerboard_postype;         //!< Accepted positions and types not yet committed
+        std::vector<Scalar4> m_checkerboard_orientation;     //!< Accepted orientations not yet committed
+
+        //! Perform the trial moves of one update concurrently on a checkerboard of cells
+        virtual bool updateCheckerboard(unsigned int timestep, const unsigned int *overlaps, hpmc_counters_t& counters);
+
         //! Set the nominal width appropriate for looped moves
         virtual void updateCellWidth();
 
@@ -333,7 +368,10 @@ IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition>
               m_image_list_is_initialized(false),
               m_image_list_valid(false),
               m_hasOrientation(true),
-              m_past_first_run(false)
+              m_past_first_run(false),
+              m_checkerboard(false),
+              m_checkerboard_warning_issued(false),
+              m_checkerboard_set_order(seed+m_exec_conf->getRank())
     {
     // allocate the parameter storage
     GPUArray<param_type> params(m_pdata->getNTypes(), m_exec_conf);
@@ -443,8 +481,11 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
     // access interaction matrix
     ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
 
-    // loop over local particles nselect times
-    for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
+    // make concurrent trial moves on a checkerboard of cells if requested and possible
+    bool checkerboard = m_checkerboard && updateCheckerboard(timestep, h_overlaps.data, counters);
+
+    // otherwise, loop over local particles nselect times
+    for (unsigned int i_nselect = 0; i_nselect < m_nselect && !checkerboard; i_nselect++)
         {
         // access particle data and system box
         ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
@@ -643,9 +684,14 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
             }
         }
 
-    // perform the grid shift
+    // perform the grid shift, moves on the checkerboard rely on it for ergodicity
+    bool grid_shift = checkerboard;
     #ifdef ENABLE_MPI
     if (m_comm)
+        grid_shift = true;
+    #endif
+
+    if (grid_shift)
         {
         ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
         ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
@@ -670,7 +716,6 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
             }
         this->m_pdata->translateOrigin(shift);
         }
-    #endif
 
     if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
 
@@ -681,6 +726,369 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
     m_aabb_tree_invalid = true;
     }
 
+/*! \param timestep Current time step
+    \param overlaps Interaction matrix
+    \param counters Acceptance counters to update
+    \returns true if the trial moves were made, false if the caller must fall back to the serial loop
+
+    The local box is divided into a grid of cells that are at least as wide as the largest particle, with an even
+    number of cells along each direction. The cells are split into 4 (2D) or 8 (3D) sets such that no two cells in the
+    same set are adjacent. Like in the GPU implementation, trial moves that take a particle out of its cell are
+    rejected, so that moves in different cells of the same set cannot interact and are made concurrently. The random
+    grid shift at the end of update() keeps the simulation ergodic.
+
+    The particle data and the AABB tree are only read while a set is processed. Accepted moves are stored in
+    m_checkerboard_postype and m_checkerboard_orientation, and overlap checks against particles that have already
+    moved in the same cell use the stored configuration. The moves are committed after all cells of the set are
+    done. Every particle is moved with the same random number stream as in the serial loop and the cells of a set are
+    independent, so the trajectory does not depend on the number of threads.
+*/
+template <class Shape>
+bool IntegratorHPMCMono<Shape>::updateCheckerboard(unsigned int timestep,
+                                                   const unsigned int *overlaps,
+                                                   hpmc_counters_t& counters)
+    {
+    if (m_external)
+        {
+        if (!m_checkerboard_warning_issued)
+            {
+            m_exec_conf->msg->warning() << "HPMC checkerboard moves do not support external fields, "
+                                        << "moving particles serially" << std::endl;
+            m_checkerboard_warning_issued = true;
+            }
+        return false;
+        }
+
+    const BoxDim& box = m_pdata->getBox();
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+    const unsigned int N = m_pdata->getN();
+
+    // use the largest even number of cells along each direction that fits cells of the nominal width,
+    // but not many more cells than particles
+    Scalar3 npd = box.getNearestPlaneDistance();
+    Scalar max_pairs = std::max(Scalar(1.0), floor(pow(Scalar(N), Scalar(1.0)/Scalar(ndim))/Scalar(2.0)));
+    auto cells_along = [&](Scalar width) -> unsigned int
+        {
+        return 2*(unsigned int)std::min(max_pairs, floor(width / (Scalar(2.0)*m_nominal_width)));
+        };
+    uint3 dim = make_uint3(cells_along(npd.x), cells_along(npd.y), (ndim == 3) ? cells_along(npd.z) : 1);
+
+    if (dim.x < 2 || dim.y < 2 || (ndim == 3 && dim.z < 2))
+        {
+        if (!m_checkerboard_warning_issued)
+            {
+            m_exec_conf->msg->warning() << "Box too small for HPMC checkerboard moves, moving particles serially"
+                                        << std::endl;
+            m_checkerboard_warning_issued = true;
+            }
+        return false;
+        }
+
+    Index3D ci(dim.x, dim.y, dim.z);
+    const unsigned int n_cells = ci.getNumElements();
+    const unsigned int invalid_cell = n_cells;
+
+    // find the cell of a position, clamp to the box for stored positions and flag trial positions outside of it
+    auto find_cell = [&](const vec3<Scalar>& pos, bool clamp) -> unsigned int
+        {
+        Scalar3 f = box.makeFraction(vec_to_scalar3(pos));
+        int c[3] = {int(floor(f.x * dim.x)), int(floor(f.y * dim.y)), int(floor(f.z * dim.z))};
+        int n[3] = {int(dim.x), int(dim.y), int(dim.z)};
+        if (ndim == 2)
+            c[2] = 0;
+
+        for (unsigned int d = 0; d < 3; d++)
+            {
+            if (c[d] < 0 || c[d] >= n[d])
+                {
+                if (!clamp)
+                    return invalid_cell;
+                c[d] = std::min(std::max(c[d], 0), n[d]-1);
+                }
+            }
+        return ci(c[0], c[1], c[2]);
+        };
+
+    #ifdef ENABLE_MPI
+    // compute the width of the active region
+    Scalar3 ghost_fraction = m_nominal_width / npd;
+    #endif
+
+    // access particle data, parameters and move sizes
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+    ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::read);
+
+    // sort the particles into cells in update order, particles never leave their cell during this step
+    m_checkerboard_cell_offset.assign(n_cells+1, 0);
+    m_checkerboard_cell_particles.resize(N);
+    m_checkerboard_particle_cell.resize(N);
+    m_checkerboard_moved.assign(N, 0);
+    m_checkerboard_postype.resize(N);
+    m_checkerboard_orientation.resize(N);
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        unsigned int cell = find_cell(vec3<Scalar>(h_postype.data[i]), true);
+        m_checkerboard_particle_cell[i] = cell;
+        m_checkerboard_cell_offset[cell+1]++;
+        }
+
+    for (unsigned int cell = 0; cell < n_cells; cell++)
+        m_checkerboard_cell_offset[cell+1] += m_checkerboard_cell_offset[cell];
+
+    std::vector<unsigned int> cell_fill(m_checkerboard_cell_offset.begin(), m_checkerboard_cell_offset.end()-1);
+    for (unsigned int cur_particle = 0; cur_particle < N; cur_particle++)
+        {
+        unsigned int i = m_update_order[cur_particle];
+        m_checkerboard_cell_particles[cell_fill[m_checkerboard_particle_cell[i]]++] = i;
+        }
+
+    // the cells in each set
+    const uint3 set_dim = make_uint3(dim.x/2, dim.y/2, (ndim == 3) ? dim.z/2 : 1);
+    const unsigned int n_set_cells = set_dim.x*set_dim.y*set_dim.z;
+    const unsigned int n_sets = (ndim == 3) ? 8 : 4;
+    m_checkerboard_set_order.resize(n_sets);
+
+    // make the trial moves for all particles in one cell
+    auto move_cell = [&](unsigned int cell, unsigned int i_nselect, hpmc_counters_t& cell_counters)
+        {
+        const unsigned int first = m_checkerboard_cell_offset[cell];
+        const unsigned int last = m_checkerboard_cell_offset[cell+1];
+        for (unsigned int cur = first; cur < last; cur++)
+            {
+            unsigned int i = m_checkerboard_cell_particles[cur];
+
+            // read in the current position and orientation
+            Scalar4 postype_i = h_postype.data[i];
+            Scalar4 orientation_i = h_orientation.data[i];
+            vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+
+            #ifdef ENABLE_MPI
+            if (m_comm)
+                {
+                // only move particle if active
+                if (!isActive(make_scalar3(postype_i.x, postype_i.y, postype_i.z), box, ghost_fraction))
+                    continue;
+                }
+            #endif
+
+            // make a trial move for i
+            Saru rng_i(i, m_seed + m_exec_conf->getRank()*m_nselect + i_nselect, timestep);
+            int typ_i = __scalar_as_int(postype_i.w);
+            Shape shape_i(quat<Scalar>(orientation_i), h_params.data[typ_i]);
+            unsigned int move_type_select = rng_i.u32() & 0xffff;
+            bool move_type_translate = !shape_i.hasOrientation() || (move_type_select < m_move_ratio);
+
+            if (move_type_translate)
+                {
+                move_translate(pos_i, rng_i, h_d.data[typ_i], ndim);
+
+                #ifdef ENABLE_MPI
+                if (m_comm)
+                    {
+                    // check if particle has moved into the ghost layer, and skip if it is
+                    if (!isActive(vec_to_scalar3(pos_i), box, ghost_fraction))
+                        continue;
+                    }
+                #endif
+                }
+            else
+                {
+                move_rotate(shape_i.orientation, rng_i, h_a.data[typ_i], ndim);
+                }
+
+            // reject moves that leave the cell
+            bool overlap = move_type_translate && find_cell(pos_i, false) != cell;
+
+            // check for overlaps with neighboring particles that have not moved in this set
+            detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0,0,0));
+            const unsigned int n_images = m_image_list.size();
+            for (unsigned int cur_image = 0; cur_image < n_images && !overlap; cur_image++)
+                {
+                vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
+                detail::AABB aabb = aabb_i_local;
+                aabb.translate(pos_i_image);
+
+                // stackless search
+                for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes() && !overlap; cur_node_idx++)
+                    {
+                    if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                        {
+                        if (m_aabb_tree.isNodeLeaf(cur_node_idx))
+                            {
+                            for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                                {
+                                unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                                Scalar4 postype_j;
+                                Scalar4 orientation_j;
+
+                                if (j != i)
+                                    {
+                                    // particles moved in this cell are checked below with their new configuration
+                                    if (j < N && m_checkerboard_particle_cell[j] == cell && m_checkerboard_moved[j])
+                                        continue;
+
+                                    postype_j = h_postype.data[j];
+                                    orientation_j = h_orientation.data[j];
+                                    }
+                                else
+                                    {
+                                    // in the first image, skip i == j
+                                    if (cur_image == 0)
+                                        continue;
+
+                                    // in an outside image, use the trial position and orientation
+                                    postype_j = make_scalar4(pos_i.x, pos_i.y, pos_i.z, postype_i.w);
+                                    orientation_j = quat_to_scalar4(shape_i.orientation);
+                                    }
+
+                                // put particles in coordinate system of particle i
+                                vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+
+                                unsigned int typ_j = __scalar_as_int(postype_j.w);
+                                Shape shape_j(quat<Scalar>(orientation_j), h_params.data[typ_j]);
+
+                                cell_counters.overlap_checks++;
+                                if (overlaps[m_overlap_idx(typ_i, typ_j)]
+                                    && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                                    && test_overlap(r_ij, shape_i, shape_j, cell_counters.overlap_err_count))
+                                    {
+                                    overlap = true;
+                                    break;
+                                    }
+                                }
+                            }
+                        }
+                    else
+                        {
+                        // skip ahead
+                        cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
+                        }
+                    }  // end loop over AABB nodes
+                } // end loop over images
+
+            // check for overlaps with the particles that have already moved in this cell
+            for (unsigned int cur_image = 0; cur_image < n_images && !overlap; cur_image++)
+                {
+                vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
+                for (unsigned int cur_j = first; cur_j < cur; cur_j++)
+                    {
+                    unsigned int j = m_checkerboard_cell_particles[cur_j];
+                    if (!m_checkerboard_moved[j])
+                        continue;
+
+                    vec3<Scalar> r_ij = vec3<Scalar>(m_checkerboard_postype[j]) - pos_i_image;
+
+                    unsigned int typ_j = __scalar_as_int(m_checkerboard_postype[j].w);
+                    Shape shape_j(quat<Scalar>(m_checkerboard_orientation[j]), h_params.data[typ_j]);
+
+                    cell_counters.overlap_checks++;
+                    if (overlaps[m_overlap_idx(typ_i, typ_j)]
+                        && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                        && test_overlap(r_ij, shape_i, shape_j, cell_counters.overlap_err_count))
+                        {
+                        overlap = true;
+                        break;
+                        }
+                    }
+                }
+
+            // if the move is accepted
+            if (!overlap)
+                {
+                // increment accept counter and store the new configuration until the set is committed
+                if (!shape_i.ignoreStatistics())
+                    {
+                    if (move_type_translate)
+                        cell_counters.translate_accept_count++;
+                    else
+                        cell_counters.rotate_accept_count++;
+                    }
+
+                m_checkerboard_postype[i] = make_scalar4(pos_i.x, pos_i.y, pos_i.z, postype_i.w);
+                m_checkerboard_orientation[i] = shape_i.hasOrientation() ? quat_to_scalar4(shape_i.orientation)
+                                                                         : orientation_i;
+                m_checkerboard_moved[i] = 1;
+                }
+            else
+                {
+                if (!shape_i.ignoreStatistics())
+                    {
+                    // increment reject counter
+                    if (move_type_translate)
+                        cell_counters.translate_reject_count++;
+                    else
+                        cell_counters.rotate_reject_count++;
+                    }
+                }
+            }
+        };
+
+    const unsigned int num_threads = m_exec_conf->getNumThreads();
+
+    for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
+        {
+        // loop over cell sets in a shuffled order
+        m_checkerboard_set_order.shuffle(timestep, i_nselect);
+        for (unsigned int cur_set = 0; cur_set < n_sets; cur_set++)
+            {
+            unsigned int set = m_checkerboard_set_order[cur_set];
+
+            // get the cell with index k in the current set
+            auto set_cell = [&](unsigned int k) -> unsigned int
+                {
+                return ci(2*(k % set_dim.x) + (set & 1),
+                          2*((k / set_dim.x) % set_dim.y) + ((set >> 1) & 1),
+                          2*(k / (set_dim.x*set_dim.y)) + ((set >> 2) & 1));
+                };
+
+            if (num_threads == 1)
+                {
+                for (unsigned int k = 0; k < n_set_cells; k++)
+                    move_cell(set_cell(k), i_nselect, counters);
+                }
+            #ifdef ENABLE_TBB
+            else
+                {
+                tbb::enumerable_thread_specific<hpmc_counters_t> thread_counters;
+                tbb::parallel_for((unsigned int)0, n_set_cells, [&](unsigned int k)
+                    {
+                    move_cell(set_cell(k), i_nselect, thread_counters.local());
+                    });
+
+                for (auto c = thread_counters.begin(); c != thread_counters.end(); ++c)
+                    counters = counters + *c;
+                }
+            #endif
+
+            // commit the accepted moves and update the particles in the tree for the next set
+            for (unsigned int k = 0; k < n_set_cells; k++)
+                {
+                unsigned int cell = set_cell(k);
+                for (unsigned int cur = m_checkerboard_cell_offset[cell]; cur < m_checkerboard_cell_offset[cell+1]; cur++)
+                    {
+                    unsigned int i = m_checkerboard_cell_particles[cur];
+                    if (!m_checkerboard_moved[i])
+                        continue;
+
+                    h_postype.data[i] = m_checkerboard_postype[i];
+                    h_orientation.data[i] = m_checkerboard_orientation[i];
+                    m_checkerboard_moved[i] = 0;
+
+                    Shape shape_i(quat<Scalar>(h_orientation.data[i]), h_params.data[__scalar_as_int(h_postype.data[i].w)]);
+                    m_aabb_tree.update(i, shape_i.getAABB(vec3<Scalar>(h_postype.data[i])));
+                    }
+                }
+            }
+        }
+
+    return true;
+    }
+
 /*! \param timestep current step
     \param early_exit exit at first overlap found if true
     \returns number of overlaps if early_exit=false, 1 if early_exit=true
@@ -1265,6 +1673,8 @@ template < class Shape > void export_IntegratorHPMCMono(pybind11::module& m, con
           .def("setParam", &IntegratorHPMCMono<Shape>::setParam)
           .def("setOverlapChecks", &IntegratorHPMCMono<Shape>::setOverlapChecks)
           .def("setExternalField", &IntegratorHPMCMono<Shape>::setExternalField)
+          .def("setCheckerboard", &IntegratorHPMCMono<Shape>::setCheckerboard)
+          .def("getCheckerboard", &IntegratorHPMCMono<Shape>::getCheckerboard)
           .def("mapOverlaps", &IntegratorHPMCMono<Shape>::PyMapOverlaps)
           ;
     }
@@ -8,10 +8,7 @@
 #include "hoomd/Autotuner.h"
 
 #include <random>
-
-#ifdef _OPENMP
-#include <omp.h>
-#endif
+#include <atomic>
 
 /*! \file IntegratorHPMCMonoImplicit.h
     \brief Defines the template class for HPMC with implicit generated depletant solvent
@@ -33,6 +30,11 @@ namespace hpmc
 
     The penetrable depletants model is simulated.
 
+    The depletants of a trial move are inserted concurrently. They are tested against a list of the colloids near the
+    insertion sphere, which is gathered with a single traversal of the AABB tree per trial move. Every depletant draws
+    from its own random number stream and the contributions to the acceptance probability are summed in a fixed
+    order, so that the result does not depend on the number of threads.
+
     \ingroup hpmc_integrators
 */
 template< class Shape >
@@ -149,6 +151,15 @@ class IntegratorHPMCMonoImplicit : public IntegratorHPMCMono<Shape>
         //! Slot to be called when number of types changes
         void slotNumTypesChange();
 
+        //! Get the half width of the box around the insertion sphere that contains every colloid a depletant may overlap
+        /*! \param d_max Diameter of the insertion sphere
+            \param d_depletant Circumsphere diameter of the depletant
+        */
+        static Scalar getColloidQueryRadius(Scalar d_max, Scalar d_depletant)
+            {
+            return Scalar(0.5)*(d_max + d_depletant);
+            }
+
     protected:
         Scalar m_n_R;                                            //!< Averge depletant number density in free volume
         unsigned int m_type;                                     //!< Type of depletant particle to generate
@@ -163,10 +174,40 @@ class IntegratorHPMCMonoImplicit : public IntegratorHPMCMono<Shape>
         GPUArray<Scalar> m_d_min;                                //!< Minimum sphere from which test depletant is excluded
         GPUArray<Scalar> m_d_max;                                //!< Maximum sphere for test depletant insertion
 
-        std::vector<Saru> m_rng_depletant;                       //!< RNGs for depletant insertion
-        bool m_rng_initialized;                                  //!< True if RNGs have been initialized
         unsigned int m_n_trial;                                 //!< Number of trial re-insertions per depletant
 
+        std::vector< vec3<Scalar> > m_colloid_pos;               //!< Positions of the colloids near the current insertion sphere
+        std::vector< quat<Scalar> > m_colloid_orientation;       //!< Orientations of the colloids near the current insertion sphere
+        std::vector<unsigned int> m_colloid_type;                //!< Types of the colloids near the current insertion sphere
+        std::vector<Scalar> m_depletant_lnb;                     //!< Contribution of every depletant to the log acceptance probability
+
+        //! Counters of the depletants inserted for one trial move
+        struct depletant_counters_t
+            {
+            unsigned int overlap_checks;
+            unsigned int overlap_err_count;
+            unsigned int insert_count;
+            unsigned int reinsert_count;
+            unsigned int free_volume_count;
+            unsigned int overlap_count;
+
+            depletant_counters_t()
+                : overlap_checks(0), overlap_err_count(0), insert_count(0), reinsert_count(0),
+                  free_volume_count(0), overlap_count(0)
+                { }
+
+            depletant_counters_t& operator+=(const depletant_counters_t& other)
+                {
+                overlap_checks += other.overlap_checks;
+                overlap_err_count += other.overlap_err_count;
+                insert_count += other.insert_count;
+                reinsert_count += other.reinsert_count;
+                free_volume_count += other.free_volume_count;
+                overlap_count += other.overlap_count;
+                return *this;
+                }
+            };
+
         bool m_need_initialize_poisson;                             //!< Flag to tell if we need to initialize the poisson distribution
 
         //! Take one timestep forward
@@ -211,7 +252,7 @@ class IntegratorHPMCMonoImplicit : public IntegratorHPMCMono<Shape>
 template< class Shape >
 IntegratorHPMCMonoImplicit< Shape >::IntegratorHPMCMonoImplicit(std::shared_ptr<SystemDefinition> sysdef,
                                                                    unsigned int seed)
-    : IntegratorHPMCMono<Shape>(sysdef, seed), m_n_R(0), m_type(0), m_d_dep(0.0), m_rng_initialized(false), m_n_trial(0),
+    : IntegratorHPMCMono<Shape>(sysdef, seed), m_n_R(0), m_type(0), m_d_dep(0.0), m_n_trial(0),
       m_need_initialize_poisson(true)
     {
     this->m_exec_conf->msg->notice(5) << "Constructing IntegratorHPMCImplicit" << std::endl;
@@ -344,22 +385,6 @@ void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
         m_need_initialize_poisson = false;
         }
 
-    if (!m_rng_initialized)
-        {
-        unsigned int n_omp_threads = 1;
-
-        #ifdef _OPENMP
-        n_omp_threads = omp_get_max_threads();
-        #endif
-
-        // initialize a set of random number generators
-        for (unsigned int i = 0; i < n_omp_threads; ++i)
-            {
-            m_rng_depletant.push_back(Saru(timestep,this->m_seed+this->m_exec_conf->getRank(), i));
-            }
-        m_rng_initialized = true;
-        }
-
     // get needed vars
     ArrayHandle<hpmc_counters_t> h_counters(this->m_count_total, access_location::host, access_mode::readwrite);
     hpmc_counters_t& counters = h_counters.data[0];
@@ -570,56 +595,84 @@ void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
                     n = m_poisson[typ_i](rng_poisson);
                     }
 
-                unsigned int n_overlap_checks = 0;
-                unsigned int overlap_err_count = 0;
-                unsigned int insert_count = 0;
-                unsigned int reinsert_count = 0;
-                unsigned int free_volume_count = 0;
-                unsigned int overlap_count = 0;
+                // every depletant draws from its own random number stream, so that the result
+                // does not depend on the number of threads or the order the depletants are processed in
+                unsigned int seed_depletant = rng_i.u32();
 
-                volatile bool flag=false;
-
-                #pragma omp parallel for reduction(+ : lnb, n_overlap_checks, overlap_err_count, insert_count, reinsert_count, free_volume_count, overlap_count) reduction(max: zero) shared(flag) if (n>0) schedule(dynamic)
-                for (unsigned int k = 0; k < n; ++k)
+                if (n > 0)
                     {
-                    if (flag)
+                    // gather the colloids that a depletant in the insertion sphere may overlap with a single
+                    // traversal of the tree, all depletants of this move are tested against this list
+                    m_colloid_pos.clear();
+                    m_colloid_orientation.clear();
+                    m_colloid_type.clear();
+
+                    Shape shape_depletant(quat<Scalar>(), h_params.data[m_type]);
+                    Scalar r_query = getColloidQueryRadius(h_d_max.data[typ_i], shape_depletant.getCircumsphereDiameter());
+
+                    // All image boxes (including the primary)
+                    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
                         {
-                        #ifndef _OPENMP
-                        break;
-                        #else
-                        continue;
-                        #endif
-                        }
-                    insert_count++;
+                        detail::AABB aabb(pos_i + this->m_image_list[cur_image], r_query);
+
+                        // stackless search
+                        for (unsigned int cur_node_idx = 0; cur_node_idx < this->m_aabb_tree.getNumNodes(); cur_node_idx++)
+                            {
+                            if (detail::overlap(this->m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                                {
+                                if (this->m_aabb_tree.isNodeLeaf(cur_node_idx))
+                                    {
+                                    for (unsigned int cur_p = 0; cur_p < this->m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                                        {
+                                        // store the old position in the coordinate system of the depletants
+                                        unsigned int j = this->m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+                                        m_colloid_pos.push_back(vec3<Scalar>(h_postype.data[j]) - this->m_image_list[cur_image]);
+                                        m_colloid_orientation.push_back(quat<Scalar>(h_orientation.data[j]));
+                                        m_colloid_type.push_back(__scalar_as_int(h_postype.data[j].w));
+                                        }
+                                    }
+                                }
+                            else
+                                {
+                                // skip ahead
+                                cur_node_idx += this->m_aabb_tree.getNodeSkip(cur_node_idx);
+                                }
+                            }  // end loop over AABB nodes
+                        } // end loop over images
+
+                    if (m_depletant_lnb.size() < n)
+                        m_depletant_lnb.resize(n);
+                    }
+
+                // set when a depletant rejects the trial move, the remaining depletants are skipped
+                std::atomic<bool> reject(false);
+
+                // insert depletant k and store its contribution to the log of the acceptance probability
+                auto insert_depletant = [&](unsigned int k, depletant_counters_t& c)
+                    {
+                    c.insert_count++;
+                    m_depletant_lnb[k] = Scalar(0.0);
+
+                    Saru rng_depletant(seed_depletant, k, 0x8a61c3e5);
 
                     // generate a random depletant coordinate and orientation in the sphere around the new position
                     vec3<Scalar> pos_test;
                     quat<Scalar> orientation_test;
 
-                    #ifdef _OPENMP
-                    unsigned int thread_idx = omp_get_thread_num();
-                    #else
-                    unsigned int thread_idx = 0;
-                    #endif
-
-                    generateDepletant(m_rng_depletant[thread_idx], pos_i, h_d_max.data[typ_i], h_d_min.data[typ_i], pos_test,
+                    generateDepletant(rng_depletant, pos_i, h_d_max.data[typ_i], h_d_min.data[typ_i], pos_test,
                         orientation_test, h_params.data[m_type]);
                     Shape shape_test(orientation_test, h_params.data[m_type]);
 
-                    detail::AABB aabb_test_local = shape_test.getAABB(vec3<Scalar>(0,0,0));
-
                     bool overlap_depletant = false;
 
                     // Check if the new configuration of particle i generates an overlap
                     for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
                         {
                         vec3<Scalar> pos_test_image = pos_test + this->m_image_list[cur_image];
-                        detail::AABB aabb = aabb_test_local;
-                        aabb.translate(pos_test_image);
 
                         vec3<Scalar> r_ij = pos_i - pos_test_image;
 
-                        n_overlap_checks++;
+                        c.overlap_checks++;
 
                         // check circumsphere overlap
                         OverlapReal rsq = dot(r_ij,r_ij);
@@ -628,10 +681,10 @@ void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
 
                         if (h_overlaps.data[this->m_overlap_idx(m_type, typ_i)]
                             && circumsphere_overlap
-                            && test_overlap(r_ij, shape_test, shape_i, overlap_err_count))
+                            && test_overlap(r_ij, shape_test, shape_i, c.overlap_err_count))
                             {
                             overlap_depletant = true;
-                            overlap_count++;
+                            c.overlap_count++;
                             break;
                             }
                         }
@@ -641,74 +694,34 @@ void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
                         // check against overlap with old position
                         bool overlap_old = false;
 
-                        // All image boxes (including the primary)
-                        const unsigned int n_images = this->m_image_list.size();
-                        for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+                        for (unsigned int cur_colloid = 0; cur_colloid < m_colloid_pos.size(); cur_colloid++)
                             {
-                            vec3<Scalar> pos_test_image = pos_test + this->m_image_list[cur_image];
-                            detail::AABB aabb = aabb_test_local;
-                            aabb.translate(pos_test_image);
+                            // put particles in coordinate system of the depletant
+                            vec3<Scalar> r_ij = m_colloid_pos[cur_colloid] - pos_test;
 
-                            // stackless search
-                            for (unsigned int cur_node_idx = 0; cur_node_idx < this->m_aabb_tree.getNumNodes(); cur_node_idx++)
-                                {
-                                if (detail::overlap(this->m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
-                                    {
-                                    if (this->m_aabb_tree.isNodeLeaf(cur_node_idx))
-                                        {
-                                        for (unsigned int cur_p = 0; cur_p < this->m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
-                                            {
-                                            // read in its position and orientation
-                                            unsigned int j = this->m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
-
-                                            Scalar4 postype_j;
-                                            Scalar4 orientation_j;
-
-                                            // load the old position and orientation of the j particle
-                                            postype_j = h_postype.data[j];
-                                            orientation_j = h_orientation.data[j];
-
-                                            // put particles in coordinate system of particle i
-                                            vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_test_image;
-
-                                            unsigned int typ_j = __scalar_as_int(postype_j.w);
-                                            Shape shape_j(quat<Scalar>(orientation_j), h_params.data[typ_j]);
-
-                                            n_overlap_checks++;
-
-                                            // check circumsphere overlap
-                                            OverlapReal rsq = dot(r_ij,r_ij);
-                                            OverlapReal DaDb = shape_test.getCircumsphereDiameter() + shape_j.getCircumsphereDiameter();
-                                            bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
-
-                                            if (h_overlaps.data[this->m_overlap_idx(m_type,typ_j)]
-                                                && circumsphere_overlap
-                                                && test_overlap(r_ij, shape_test, shape_j, overlap_err_count))
-                                                {
-                                                // depletant is ignored for any overlap in the old configuration
-                                                overlap_old = true;
-                                                break;
-                                                }
-                                            }
-                                        }
-                                    }
-                                else
-                                    {
-                                    // skip ahead
-                                    cur_node_idx += this->m_aabb_tree.getNodeSkip(cur_node_idx);
-                                    }
+                            unsigned int typ_j = m_colloid_type[cur_colloid];
+                            Shape shape_j(m_colloid_orientation[cur_colloid], h_params.data[typ_j]);
 
-                                if (overlap_old)
-                                    break;
-                                }  // end loop over AABB nodes
+                            c.overlap_checks++;
+
+                            // check circumsphere overlap
+                            OverlapReal rsq = dot(r_ij,r_ij);
+                            OverlapReal DaDb = shape_test.getCircumsphereDiameter() + shape_j.getCircumsphereDiameter();
+                            bool circumsphere_overlap = (rsq*OverlapReal(4.0) <= DaDb * DaDb);
 
-                            if (overlap_old)
+                            if (h_overlaps.data[this->m_overlap_idx(m_type,typ_j)]
+                                && circumsphere_overlap
+                                && test_overlap(r_ij, shape_test, shape_j, c.overlap_err_count))
+                                {
+                                // depletant is ignored for any overlap in the old configuration
+                                overlap_old = true;
                                 break;
-                            } // end loop over images
+                                }
+                            }
 
                         if (!overlap_old)
                             {
-                            free_volume_count++;
+                            c.free_volume_count++;
                             }
                         else
                             {
@@ -720,9 +733,7 @@ void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
 
                     if (overlap_depletant && !m_n_trial)
                         {
-                        zero = 1;
-                        // break out of loop
-                        flag = true;
+                        reject = true;
                         }
                     else if (overlap_depletant && m_n_trial)
                         {
@@ -756,10 +767,10 @@ void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
 
                             // try moving the overlapping depletant in the excluded volume
                             // such that it overlaps with the particle at the old position
-                            generateDepletantRestricted(m_rng_depletant[thread_idx], pos_i_old, h_d_max.data[typ_i], delta_insphere,
+                            generateDepletantRestricted(rng_depletant, pos_i_old, h_d_max.data[typ_i], delta_insphere,
                                 pos_depletant_new, orientation_depletant_new, params_depletant, pos_i);
 
-                            reinsert_count++;
+                            c.reinsert_count++;
 
                             Shape shape_depletant_new(orientation_depletant_new, params_depletant);
                             const typename Shape::param_type& params_i = h_params.data[__scalar_as_int(postype_i_old.w)];
@@ -767,7 +778,7 @@ void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
                             bool overlap_shape = false;
                             if (insertDepletant(pos_depletant_new, shape_depletant_new, i, h_params.data, h_overlaps.data, typ_i,
                                 h_postype.data, h_orientation.data, pos_i, shape_i.orientation, params_i,
-                                n_overlap_checks, overlap_err_count, overlap_shape, false))
+                                c.overlap_checks, c.overlap_err_count, overlap_shape, false))
                                 {
                                 n_success_new++;
                                 }
@@ -781,12 +792,12 @@ void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
                             if (l >= 1)
                                 {
                                 // as above, in excluded volume sphere at new position
-                                generateDepletantRestricted(m_rng_depletant[thread_idx], pos_i, h_d_max.data[typ_i], delta_insphere,
+                                generateDepletantRestricted(rng_depletant, pos_i, h_d_max.data[typ_i], delta_insphere,
                                     pos_depletant_old, orientation_depletant_old, params_depletant, pos_i_old);
                                 Shape shape_depletant_old(orientation_depletant_old, params_depletant);
                                 if (insertDepletant(pos_depletant_old, shape_depletant_old, i, h_params.data, h_overlaps.data, typ_i,
                                     h_postype.data, h_orientation.data, pos_i, shape_i.orientation, params_i,
-                                    n_overlap_checks, overlap_err_count, overlap_shape, true))
+                                    c.overlap_checks, c.overlap_err_count, overlap_shape, true))
                                     {
                                     n_success_old++;
                                     }
@@ -796,35 +807,66 @@ void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
                                     // depletant overlaps with colloid at new position
                                     n_overlap_shape_old++;
                                     }
-                                reinsert_count++;
+                                c.reinsert_count++;
                                 }
 
-                            n_overlap_checks += counters.overlap_checks;
-                            overlap_err_count += counters.overlap_err_count;
+                            c.overlap_checks += counters.overlap_checks;
+                            c.overlap_err_count += counters.overlap_err_count;
                             } // end loop over re-insertion attempts
 
                         if (n_success_new != 0)
                             {
-                            lnb += log((Scalar)n_success_new/(Scalar)n_overlap_shape_new);
-                            lnb -= log((Scalar)n_success_old/(Scalar)n_overlap_shape_old);
+                            m_depletant_lnb[k] = log((Scalar)n_success_new/(Scalar)n_overlap_shape_new)
+                                - log((Scalar)n_success_old/(Scalar)n_overlap_shape_old);
                             }
                         else
                             {
-                            zero = 1;
-                            // break out of loop
-                            flag = true;
+                            reject = true;
                             }
                         } // end if depletant overlap
+                    };
+
+                depletant_counters_t depletant_counters;
 
-                    } // end loop over depletants
+                const unsigned int num_threads = this->m_exec_conf->getNumThreads();
+                if (num_threads == 1 || n <= 1)
+                    {
+                    for (unsigned int k = 0; k < n && !reject; ++k)
+                        insert_depletant(k, depletant_counters);
+                    }
+                #ifdef ENABLE_TBB
+                else
+                    {
+                    tbb::enumerable_thread_specific<depletant_counters_t> thread_counters;
+                    tbb::parallel_for((unsigned int)0, n, [&](unsigned int k)
+                        {
+                        if (!reject)
+                            insert_depletant(k, thread_counters.local());
+                        });
+
+                    for (auto c = thread_counters.begin(); c != thread_counters.end(); ++c)
+                        depletant_counters += *c;
+                    }
+                #endif
+
+                if (reject)
+                    {
+                    zero = 1;
+                    }
+                else
+                    {
+                    // sum the contributions in a fixed order
+                    for (unsigned int k = 0; k < n; ++k)
+                        lnb += m_depletant_lnb[k];
+                    }
 
                 // increment counters
-                counters.overlap_checks += n_overlap_checks;
-                counters.overlap_err_count += overlap_err_count;
-                implicit_counters.insert_count += insert_count;
-                implicit_counters.free_volume_count += free_volume_count;
-                implicit_counters.overlap_count += overlap_count;
-                implicit_counters.reinsert_count += reinsert_count;
+                counters.overlap_checks += depletant_counters.overlap_checks;
+                counters.overlap_err_count += depletant_counters.overlap_err_count;
+                implicit_counters.insert_count += depletant_counters.insert_count;
+                implicit_counters.free_volume_count += depletant_counters.free_volume_count;
+                implicit_counters.overlap_count += depletant_counters.overlap_count;
+                implicit_counters.reinsert_count += depletant_counters.reinsert_count;
 
                 // apply acceptance criterium
                 if (!zero)
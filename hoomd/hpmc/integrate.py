@@ -372,7 +372,8 @@ class mode_hpmc(_integrator):
                    nselect=None,
                    nR=None,
                    depletant_type=None,
-                   ntrial=None):
+                   ntrial=None,
+                   checkerboard=None):
         R""" Changes parameters of an existing integration mode.
 
         Args:
@@ -383,6 +384,12 @@ class mode_hpmc(_integrator):
             nR (int): (if set) **Implicit depletants only**: Number density of implicit depletants in free volume.
             depletant_type (str): (if set) **Implicit depletants only**: Particle type to use as implicit depletant.
             ntrial (int): (if set) **Implicit depletants only**: Number of re-insertion attempts per overlapping depletant.
+            checkerboard (bool): (if set) **CPU only**: Set to True to perform trial moves concurrently on all CPU threads.
+
+        With *checkerboard* enabled, the box is divided into cells at least as wide as the largest particle and
+        trial moves in non-adjacent cells are performed at the same time, similar to the GPU implementation.
+        Trial moves that leave a cell are rejected. The number of threads is set with
+        :py:func:`hoomd.option.set_num_threads`. External fields and implicit depletants are not supported in this mode.
         """
 
         hoomd.util.print_status_line();
@@ -428,6 +435,12 @@ class mode_hpmc(_integrator):
         elif any([p is not None for p in [nR,depletant_type,ntrial]]):
             hoomd.context.msg.warning("Implicit depletant parameters not supported by this integrator.\n")
 
+        if checkerboard is not None:
+            if hoomd.context.exec_conf.isCUDAEnabled() or self.implicit:
+                hoomd.context.msg.warning("checkerboard is only supported by CPU integrators without implicit depletants.\n")
+            else:
+                self.cpp_integrator.setCheckerboard(checkerboard);
+
     def map_overlaps(self):
         R""" Build an overlap map of the system
 
@@ -0,0 +1,77 @@
+from __future__ import division, print_function
+from hoomd import *
+from hoomd import hpmc
+import unittest
+import numpy
+
+context.initialize()
+
+def create_empty(**kwargs):
+    snap = data.make_snapshot(**kwargs);
+    return init.read_snapshot(snap);
+
+# These tests run HPMC with concurrent trial moves on a checkerboard of cells. They verify that
+# 1) no overlaps are introduced by moves made at the same time in different cells
+# 2) every particle makes exactly nselect trial moves per step, so that the counters are exact
+# 3) some moves are accepted and some are rejected
+class checkerboard_3d(unittest.TestCase):
+    def setUp(self):
+        self.system = create_empty(N=1000, box=data.boxdim(L=12, dimensions=3), particle_types=['A'])
+
+        #init particles on a grid
+        xs, ys, zs = numpy.meshgrid(numpy.linspace(-5.4,5.4,10),numpy.linspace(-5.4,5.4,10),numpy.linspace(-5.4,5.4,10))
+        for x,y,z,p in zip(xs.ravel(),ys.ravel(),zs.ravel(),self.system.particles):
+            p.position=(x,y,z)
+
+        self.mc = hpmc.integrate.sphere(seed=10, d=0.2, nselect=4);
+        self.mc.shape_param.set('A', diameter=1.0)
+        self.mc.set_params(checkerboard=True)
+
+    def test_moves(self):
+        run(20)
+
+        self.assertEqual(self.mc.count_overlaps(), 0)
+
+        counters = self.mc.get_counters()
+        if comm.get_num_ranks() == 1:
+            self.assertEqual(counters['move_count'], 1000*4*20)
+        self.assertGreater(counters['translate_accept_count'], 0)
+        self.assertGreater(counters['translate_reject_count'], 0)
+
+    def tearDown(self):
+        del self.mc
+        del self.system
+        context.initialize()
+
+class checkerboard_2d(unittest.TestCase):
+    def setUp(self):
+        self.system = create_empty(N=400, box=data.boxdim(L=24, dimensions=2), particle_types=['A'])
+
+        #init particles on a grid
+        xs, ys = numpy.meshgrid(numpy.linspace(-11.4,11.4,20),numpy.linspace(-11.4,11.4,20))
+        for x,y,p in zip(xs.ravel(),ys.ravel(),self.system.particles):
+            p.position=(x,y,0)
+            p.orientation=(1,0,0,0)
+
+        self.mc = hpmc.integrate.convex_polygon(seed=10, d=0.2, a=0.2, nselect=2);
+        self.mc.shape_param.set('A', vertices=[(-0.5,-0.5),(0.5,-0.5),(0.5,0.5),(-0.5,0.5)])
+        self.mc.set_params(checkerboard=True)
+
+    def test_moves(self):
+        run(20)
+
+        self.assertEqual(self.mc.count_overlaps(), 0)
+
+        counters = self.mc.get_counters()
+        if comm.get_num_ranks() == 1:
+            self.assertEqual(counters['move_count'], 400*2*20)
+        self.assertGreater(counters['translate_accept_count'], 0)
+        self.assertGreater(counters['rotate_accept_count'], 0)
+
+    def tearDown(self):
+        del self.mc
+        del self.system
+        context.initialize()
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
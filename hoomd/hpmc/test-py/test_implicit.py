@@ -230,5 +230,59 @@ class implicit_test_cube(unittest.TestCase):
         context.initialize();
 
 
+# The depletants of a trial move are inserted concurrently. Every depletant draws from its own random number
+# stream, so the trajectory and the acceptance counts must not depend on the number of threads.
+class implicit_test_threads(unittest.TestCase):
+    def setUp(self):
+        self.num_threads = context.exec_conf.getNumThreads()
+
+    def run_implicit(self, num_threads, ntrial):
+        option.set_num_threads(num_threads)
+
+        system = init.create_lattice(unitcell=lattice.sc(a=1.3), n=8)
+        system.particles.types.add('B')
+
+        mc = hpmc.integrate.sphere(seed=123, d=0.1, implicit=True)
+        q = 0.5
+        etap = 0.5
+        mc.set_params(nR=etap/(math.pi/6.0*math.pow(q,3.0)), depletant_type='B')
+        if ntrial > 0:
+            mc.set_params(ntrial=ntrial)
+
+        mc.shape_param.set('A', diameter=1.0)
+        mc.shape_param.set('B', diameter=q)
+
+        run(20)
+
+        self.assertEqual(mc.count_overlaps(), 0)
+        counters = mc.get_counters()
+        snap = system.take_snapshot()
+
+        del mc
+        del system
+        context.initialize()
+        return snap, counters
+
+    def check_threads(self, ntrial):
+        snap_1, counters_1 = self.run_implicit(1, ntrial)
+        snap_n, counters_n = self.run_implicit(4, ntrial)
+
+        self.assertGreater(counters_1['translate_accept_count'], 0)
+        self.assertGreater(counters_1['translate_reject_count'], 0)
+        self.assertEqual(counters_1['translate_accept_count'], counters_n['translate_accept_count'])
+        self.assertEqual(counters_1['translate_reject_count'], counters_n['translate_reject_count'])
+
+        if comm.get_rank() == 0:
+            self.assertEqual(snap_1.particles.position.tolist(), snap_n.particles.position.tolist())
+
+    def test_threads(self):
+        self.check_threads(ntrial=0)
+
+    def test_threads_ntrial(self):
+        self.check_threads(ntrial=5)
+
+    def tearDown(self):
+        option.set_num_threads(self.num_threads)
+
 if __name__ == '__main__':
     unittest.main(argv = ['test.py', '-v'])
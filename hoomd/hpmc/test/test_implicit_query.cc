@@ -0,0 +1,125 @@
+
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/test/upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+#include "hoomd/extern/saruprng.h"
+#include "hoomd/AABBTree.h"
+#include "hoomd/VectorMath.h"
+
+#include "hoomd/hpmc/ShapeSphere.h"
+#include "hoomd/hpmc/IntegratorHPMCMonoImplicit.h"
+
+#include <iostream>
+#include <vector>
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+using namespace hpmc;
+using namespace hpmc::detail;
+
+//! Test whether a depletant overlaps any of the colloids
+bool overlap_any(const vec3<Scalar>& pos_test, const ShapeSphere& shape_test, const std::vector<unsigned int>& colloids,
+    const std::vector< vec3<Scalar> >& pos, const ShapeSphere& shape_colloid)
+    {
+    unsigned int err = 0;
+    for (unsigned int n = 0; n < colloids.size(); n++)
+        {
+        if (test_overlap(pos[colloids[n]] - pos_test, shape_test, shape_colloid, err))
+            return true;
+        }
+    return false;
+    }
+
+/*! The implicit depletant integrator tests all depletants of a trial move against the colloids found with a single
+    tree query around the insertion sphere. Check that this finds the same free volume as querying the tree with the
+    bounding box of every depletant.
+*/
+UP_TEST( colloid_query_radius )
+    {
+    const unsigned int N = 1000;
+    const unsigned int n_depletants = 20;
+    Saru rng(1);
+
+    sph_params colloid_params;
+    colloid_params.radius = OverlapReal(0.5);
+    colloid_params.ignore = 0;
+    ShapeSphere shape_colloid(quat<Scalar>(), colloid_params);
+
+    sph_params depletant_params;
+    depletant_params.radius = OverlapReal(0.25);
+    depletant_params.ignore = 0;
+    ShapeSphere shape_depletant(quat<Scalar>(), depletant_params);
+
+    // random colloids, overlaps between them do not matter here
+    std::vector< vec3<Scalar> > pos(N);
+    std::vector<AABB> aabbs(N);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        pos[i] = vec3<Scalar>(rng.f(), rng.f(), rng.f()) * Scalar(12.0);
+        aabbs[i] = shape_colloid.getAABB(pos[i]);
+        }
+
+    AABBTree tree;
+    tree.buildTree(&aabbs.front(), N);
+
+    // the insertion sphere and query radius as set up by the integrator
+    Scalar d_max = shape_colloid.getCircumsphereDiameter() + shape_depletant.getCircumsphereDiameter();
+    Scalar r_query = IntegratorHPMCMonoImplicit<ShapeSphere>::getColloidQueryRadius(d_max,
+        shape_depletant.getCircumsphereDiameter());
+
+    unsigned int free_volume_list = 0;
+    unsigned int free_volume_tree = 0;
+    unsigned int overlap_old = 0;
+    std::vector<unsigned int> colloids;
+    std::vector<unsigned int> hits;
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        // trial move of colloid i, the tree holds the old configuration
+        vec3<Scalar> pos_i = pos[i] + (vec3<Scalar>(rng.f(), rng.f(), rng.f()) - vec3<Scalar>(0.5,0.5,0.5)) * Scalar(0.6);
+
+        // the colloids near the insertion sphere, found once per move
+        colloids.clear();
+        tree.query(colloids, AABB(pos_i, r_query));
+
+        for (unsigned int k = 0; k < n_depletants; k++)
+            {
+            // random depletant position in the insertion sphere
+            vec3<Scalar> r;
+            do
+                {
+                r = (vec3<Scalar>(rng.f(), rng.f(), rng.f()) - vec3<Scalar>(0.5,0.5,0.5)) * d_max;
+                } while (dot(r,r) > Scalar(0.25)*d_max*d_max);
+            vec3<Scalar> pos_test = pos_i + r;
+
+            // only depletants that overlap the colloid in its new position are tested against the old configuration
+            unsigned int err = 0;
+            if (!test_overlap(pos_i - pos_test, shape_depletant, shape_colloid, err))
+                continue;
+
+            // the per-depletant tree query
+            hits.clear();
+            tree.query(hits, shape_depletant.getAABB(pos_test));
+            bool overlap_tree = overlap_any(pos_test, shape_depletant, hits, pos, shape_colloid);
+
+            bool overlap_list = overlap_any(pos_test, shape_depletant, colloids, pos, shape_colloid);
+
+            if (!overlap_tree)
+                free_volume_tree++;
+            else
+                overlap_old++;
+
+            if (!overlap_list)
+                free_volume_list++;
+            }
+        }
+
+    UP_ASSERT_EQUAL(free_volume_list, free_volume_tree);
+
+    // sanity check: both outcomes occur
+    UP_ASSERT(free_volume_tree > 0);
+    UP_ASSERT(overlap_old > 0);
+    }
@@ -253,7 +253,7 @@ def read_snapshot(snapshot):
     _perform_common_init_tasks();
     return hoomd.data.system_data(hoomd.context.current.system_definition);
 
-def read_gsd(filename, restart = None, frame = 0, time_step = None):
+def read_gsd(filename, restart = None, frame = 0, time_step = None, distributed = False):
     R""" Read initial system state from an GSD file.
 
     Args:
@@ -261,6 +261,7 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
         restart (str): If it exists, read the file *restart* instead of *filename*.
         frame (int): Index of the frame to read from the GSD file.
         time_step (int): (if specified) Time step number to initialize instead of the one stored in the GSD file.
+        distributed (bool): When True, every MPI rank reads the particles in its own domain from the file.
 
     All particles, bonds, angles, dihedrals, impropers, constraints, and box information
     are read from the given GSD file at the given frame index. To read and write GSD files
@@ -272,6 +273,12 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     If *time_step* is specified, its value will be used as the initial time
     step of the simulation instead of the one read from the GSD file.
 
+    By default, the root rank reads the whole frame and distributes the particles to the other ranks. With
+    *distributed=True*, every rank memory maps the file, scans the positions, and reads only the particles in its
+    own domain, so initialization runs in parallel and no rank needs memory for the whole system. Bonds, angles,
+    dihedrals, impropers, constraints, and pairs are still read on the root rank. All ranks must be able to access
+    the file. In single rank simulations, *distributed* has no effect.
+
     The result of :py:func:`hoomd.init.read_gsd` can be saved in a variable and later used to read and/or
     change particle properties later in the script. See :py:mod:`hoomd.data` for more information.
 
@@ -288,21 +295,31 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
         raise RuntimeError("Error initializing");
 
     if restart is not None and os.path.exists(restart):
-        reader = _hoomd.GSDReader(hoomd.context.exec_conf, restart, frame);
+        filename = restart;
+
+    if distributed and _hoomd.is_MPI_available() and hoomd.context.exec_conf.getNRanks() > 1:
+        # all ranks open the file, use the name from the root rank
+        filename = _hoomd.mpi_bcast_str(filename, hoomd.context.exec_conf);
+        reader = _hoomd.GSDReader(hoomd.context.exec_conf, filename, frame, True);
+        if time_step is None:
+            time_step = reader.getTimeStep();
+
+        my_domain_decomposition = _create_domain_decomposition(reader.getGlobalBox());
+        hoomd.context.current.system_definition = reader.createSystemDefinition(hoomd.context.exec_conf, my_domain_decomposition);
     else:
         reader = _hoomd.GSDReader(hoomd.context.exec_conf, filename, frame);
-    snapshot = reader.getSnapshot();
-    if time_step is None:
-        time_step = reader.getTimeStep();
+        snapshot = reader.getSnapshot();
+        if time_step is None:
+            time_step = reader.getTimeStep();
 
-    # broadcast snapshot metadata so that all ranks have _global_box (the user may have set box only on rank 0)
-    snapshot._broadcast(hoomd.context.exec_conf);
-    my_domain_decomposition = _create_domain_decomposition(snapshot._global_box);
+        # broadcast snapshot metadata so that all ranks have _global_box (the user may have set box only on rank 0)
+        snapshot._broadcast(hoomd.context.exec_conf);
+        my_domain_decomposition = _create_domain_decomposition(snapshot._global_box);
 
-    if my_domain_decomposition is not None:
-        hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.exec_conf, my_domain_decomposition);
-    else:
-        hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.exec_conf);
+        if my_domain_decomposition is not None:
+            hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.exec_conf, my_domain_decomposition);
+        else:
+            hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.exec_conf);
 
     # initialize the system
     hoomd.context.current.system = _hoomd.System(hoomd.context.current.system_definition, time_step);
@@ -358,6 +375,7 @@ def _perform_common_init_tasks():
 
             # set Communicator in C++ System
             hoomd.context.current.system.setCommunicator(cpp_communicator)
+            hoomd.context.current.communicator = cpp_communicator
 
 ## Create a DomainDecomposition object
 # \internal
@@ -152,6 +152,10 @@ void BondTablePotential::computeForces(unsigned int timestep)
     // start the profile for this compute
     if (m_prof) m_prof->push("Bond Table pair");
 
+    // bonds that share no particle are computed concurrently
+    const unsigned int num_threads = m_exec_conf->getNumThreads();
+    if (num_threads > 1)
+        m_bond_data->updateColoring();
 
     // access the particle data
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
@@ -176,12 +180,15 @@ void BondTablePotential::computeForces(unsigned int timestep)
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::read);
 
-    // for each of the bonds
-    const unsigned int size = (unsigned int)m_bond_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    // access the bond table
+    ArrayHandle<BondData::members_t> h_bonds(m_bond_data->getMembersArray(), access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_bond_data->getTypeValArray(), access_location::host, access_mode::read);
+
+    // computes a single bond, only the forces on its members are written
+    auto compute_bond = [&](unsigned int i)
         {
         // lookup the tag of each of the particles participating in the bond
-        const BondData::members_t bond = m_bond_data->getMembersByIndex(i);
+        const BondData::members_t bond = h_bonds.data[i];
         assert(bond.tag[0] < m_pdata->getN());
         assert(bond.tag[1] < m_pdata->getN());
 
@@ -192,13 +199,9 @@ void BondTablePotential::computeForces(unsigned int timestep)
         assert(idx_a <= m_pdata->getMaximumTag());
         assert(idx_b <= m_pdata->getMaximumTag());
 
-        // throw an error if this bond is incomplete
+        // an incomplete bond is reported after the loop, errors can not be raised on a worker thread
         if (idx_a == NOT_LOCAL || idx_b == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error() << "bond.table: bond " <<
-                bond.tag[0] << " " << bond.tag[1] << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in bond calculation");
-            }
+            return false;
         assert(idx_a <= m_pdata->getN() + m_pdata->getNGhosts());
         assert(idx_b <= m_pdata->getN() + m_pdata->getNGhosts());
 
@@ -211,7 +214,7 @@ void BondTablePotential::computeForces(unsigned int timestep)
         dx = box.minImage(dx);
 
         // access needed parameters
-        unsigned int type = m_bond_data->getTypeByIndex(i);
+        unsigned int type = h_typeval.data[i].type;
         Scalar4 params = h_params.data[type];
         Scalar rmin = params.x;
         Scalar rmax = params.y;
@@ -281,12 +284,25 @@ void BondTablePotential::computeForces(unsigned int timestep)
 
             }
         else
-            {
-            m_exec_conf->msg->error() << "Table bond out of bounds" << endl;
-            throw std::runtime_error("Error in bond calculation");
-            }
+            return false;
 
+        return true;
+        };
+
+    // for each of the bonds
+    unsigned int failed = m_bond_data->forEachGroup(num_threads, compute_bond);
+    if (failed != GROUP_NOT_LOCAL)
+        {
+        // the bond either has a member that is not local, or is out of bounds
+        const BondData::members_t& bond = h_bonds.data[failed];
+        if (h_rtag.data[bond.tag[0]] == NOT_LOCAL || h_rtag.data[bond.tag[1]] == NOT_LOCAL)
+            this->m_exec_conf->msg->error() << "bond.table: bond " <<
+                bond.tag[0] << " " << bond.tag[1] << " incomplete." << endl << endl;
+        else
+            m_exec_conf->msg->error() << "Table bond out of bounds" << endl;
+        throw std::runtime_error("Error in bond calculation");
         }
+
     if (m_prof) m_prof->pop();
     }
 
@@ -113,6 +113,52 @@ class EvaluatorPairForceShiftedLJ
                 return false;
             }
 
+        #ifndef NVCC
+        //! Evaluate the force and energy for a batch of pairs
+        /*! \param rsq Squared distances of the pairs
+            \param rcutsq Squared cutoff radii of the pairs
+            \param params Per type pair parameters of the pairs
+            \param force_divr Output array for the computed forces divided by r
+            \param pair_eng Output array for the computed pair energies
+            \param energy_shift If true, the potential must be shifted so that V(r) is continuous at the cutoff
+            \param n Number of pairs in the batch
+
+            Performs the same computation as evalForceAndEnergy() on \a n pairs at once. The loop body is free of
+            branches so that the compiler can vectorize it for the host instruction set. Pairs that
+            evalForceAndEnergy() would not evaluate are assigned zero force and energy.
+        */
+        static void evalForceAndEnergyBatch(const Scalar *rsq, const Scalar *rcutsq, const param_type *params,
+                                            Scalar *force_divr, Scalar *pair_eng, bool energy_shift, unsigned int n)
+            {
+            for (unsigned int b = 0; b < n; b++)
+                {
+                const Scalar lj1 = params[b].x;
+                const Scalar lj2 = params[b].y;
+
+                Scalar r2inv = Scalar(1.0)/rsq[b];
+                Scalar r6inv = r2inv * r2inv * r2inv;
+                Scalar f = r2inv * r6inv * (Scalar(12.0)*lj1*r6inv - Scalar(6.0)*lj2);
+
+                Scalar eng = r6inv * (lj1*r6inv - lj2);
+
+                Scalar rcut2inv = Scalar(1.0)/rcutsq[b];
+                Scalar rcut6inv = rcut2inv * rcut2inv * rcut2inv;
+
+                if (energy_shift)
+                    eng -= rcut6inv * (lj1*rcut6inv - lj2);
+
+                Scalar rcut_r_inv = fast::rsqrt(rsq[b]*rcutsq[b]);
+                Scalar force_rcut_at_rcut = rcut6inv * (Scalar(12.0)*lj1*rcut6inv - Scalar(6.0)*lj2);
+                f -= rcut_r_inv * force_rcut_at_rcut;
+                eng += (rsq[b]*rcut_r_inv-Scalar(1.0))*force_rcut_at_rcut;
+
+                const bool evaluated = rsq[b] < rcutsq[b] && lj1 != 0;
+                force_divr[b] = evaluated ? f : Scalar(0.0);
+                pair_eng[b] = evaluated ? eng : Scalar(0.0);
+                }
+            }
+        #endif
+
         #ifndef NVCC
         //! Get the name of this potential
         /*! \returns The potential name. Must be short and all lowercase, as this is the name energies will be logged as
@@ -7,6 +7,7 @@
 #include "ForceDistanceConstraint.h"
 
 #include <string.h>
+#include <algorithm>
 using namespace Eigen;
 namespace py = pybind11;
 
@@ -20,7 +21,8 @@ ForceDistanceConstraint::ForceDistanceConstraint(std::shared_ptr<SystemDefinitio
         : MolecularForceCompute(sysdef), m_cdata(m_sysdef->getConstraintData()),
           m_cmatrix(m_exec_conf), m_cvec(m_exec_conf), m_lagrange(m_exec_conf),
           m_rel_tol(1e-3), m_constraint_violated(m_exec_conf), m_condition(m_exec_conf),
-          m_sparse_idxlookup(m_exec_conf), m_constraint_reorder(true), m_constraints_added_removed(true),
+          m_sparse_idxlookup(m_exec_conf), m_iterative(false), m_solver_tol(1e-10),
+          m_constraint_reorder(true), m_constraints_added_removed(true),
           m_d_max(0.0)
     {
     m_constraint_violated.resetFlags(0);
@@ -63,7 +65,6 @@ void ForceDistanceConstraint::computeForces(unsigned int timestep)
 
     // reallocate through amortized resizin
     unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
-    m_cmatrix.resize(n_constraint*n_constraint);
     m_cvec.resize(n_constraint);
 
     // populate the terms in the matrix vector equation
@@ -82,43 +83,32 @@ void ForceDistanceConstraint::computeForces(unsigned int timestep)
         m_prof->pop();
     }
 
+/*! The constraint matrix is filled in place in the compressed sparse column storage of m_sparse. The sparsity
+    pattern is rebuilt first if the constraints have changed since the last call.
+*/
 void ForceDistanceConstraint::fillMatrixVector(unsigned int timestep)
     {
-    // fill the matrix in column-major order
     unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
 
-    if (m_constraint_reorder)
-        {
-        // reset flag
-        m_constraint_reorder = false;
-
-        // resize lookup matrix
-        m_sparse_idxlookup.resize(n_constraint*n_constraint);
-
-        ArrayHandle<int> h_sparse_idxlookup(m_sparse_idxlookup, access_location::host, access_mode::overwrite);
-
-        // reset lookup matrix values to -1
-        for (unsigned int i = 0; i < n_constraint*n_constraint; ++i)
-            {
-            h_sparse_idxlookup.data[i] = -1;
-            }
-        }
-
     // access particle data
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_netforce(m_pdata->getNetForce(), access_location::host, access_mode::read);
 
-    // access matrix elements
-    ArrayHandle<double> h_cmatrix(m_cmatrix, access_location::host, access_mode::overwrite);
+    // access RHS vector
     ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::overwrite);
 
-    // clear matrix
-    memset(h_cmatrix.data, 0, sizeof(double)*m_cmatrix.size());
-
     const BoxDim& box = m_pdata->getBox();
 
+    m_constraint_idx.resize(2*n_constraint);
+    m_constraint_rn.resize(n_constraint);
+    m_constraint_qn.resize(n_constraint);
+
+    // the pattern only depends on which constraints share a particle
+    bool pattern_changed = m_constraint_reorder || m_pattern_members.size() != n_constraint;
+    m_constraint_reorder = false;
+
     unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
     for (unsigned int n = 0; n < n_constraint; ++n)
         {
@@ -139,6 +129,11 @@ void ForceDistanceConstraint::fillMatrixVector(unsigned int timestep)
             throw std::runtime_error("Error in constraint calculation");
             }
 
+        if (!pattern_changed && (m_pattern_members[n].tag[0] != constraint.tag[0]
+            || m_pattern_members[n].tag[1] != constraint.tag[1]))
+            {
+            pattern_changed = true;
+            }
 
         vec3<Scalar> ra(h_pos.data[idx_a]);
         vec3<Scalar> rb(h_pos.data[idx_b]);
@@ -155,34 +150,47 @@ void ForceDistanceConstraint::fillMatrixVector(unsigned int timestep)
         vec3<Scalar> rndot(va-vb);
         vec3<Scalar> qn(rn+rndot*m_deltaT);
 
-        // fill matrix row
-        for (unsigned int m = 0; m < n_constraint; ++m)
+        m_constraint_idx[2*n] = idx_a;
+        m_constraint_idx[2*n+1] = idx_b;
+        m_constraint_rn[n] = rn;
+        m_constraint_qn[n] = qn;
+
+        // get constraint distance
+        Scalar d = m_cdata->getValueByIndex(n);
+
+        // check distance violation
+        if (fast::sqrt(dot(rn,rn))-d >= m_rel_tol*d || std::isnan(dot(rn,rn)))
             {
-            // lookup the tag of each of the particles participating in the constraint
-            const ConstraintData::members_t constraint_m = m_cdata->getMembersByIndex(m);
-            assert(constraint_m.tag[0] <= m_pdata->getMaximumTag());
-            assert(constraint_m.tag[1] <= m_pdata->getMaximumTag());
-
-            // transform a and b into indicies into the particle data arrays
-            // (MEM TRANSFER: 4 integers)
-            unsigned int idx_m_a = h_rtag.data[constraint_m.tag[0]];
-            unsigned int idx_m_b = h_rtag.data[constraint_m.tag[1]];
-            assert(idx_m_a <= m_pdata->getN()+m_pdata->getNGhosts());
-            assert(idx_m_b <= m_pdata->getN()+m_pdata->getNGhosts());
-
-            if (idx_m_a >= max_local || idx_m_b >= max_local)
-                {
-                this->m_exec_conf->msg->error() << "constrain.distance(): constraint " <<
-                    constraint_m.tag[0] << " " << constraint_m.tag[1] << " incomplete." << std::endl << std::endl;
-                throw std::runtime_error("Error in constraint calculation");
-                }
+            m_constraint_violated.resetFlags(n+1);
+            }
+
+        // fill vector component
+        h_cvec.data[n] = (dot(qn,qn)-d*d)/m_deltaT/m_deltaT;
+        h_cvec.data[n] += double(2.0)*dot(qn,vec3<Scalar>(h_netforce.data[idx_a])/ma
+              -vec3<Scalar>(h_netforce.data[idx_b])/mb);
+        }
 
-            vec3<Scalar> rm_a(h_pos.data[idx_m_a]);
-            vec3<Scalar> rm_b(h_pos.data[idx_m_b]);
-            vec3<Scalar> rm(rm_a-rm_b);
+    if (pattern_changed)
+        buildSparsityPattern();
 
-            // apply minimum image
-            rm = box.minImage(rm);
+    // fill the non-zero matrix elements, column by column
+    double *values = m_sparse.valuePtr();
+    const int *outer = m_sparse.outerIndexPtr();
+    const int *inner = m_sparse.innerIndexPtr();
+    for (unsigned int m = 0; m < n_constraint; ++m)
+        {
+        unsigned int idx_m_a = m_constraint_idx[2*m];
+        unsigned int idx_m_b = m_constraint_idx[2*m+1];
+        const vec3<Scalar>& rm = m_constraint_rn[m];
+
+        for (int k = outer[m]; k < outer[m+1]; ++k)
+            {
+            unsigned int n = inner[k];
+            unsigned int idx_a = m_constraint_idx[2*n];
+            unsigned int idx_b = m_constraint_idx[2*n+1];
+            Scalar ma(h_vel.data[idx_a].w);
+            Scalar mb(h_vel.data[idx_b].w);
+            const vec3<Scalar>& qn = m_constraint_qn[n];
 
             double delta(0.0);
             if (idx_m_a == idx_a)
@@ -202,38 +210,68 @@ void ForceDistanceConstraint::fillMatrixVector(unsigned int timestep)
                 delta += double(4.0)*dot(qn,rm)/mb;
                 }
 
-            h_cmatrix.data[m*n_constraint+n] += delta;
+            values[k] = delta;
+            }
+        }
+    }
 
-            // update sparse matrix
-            int k = m_sparse_idxlookup[m*n_constraint+n];
+/*! The element (n,m) of the constraint matrix can only be non-zero if the constraints n and m share a particle.
+    Because that relation is symmetric, the rows in column m are the constraints that share a particle with m.
 
-            if ( (k == -1 && delta != double(0.0))
-                || (k != -1 && delta == double(0.0)))
-                {
-                m_condition.resetFlags(1);
-                }
+    \pre m_constraint_idx holds the particle indices of the current constraints
+*/
+void ForceDistanceConstraint::buildSparsityPattern()
+    {
+    unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
+    unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
 
-            if (k != -1)
-                {
-                // update sparse matrix value directly
-                m_sparse.valuePtr()[k] = delta;
-                }
-            }
+    m_exec_conf->msg->notice(6) << "ForceDistanceConstraint: building sparsity pattern" << std::endl;
 
-        // get constraint distance
-        Scalar d = m_cdata->getValueByIndex(n);
+    // list the constraints of every particle, in compressed row format
+    std::vector<unsigned int> ptl_offset(max_local+1, 0);
+    for (unsigned int i = 0; i < 2*n_constraint; ++i)
+        ptl_offset[m_constraint_idx[i]+1]++;
+    for (unsigned int i = 0; i < max_local; ++i)
+        ptl_offset[i+1] += ptl_offset[i];
 
-        // check distance violation
-        if (fast::sqrt(dot(rn,rn))-d >= m_rel_tol*d || std::isnan(dot(rn,rn)))
+    std::vector<unsigned int> ptl_constraints(2*n_constraint);
+        {
+        std::vector<unsigned int> cursor(ptl_offset.begin(), ptl_offset.end()-1);
+        for (unsigned int i = 0; i < 2*n_constraint; ++i)
+            ptl_constraints[cursor[m_constraint_idx[i]]++] = i/2;
+        }
+
+    std::vector< Triplet<double> > triplets;
+    triplets.reserve(4*n_constraint);
+    std::vector<unsigned int> rows;
+    for (unsigned int m = 0; m < n_constraint; ++m)
+        {
+        rows.clear();
+        for (unsigned int j = 0; j < 2; ++j)
             {
-            m_constraint_violated.resetFlags(n+1);
+            unsigned int idx = m_constraint_idx[2*m+j];
+            rows.insert(rows.end(), ptl_constraints.begin() + ptl_offset[idx],
+                ptl_constraints.begin() + ptl_offset[idx+1]);
             }
 
-        // fill vector component
-        h_cvec.data[n] = (dot(qn,qn)-d*d)/m_deltaT/m_deltaT;
-        h_cvec.data[n] += double(2.0)*dot(qn,vec3<Scalar>(h_netforce.data[idx_a])/ma
-              -vec3<Scalar>(h_netforce.data[idx_b])/mb);
+        std::sort(rows.begin(), rows.end());
+        rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+        for (unsigned int i = 0; i < rows.size(); ++i)
+            triplets.push_back(Triplet<double>(rows[i], m, 0.0));
         }
+
+    m_sparse.resize(n_constraint, n_constraint);
+    m_sparse.setFromTriplets(triplets.begin(), triplets.end());
+    m_sparse.makeCompressed();
+
+    // remember the constraints the pattern belongs to
+    m_pattern_members.resize(n_constraint);
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        m_pattern_members[n] = m_cdata->getMembersByIndex(n);
+
+    // the solver needs to analyze the new pattern
+    m_condition.resetFlags(1);
     }
 
 void ForceDistanceConstraint::checkConstraints(unsigned int timestep)
@@ -262,12 +300,12 @@ void ForceDistanceConstraint::checkConstraints(unsigned int timestep)
         }
     }
 
+/*! Solves the sparse system in m_sparse for the Lagrange multipliers. The symbolic analysis of the LU
+    decomposition is reused until m_condition signals a change of the sparsity pattern.
+*/
 void ForceDistanceConstraint::solveConstraints(unsigned int timestep)
     {
-    // use Eigen dense matrix algebra (slow for large matrices)
-    typedef Matrix<double, Dynamic, Dynamic, ColMajor> matrix_t;
     typedef Matrix<double, Dynamic, 1> vec_t;
-    typedef Map<matrix_t> matrix_map_t;
     typedef Map<vec_t> vec_map_t;
 
     unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
@@ -290,80 +328,69 @@ void ForceDistanceConstraint::solveConstraints(unsigned int timestep)
         // reset flags
         m_condition.resetFlags(0);
 
-        if (m_prof)
-            m_prof->push("LU");
-
-        // access matrix
-        ArrayHandle<double> h_cmatrix(m_cmatrix, access_location::host, access_mode::read);
-
-        // wrap array
-        matrix_map_t map_matrix(h_cmatrix.data, n_constraint,n_constraint);
-
-        // sparsity pattern changed
-        m_sparse = map_matrix.sparseView();
-
+        if (!m_iterative)
             {
-            ArrayHandle<int> h_sparse_idxlookup(m_sparse_idxlookup, access_location::host, access_mode::overwrite);
+            if (m_prof)
+                m_prof->push("LU");
 
-            // reset lookup matrix values to -1
-            for (unsigned int i = 0; i < n_constraint*n_constraint; ++i)
-                {
-                h_sparse_idxlookup.data[i] = -1;
-                }
+            // Compute the ordering permutation vector from the structural pattern of A
+            m_sparse_solver.analyzePattern(m_sparse);
 
-            // construct lookup table
-            int *inner_non_zeros = m_sparse.innerNonZeroPtr();
-            int *outer = m_sparse.outerIndexPtr();
-            int *inner = m_sparse.innerIndexPtr();
-            for (int i = 0; i < m_sparse.outerSize(); ++i)
-                {
-                int id = outer[i];
-                int end;
-
-                if(m_sparse.isCompressed())
-                    end = outer[i+1];
-                else
-                    end = id + inner_non_zeros[i];
-
-                for (; id < end; ++id)
-                    {
-                    unsigned int col = i;
-                    unsigned int row = inner[id];
-
-                    // set pointer to index in sparse_val
-                    h_sparse_idxlookup.data[col*n_constraint+row] = id;
-                    }
-                }
+            if (m_prof)
+                m_prof->pop();
             }
+        }
 
-        // Compute the ordering permutation vector from the structural pattern of A
-        m_sparse_solver.analyzePattern(m_sparse);
+    // access RHS and solution vector
+    ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::read);
+    ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::readwrite);
+    vec_map_t map_vec(h_cvec.data, n_constraint, 1);
+    vec_map_t map_lagrange(h_lagrange.data,n_constraint, 1);
 
+    if (m_iterative)
+        {
         if (m_prof)
-            m_prof->pop();
-        }
+            m_prof->push("iterate");
 
+        m_iterative_solver.setTolerance(m_solver_tol);
+        m_iterative_solver.compute(m_sparse);
 
-    if (m_prof)
-        m_prof->push("refactor/solve");
-
-    // Compute the numerical factorization
-    m_sparse_solver.factorize(m_sparse);
+        if (sparsity_pattern_changed)
+            {
+            // the multipliers of the previous step belong to different constraints
+            map_lagrange = m_iterative_solver.solve(map_vec);
+            }
+        else
+            {
+            // start from the multipliers of the previous step
+            vec_t guess = map_lagrange;
+            map_lagrange = m_iterative_solver.solveWithGuess(map_vec, guess);
+            }
 
-    if (m_sparse_solver.info())
-        {
-        m_exec_conf->msg->error() << "Could not solve linear system of constraint equations." << std::endl;
-        throw std::runtime_error("Error evaluating constraint forces.\n");
+        if (m_iterative_solver.info() != Success)
+            {
+            m_exec_conf->msg->error() << "Iterative solution of the constraint equations did not converge after "
+                                      << m_iterative_solver.iterations() << " iterations." << std::endl;
+            throw std::runtime_error("Error evaluating constraint forces.\n");
+            }
         }
+    else
+        {
+        if (m_prof)
+            m_prof->push("refactor/solve");
 
-    // access RHS and solution vector
-    ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::read);
-    ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::overwrite);
-    vec_map_t map_vec(h_cvec.data, n_constraint, 1);
-    vec_map_t map_lagrange(h_lagrange.data,n_constraint, 1);
+        // Compute the numerical factorization
+        m_sparse_solver.factorize(m_sparse);
+
+        if (m_sparse_solver.info())
+            {
+            m_exec_conf->msg->error() << "Could not solve linear system of constraint equations." << std::endl;
+            throw std::runtime_error("Error evaluating constraint forces.\n");
+            }
 
-    //Use the factors to solve the linear system
-    map_lagrange = m_sparse_solver.solve(map_vec);
+        //Use the factors to solve the linear system
+        map_lagrange = m_sparse_solver.solve(map_vec);
+        }
 
     if (m_prof)
         m_prof->pop();
@@ -596,5 +623,7 @@ void export_ForceDistanceConstraint(py::module& m)
     py::class_< ForceDistanceConstraint, std::shared_ptr<ForceDistanceConstraint> >(m, "ForceDistanceConstraint", py::base<MolecularForceCompute>())
         .def(py::init< std::shared_ptr<SystemDefinition> >())
         .def("setRelativeTolerance", &ForceDistanceConstraint::setRelativeTolerance)
+        .def("setIterative", &ForceDistanceConstraint::setIterative)
+        .def("setSolverTolerance", &ForceDistanceConstraint::setSolverTolerance)
     ;
     }
@@ -24,12 +24,21 @@
 
 #include "hoomd/extern/Eigen/Dense"
 #include "hoomd/extern/Eigen/SparseLU"
+#include "hoomd/extern/Eigen/IterativeLinearSolvers"
+
+#include <vector>
 
 /*! Implements a pairwise distance constraint using the algorithm of
 
     [1] M. Yoneya, H. J. C. Berendsen, and K. Hirasawa, “A Non-Iterative Matrix Method for Constraint Molecular Dynamics Simulations,” Mol. Simul., vol. 13, no. 6, pp. 395–405, 1994.
     [2] M. Yoneya, “A Generalized Non-iterative Matrix Method for Constraint Molecular Dynamics Simulations,” J. Comput. Phys., vol. 172, no. 1, pp. 188–197, Sep. 2001.
 
+    On the CPU, the constraint matrix is assembled directly in sparse form. Its element (n,m) can only be non-zero if
+    the constraints n and m share a particle, so the sparsity pattern is built from the constraint topology and only
+    rebuilt (and re-analyzed by the solver) when the constraints change. The linear system is solved with a sparse LU
+    decomposition, or optionally with a Jacobi preconditioned BiCGSTAB iteration that starts from the Lagrange
+    multipliers of the previous step.
+
     See Integrator for detailed documentation on constraint force implementation.
     \ingroup computes
 */
@@ -54,6 +63,21 @@ class ForceDistanceConstraint : public MolecularForceCompute
             m_rel_tol = rel_tol;
             }
 
+        //! Select the iterative solver instead of the sparse LU decomposition
+        void setIterative(bool iterative)
+            {
+            m_iterative = iterative;
+
+            // the LU decomposition needs to analyze the pattern again
+            m_condition.resetFlags(1);
+            }
+
+        //! Set the relative residual tolerance of the iterative solver
+        void setSolverTolerance(Scalar tol)
+            {
+            m_solver_tol = tol;
+            }
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
@@ -65,7 +89,7 @@ class ForceDistanceConstraint : public MolecularForceCompute
     protected:
         std::shared_ptr<ConstraintData> m_cdata; //! The constraint data
 
-        GPUVector<double> m_cmatrix;                //!< The matrix for the constraint force equation (column-major)
+        GPUVector<double> m_cmatrix;                //!< The dense constraint matrix (column-major), GPU only
         GPUVector<double> m_cvec;                   //!< The vector on the RHS of the constraint equation
         GPUVector<double> m_lagrange;               //!< The solution for the lagrange multipliers
 
@@ -77,6 +101,15 @@ class ForceDistanceConstraint : public MolecularForceCompute
         Eigen::SparseLU<Eigen::SparseMatrix<double, Eigen::ColMajor>, Eigen::COLAMDOrdering<int> > m_sparse_solver;
             //!< The persistent state of the sparse matrix solver
         GPUVector<int> m_sparse_idxlookup;          //!< Reverse lookup from column-major to sparse matrix element
+        Eigen::BiCGSTAB<Eigen::SparseMatrix<double, Eigen::ColMajor>, Eigen::DiagonalPreconditioner<double> >
+            m_iterative_solver;                     //!< The iterative solver
+        bool m_iterative;                           //!< True if the iterative solver is used
+        Scalar m_solver_tol;                        //!< Relative residual tolerance of the iterative solver
+
+        std::vector<ConstraintData::members_t> m_pattern_members; //!< Constraints the sparsity pattern was built for
+        std::vector<unsigned int> m_constraint_idx; //!< Particle indices of every constraint (2 per constraint)
+        std::vector< vec3<Scalar> > m_constraint_rn; //!< Current separation of every constraint
+        std::vector< vec3<Scalar> > m_constraint_qn; //!< Separation of every constraint after an unconstrained step
 
         bool m_constraint_reorder;         //!< True if groups have changed
         bool m_constraints_added_removed;  //!< True if global constraint topology has changed
@@ -89,6 +122,9 @@ class ForceDistanceConstraint : public MolecularForceCompute
         //! Populate the quantities in the constraint-force equatino
         virtual void fillMatrixVector(unsigned int timestep);
 
+        //! Build the sparsity pattern of the constraint matrix
+        void buildSparsityPattern();
+
         //! Check violation of constraints
         virtual void checkConstraints(unsigned int timestep);
 
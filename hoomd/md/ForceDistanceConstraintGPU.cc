@@ -96,6 +96,9 @@ void ForceDistanceConstraintGPU::fillMatrixVector(unsigned int timestep)
     // fill the matrix in row-major order
     unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
 
+    // the dense matrix is only needed on the GPU
+    m_cmatrix.resize(n_constraint*n_constraint);
+
     if (m_constraint_reorder)
         {
         // reset flag
@@ -192,6 +195,44 @@ void ForceDistanceConstraintGPU::solveConstraints(unsigned int timestep)
         ArrayHandle<double> h_sparse_val(m_sparse_val, access_location::device, access_mode::read);
         cudaMemcpy(m_sparse.valuePtr(), h_sparse_val.data, sizeof(double)*m_sparse.data().size(),cudaMemcpyDeviceToHost);
         }
+    else
+        {
+        typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> matrix_t;
+        typedef Eigen::Map<matrix_t> matrix_map_t;
+
+        unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
+
+        // access matrix
+        ArrayHandle<double> h_cmatrix(m_cmatrix, access_location::host, access_mode::read);
+
+        // sparsity pattern changed, convert the dense matrix filled on the GPU
+        matrix_map_t map_matrix(h_cmatrix.data, n_constraint,n_constraint);
+        m_sparse = map_matrix.sparseView();
+        m_sparse.makeCompressed();
+
+        ArrayHandle<int> h_sparse_idxlookup(m_sparse_idxlookup, access_location::host, access_mode::overwrite);
+
+        // reset lookup matrix values to -1
+        for (unsigned int i = 0; i < n_constraint*n_constraint; ++i)
+            {
+            h_sparse_idxlookup.data[i] = -1;
+            }
+
+        // construct lookup table
+        int *outer = m_sparse.outerIndexPtr();
+        int *inner = m_sparse.innerIndexPtr();
+        for (int i = 0; i < m_sparse.outerSize(); ++i)
+            {
+            for (int id = outer[i]; id < outer[i+1]; ++id)
+                {
+                unsigned int col = i;
+                unsigned int row = inner[id];
+
+                // set pointer to index in sparse_val
+                h_sparse_idxlookup.data[col*n_constraint+row] = id;
+                }
+            }
+        }
 
     // solve on CPU
     ForceDistanceConstraint::solveConstraints(timestep);
@@ -116,6 +116,11 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
     {
     if (m_prof) m_prof->push("Harmonic Angle");
 
+    // angles that share no particle are computed concurrently
+    const unsigned int num_threads = m_exec_conf->getNumThreads();
+    if (num_threads > 1)
+        m_angle_data->updateColoring();
+
     assert(m_pdata);
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
@@ -138,12 +143,15 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getGlobalBox();
 
-    // for each of the angles
-    const unsigned int size = (unsigned int)m_angle_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    // access the angle table
+    ArrayHandle<AngleData::members_t> h_angles(m_angle_data->getMembersArray(), access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_angle_data->getTypeValArray(), access_location::host, access_mode::read);
+
+    // computes a single angle, only the forces on its members are written
+    auto compute_angle = [&](unsigned int i)
         {
         // lookup the tag of each of the particles participating in the angle
-        const AngleData::members_t& angle = m_angle_data->getMembersByIndex(i);
+        const AngleData::members_t& angle = h_angles.data[i];
         assert(angle.tag[0] <= m_pdata->getMaximumTag());
         assert(angle.tag[1] <= m_pdata->getMaximumTag());
         assert(angle.tag[2] <= m_pdata->getMaximumTag());
@@ -154,13 +162,9 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
         unsigned int idx_b = h_rtag.data[angle.tag[1]];
         unsigned int idx_c = h_rtag.data[angle.tag[2]];
 
-        // throw an error if this angle is incomplete
+        // an incomplete angle is reported after the loop, errors can not be raised on a worker thread
         if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error() << "angle.harmonic: angle " <<
-                angle.tag[0] << " " << angle.tag[1] << " " << angle.tag[2] << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in angle calculation");
-            }
+            return false;
 
         assert(idx_a < m_pdata->getN()+m_pdata->getNGhosts());
         assert(idx_b < m_pdata->getN()+m_pdata->getNGhosts());
@@ -208,7 +212,7 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
         s_abbc = 1.0/s_abbc;
 
         // actually calculate the force
-        unsigned int angle_type = m_angle_data->getTypeByIndex(i);
+        unsigned int angle_type = h_typeval.data[i].type;
         Scalar dth = acos(c_abbc) - m_t_0[angle_type];
         Scalar tk = m_K[angle_type]*dth;
 
@@ -271,6 +275,17 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
             for (int j = 0; j < 6; j++)
                 h_virial.data[j*virial_pitch+idx_c]  += angle_virial[j];
             }
+        return true;
+        };
+
+    // for each of the angles
+    unsigned int failed = m_angle_data->forEachGroup(num_threads, compute_angle);
+    if (failed != GROUP_NOT_LOCAL)
+        {
+        const AngleData::members_t& angle = h_angles.data[failed];
+        this->m_exec_conf->msg->error() << "angle.harmonic: angle " <<
+            angle.tag[0] << " " << angle.tag[1] << " " << angle.tag[2] << " incomplete." << endl << endl;
+        throw std::runtime_error("Error in angle calculation");
         }
 
     if (m_prof) m_prof->pop();
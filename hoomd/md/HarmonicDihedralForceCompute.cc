@@ -122,6 +122,11 @@ void HarmonicDihedralForceCompute::computeForces(unsigned int timestep)
     {
     if (m_prof) m_prof->push("Harmonic Dihedral");
 
+    // dihedrals that share no particle are computed concurrently
+    const unsigned int num_threads = m_exec_conf->getNumThreads();
+    if (num_threads > 1)
+        m_dihedral_data->updateColoring();
+
     assert(m_pdata);
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
@@ -145,12 +150,15 @@ void HarmonicDihedralForceCompute::computeForces(unsigned int timestep)
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getBox();
 
-    // for each of the dihedrals
-    const unsigned int size = (unsigned int)m_dihedral_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    // access the dihedral table
+    ArrayHandle<DihedralData::members_t> h_dihedrals(m_dihedral_data->getMembersArray(), access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_dihedral_data->getTypeValArray(), access_location::host, access_mode::read);
+
+    // computes a single dihedral, only the forces on its members are written
+    auto compute_dihedral = [&](unsigned int i)
         {
         // lookup the tag of each of the particles participating in the dihedral
-        const ImproperData::members_t& dihedral = m_dihedral_data->getMembersByIndex(i);
+        const ImproperData::members_t& dihedral = h_dihedrals.data[i];
         assert(dihedral.tag[0] <= m_pdata->getMaximumTag());
         assert(dihedral.tag[1] <= m_pdata->getMaximumTag());
         assert(dihedral.tag[2] <= m_pdata->getMaximumTag());
@@ -163,14 +171,9 @@ void HarmonicDihedralForceCompute::computeForces(unsigned int timestep)
         unsigned int idx_c = h_rtag.data[dihedral.tag[2]];
         unsigned int idx_d = h_rtag.data[dihedral.tag[3]];
 
-        // throw an error if this angle is incomplete
+        // an incomplete dihedral is reported after the loop, errors can not be raised on a worker thread
         if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL || idx_d == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error() << "dihedral.harmonic: dihedral " <<
-                dihedral.tag[0] << " " << dihedral.tag[1] << " " << dihedral.tag[2] << " " << dihedral.tag[3]
-                << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in dihedral calculation");
-            }
+            return false;
 
         assert(idx_a < m_pdata->getN() + m_pdata->getNGhosts());
         assert(idx_b < m_pdata->getN() + m_pdata->getNGhosts());
@@ -231,7 +234,7 @@ void HarmonicDihedralForceCompute::computeForces(unsigned int timestep)
         if (c_abcd > 1.0) c_abcd = 1.0;
         if (c_abcd < -1.0) c_abcd = -1.0;
 
-        unsigned int dihedral_type = m_dihedral_data->getTypeByIndex(i);
+        unsigned int dihedral_type = h_typeval.data[i].type;
         int multi = (int)m_multi[dihedral_type];
         Scalar p = Scalar(1.0);
         Scalar dfab = Scalar(0.0);
@@ -345,7 +348,19 @@ void HarmonicDihedralForceCompute::computeForces(unsigned int timestep)
         h_force.data[idx_d].w += dihedral_eng;
         for (int k = 0; k < 6; k++)
            h_virial.data[virial_pitch*k+idx_d]  += dihedral_virial[k];
-       }
+        return true;
+        };
+
+    // for each of the dihedrals
+    unsigned int failed = m_dihedral_data->forEachGroup(num_threads, compute_dihedral);
+    if (failed != GROUP_NOT_LOCAL)
+        {
+        const ImproperData::members_t& dihedral = h_dihedrals.data[failed];
+        this->m_exec_conf->msg->error() << "dihedral.harmonic: dihedral " <<
+            dihedral.tag[0] << " " << dihedral.tag[1] << " " << dihedral.tag[2] << " " << dihedral.tag[3]
+            << " incomplete." << endl << endl;
+        throw std::runtime_error("Error in dihedral calculation");
+        }
 
     if (m_prof) m_prof->pop();
     }
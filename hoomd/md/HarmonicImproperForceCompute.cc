@@ -115,6 +115,11 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
     {
     if (m_prof) m_prof->push("Harmonic Improper");
 
+    // impropers that share no particle are computed concurrently
+    const unsigned int num_threads = m_exec_conf->getNumThreads();
+    if (num_threads > 1)
+        m_improper_data->updateColoring();
+
     assert(m_pdata);
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
@@ -137,12 +142,15 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getBox();
 
-    // for each of the impropers
-    const unsigned int size = (unsigned int)m_improper_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    // access the improper table
+    ArrayHandle<ImproperData::members_t> h_impropers(m_improper_data->getMembersArray(), access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_improper_data->getTypeValArray(), access_location::host, access_mode::read);
+
+    // computes a single improper, only the forces on its members are written
+    auto compute_improper = [&](unsigned int i)
         {
         // lookup the tag of each of the particles participating in the improper
-        const ImproperData::members_t& improper = m_improper_data->getMembersByIndex(i);
+        const ImproperData::members_t& improper = h_impropers.data[i];
         assert(improper.tag[0] <= m_pdata->getMaximumTag());
         assert(improper.tag[1] <= m_pdata->getMaximumTag());
         assert(improper.tag[2] <= m_pdata->getMaximumTag());
@@ -155,14 +163,9 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
         unsigned int idx_c = h_rtag.data[improper.tag[2]];
         unsigned int idx_d = h_rtag.data[improper.tag[3]];
 
-        // throw an error if this angle is incomplete
+        // an incomplete improper is reported after the loop, errors can not be raised on a worker thread
         if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL || idx_d == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error() << "improper.harmonic: improper " <<
-                improper.tag[0] << " " << improper.tag[1] << " " << improper.tag[2] << " " << improper.tag[3]
-                << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in improper calculation");
-            }
+            return false;
 
         assert(idx_a < m_pdata->getN() + m_pdata->getNGhosts());
         assert(idx_b < m_pdata->getN() + m_pdata->getNGhosts());
@@ -220,7 +223,7 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
         Scalar s = sqrt(1.0 - c*c);
         if (s < SMALL) s = SMALL;
 
-        unsigned int improper_type = m_improper_data->getTypeByIndex(i);
+        unsigned int improper_type = h_typeval.data[i].type;
         Scalar domega = acos(c) - m_chi[improper_type];
         Scalar a = m_K[improper_type] * domega;
 
@@ -311,6 +314,18 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
             for (int k = 0; k < 6; k++)
                 h_virial.data[k*virial_pitch+idx_d]  += improper_virial[k];
             }
+        return true;
+        };
+
+    // for each of the impropers
+    unsigned int failed = m_improper_data->forEachGroup(num_threads, compute_improper);
+    if (failed != GROUP_NOT_LOCAL)
+        {
+        const ImproperData::members_t& improper = h_impropers.data[failed];
+        this->m_exec_conf->msg->error() << "improper.harmonic: improper " <<
+            improper.tag[0] << " " << improper.tag[1] << " " << improper.tag[2] << " " << improper.tag[3]
+            << " incomplete." << endl << endl;
+        throw std::runtime_error("Error in improper calculation");
         }
 
     if (m_prof) m_prof->pop();
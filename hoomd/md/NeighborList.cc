@@ -10,11 +10,13 @@
 
 #include "NeighborList.h"
 #include "hoomd/BondedGroupData.h"
+#include "hoomd/StepTimer.h"
 
 namespace py = pybind11;
 
 #include <iostream>
 #include <stdexcept>
+#include <algorithm>
 
 using namespace std;
 
@@ -54,6 +56,21 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar _r_c
 
     m_need_reallocate_exlist = false;
 
+    // buffer tuning is off by default
+    m_tune_r_buff = false;
+    m_tune_r_min = m_tune_r_max = r_buff;
+    m_tune_period = 0;
+    m_tune_started = false;
+    m_tune_last_step = 0;
+    m_tune_last_time = 0;
+    m_tune_steps = 0;
+    m_tune_time = 0;
+    m_tune_build_time = 0;
+    m_tune_dr = 0;
+    m_tune_direction = 1;
+    m_tune_best_r_buff = r_buff;
+    m_tune_best_cost = -1.0;
+
     // initialize box length at last update
     m_last_L = m_pdata->getGlobalBox().getNearestPlaneDistance();
     m_last_L_local = m_pdata->getBox().getNearestPlaneDistance();
@@ -119,6 +136,12 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar _r_c
     GPUArray<unsigned int> ex_list_idx(m_pdata->getMaxN(), 1, m_exec_conf);
     m_ex_list_idx.swap(ex_list_idx);
 
+    // account the host memory of the largest arrays
+    m_nlist.setName("nlist.nlist");
+    m_n_neigh.setName("nlist.n_neigh");
+    m_head_list.setName("nlist.head_list");
+    m_last_pos.setName("nlist.last_pos");
+
     // reset exclusions
     clearExclusions();
 
@@ -200,6 +223,15 @@ NeighborList::~NeighborList()
 */
 void NeighborList::compute(unsigned int timestep)
     {
+    // measure the previous step first, the tuner may change the buffer radius
+    // with domain decomposition, this is done in peekUpdate() before the ghost particles are exchanged
+    #ifdef ENABLE_MPI
+    if (m_tune_r_buff && !m_comm)
+    #else
+    if (m_tune_r_buff)
+    #endif
+        tuneRBuff(timestep);
+
     // check if the rcut array has changed and update it
     if (m_rcut_changed)
         {
@@ -211,6 +243,7 @@ void NeighborList::compute(unsigned int timestep)
         return;
 
     if (m_prof) m_prof->push("Neighbor");
+    if (m_step_timer) m_step_timer->start(m_timer_slot);
 
     // take care of some updates if things have changed since construction
     if (m_force_update)
@@ -225,6 +258,8 @@ void NeighborList::compute(unsigned int timestep)
     // check if the list needs to be updated and update it
     if (needsUpdating(timestep))
         {
+        int64_t build_start = m_tune_r_buff ? m_tune_clk.getTime() : 0;
+
         // rebuild the list until there is no overflow
         bool overflowed = false;
         do
@@ -248,7 +283,11 @@ void NeighborList::compute(unsigned int timestep)
 
         setLastUpdatedPos();
         m_has_been_updated_once = true;
+
+        if (m_tune_r_buff)
+            m_tune_build_time += m_tune_clk.getTime() - build_start;
         }
+    if (m_step_timer) m_step_timer->stop(m_timer_slot);
     if (m_prof) m_prof->pop();
     }
 
@@ -351,6 +390,151 @@ void NeighborList::setRBuff(Scalar r_buff)
     forceUpdate();
     }
 
+/*! \param enable Set to true to tune the buffer radius during the run
+    \param r_min Smallest buffer radius to set
+    \param r_max Largest buffer radius to set
+    \param period Number of steps to measure each buffer radius for
+
+    The current buffer radius is moved into [r_min, r_max] and the search starts from there. Calling this method
+    again restarts the search.
+*/
+void NeighborList::setAutotuneRBuff(bool enable, Scalar r_min, Scalar r_max, unsigned int period)
+    {
+    if (enable)
+        {
+        if (r_min < 0.0 || r_max < r_min)
+            {
+            m_exec_conf->msg->error() << "nlist: Buffer radius tuning requires 0 <= r_min <= r_max" << endl;
+            throw runtime_error("Error changing NeighborList parameters");
+            }
+        if (period == 0)
+            {
+            m_exec_conf->msg->error() << "nlist: Buffer radius tuning period must be positive" << endl;
+            throw runtime_error("Error changing NeighborList parameters");
+            }
+
+        m_tune_r_min = r_min;
+        m_tune_r_max = r_max;
+        m_tune_period = period;
+
+        if (m_r_buff < r_min)
+            setRBuff(r_min);
+        if (m_r_buff > r_max)
+            setRBuff(r_max);
+        }
+
+    m_tune_r_buff = enable;
+    m_tune_started = false;
+    m_tune_steps = 0;
+    m_tune_time = 0;
+    m_tune_build_time = 0;
+    m_tune_dr = (m_tune_r_max - m_tune_r_min) / Scalar(8.0);
+    m_tune_best_r_buff = m_r_buff;
+    m_tune_best_cost = -1.0;
+    }
+
+/*! \param timestep Current time step
+
+    Called at the beginning of every step while tuning is enabled. The wall time since the beginning of the previous
+    step is added to the current window. Steps that do not directly follow the previous one (e.g. the first step of
+    a run) are not measured. At the end of the window, the buffer radius is moved as described in the class
+    documentation.
+*/
+void NeighborList::tuneRBuff(unsigned int timestep)
+    {
+    int64_t now = m_tune_clk.getTime();
+
+    // only measure once per step
+    if (m_tune_started && timestep == m_tune_last_step)
+        return;
+
+    if (m_tune_started && timestep == m_tune_last_step + 1)
+        {
+        m_tune_time += now - m_tune_last_time;
+        m_tune_steps++;
+        }
+    m_tune_started = true;
+    m_tune_last_step = timestep;
+    m_tune_last_time = now;
+
+    if (m_tune_steps < m_tune_period)
+        return;
+
+    double cost = double(m_tune_time) / double(m_tune_steps);
+    double build_cost = double(m_tune_build_time) / double(m_tune_steps);
+    m_tune_steps = 0;
+    m_tune_time = 0;
+    m_tune_build_time = 0;
+
+    #ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        // the slowest rank determines the step time, and all ranks need to make the same choice
+        double local[2] = {cost, build_cost};
+        double global[2];
+        MPI_Allreduce(local, global, 2, MPI_DOUBLE, MPI_MAX, m_exec_conf->getMPICommunicator());
+        cost = global[0];
+        build_cost = global[1];
+        }
+    #endif
+
+    if (m_tune_best_cost < 0.0)
+        {
+        // first window: grow the buffer if builds dominate the step, shrink it otherwise
+        m_tune_best_r_buff = m_r_buff;
+        m_tune_best_cost = cost;
+        m_tune_direction = (build_cost > cost - build_cost) ? 1 : -1;
+        }
+    else if (m_tune_dr > Scalar(0.0))
+        {
+        if (cost < m_tune_best_cost)
+            {
+            m_tune_best_r_buff = m_r_buff;
+            m_tune_best_cost = cost;
+            }
+        else
+            {
+            m_tune_direction = -m_tune_direction;
+            m_tune_dr /= Scalar(2.0);
+            }
+        }
+    else
+        {
+        // converged, resume the search only if the system has become noticeably slower
+        if (cost < 1.1 * m_tune_best_cost)
+            return;
+
+        m_tune_best_cost = cost;
+        m_tune_dr = (m_tune_r_max - m_tune_r_min) / Scalar(8.0);
+        }
+
+    Scalar r_buff = m_tune_best_r_buff;
+    if (m_tune_dr < (m_tune_r_max - m_tune_r_min) / Scalar(64.0) || m_tune_dr == Scalar(0.0))
+        {
+        m_tune_dr = 0;
+        m_exec_conf->msg->notice(4) << "nlist: Tuned r_buff = " << r_buff << endl;
+        }
+    else
+        {
+        r_buff = m_tune_best_r_buff + m_tune_direction * m_tune_dr;
+
+        // turn around at the bounds
+        if (r_buff < m_tune_r_min || r_buff > m_tune_r_max)
+            {
+            m_tune_direction = -m_tune_direction;
+            r_buff = m_tune_best_r_buff + m_tune_direction * m_tune_dr;
+            r_buff = std::max(m_tune_r_min, std::min(m_tune_r_max, r_buff));
+            }
+        }
+
+    if (r_buff != m_r_buff)
+        {
+        m_exec_conf->msg->notice(6) << "nlist: Tuning r_buff " << m_r_buff << " -> " << r_buff
+                                    << " (" << cost * 1e-6 << " ms/step)" << endl;
+        setRBuff(r_buff);
+        }
+    }
+
 void NeighborList::updateRList()
     {
     // only need a read on the real cutoff
@@ -1185,6 +1369,29 @@ unsigned int NeighborList::getSmallestRebuild()
     return m_update_periods.size();
     }
 
+/*! Provides nlist_r_buff while the buffer radius is tuned
+*/
+std::vector< std::string > NeighborList::getProvidedLogQuantities()
+    {
+    vector<string> list;
+    if (m_tune_r_buff)
+        list.push_back("nlist_r_buff");
+    return list;
+    }
+
+/*! \param quantity Name of the log quantity to get
+    \param timestep Current time step of the simulation
+    \returns The current buffer radius
+*/
+Scalar NeighborList::getLogValue(const std::string& quantity, unsigned int timestep)
+    {
+    if (quantity == "nlist_r_buff")
+        return m_r_buff;
+
+    m_exec_conf->msg->error() << "nlist: " << quantity << " is not a valid log quantity" << endl;
+    throw runtime_error("Error getting log value");
+    }
+
 /*! This method is now deprecated, and deriving classes must supply it.
 */
 void NeighborList::buildNlist(unsigned int timestep)
@@ -1413,6 +1620,10 @@ bool NeighborList::peekUpdate(unsigned int timestep)
     {
     if (m_prof) m_prof->push("Neighbor");
 
+    // a new buffer radius must be set before the ghost particles are exchanged
+    if (m_tune_r_buff)
+        tuneRBuff(timestep);
+
     bool result = needsUpdating(timestep);
 
     if (m_prof) m_prof->pop();
@@ -1428,6 +1639,8 @@ void export_NeighborList(py::module& m)
         .def("setRCut", &NeighborList::setRCut)
         .def("setRCutPair", &NeighborList::setRCutPair)
         .def("setRBuff", &NeighborList::setRBuff)
+        .def("getRBuff", &NeighborList::getRBuff)
+        .def("setAutotuneRBuff", &NeighborList::setAutotuneRBuff)
         .def("setEvery", &NeighborList::setEvery)
         .def("setStorageMode", &NeighborList::setStorageMode)
         .def("addExclusion", &NeighborList::addExclusion)
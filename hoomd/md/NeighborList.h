@@ -9,6 +9,7 @@
 #include "hoomd/GPUVector.h"
 #include "hoomd/GPUFlags.h"
 #include "hoomd/Index1D.h"
+#include "hoomd/ClockSource.h"
 
 #include <memory>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
@@ -110,6 +111,19 @@
     Condition flags are to be set during the buildNlist() call and will be checked by compute() which will then
     take the appropriate action.
 
+    <b>Buffer tuning:</b>
+
+    A larger buffer radius makes the list rebuild less often, but every pair force computation has more neighbors
+    to loop over. setAutotuneRBuff() enables an online search for the buffer radius that minimizes the wall time
+    per step. The wall time between consecutive steps and the time spent in list builds are measured with a
+    ClockSource over windows of \a period steps. At the end of each window the buffer radius is moved within the
+    given bounds: the search starts in the direction suggested by the ratio of the build time to the rest of the
+    step, keeps going while the step time improves, and reverses with half the step size when it gets worse. Once the
+    step size is small enough, the search stops and only resumes when the step time degrades. In MPI simulations the
+    time of the slowest rank is used so that all ranks choose the same buffer radius, and a new value is applied
+    at the beginning of the step before the ghost particles are exchanged. The current value is available to the
+    Logger as nlist_r_buff.
+
     \ingroup computes
 */
 class NeighborList : public Compute
@@ -166,6 +180,9 @@ class NeighborList : public Compute
             forceUpdate();
             }
 
+        //! Enable or disable online tuning of the buffer radius
+        void setAutotuneRBuff(bool enable, Scalar r_min, Scalar r_max, unsigned int period);
+
         // @}
         //! \name Get properties
         // @{
@@ -227,6 +244,12 @@ class NeighborList : public Compute
         //! Gets the shortest rebuild period this nlist has experienced since a call to resetStats
         unsigned int getSmallestRebuild();
 
+        //! Returns a list of log quantities this compute calculates
+        virtual std::vector< std::string > getProvidedLogQuantities();
+
+        //! Calculates the requested log value and returns it
+        virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
+
         // @}
         //! \name Get data
         // @{
@@ -546,6 +569,25 @@ class NeighborList : public Compute
         unsigned int m_every; //!< No update checks will be performed until m_every steps after the last one
         std::vector<unsigned int> m_update_periods;    //!< Steps between updates
 
+        bool m_tune_r_buff;             //!< True if the buffer radius is tuned during the run
+        Scalar m_tune_r_min;            //!< Smallest buffer radius the tuner may set
+        Scalar m_tune_r_max;            //!< Largest buffer radius the tuner may set
+        unsigned int m_tune_period;     //!< Number of steps measured for each buffer radius
+        ClockSource m_tune_clk;         //!< Clock for the tuner measurements
+        bool m_tune_started;            //!< True once the tuner has seen a step
+        unsigned int m_tune_last_step;  //!< Last time step seen by the tuner
+        int64_t m_tune_last_time;       //!< Clock time at the beginning of m_tune_last_step
+        unsigned int m_tune_steps;      //!< Steps measured in the current window
+        int64_t m_tune_time;            //!< Wall time of the steps measured in the current window
+        int64_t m_tune_build_time;      //!< Time spent in list builds in the current window
+        Scalar m_tune_dr;               //!< Current step size of the search (0 when converged)
+        int m_tune_direction;           //!< Current direction of the search (+1 or -1)
+        Scalar m_tune_best_r_buff;      //!< Fastest buffer radius found so far
+        double m_tune_best_cost;        //!< Time per step at m_tune_best_r_buff (negative if not yet measured)
+
+        //! Measure the last step and move the buffer radius at the end of a tuning window
+        void tuneRBuff(unsigned int timestep);
+
         //! Test if the list needs updating
         bool needsUpdating(unsigned int timestep);
 
@@ -106,6 +106,11 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
     {
     if (m_prof) m_prof->push("OPLS Dihedral");
 
+    // dihedrals that share no particle are computed concurrently
+    const unsigned int num_threads = m_exec_conf->getNumThreads();
+    if (num_threads > 1)
+        m_dihedral_data->updateColoring();
+
     assert(m_pdata);
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
@@ -130,26 +135,29 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
 
     unsigned int virial_pitch = m_virial.getPitch();
 
-    // From LAMMPS OPLS dihedral implementation
-    unsigned int i1,i2,i3,i4,n,dihedral_type;
-    Scalar3 vb1,vb2,vb3,vb2m;
-    Scalar4 f1,f2,f3,f4;
-    Scalar ax,ay,az,bx,by,bz,rasq,rbsq,rgsq,rg,rginv,ra2inv,rb2inv,rabinv;
-    Scalar df,df1,ddf1,fg,hg,fga,hgb,gaa,gbb;
-    Scalar dtfx,dtfy,dtfz,dtgx,dtgy,dtgz,dthx,dthy,dthz;
-    Scalar c,s,p,sx2,sy2,sz2,cos_term,e_dihedral;
-    Scalar k1,k2,k3,k4;
-    Scalar dihedral_virial[6];
-
     // get a local copy of the simulation box
     const BoxDim& box = m_pdata->getBox();
 
-    // iterate through each dihedral
-    const unsigned int numDihedrals = (unsigned int)m_dihedral_data->getN();
-    for (n = 0; n < numDihedrals; n++)
+    // access the dihedral table
+    ArrayHandle<DihedralData::members_t> h_dihedrals(m_dihedral_data->getMembersArray(), access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_dihedral_data->getTypeValArray(), access_location::host, access_mode::read);
+
+    // computes a single dihedral, only the forces on its members are written
+    auto compute_dihedral = [&](unsigned int n)
         {
+        // From LAMMPS OPLS dihedral implementation
+        unsigned int i1,i2,i3,i4,dihedral_type;
+        Scalar3 vb1,vb2,vb3,vb2m;
+        Scalar4 f1,f2,f3,f4;
+        Scalar ax,ay,az,bx,by,bz,rasq,rbsq,rgsq,rg,rginv,ra2inv,rb2inv,rabinv;
+        Scalar df,df1,ddf1,fg,hg,fga,hgb,gaa,gbb;
+        Scalar dtfx,dtfy,dtfz,dtgx,dtgy,dtgz,dthx,dthy,dthz;
+        Scalar c,s,p,sx2,sy2,sz2,cos_term,e_dihedral;
+        Scalar k1,k2,k3,k4;
+        Scalar dihedral_virial[6];
+
         // lookup the tag of each of the particles participating in the dihedral
-        const ImproperData::members_t& dihedral = m_dihedral_data->getMembersByIndex(n);
+        const ImproperData::members_t& dihedral = h_dihedrals.data[n];
         assert(dihedral.tag[0] < m_pdata->getNGlobal());
         assert(dihedral.tag[1] < m_pdata->getNGlobal());
         assert(dihedral.tag[2] < m_pdata->getNGlobal());
@@ -161,14 +169,9 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
         i3 = h_rtag.data[dihedral.tag[2]];
         i4 = h_rtag.data[dihedral.tag[3]];
 
-        // throw an error if this angle is incomplete
+        // an incomplete dihedral is reported after the loop, errors can not be raised on a worker thread
         if (i1 == NOT_LOCAL|| i2 == NOT_LOCAL || i3 == NOT_LOCAL || i4 == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error() << "dihedral.opls: dihedral " <<
-                dihedral.tag[0] << " " << dihedral.tag[1] << " " << dihedral.tag[2] << " " << dihedral.tag[3]
-                << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in dihedral calculation");
-            }
+            return false;
 
         assert(i1 < m_pdata->getN() + m_pdata->getNGhosts());
         assert(i2 < m_pdata->getN() + m_pdata->getNGhosts());
@@ -231,7 +234,7 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
 
         // get values for k1/2 through k4/2
         // ----- The 1/2 factor is already stored in the parameters --------
-        dihedral_type = m_dihedral_data->getTypeByIndex(n);
+        dihedral_type = h_typeval.data[n].type;
         k1 = h_params.data[dihedral_type].x;
         k2 = h_params.data[dihedral_type].y;
         k3 = h_params.data[dihedral_type].z;
@@ -350,6 +353,18 @@ void OPLSDihedralForceCompute::computeForces(unsigned int timestep)
             h_virial.data[virial_pitch*k+i3]  += dihedral_virial[k];
             h_virial.data[virial_pitch*k+i4]  += dihedral_virial[k];
             }
+        return true;
+        };
+
+    // iterate through each dihedral
+    unsigned int failed = m_dihedral_data->forEachGroup(num_threads, compute_dihedral);
+    if (failed != GROUP_NOT_LOCAL)
+        {
+        const ImproperData::members_t& dihedral = h_dihedrals.data[failed];
+        this->m_exec_conf->msg->error() << "dihedral.opls: dihedral " <<
+            dihedral.tag[0] << " " << dihedral.tag[1] << " " << dihedral.tag[2] << " " << dihedral.tag[3]
+            << " incomplete." << endl << endl;
+        throw std::runtime_error("Error in dihedral calculation");
         }
 
     if (m_prof) m_prof->pop();
@@ -3,6 +3,10 @@
 
 #include "PPPMForceCompute.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 namespace py = pybind11;
 
 bool is_pow2(unsigned int n)
@@ -12,6 +16,19 @@ bool is_pow2(unsigned int n)
     return (n == 1);
     };
 
+#ifdef ENABLE_FFTW_THREADS
+//! Initialize the threaded FFTW routines once per process
+static void initFFTWThreads()
+    {
+    static bool fftw_threads_initialized = false;
+    if (! fftw_threads_initialized)
+        {
+        fftwf_init_threads();
+        fftw_threads_initialized = true;
+        }
+    }
+#endif
+
 //! Coefficients of a power expansion of sin(x)/x
 const Scalar cpu_sinc_coeff[] = {Scalar(1.0), Scalar(-1.0/6.0), Scalar(1.0/120.0),
                         Scalar(-1.0/5040.0),Scalar(1.0/362880.0),
@@ -44,8 +61,14 @@ PPPMForceCompute::PPPMForceCompute(std::shared_ptr<SystemDefinition> sysdef,
       m_body_energy(0.0),
       m_ptls_added_removed(false),
       m_kiss_fft_initialized(false),
+      m_local_fft(true),
       m_dfft_initialized(false)
     {
+    #ifdef ENABLE_FFTW
+    m_fftw_initialized = false;
+    m_fftw_mesh_points = make_uint3(0,0,0);
+    m_fftw_num_threads = 0;
+    #endif
 
     m_pdata->getBoxChangeSignal().connect<PPPMForceCompute, &PPPMForceCompute::setBoxChange>(this);
     // reset virial
@@ -150,6 +173,13 @@ PPPMForceCompute::~PPPMForceCompute()
         free(m_kiss_ifft);
         kiss_fft_cleanup();
         }
+    #ifdef ENABLE_FFTW
+    if (m_fftw_initialized)
+        {
+        fftwf_destroy_plan(m_fftw_forward);
+        fftwf_destroy_plan(m_fftw_inverse);
+        }
+    #endif
     #ifdef ENABLE_MPI
     if (m_dfft_initialized)
         {
@@ -470,6 +500,19 @@ void PPPMForceCompute::initializeFFT()
         int row_m = 0; /* both local grid and proc grid are row major, no transposition necessary */
         ArrayHandle<unsigned int> h_cart_ranks(m_pdata->getDomainDecomposition()->getCartRanks(),
             access_location::host, access_mode::read);
+
+        if (m_dfft_initialized)
+            {
+            dfft_destroy_plan(m_dfft_plan_forward);
+            dfft_destroy_plan(m_dfft_plan_inverse);
+            }
+
+        #ifdef ENABLE_FFTW_THREADS
+        // the local transforms of the distributed FFT use FFTW
+        initFFTWThreads();
+        fftwf_plan_with_nthreads(m_exec_conf->getNumThreads());
+        #endif
+
         dfft_create_plan(&m_dfft_plan_forward, 3, gdim, embed, NULL, pdim, pidx,
             row_m, 0, 1, m_exec_conf->getMPICommunicator(), (int *)h_cart_ranks.data);
         dfft_create_plan(&m_dfft_plan_inverse, 3, gdim, NULL, embed, pdim, pidx,
@@ -478,18 +521,7 @@ void PPPMForceCompute::initializeFFT()
         }
     #endif // ENABLE_MPI
 
-    if (local_fft)
-        {
-        int dims[3];
-        dims[0] = m_mesh_points.z;
-        dims[1] = m_mesh_points.y;
-        dims[2] = m_mesh_points.x;
-
-        m_kiss_fft = kiss_fftnd_alloc(dims, 3, 0, NULL, NULL);
-        m_kiss_ifft = kiss_fftnd_alloc(dims, 3, 1, NULL, NULL);
-
-        m_kiss_fft_initialized = true;
-        }
+    m_local_fft = local_fft;
 
     // allocate mesh and transformed mesh
 
@@ -519,6 +551,96 @@ void PPPMForceCompute::initializeFFT()
 
     GPUArray<kiss_fft_cpx> inv_fourier_mesh_z(m_n_cells+m_ghost_offset, m_exec_conf);
     m_inv_fourier_mesh_z.swap(inv_fourier_mesh_z);
+
+    if (! local_fft)
+        return;
+
+    #ifdef ENABLE_FFTW
+    // the plans only depend on the mesh dimensions, keep them across calls to setupMesh()
+    unsigned int num_threads = m_exec_conf->getNumThreads();
+    if (m_fftw_initialized && (m_fftw_mesh_points.x != m_mesh_points.x ||
+                               m_fftw_mesh_points.y != m_mesh_points.y ||
+                               m_fftw_mesh_points.z != m_mesh_points.z ||
+                               m_fftw_num_threads != num_threads))
+        {
+        fftwf_destroy_plan(m_fftw_forward);
+        fftwf_destroy_plan(m_fftw_inverse);
+        m_fftw_initialized = false;
+        }
+
+    if (! m_fftw_initialized)
+        {
+        m_exec_conf->msg->notice(6) << "charge.pppm: Planning FFTW transforms" << std::endl;
+
+        #ifdef ENABLE_FFTW_THREADS
+        initFFTWThreads();
+        fftwf_plan_with_nthreads(num_threads);
+        #endif
+
+        // planning overwrites the arrays, they do not hold data yet
+        ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::overwrite);
+        ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh, access_location::host, access_mode::overwrite);
+
+        // the mesh is stored in row major order with x varying fastest, as for kiss_fftnd
+        m_fftw_forward = fftwf_plan_dft_3d(m_mesh_points.z, m_mesh_points.y, m_mesh_points.x,
+            (fftwf_complex *)h_mesh.data, (fftwf_complex *)h_fourier_mesh.data, FFTW_FORWARD, FFTW_MEASURE);
+        m_fftw_inverse = fftwf_plan_dft_3d(m_mesh_points.z, m_mesh_points.y, m_mesh_points.x,
+            (fftwf_complex *)h_fourier_mesh.data, (fftwf_complex *)h_mesh.data, FFTW_BACKWARD, FFTW_MEASURE);
+
+        if (m_fftw_forward != NULL && m_fftw_inverse != NULL)
+            {
+            m_fftw_initialized = true;
+            m_fftw_mesh_points = m_mesh_points;
+            m_fftw_num_threads = num_threads;
+            }
+        else
+            {
+            if (m_fftw_forward != NULL) fftwf_destroy_plan(m_fftw_forward);
+            if (m_fftw_inverse != NULL) fftwf_destroy_plan(m_fftw_inverse);
+            m_exec_conf->msg->warning() << "charge.pppm: Unable to plan FFTW transforms, falling back to kiss_fft" << std::endl;
+            }
+        }
+
+    if (m_fftw_initialized)
+        return;
+    #endif
+
+    // fall back on kiss_fft
+    if (m_kiss_fft_initialized)
+        {
+        free(m_kiss_fft);
+        free(m_kiss_ifft);
+        }
+
+    int dims[3];
+    dims[0] = m_mesh_points.z;
+    dims[1] = m_mesh_points.y;
+    dims[2] = m_mesh_points.x;
+
+    m_kiss_fft = kiss_fftnd_alloc(dims, 3, 0, NULL, NULL);
+    m_kiss_ifft = kiss_fftnd_alloc(dims, 3, 1, NULL, NULL);
+
+    m_kiss_fft_initialized = true;
+    }
+
+/*! \param in Input mesh
+    \param out Output mesh
+    \param inverse True for the inverse (unnormalized) transform
+
+    Transforms with FFTW if its plans are set up, or with kiss_fft otherwise.
+*/
+void PPPMForceCompute::localFFT(kiss_fft_cpx *in, kiss_fft_cpx *out, bool inverse)
+    {
+    #ifdef ENABLE_FFTW
+    if (m_fftw_initialized)
+        {
+        // GPUArray host memory has the same alignment as the arrays used for planning
+        fftwf_execute_dft(inverse ? m_fftw_inverse : m_fftw_forward, (fftwf_complex *)in, (fftwf_complex *)out);
+        return;
+        }
+    #endif
+
+    kiss_fftnd(inverse ? m_kiss_ifft : m_kiss_fft, in, out);
     }
 
 //! CPU implementation of sinc(x)==sin(x)/x
@@ -567,7 +689,7 @@ void PPPMForceCompute::computeInfluenceFunction()
     Scalar3 b3 = Scalar(2.0*M_PI)*make_scalar3(a1.y*a2.z-a1.z*a2.y, a1.z*a2.x-a1.x*a2.z, a1.x*a2.y-a1.y*a2.x)/V_box;
 
     #ifdef ENABLE_MPI
-    bool local_fft = m_kiss_fft_initialized;
+    bool local_fft = m_local_fft;
 
     uint3 pdim=make_uint3(0,0,0);
     uint3 pidx=make_uint3(0,0,0);
@@ -720,6 +842,9 @@ void PPPMForceCompute::assignParticles()
 
     ArrayHandle<Scalar> h_rho_coeff(m_rho_coeff,access_location::host, access_mode::read);
 
+    // the group members are read concurrently, so acquire the index array only once
+    ArrayHandle<unsigned int> h_index(m_group->getIndexArray(), access_location::host, access_mode::read);
+
     const BoxDim& box = m_pdata->getBox();
 
     // set mesh to zero
@@ -727,11 +852,10 @@ void PPPMForceCompute::assignParticles()
 
     Scalar V_cell = box.getVolume()/(Scalar)(m_mesh_points.x*m_mesh_points.y*m_mesh_points.z);
 
-    // loop over group
-    unsigned int group_size = m_group->getNumMembers();
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    // spread the charge of group member group_idx onto mesh
+    auto assign_particle = [&](unsigned int group_idx, kiss_fft_cpx *mesh)
         {
-        unsigned int idx = m_group->getMemberIndex(group_idx);
+        unsigned int idx = h_index.data[group_idx];
 
         Scalar4 postype = h_postype.data[idx];
         Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
@@ -739,7 +863,7 @@ void PPPMForceCompute::assignParticles()
         // ignore if NaN
         if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
             {
-            continue;
+            return;
             }
 
         Scalar qi = h_charge.data[idx];
@@ -790,7 +914,7 @@ void PPPMForceCompute::assignParticles()
             iz < 0 || iz >= (int)m_grid_dim.z)
             {
             // ignore, error will be thrown elsewhere (in CellList)
-            continue;
+            return;
             }
 
         int mult_fact = 2*m_order+1;
@@ -858,25 +982,70 @@ void PPPMForceCompute::assignParticles()
                     // store in row major order
                     unsigned int neigh_idx = neighi + m_grid_dim.x * (neighj + m_grid_dim.y*neighk);
 
-                    h_mesh.data[neigh_idx].r += qi*W/V_cell;
+                    mesh[neigh_idx].r += qi*W/V_cell;
                     }
                 }
             }
-        } // end loop over particles
+        };
+
+    unsigned int group_size = m_group->getNumMembers();
+    const unsigned int num_threads = m_exec_conf->getNumThreads();
+
+    if (num_threads == 1)
+        {
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            assign_particle(group_idx, h_mesh.data);
+        }
+    #ifdef ENABLE_TBB
+    else
+        {
+        // the stencils of different particles overlap, so every thread but the first spreads a fixed range of
+        // particles onto its own copy of the mesh. The copies are then added to the mesh in a fixed order.
+        const unsigned int n_elements = m_mesh.getNumElements();
+        if (m_thread_mesh.size() < (size_t)(num_threads-1)*n_elements)
+            m_thread_mesh.resize((num_threads-1)*n_elements);
+
+        tbb::parallel_for((unsigned int)0, num_threads, [&](unsigned int chunk)
+            {
+            kiss_fft_cpx *mesh = h_mesh.data;
+            if (chunk > 0)
+                {
+                mesh = &m_thread_mesh[(chunk-1)*n_elements];
+                memset(mesh, 0, sizeof(kiss_fft_cpx)*n_elements);
+                }
+
+            for (unsigned int group_idx = chunk*group_size/num_threads;
+                 group_idx < (chunk+1)*group_size/num_threads; group_idx++)
+                assign_particle(group_idx, mesh);
+            });
+
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_elements),
+            [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                for (unsigned int cell = r.begin(); cell != r.end(); ++cell)
+                    {
+                    for (unsigned int chunk = 1; chunk < num_threads; ++chunk)
+                        {
+                        h_mesh.data[cell].r += m_thread_mesh[(chunk-1)*n_elements+cell].r;
+                        }
+                    }
+                });
+        }
+    #endif
 
     if (m_prof) m_prof->pop();
     }
 
 void PPPMForceCompute::updateMeshes()
     {
-    if (m_kiss_fft_initialized)
+    if (m_local_fft)
         {
         if (m_prof) m_prof->push("FFT");
         // transform the particle mesh locally (forward transform)
         ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::read);
         ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh, access_location::host, access_mode::overwrite);
 
-        kiss_fftnd(m_kiss_fft, h_mesh.data, h_fourier_mesh.data);
+        localFFT(h_mesh.data, h_fourier_mesh.data, false);
         if (m_prof) m_prof->pop();
         }
 
@@ -935,7 +1104,7 @@ void PPPMForceCompute::updateMeshes()
 
     if (m_prof) m_prof->pop();
 
-    if (m_kiss_fft_initialized)
+    if (m_local_fft)
         {
         if (m_prof) m_prof->push("FFT");
         // do a local inverse transform of the force mesh
@@ -945,9 +1114,9 @@ void PPPMForceCompute::updateMeshes()
         ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x, access_location::host, access_mode::overwrite);
         ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_y(m_inv_fourier_mesh_y, access_location::host, access_mode::overwrite);
         ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_z(m_inv_fourier_mesh_z, access_location::host, access_mode::overwrite);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_x.data, h_inv_fourier_mesh_x.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data);
+        localFFT(h_fourier_mesh_G_x.data, h_inv_fourier_mesh_x.data, true);
+        localFFT(h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data, true);
+        localFFT(h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data, true);
         if (m_prof) m_prof->pop();
         }
 
@@ -1006,13 +1175,15 @@ void PPPMForceCompute::interpolateForces()
 
     ArrayHandle<Scalar> h_rho_coeff(m_rho_coeff, access_location::host, access_mode::read);
 
+    // the group members are read concurrently, so acquire the index array only once
+    ArrayHandle<unsigned int> h_index(m_group->getIndexArray(), access_location::host, access_mode::read);
+
     const BoxDim& box = m_pdata->getBox();
 
-    // loop over group
-    unsigned int group_size = m_group->getNumMembers();
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    // gather the force on group member group_idx from the mesh
+    auto interpolate_particle = [&](unsigned int group_idx)
         {
-        unsigned int idx = m_group->getMemberIndex(group_idx);
+        unsigned int idx = h_index.data[group_idx];
         Scalar4 postype = h_postype.data[idx];
 
         Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
@@ -1020,7 +1191,7 @@ void PPPMForceCompute::interpolateForces()
         // ignore if NaN
         if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
             {
-            continue;
+            return;
             }
 
         Scalar qi = h_charge.data[idx];
@@ -1070,7 +1241,7 @@ void PPPMForceCompute::interpolateForces()
             iz < 0 || iz >= (int)m_grid_dim.z)
             {
             // ignore, error will be thrown elsewhere (in CellList)
-            continue;
+            return;
             }
 
         Scalar3 force = make_scalar3(0.0,0.0,0.0);
@@ -1151,7 +1322,26 @@ void PPPMForceCompute::interpolateForces()
             }
 
         h_force.data[idx] = make_scalar4(force.x,force.y,force.z,0.0);
-        }  // end of loop over particles
+        };
+
+    // every particle only writes its own force
+    unsigned int group_size = m_group->getNumMembers();
+    if (m_exec_conf->getNumThreads() == 1)
+        {
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            interpolate_particle(group_idx);
+        }
+    #ifdef ENABLE_TBB
+    else
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, group_size),
+            [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                for (unsigned int group_idx = r.begin(); group_idx != r.end(); ++group_idx)
+                    interpolate_particle(group_idx);
+                });
+        }
+    #endif
 
     if (m_prof) m_prof->pop();
     }
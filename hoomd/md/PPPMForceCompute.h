@@ -15,6 +15,10 @@
 
 #include "hoomd/extern/kiss_fftnd.h"
 
+#ifdef ENABLE_FFTW
+#include <fftw3.h>
+#endif
+
 #include <memory>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 
@@ -189,8 +193,18 @@ class PPPMForceCompute : public ForceCompute
         #endif
 
         bool m_kiss_fft_initialized;               //!< True if a local KISS FFT has been set up
+        bool m_local_fft;                          //!< True if the FFT is performed locally (single rank)
+
+        #ifdef ENABLE_FFTW
+        fftwf_plan m_fftw_forward;                 //!< FFTW plan for the local forward transform
+        fftwf_plan m_fftw_inverse;                 //!< FFTW plan for the local inverse transform
+        bool m_fftw_initialized;                   //!< True if the local FFTW plans have been set up
+        uint3 m_fftw_mesh_points;                  //!< Mesh dimensions the FFTW plans were created for
+        unsigned int m_fftw_num_threads;           //!< Number of threads the FFTW plans were created for
+        #endif
 
         GPUArray<kiss_fft_cpx> m_mesh;             //!< The particle density mesh
+        std::vector<kiss_fft_cpx> m_thread_mesh;   //!< Per-thread density meshes for threaded charge assignment
         GPUArray<kiss_fft_cpx> m_fourier_mesh;     //!< The fourier transformed mesh
         GPUArray<kiss_fft_cpx> m_fourier_mesh_G_x;   //!< Fourier transformed mesh times the influence function, x-component
         GPUArray<kiss_fft_cpx> m_fourier_mesh_G_y;   //!< Fourier transformed mesh times the influence function, y-component
@@ -206,6 +220,9 @@ class PPPMForceCompute : public ForceCompute
         //! Compute virial on mesh
         void computeVirialMesh();
 
+        //! Perform a local (single rank) FFT
+        void localFFT(kiss_fft_cpx *in, kiss_fft_cpx *out, bool inverse);
+
         //! Compute number of ghost cellso
         uint3 computeGhostCellNum();
 
@@ -147,6 +147,11 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
 
     assert(m_pdata);
 
+    // bonds that share no particle are computed concurrently
+    const unsigned int num_threads = m_exec_conf->getNumThreads();
+    if (num_threads > 1)
+        m_bond_data->updateColoring();
+
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
@@ -178,19 +183,18 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
 
-    Scalar bond_virial[6];
-    for (unsigned int i = 0; i< 6; i++)
-        bond_virial[i]=Scalar(0.0);
-
     ArrayHandle<typename BondData::members_t> h_bonds(m_bond_data->getMembersArray(), access_location::host, access_mode::read);
     ArrayHandle<typeval_t> h_typeval(m_bond_data->getTypeValArray(), access_location::host, access_mode::read);
 
     unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
 
-    // for each of the bonds
-    const unsigned int size = (unsigned int)m_bond_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    // computes a single bond, only the forces on its two members are written
+    auto compute_bond = [&](unsigned int i)
         {
+        Scalar bond_virial[6];
+        for (unsigned int l = 0; l < 6; l++)
+            bond_virial[l] = Scalar(0.0);
+
         // lookup the tag of each of the particles participating in the bond
         const typename BondData::members_t& bond = h_bonds.data[i];
         assert(bond.tag[0] < m_pdata->getMaximumTag()+1);
@@ -201,13 +205,9 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
         unsigned int idx_a = h_rtag.data[bond.tag[0]];
         unsigned int idx_b = h_rtag.data[bond.tag[1]];
 
-        // throw an error if this bond is incomplete
+        // an incomplete bond is reported after the loop, errors can not be raised on a worker thread
         if (idx_a >= max_local || idx_b >= max_local)
-            {
-            this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond " <<
-                bond.tag[0] << " " << bond.tag[1] << " incomplete." << std::endl << std::endl;
-            throw std::runtime_error("Error in bond calculation");
-            }
+            return false;
 
         // calculate d\vec{r}
         // (MEM TRANSFER: 6 Scalars / FLOPS: 3)
@@ -295,10 +295,23 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
                 }
             }
         else
-            {
+            return false;
+
+        return true;
+        };
+
+    // for each of the bonds
+    unsigned int failed = m_bond_data->forEachGroup(num_threads, compute_bond);
+    if (failed != GROUP_NOT_LOCAL)
+        {
+        // the bond either has a member that is not local, or is out of bounds
+        const typename BondData::members_t& bond = h_bonds.data[failed];
+        if (h_rtag.data[bond.tag[0]] >= max_local || h_rtag.data[bond.tag[1]] >= max_local)
+            this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond " <<
+                bond.tag[0] << " " << bond.tag[1] << " incomplete." << std::endl << std::endl;
+        else
             this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond out of bounds" << std::endl << std::endl;
-            throw std::runtime_error("Error in bond calculation");
-            }
+        throw std::runtime_error("Error in bond calculation");
         }
 
     if (m_prof) m_prof->pop();
@@ -10,6 +10,7 @@
 #include <iostream>
 #include <stdexcept>
 #include <memory>
+#include <algorithm>
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
 #include "hoomd/extern/num_util.h"
 
@@ -23,6 +24,10 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 
 /*! \file PotentialPair.h
     \brief Defines the template class for standard pair potentials
@@ -34,6 +39,50 @@
 #error This header cannot be compiled by nvcc
 #endif
 
+//! Detects pair evaluators that provide a batched evalForceAndEnergyBatch() method
+/*! PotentialPair evaluates pairs in batches when \a evaluator provides a static method
+
+    \code
+    static void evalForceAndEnergyBatch(const Scalar *rsq, const Scalar *rcutsq, const param_type *params,
+                                        Scalar *force_divr, Scalar *pair_eng, bool energy_shift, unsigned int n);
+    \endcode
+
+    All other evaluators are evaluated pair by pair with evalForceAndEnergy().
+*/
+template< class evaluator >
+struct PairEvaluatorHasBatch
+    {
+    template< class T > static char test(decltype(&T::evalForceAndEnergyBatch));
+    template< class T > static long test(...);
+
+    static const bool value = sizeof(test<evaluator>(0)) == sizeof(char);
+    };
+
+//! Dispatches to evaluator::evalForceAndEnergyBatch() for evaluators that provide it
+template< class evaluator, bool has_batch = PairEvaluatorHasBatch<evaluator>::value >
+struct PairEvaluatorBatch
+    {
+    static const bool supported = false;
+
+    static void eval(const Scalar *rsq, const Scalar *rcutsq, const typename evaluator::param_type *params,
+                     Scalar *force_divr, Scalar *pair_eng, bool energy_shift, unsigned int n)
+        {
+        }
+    };
+
+//! Specialization for evaluators with a batched path
+template< class evaluator >
+struct PairEvaluatorBatch< evaluator, true >
+    {
+    static const bool supported = true;
+
+    static void eval(const Scalar *rsq, const Scalar *rcutsq, const typename evaluator::param_type *params,
+                     Scalar *force_divr, Scalar *pair_eng, bool energy_shift, unsigned int n)
+        {
+        evaluator::evalForceAndEnergyBatch(rsq, rcutsq, params, force_divr, pair_eng, energy_shift, n);
+        }
+    };
+
 //! Template class for computing pair potentials
 /*! <b>Overview:</b>
     PotentialPair computes standard pair potentials (and forces) between all particle pairs in the simulation. It
@@ -73,6 +122,12 @@
     potential evaluator class passed in. See the appropriate documentation for the evaluator for the definition of each
     element of the parameters.
 
+    On the CPU, evaluators that provide evalForceAndEnergyBatch() (see PairEvaluatorHasBatch) are evaluated on
+    batches of neighbors at a time: the distances and parameters of up to batch_size neighbors are gathered into
+    small aligned arrays, evaluated in a single vectorizable loop, and the results are accumulated in neighbor list
+    order, so the batched path produces the same results as the per pair path. XPLOR switching always uses the per
+    pair path.
+
     For profiling and logging, PotentialPair needs to know the name of the potential. For now, that will be queried from
     the evaluator. Perhaps in the future we could allow users to change that so multiple pair potentials could be logged
     independantly.
@@ -119,9 +174,20 @@ class PotentialPair : public ForceCompute
             m_shift_mode = mode;
             }
 
+        //! Enable or disable the batched evaluation of pairs on the CPU
+        /*! \param enable Set to false to always evaluate pairs one by one (mainly useful for testing)
+        */
+        void setBatchEvaluation(bool enable)
+            {
+            m_batch_eval = enable;
+            }
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
+
+        //! Compute the forces on particles that do not interact with ghosts
+        virtual void computeInterior(unsigned int timestep);
         #endif
 
         //! Calculates the energy between two lists of particles.
@@ -136,6 +202,7 @@ class PotentialPair : public ForceCompute
     protected:
         std::shared_ptr<NeighborList> m_nlist;    //!< The neighborlist to use for the computation
         energyShiftMode m_shift_mode;               //!< Store the mode with which to handle the energy shift at r_cut
+        bool m_batch_eval;                          //!< True if batched evaluation is used when available
         Index2D m_typpair_idx;                      //!< Helper class for indexing per type pair arrays
         GPUArray<Scalar> m_rcutsq;                  //!< Cuttoff radius squared per type pair
         GPUArray<Scalar> m_ronsq;                   //!< ron squared per type pair
@@ -143,9 +210,23 @@ class PotentialPair : public ForceCompute
         std::string m_prof_name;                    //!< Cached profiler name
         std::string m_log_name;                     //!< Cached log name
 
+        std::vector< std::vector<Scalar4> > m_thread_force; //!< Per-thread third law force buffers (half neighbor list only)
+        std::vector< std::vector<Scalar> > m_thread_virial; //!< Per-thread third law virial buffers (half neighbor list only)
+
+        #ifdef ENABLE_MPI
+        std::vector<unsigned int> m_interior;       //!< Local particles without ghost neighbors
+        std::vector<unsigned int> m_boundary;       //!< Local particles with ghost neighbors
+        bool m_classified;                          //!< True if m_interior and m_boundary match the neighbor list
+        bool m_interior_computed;                   //!< True if the interior forces have been computed
+        unsigned int m_interior_tstep;              //!< Time step of the interior forces
+        #endif
+
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
 
+        //! Compute the forces on a list of particles
+        void computePairForces(const unsigned int *particles, unsigned int n, bool zero);
+
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange()
             {
@@ -176,13 +257,19 @@ template < class evaluator >
 PotentialPair< evaluator >::PotentialPair(std::shared_ptr<SystemDefinition> sysdef,
                                                 std::shared_ptr<NeighborList> nlist,
                                                 const std::string& log_suffix)
-    : ForceCompute(sysdef), m_nlist(nlist), m_shift_mode(no_shift), m_typpair_idx(m_pdata->getNTypes())
+    : ForceCompute(sysdef), m_nlist(nlist), m_shift_mode(no_shift), m_batch_eval(true), m_typpair_idx(m_pdata->getNTypes())
     {
     m_exec_conf->msg->notice(5) << "Constructing PotentialPair<" << evaluator::getName() << ">" << std::endl;
 
     assert(m_pdata);
     assert(m_nlist);
 
+    #ifdef ENABLE_MPI
+    m_classified = false;
+    m_interior_computed = false;
+    m_interior_tstep = 0;
+    #endif
+
     GPUArray<Scalar> rcutsq(m_typpair_idx.getNumElements(), m_exec_conf);
     m_rcutsq.swap(rcutsq);
     GPUArray<Scalar> ronsq(m_typpair_idx.getNumElements(), m_exec_conf);
@@ -304,6 +391,14 @@ Scalar PotentialPair< evaluator >::getLogValue(const std::string& quantity, unsi
     that it is up to date before proceeding.
 
     \param timestep specifies the current time step of the simulation
+
+    When more than one CPU thread is available, the particles are split into ranges that are processed concurrently.
+    With a full neighbor list, every thread only writes to the particles in its own range. With a half neighbor list,
+    the third law contributions to neighbors are accumulated into per-thread buffers, which are summed in a fixed
+    order afterwards so that results are reproducible for a given number of threads. Each buffer only spans the
+    indices of the local neighbors of its range, found in an extra pass over the neighbor list. After the particles
+    are spatially sorted, this is little more than the range itself, but a poorly sorted system may need up to one
+    buffer of N particles per thread.
 */
 template< class evaluator >
 void PotentialPair< evaluator >::computeForces(unsigned int timestep)
@@ -314,6 +409,92 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     // start the profile for this compute
     if (m_prof) m_prof->push(m_prof_name);
 
+    #ifdef ENABLE_MPI
+    // the interior forces are only valid if the neighbor list has not changed since they were computed
+    bool nlist_updated = m_nlist->hasBeenUpdated(timestep);
+    if (nlist_updated)
+        m_classified = false;
+
+    if (m_interior_computed && m_interior_tstep == timestep && !nlist_updated)
+        {
+        // add the forces on the particles that interact with ghosts
+        computePairForces(m_boundary.size() ? &m_boundary.front() : NULL, m_boundary.size(), false);
+        }
+    else
+    #endif
+        {
+        computePairForces(NULL, m_pdata->getN(), true);
+        }
+
+    #ifdef ENABLE_MPI
+    m_interior_computed = false;
+    #endif
+
+    if (m_prof) m_prof->pop();
+    }
+
+#ifdef ENABLE_MPI
+/*! \param timestep Current time step
+
+    Computes the forces on all particles that have no ghost particles in their neighbor list. These only depend on
+    local particle positions and can be evaluated while the ghost positions are in flight. computeForces() then
+    adds the contributions of the remaining particles, unless the neighbor list is rebuilt in between.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::computeInterior(unsigned int timestep)
+    {
+    m_interior_computed = false;
+
+    if (m_exec_conf->isCUDAEnabled())
+        return;
+
+    if (m_step_timer) m_step_timer->start(m_timer_slot);
+    if (m_prof) m_prof->push(m_prof_name);
+
+    const unsigned int N = m_pdata->getN();
+
+    // split the particles by whether they have ghost neighbors, once per neighbor list build
+    if (!m_classified)
+        {
+        ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(), access_location::host, access_mode::read);
+
+        m_interior.clear();
+        m_boundary.clear();
+        for (unsigned int i = 0; i < N; i++)
+            {
+            const unsigned int myHead = h_head_list.data[i];
+            const unsigned int size = (unsigned int)h_n_neigh.data[i];
+
+            bool boundary = false;
+            for (unsigned int k = 0; k < size && !boundary; k++)
+                boundary = h_nlist.data[myHead + k] >= N;
+
+            if (boundary)
+                m_boundary.push_back(i);
+            else
+                m_interior.push_back(i);
+            }
+        m_classified = true;
+        }
+
+    computePairForces(m_interior.size() ? &m_interior.front() : NULL, m_interior.size(), true);
+    m_interior_computed = true;
+    m_interior_tstep = timestep;
+
+    if (m_prof) m_prof->pop();
+    if (m_step_timer) m_step_timer->stop(m_timer_slot);
+    }
+#endif
+
+/*! \param particles List of particle indices to compute the forces on, or NULL to compute the forces on particles 0 to n-1
+    \param n Number of particles to compute the forces on
+    \param zero If true, all forces and virials are set to zero first, otherwise the forces are added to the current ones
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::computePairForces(const unsigned int *particles, unsigned int n, bool zero)
+    {
     // depending on the neighborlist settings, we can take advantage of newton's third law
     // to reduce computations at the cost of memory access complexity: set that flag now
     bool third_law = m_nlist->getStorageMode() == NeighborList::half;
@@ -330,8 +511,8 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
 
 
     //force arrays
-    ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar>  h_virial(m_virial,access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_force(m_force,access_location::host, zero ? access_mode::overwrite : access_mode::readwrite);
+    ArrayHandle<Scalar>  h_virial(m_virial,access_location::host, zero ? access_mode::overwrite : access_mode::readwrite);
 
 
     const BoxDim& box = m_pdata->getGlobalBox();
@@ -342,128 +523,68 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
 
-    // need to start from a zero force, energy and virial
-    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
-    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+    const unsigned int N = m_pdata->getN();
 
-    // for each particle
-    for (int i = 0; i < (int)m_pdata->getN(); i++)
+    // need to start from a zero force, energy and virial
+    if (zero)
         {
-        // access the particle's position and type (MEM TRANSFER: 4 scalars)
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
+        memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
+        memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+        }
 
-        // access diameter and charge (if needed)
-        Scalar di = Scalar(0.0);
-        Scalar qi = Scalar(0.0);
-        if (evaluator::needsDiameter())
-            di = h_diameter.data[i];
-        if (evaluator::needsCharge())
-            qi = h_charge.data[i];
+    // evaluate the neighbors in batches if the evaluator supports it, xplor switching is applied pair by pair
+    const unsigned int batch_size = 16;
+    const bool batch = PairEvaluatorBatch<evaluator>::supported && m_batch_eval && m_shift_mode != xplor
+                       && !evaluator::needsDiameter() && !evaluator::needsCharge();
 
-        // initialize current particle force, potential energy, and virial to 0
-        Scalar3 fi = make_scalar3(0, 0, 0);
-        Scalar pei = 0.0;
-        Scalar virialxxi = 0.0;
-        Scalar virialxyi = 0.0;
-        Scalar virialxzi = 0.0;
-        Scalar virialyyi = 0.0;
-        Scalar virialyzi = 0.0;
-        Scalar virialzzi = 0.0;
-
-        // loop over all of the neighbors of this particle
-        const unsigned int myHead = h_head_list.data[i];
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        for (unsigned int k = 0; k < size; k++)
+    // compute the forces on the particles [first, last) of the list, third law forces on neighbors go to force_j and
+    // virial_j, which hold the particles starting at index offset_j
+    auto compute_range = [&](unsigned int first, unsigned int last,
+                             Scalar4 *force_j, Scalar *virial_j, unsigned int virial_pitch_j, unsigned int offset_j)
+        {
+        // buffers for the batched evaluation
+        alignas(64) unsigned int batch_j[batch_size];
+        alignas(64) Scalar3 batch_dx[batch_size];
+        alignas(64) Scalar batch_rsq[batch_size];
+        alignas(64) Scalar batch_rcutsq[batch_size];
+        alignas(64) param_type batch_params[batch_size];
+        alignas(64) Scalar batch_force_divr[batch_size];
+        alignas(64) Scalar batch_pair_eng[batch_size];
+
+        // for each particle
+        for (unsigned int p = first; p < last; p++)
             {
-            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int j = h_nlist.data[myHead + k];
-            assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+            const unsigned int i = particles ? particles[p] : p;
 
-            // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-            Scalar3 dx = pi - pj;
+            // access the particle's position and type (MEM TRANSFER: 4 scalars)
+            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
 
-            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
-            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
-            assert(typej < m_pdata->getNTypes());
+            // sanity check
+            assert(typei < m_pdata->getNTypes());
 
             // access diameter and charge (if needed)
-            Scalar dj = Scalar(0.0);
-            Scalar qj = Scalar(0.0);
+            Scalar di = Scalar(0.0);
+            Scalar qi = Scalar(0.0);
             if (evaluator::needsDiameter())
-                dj = h_diameter.data[j];
+                di = h_diameter.data[i];
             if (evaluator::needsCharge())
-                qj = h_charge.data[j];
-
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
-
-            // calculate r_ij squared (FLOPS: 5)
-            Scalar rsq = dot(dx, dx);
-
-            // get parameters for this type pair
-            unsigned int typpair_idx = m_typpair_idx(typei, typej);
-            param_type param = h_params.data[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
-            Scalar ronsq = Scalar(0.0);
-            if (m_shift_mode == xplor)
-                ronsq = h_ronsq.data[typpair_idx];
-
-            // design specifies that energies are shifted if
-            // 1) shift mode is set to shift
-            // or 2) shift mode is explor and ron > rcut
-            bool energy_shift = false;
-            if (m_shift_mode == shift)
-                energy_shift = true;
-            else if (m_shift_mode == xplor)
+                qi = h_charge.data[i];
+
+            // initialize current particle force, potential energy, and virial to 0
+            Scalar3 fi = make_scalar3(0, 0, 0);
+            Scalar pei = 0.0;
+            Scalar virialxxi = 0.0;
+            Scalar virialxyi = 0.0;
+            Scalar virialxzi = 0.0;
+            Scalar virialyyi = 0.0;
+            Scalar virialyzi = 0.0;
+            Scalar virialzzi = 0.0;
+
+            // add the force, potential energy and virial of a single pair to particle i and, if we are using the
+            // third law, to particle j
+            auto accumulate = [&](unsigned int j, const Scalar3& dx, Scalar force_divr, Scalar pair_eng)
                 {
-                if (ronsq > rcutsq)
-                    energy_shift = true;
-                }
-
-            // compute the force and potential energy
-            Scalar force_divr = Scalar(0.0);
-            Scalar pair_eng = Scalar(0.0);
-            evaluator eval(rsq, rcutsq, param);
-            if (evaluator::needsDiameter())
-                eval.setDiameter(di, dj);
-            if (evaluator::needsCharge())
-                eval.setCharge(qi, qj);
-
-            bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
-
-            if (evaluated)
-                {
-                // modify the potential for xplor shifting
-                if (m_shift_mode == xplor)
-                    {
-                    if (rsq >= ronsq && rsq < rcutsq)
-                        {
-                        // Implement XPLOR smoothing (FLOPS: 16)
-                        Scalar old_pair_eng = pair_eng;
-                        Scalar old_force_divr = force_divr;
-
-                        // calculate 1.0 / (xplor denominator)
-                        Scalar xplor_denom_inv =
-                            Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
-
-                        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
-                        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq *
-                                   (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
-                        Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
-
-                        // make modifications to the old pair energy and force
-                        pair_eng = old_pair_eng * s;
-                        // note: I'm not sure why the minus sign needs to be there: my notes have a +
-                        // But this is verified correct via plotting
-                        force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
-                        }
-                    }
-
                 Scalar force_div2r = force_divr * Scalar(0.5);
                 // add the force, potential energy and virial to the particle i
                 // (FLOPS: 8)
@@ -481,44 +602,283 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
 
                 // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
                 // only add force to local particles
-                if (third_law && j < m_pdata->getN())
+                if (third_law && j < N)
                     {
-                    unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x*force_divr;
-                    h_force.data[mem_idx].y -= dx.y*force_divr;
-                    h_force.data[mem_idx].z -= dx.z*force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
+                    unsigned int mem_idx = j - offset_j;
+                    force_j[mem_idx].x -= dx.x*force_divr;
+                    force_j[mem_idx].y -= dx.y*force_divr;
+                    force_j[mem_idx].z -= dx.z*force_divr;
+                    force_j[mem_idx].w += pair_eng * Scalar(0.5);
                     if (compute_virial)
                         {
-                        h_virial.data[0*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.x;
-                        h_virial.data[1*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.y;
-                        h_virial.data[2*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.z;
-                        h_virial.data[3*m_virial_pitch+mem_idx] += force_div2r*dx.y*dx.y;
-                        h_virial.data[4*m_virial_pitch+mem_idx] += force_div2r*dx.y*dx.z;
-                        h_virial.data[5*m_virial_pitch+mem_idx] += force_div2r*dx.z*dx.z;
+                        virial_j[0*virial_pitch_j+mem_idx] += force_div2r*dx.x*dx.x;
+                        virial_j[1*virial_pitch_j+mem_idx] += force_div2r*dx.x*dx.y;
+                        virial_j[2*virial_pitch_j+mem_idx] += force_div2r*dx.x*dx.z;
+                        virial_j[3*virial_pitch_j+mem_idx] += force_div2r*dx.y*dx.y;
+                        virial_j[4*virial_pitch_j+mem_idx] += force_div2r*dx.y*dx.z;
+                        virial_j[5*virial_pitch_j+mem_idx] += force_div2r*dx.z*dx.z;
+                        }
+                    }
+                };
+
+            // loop over all of the neighbors of this particle
+            const unsigned int myHead = h_head_list.data[i];
+            const unsigned int size = (unsigned int)h_n_neigh.data[i];
+            if (batch)
+                {
+                for (unsigned int k = 0; k < size; k += batch_size)
+                    {
+                    const unsigned int n = std::min(batch_size, size - k);
+
+                    // gather the distances and parameters of the neighbors in this batch
+                    for (unsigned int b = 0; b < n; b++)
+                        {
+                        unsigned int j = h_nlist.data[myHead + k + b];
+                        assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+
+                        Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                        Scalar3 dx = box.minImage(pi - pj);
+
+                        unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+                        assert(typej < m_pdata->getNTypes());
+
+                        unsigned int typpair_idx = m_typpair_idx(typei, typej);
+                        batch_j[b] = j;
+                        batch_dx[b] = dx;
+                        batch_rsq[b] = dot(dx, dx);
+                        batch_rcutsq[b] = h_rcutsq.data[typpair_idx];
+                        batch_params[b] = h_params.data[typpair_idx];
+                        }
+
+                    // compute the forces and potential energies of the whole batch
+                    PairEvaluatorBatch<evaluator>::eval(batch_rsq, batch_rcutsq, batch_params,
+                        batch_force_divr, batch_pair_eng, m_shift_mode == shift, n);
+
+                    // accumulate in neighbor list order, skipping neighbors outside of the cutoff
+                    for (unsigned int b = 0; b < n; b++)
+                        {
+                        if (batch_rsq[b] < batch_rcutsq[b])
+                            accumulate(batch_j[b], batch_dx[b], batch_force_divr[b], batch_pair_eng[b]);
                         }
                     }
                 }
-            }
+            else
+                {
+                for (unsigned int k = 0; k < size; k++)
+                    {
+                    // access the index of this neighbor (MEM TRANSFER: 1 scalar)
+                    unsigned int j = h_nlist.data[myHead + k];
+                    assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+
+                    // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
+                    Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                    Scalar3 dx = pi - pj;
+
+                    // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
+                    unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+                    assert(typej < m_pdata->getNTypes());
+
+                    // access diameter and charge (if needed)
+                    Scalar dj = Scalar(0.0);
+                    Scalar qj = Scalar(0.0);
+                    if (evaluator::needsDiameter())
+                        dj = h_diameter.data[j];
+                    if (evaluator::needsCharge())
+                        qj = h_charge.data[j];
+
+                    // apply periodic boundary conditions
+                    dx = box.minImage(dx);
+
+                    // calculate r_ij squared (FLOPS: 5)
+                    Scalar rsq = dot(dx, dx);
+
+                    // get parameters for this type pair
+                    unsigned int typpair_idx = m_typpair_idx(typei, typej);
+                    param_type param = h_params.data[typpair_idx];
+                    Scalar rcutsq = h_rcutsq.data[typpair_idx];
+                    Scalar ronsq = Scalar(0.0);
+                    if (m_shift_mode == xplor)
+                        ronsq = h_ronsq.data[typpair_idx];
+
+                    // design specifies that energies are shifted if
+                    // 1) shift mode is set to shift
+                    // or 2) shift mode is explor and ron > rcut
+                    bool energy_shift = false;
+                    if (m_shift_mode == shift)
+                        energy_shift = true;
+                    else if (m_shift_mode == xplor)
+                        {
+                        if (ronsq > rcutsq)
+                            energy_shift = true;
+                        }
 
-        // finally, increment the force, potential energy and virial for particle i
-        unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
-        if (compute_virial)
-            {
-            h_virial.data[0*m_virial_pitch+mem_idx] += virialxxi;
-            h_virial.data[1*m_virial_pitch+mem_idx] += virialxyi;
-            h_virial.data[2*m_virial_pitch+mem_idx] += virialxzi;
-            h_virial.data[3*m_virial_pitch+mem_idx] += virialyyi;
-            h_virial.data[4*m_virial_pitch+mem_idx] += virialyzi;
-            h_virial.data[5*m_virial_pitch+mem_idx] += virialzzi;
+                    // compute the force and potential energy
+                    Scalar force_divr = Scalar(0.0);
+                    Scalar pair_eng = Scalar(0.0);
+                    evaluator eval(rsq, rcutsq, param);
+                    if (evaluator::needsDiameter())
+                        eval.setDiameter(di, dj);
+                    if (evaluator::needsCharge())
+                        eval.setCharge(qi, qj);
+
+                    bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+
+                    if (evaluated)
+                        {
+                        // modify the potential for xplor shifting
+                        if (m_shift_mode == xplor)
+                            {
+                            if (rsq >= ronsq && rsq < rcutsq)
+                                {
+                                // Implement XPLOR smoothing (FLOPS: 16)
+                                Scalar old_pair_eng = pair_eng;
+                                Scalar old_force_divr = force_divr;
+
+                                // calculate 1.0 / (xplor denominator)
+                                Scalar xplor_denom_inv =
+                                    Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+
+                                Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
+                                Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq *
+                                           (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
+                                Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+
+                                // make modifications to the old pair energy and force
+                                pair_eng = old_pair_eng * s;
+                                // note: I'm not sure why the minus sign needs to be there: my notes have a +
+                                // But this is verified correct via plotting
+                                force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
+                                }
+                            }
+
+                        accumulate(j, dx, force_divr, pair_eng);
+                        }
+                    }
+                }
+
+            // finally, increment the force, potential energy and virial for particle i
+            unsigned int mem_idx = i;
+            h_force.data[mem_idx].x += fi.x;
+            h_force.data[mem_idx].y += fi.y;
+            h_force.data[mem_idx].z += fi.z;
+            h_force.data[mem_idx].w += pei;
+            if (compute_virial)
+                {
+                h_virial.data[0*m_virial_pitch+mem_idx] += virialxxi;
+                h_virial.data[1*m_virial_pitch+mem_idx] += virialxyi;
+                h_virial.data[2*m_virial_pitch+mem_idx] += virialxzi;
+                h_virial.data[3*m_virial_pitch+mem_idx] += virialyyi;
+                h_virial.data[4*m_virial_pitch+mem_idx] += virialyzi;
+                h_virial.data[5*m_virial_pitch+mem_idx] += virialzzi;
+                }
             }
+        };
+
+    const unsigned int num_threads = m_exec_conf->getNumThreads();
+
+    if (num_threads == 1)
+        {
+        // serial execution, third law forces are written directly into the output arrays
+        compute_range(0, n, h_force.data, h_virial.data, m_virial_pitch, 0);
+        }
+    #ifdef ENABLE_TBB
+    else if (!third_law)
+        {
+        // with a full neighbor list every thread only writes to particles in its own range
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n),
+            [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                compute_range(r.begin(), r.end(), h_force.data, h_virial.data, m_virial_pitch, 0);
+                });
         }
+    else
+        {
+        // with a half neighbor list, split the particles into one fixed range per thread and accumulate the third law
+        // forces of every range into its own buffer. A buffer only spans the local neighbors [j_first, j_last) its
+        // range reaches, which is little more than the range itself when the particles are spatially sorted.
+        std::vector<unsigned int> j_first(num_threads, 0);
+        std::vector<unsigned int> j_last(num_threads, 0);
+        if (m_thread_force.size() < num_threads)
+            m_thread_force.resize(num_threads);
+        if (compute_virial && m_thread_virial.size() < num_threads)
+            m_thread_virial.resize(num_threads);
+
+        tbb::parallel_for((unsigned int)0, num_threads, [&](unsigned int chunk)
+            {
+            const unsigned int first = chunk*n/num_threads;
+            const unsigned int last = (chunk+1)*n/num_threads;
 
-    if (m_prof) m_prof->pop();
+            // find the range of local neighbors
+            unsigned int lo = N;
+            unsigned int hi = 0;
+            for (unsigned int p = first; p < last; p++)
+                {
+                const unsigned int i = particles ? particles[p] : p;
+                const unsigned int myHead = h_head_list.data[i];
+                const unsigned int size = (unsigned int)h_n_neigh.data[i];
+                for (unsigned int k = 0; k < size; k++)
+                    {
+                    unsigned int j = h_nlist.data[myHead + k];
+                    if (j < N)
+                        {
+                        lo = std::min(lo, j);
+                        hi = std::max(hi, j+1);
+                        }
+                    }
+                }
+            if (lo >= hi)
+                lo = hi = 0;
+            j_first[chunk] = lo;
+            j_last[chunk] = hi;
+            const unsigned int width = hi - lo;
+
+            // grow and zero the buffer on the thread that uses it
+            std::vector<Scalar4>& force_j = m_thread_force[chunk];
+            if (force_j.size() < width)
+                force_j.resize(width);
+            memset((void*)force_j.data(), 0, sizeof(Scalar4)*width);
+
+            Scalar *virial_j = NULL;
+            if (compute_virial)
+                {
+                if (m_thread_virial[chunk].size() < 6*width)
+                    m_thread_virial[chunk].resize(6*width);
+                virial_j = m_thread_virial[chunk].data();
+                memset((void*)virial_j, 0, sizeof(Scalar)*6*width);
+                }
+
+            compute_range(first, last, force_j.data(), virial_j, width, lo);
+            });
+
+        // sum the buffers into the output arrays, always in the same order
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                    {
+                    for (unsigned int chunk = 0; chunk < num_threads; ++chunk)
+                        {
+                        if (i < j_first[chunk] || i >= j_last[chunk])
+                            continue;
+
+                        const unsigned int idx = i - j_first[chunk];
+                        const Scalar4& f = m_thread_force[chunk][idx];
+                        h_force.data[i].x += f.x;
+                        h_force.data[i].y += f.y;
+                        h_force.data[i].z += f.z;
+                        h_force.data[i].w += f.w;
+
+                        if (compute_virial)
+                            {
+                            const unsigned int width = j_last[chunk] - j_first[chunk];
+                            for (unsigned int l = 0; l < 6; ++l)
+                                h_virial.data[l*m_virial_pitch+i] += m_thread_virial[chunk][l*width+idx];
+                            }
+                        }
+                    }
+                });
+        }
+    #endif
     }
 
 #ifdef ENABLE_MPI
@@ -724,6 +1084,7 @@ template < class T > void export_PotentialPair(pybind11::module& m, const std::s
         .def("setRcut", &T::setRcut)
         .def("setRon", &T::setRon)
         .def("setShiftMode", &T::setShiftMode)
+        .def("setBatchEvaluation", &T::setBatchEvaluation)
         .def("computeEnergyBetweenSets", &T::computeEnergyBetweenSetsPythonList)
     ;
 
@@ -63,6 +63,9 @@ class PotentialPairDPDThermo : public PotentialPair<evaluator>
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
+
+        //! The DPD forces are always computed in a single pass
+        virtual void computeInterior(unsigned int timestep) {}
         #endif
 
     protected:
@@ -9,6 +9,7 @@
 #include <stdexcept>
 #include <memory>
 #include <fstream>
+#include <vector>
 
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/Index1D.h"
@@ -16,6 +17,9 @@
 #include "hoomd/ForceCompute.h"
 #include "NeighborList.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
 
 /*! \file PotentialTersoff.h
     \brief Defines the template class for standard three-body potentials
@@ -55,6 +59,13 @@
     can simply return 0 for that force.  In addition, the potential energy is stored in the w component
     of force_divr_ij.
 
+    On the CPU, the separations of all neighbors of particle i are computed once and stored before the loops over the
+    ij and ik pairs. Forces are also added to the neighbors j and k, so with several threads every thread accumulates
+    the forces of its range of particles into its own buffer, and the buffers are summed in a fixed order. A buffer
+    only spans the indices of the range and its neighbors, which is little more than the range itself after the
+    particles are spatially sorted. With ghost particles, the buffers of ranges at a domain boundary extend to the
+    ghost indices.
+
     rcutsq, ronsq, and the params are stored per particle type-pair. It wastes a little bit of space, but benchmarks
     show that storing the symmetric type pairs and indexing with Index2D is faster than not storing redudant pairs
     and indexing with Index2DUpperTriangular. All of these values are stored in GPUArray
@@ -104,6 +115,18 @@ class PotentialTersoff : public ForceCompute
         std::string m_prof_name;                    //!< Cached profiler name
         std::string m_log_name;                     //!< Cached log name
 
+        //! Quantities of a single neighbor of particle i that the triplet loops reuse
+        struct neighbor_entry
+            {
+            Scalar3 dx;                 //!< Minimum image separation r_i - r_j
+            Scalar rsq;                 //!< Squared distance
+            unsigned int idx;           //!< Particle index of the neighbor
+            unsigned int typpair_idx;   //!< Type pair index with particle i
+            bool interactive;           //!< True if the neighbor can be particle k of a triplet
+            };
+
+        std::vector< std::vector<Scalar4> > m_thread_force; //!< Per-thread force buffers
+
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
 
@@ -300,206 +323,249 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
     ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
 
     // need to start from a zero force, energy
-    memset(h_force.data, 0, sizeof(Scalar4)*m_pdata->getN());
-
-    // for each particle
-    for (int i = 0; i < (int)m_pdata->getN(); i++)
-        {
-        // access the particle's position and type (MEM TRANSFER: 4 scalars)
-        Scalar3 posi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        const unsigned int head_i = h_head_list.data[i];
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
-
-        // initialize current force and potential energy of particle i to 0
-        Scalar3 fi = make_scalar3(0.0, 0.0, 0.0);
-        Scalar pei = 0.0;
-
-        // loop over all of the neighbors of this particle
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        for (unsigned int j = 0; j < size; j++)
-            {
-            // access the index of neighbor j (MEM TRANSFER: 1 scalar)
-            unsigned int jj = h_nlist.data[head_i + j];
-            assert(jj < m_pdata->getN());
-
-            // access the position and type of particle j
-            Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
-            unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
-            assert(typej < m_pdata->getNTypes());
-
-            // initialize the current force and potential energy of particle j to 0
-            Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
-            Scalar pej = 0.0;
-
-            // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 dxij = posi - posj;
+    memset((void*)h_force.data, 0, sizeof(Scalar4)*m_force.getNumElements());
 
-            // apply periodic boundary conditions
-            dxij = box.minImage(dxij);
+    // forces are added to neighbors, which may be ghost particles
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_tot = N + m_pdata->getNGhosts();
 
-            // compute rij_sq (FLOPS: 5)
-            Scalar rij_sq = dot(dxij, dxij);
+    // compute the forces of the particles [begin, end) and add them to force, which holds the particles starting
+    // at index offset
+    auto compute_range = [&](unsigned int begin, unsigned int end, Scalar4 *force, unsigned int offset)
+        {
+        // the neighbors of the current particle, reused for all particles of this range
+        std::vector<neighbor_entry> neigh;
 
-            // get parameters for this type pair
-            unsigned int typpair_idx = m_typpair_idx(typei, typej);
-            param_type param = h_params.data[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
+        for (unsigned int i = begin; i < end; i++)
+            {
+            // access the particle's position and type (MEM TRANSFER: 4 scalars)
+            Scalar3 posi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            const unsigned int head_i = h_head_list.data[i];
+            // sanity check
+            assert(typei < m_pdata->getNTypes());
+
+            // first compute the separation of every neighbor once, the triplet loops below only read them
+            const unsigned int size = (unsigned int)h_n_neigh.data[i];
+            neigh.resize(size);
+            for (unsigned int j = 0; j < size; j++)
+                {
+                // access the index of neighbor j (MEM TRANSFER: 1 scalar)
+                unsigned int jj = h_nlist.data[head_i + j];
+                assert(jj < n_tot);
+
+                // access the position and type of particle j
+                Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
+                unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
+                assert(typej < m_pdata->getNTypes());
+
+                // calculate dr_ij and apply periodic boundary conditions
+                Scalar3 dxij = box.minImage(posi - posj);
+
+                neighbor_entry& nj = neigh[j];
+                nj.dx = dxij;
+                nj.rsq = dot(dxij, dxij);
+                nj.idx = jj;
+                nj.typpair_idx = m_typpair_idx(typei, typej);
+
+                // whether this neighbor contributes as particle k of a triplet
+                evaluator temp_eval(nj.rsq, h_rcutsq.data[nj.typpair_idx], h_params.data[nj.typpair_idx]);
+                nj.interactive = temp_eval.areInteractive();
+                }
 
-            // evaluate the base repulsive and attractive terms
-            Scalar fR = 0.0;
-            Scalar fA = 0.0;
-            evaluator eval(rij_sq, rcutsq, param);
-            bool evaluated = eval.evalRepulsiveAndAttractive(fR, fA);
+            // initialize current force and potential energy of particle i to 0
+            Scalar3 fi = make_scalar3(0.0, 0.0, 0.0);
+            Scalar pei = 0.0;
 
-            if (evaluated)
+            // loop over all of the neighbors of this particle
+            for (unsigned int j = 0; j < size; j++)
                 {
-                // evaluate chi
-                Scalar chi = 0.0;
-                for (unsigned int k = 0; k < size; k++)
+                const neighbor_entry& nj = neigh[j];
+                const unsigned int jj = nj.idx;
+                const Scalar3 dxij = nj.dx;
+                const Scalar rij_sq = nj.rsq;
+
+                // initialize the current force and potential energy of particle j to 0
+                Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
+                Scalar pej = 0.0;
+
+                // get parameters for this type pair
+                param_type param = h_params.data[nj.typpair_idx];
+                Scalar rcutsq = h_rcutsq.data[nj.typpair_idx];
+
+                // evaluate the base repulsive and attractive terms
+                Scalar fR = 0.0;
+                Scalar fA = 0.0;
+                evaluator eval(rij_sq, rcutsq, param);
+                bool evaluated = eval.evalRepulsiveAndAttractive(fR, fA);
+
+                if (evaluated)
                     {
-                    // access the index of neighbor k
-                    unsigned int kk = h_nlist.data[head_i + k];
-                    assert(kk < m_pdata->getN());
-
-                    // access the position and type of neighbor k
-                    Scalar3 posk = make_scalar3(h_pos.data[kk].x, h_pos.data[kk].y, h_pos.data[kk].z);
-                    unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
-                    assert(typek < m_pdata->getNTypes());
-
-                    // access the type pair parameters for i and k
-                    typpair_idx = m_typpair_idx(typei, typek);
-                    param_type temp_param = h_params.data[typpair_idx];
-
-                    evaluator temp_eval(rij_sq, rcutsq, temp_param);
-                    bool temp_evaluated = temp_eval.areInteractive();
-
-                    if (kk != jj && temp_evaluated)
+                    // evaluate chi
+                    Scalar chi = 0.0;
+                    for (unsigned int k = 0; k < size; k++)
                         {
-                        // compute drik
-                        Scalar3 dxik = posi - posk;
-
-                        // apply periodic boundary conditions
-                        dxik = box.minImage(dxik);
+                        const neighbor_entry& nk = neigh[k];
+
+                        if (nk.idx != jj && nk.interactive)
+                            {
+                            // compute the bond angle (if needed)
+                            Scalar cos_th = Scalar(0.0);
+                            if (evaluator::needsAngle())
+                                cos_th = dot(dxij, nk.dx) / sqrt(rij_sq * nk.rsq);
+
+                            // evaluate the partial chi term
+                            eval.setRik(nk.rsq);
+                            if (evaluator::needsAngle())
+                                eval.setAngle(cos_th);
+
+                            eval.evalChi(chi);
+                            }
+                        }
 
-                        // compute rik_sq
-                        Scalar rik_sq = dot(dxik, dxik);
+                    // evaluate the force and energy from the ij interaction
+                    Scalar force_divr = Scalar(0.0);
+                    Scalar potential_eng = Scalar(0.0);
+                    Scalar bij = Scalar(0.0);
+                    eval.evalForceij(fR, fA, chi, bij, force_divr, potential_eng);
 
-                        // compute the bond angle (if needed)
-                        Scalar cos_th = Scalar(0.0);
-                        if (evaluator::needsAngle())
-                            cos_th = dot(dxij, dxik) / sqrt(rij_sq * rik_sq);
+                    // add this force to particle i
+                    fi += force_divr * dxij;
+                    pei += potential_eng * Scalar(0.5);
 
-                        // evaluate the partial chi term
-                        eval.setRik(rik_sq);
-                        if (evaluator::needsAngle())
-                            eval.setAngle(cos_th);
+                    // add this force to particle j
+                    fj += Scalar(-1.0) * force_divr * dxij;
+                    pej += potential_eng * Scalar(0.5);
 
-                        eval.evalChi(chi);
+                    // evaluate the force from the ik interactions
+                    for (unsigned int k = 0; k < size; k++)
+                        {
+                        const neighbor_entry& nk = neigh[k];
+
+                        if (nk.idx != jj && nk.interactive)
+                            {
+                            const Scalar3 dxik = nk.dx;
+
+                            // compute the bond angle (if needed)
+                            Scalar cos_th = Scalar(0.0);
+                            if (evaluator::needsAngle())
+                                cos_th = dot(dxij, dxik) / sqrt(rij_sq * nk.rsq);
+
+                            // set up the evaluator
+                            eval.setRik(nk.rsq);
+                            if (evaluator::needsAngle())
+                                eval.setAngle(cos_th);
+
+                            // compute the total force and energy
+                            Scalar3 force_divr_ij = make_scalar3(0.0, 0.0, 0.0);
+                            Scalar3 force_divr_ik = make_scalar3(0.0, 0.0, 0.0);
+                            eval.evalForceik(fR, fA, chi, bij, force_divr_ij, force_divr_ik);
+
+                            // add the force to particle i
+                            // (FLOPS: 17)
+                            fi.x += force_divr_ij.x * dxij.x + force_divr_ik.x * dxik.x;
+                            fi.y += force_divr_ij.x * dxij.y + force_divr_ik.x * dxik.y;
+                            fi.z += force_divr_ij.x * dxij.z + force_divr_ik.x * dxik.z;
+
+                            // add the force to particle j (FLOPS: 17)
+                            fj.x += force_divr_ij.y * dxij.x + force_divr_ik.y * dxik.x;
+                            fj.y += force_divr_ij.y * dxij.y + force_divr_ik.y * dxik.y;
+                            fj.z += force_divr_ij.y * dxij.z + force_divr_ik.y * dxik.z;
+
+                            // increment the force for particle k
+                            unsigned int mem_idx = nk.idx - offset;
+                            force[mem_idx].x += force_divr_ij.z * dxij.x + force_divr_ik.z * dxik.x;
+                            force[mem_idx].y += force_divr_ij.z * dxij.y + force_divr_ik.z * dxik.y;
+                            force[mem_idx].z += force_divr_ij.z * dxij.z + force_divr_ik.z * dxik.z;
+                            }
                         }
                     }
+                // increment the force and potential energy for particle j
+                unsigned int mem_idx = jj - offset;
+                force[mem_idx].x += fj.x;
+                force[mem_idx].y += fj.y;
+                force[mem_idx].z += fj.z;
+                force[mem_idx].w += pej;
+                }
+            // finally, increment the force and potential energy for particle i
+            unsigned int mem_idx = i - offset;
+            force[mem_idx].x += fi.x;
+            force[mem_idx].y += fi.y;
+            force[mem_idx].z += fi.z;
+            force[mem_idx].w += pei;
+            }
+        };
 
-                // evaluate the force and energy from the ij interaction
-                Scalar force_divr = Scalar(0.0);
-                Scalar potential_eng = Scalar(0.0);
-                Scalar bij = Scalar(0.0);
-                eval.evalForceij(fR, fA, chi, bij, force_divr, potential_eng);
-
-                // add this force to particle i
-                fi += force_divr * dxij;
-                pei += potential_eng * Scalar(0.5);
+    const unsigned int num_threads = m_exec_conf->getNumThreads();
 
-                // add this force to particle j
-                fj += Scalar(-1.0) * force_divr * dxij;
-                pej += potential_eng * Scalar(0.5);
+    if (num_threads == 1)
+        {
+        compute_range(0, N, h_force.data, 0);
+        }
+    #ifdef ENABLE_TBB
+    else
+        {
+        // every triplet adds forces to its neighbors, so split the particles into one fixed range per thread
+        // and accumulate the forces of every range into its own buffer. A buffer only spans the particles
+        // [j_first, j_last) the range and its neighbors cover.
+        std::vector<unsigned int> j_first(num_threads, 0);
+        std::vector<unsigned int> j_last(num_threads, 0);
+        if (m_thread_force.size() < num_threads)
+            m_thread_force.resize(num_threads);
+
+        tbb::parallel_for((unsigned int)0, num_threads, [&](unsigned int chunk)
+            {
+            const unsigned int begin = chunk*N/num_threads;
+            const unsigned int end = (chunk+1)*N/num_threads;
 
-                // evaluate the force from the ik interactions
-                for (unsigned int k = 0; k < size; k++)
+            // find the range of particles this range writes to
+            unsigned int lo = begin;
+            unsigned int hi = end;
+            for (unsigned int i = begin; i < end; i++)
+                {
+                const unsigned int head_i = h_head_list.data[i];
+                const unsigned int size = (unsigned int)h_n_neigh.data[i];
+                for (unsigned int j = 0; j < size; j++)
                     {
-                    // access the index of neighbor k
-                    unsigned int kk = h_nlist.data[head_i + k];
-                    assert(kk < m_pdata->getN());
-
-                    // access the position and type of neighbor k
-                    Scalar3 posk = make_scalar3(h_pos.data[kk].x, h_pos.data[kk].y, h_pos.data[kk].z);
-                    unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
-                    assert(typek < m_pdata->getNTypes());
-
-                    // access the type pair parameters for i and k
-                    typpair_idx = m_typpair_idx(typei, typek);
-                    param_type temp_param = h_params.data[typpair_idx];
-
-                    evaluator temp_eval(rij_sq, rcutsq, temp_param);
-                    bool temp_evaluated = temp_eval.areInteractive();
-
-                    if (kk != jj && temp_evaluated)
+                    unsigned int jj = h_nlist.data[head_i + j];
+                    lo = std::min(lo, jj);
+                    hi = std::max(hi, jj+1);
+                    }
+                }
+            j_first[chunk] = lo;
+            j_last[chunk] = hi;
+            const unsigned int width = hi - lo;
+
+            // grow and zero the buffer on the thread that uses it
+            std::vector<Scalar4>& force = m_thread_force[chunk];
+            if (force.size() < width)
+                force.resize(width);
+            memset((void*)force.data(), 0, sizeof(Scalar4)*width);
+
+            compute_range(begin, end, force.data(), lo);
+            });
+
+        // sum the buffers into the output array, always in the same order
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_tot),
+            [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                    {
+                    for (unsigned int chunk = 0; chunk < num_threads; ++chunk)
                         {
-                        // create variable for the force on k
-                        Scalar3 fk = make_scalar3(0.0, 0.0, 0.0);
-
-                        // compute dr_ik
-                        Scalar3 dxik = posi - posk;
-
-                        // apply periodic boundary conditions
-                        dxik = box.minImage(dxik);
-
-                        // compute rik_sq
-                        Scalar rik_sq = dot(dxik, dxik);
-
-                        // compute the bond angle (if needed)
-                        Scalar cos_th = Scalar(0.0);
-                        if (evaluator::needsAngle())
-                            cos_th = dot(dxij, dxik) / sqrt(rij_sq * rik_sq);
-
-                        // set up the evaluator
-                        eval.setRik(rik_sq);
-                        if (evaluator::needsAngle())
-                            eval.setAngle(cos_th);
-
-                        // compute the total force and energy
-                        Scalar3 force_divr_ij = make_scalar3(0.0, 0.0, 0.0);
-                        Scalar3 force_divr_ik = make_scalar3(0.0, 0.0, 0.0);
-                        eval.evalForceik(fR, fA, chi, bij, force_divr_ij, force_divr_ik);
-
-                        // add the force to particle i
-                        // (FLOPS: 17)
-                        fi.x += force_divr_ij.x * dxij.x + force_divr_ik.x * dxik.x;
-                        fi.y += force_divr_ij.x * dxij.y + force_divr_ik.x * dxik.y;
-                        fi.z += force_divr_ij.x * dxij.z + force_divr_ik.x * dxik.z;
-
-                        // add the force to particle j (FLOPS: 17)
-                        fj.x += force_divr_ij.y * dxij.x + force_divr_ik.y * dxik.x;
-                        fj.y += force_divr_ij.y * dxij.y + force_divr_ik.y * dxik.y;
-                        fj.z += force_divr_ij.y * dxij.z + force_divr_ik.y * dxik.z;
-
-                        // add the force to particle k
-                        fk.x += force_divr_ij.z * dxij.x + force_divr_ik.z * dxik.x;
-                        fk.y += force_divr_ij.z * dxij.y + force_divr_ik.z * dxik.y;
-                        fk.z += force_divr_ij.z * dxij.z + force_divr_ik.z * dxik.z;
-
-                        // increment the force for particle k
-                        unsigned int mem_idx = kk;
-                        h_force.data[mem_idx].x += fk.x;
-                        h_force.data[mem_idx].y += fk.y;
-                        h_force.data[mem_idx].z += fk.z;
+                        if (i < j_first[chunk] || i >= j_last[chunk])
+                            continue;
+
+                        const Scalar4& f = m_thread_force[chunk][i - j_first[chunk]];
+                        h_force.data[i].x += f.x;
+                        h_force.data[i].y += f.y;
+                        h_force.data[i].z += f.z;
+                        h_force.data[i].w += f.w;
                         }
                     }
-                }
-            // increment the force and potential energy for particle j
-            unsigned int mem_idx = jj;
-            h_force.data[mem_idx].x += fj.x;
-            h_force.data[mem_idx].y += fj.y;
-            h_force.data[mem_idx].z += fj.z;
-            h_force.data[mem_idx].w += pej;
-            }
-        // finally, increment the force and potential energy for particle i
-        unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
+                });
         }
+    #endif
 
     if (m_prof) m_prof->pop();
     }
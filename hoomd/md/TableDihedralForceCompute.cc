@@ -131,6 +131,10 @@ void TableDihedralForceCompute::computeForces(unsigned int timestep)
     // start the profile for this compute
     if (m_prof) m_prof->push("Dihedral Table pair");
 
+    // dihedrals that share no particle are computed concurrently
+    const unsigned int num_threads = m_exec_conf->getNumThreads();
+    if (num_threads > 1)
+        m_dihedral_data->updateColoring();
 
     // access the particle data
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
@@ -156,12 +160,15 @@ void TableDihedralForceCompute::computeForces(unsigned int timestep)
     // access the table data
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
 
-    // for each of the dihedrals
-    const unsigned int size = (unsigned int)m_dihedral_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    // access the dihedral table
+    ArrayHandle<DihedralData::members_t> h_dihedrals(m_dihedral_data->getMembersArray(), access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_dihedral_data->getTypeValArray(), access_location::host, access_mode::read);
+
+    // computes a single dihedral, only the forces on its members are written
+    auto compute_dihedral = [&](unsigned int i)
         {
         // lookup the tag of each of the particles participating in the dihedral
-        const DihedralData::members_t& dihedral = m_dihedral_data->getMembersByIndex(i);
+        const DihedralData::members_t& dihedral = h_dihedrals.data[i];
         assert(dihedral.tag[0] <= m_pdata->getMaximumTag());
         assert(dihedral.tag[1] <= m_pdata->getMaximumTag());
         assert(dihedral.tag[2] <= m_pdata->getMaximumTag());
@@ -174,14 +181,9 @@ void TableDihedralForceCompute::computeForces(unsigned int timestep)
         unsigned int idx_c = h_rtag.data[dihedral.tag[2]];
         unsigned int idx_d = h_rtag.data[dihedral.tag[3]];
 
-        // throw an error if this angle is incomplete
+        // an incomplete dihedral is reported after the loop, errors can not be raised on a worker thread
         if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL || idx_d == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error() << "dihedral.harmonic: dihedral " <<
-                dihedral.tag[0] << " " << dihedral.tag[1] << " " << dihedral.tag[2] << " " << dihedral.tag[3]
-                << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in dihedral calculation");
-            }
+            return false;
 
         assert(idx_a < m_pdata->getN()+m_pdata->getNGhosts());
         assert(idx_b < m_pdata->getN()+m_pdata->getNGhosts());
@@ -276,7 +278,7 @@ void TableDihedralForceCompute::computeForces(unsigned int timestep)
         // compute index into the table and read in values
 
         /// Here we use the table!!
-        unsigned int dihedral_type = m_dihedral_data->getTypeByIndex(i);
+        unsigned int dihedral_type = h_typeval.data[i].type;
         unsigned int value_i = value_f;
         Scalar2 VT0 = h_tables.data[m_table_value(value_i, dihedral_type)];
         Scalar2 VT1 = h_tables.data[m_table_value(value_i+1, dihedral_type)];
@@ -347,7 +349,19 @@ void TableDihedralForceCompute::computeForces(unsigned int timestep)
         h_force.data[idx_d].w += dihedral_eng;
         for (int k = 0; k < 6; k++)
            h_virial.data[virial_pitch*k+idx_d]  += dihedral_virial[k];
-       }
+        return true;
+        };
+
+    // for each of the dihedrals
+    unsigned int failed = m_dihedral_data->forEachGroup(num_threads, compute_dihedral);
+    if (failed != GROUP_NOT_LOCAL)
+        {
+        const DihedralData::members_t& dihedral = h_dihedrals.data[failed];
+        this->m_exec_conf->msg->error() << "dihedral.harmonic: dihedral " <<
+            dihedral.tag[0] << " " << dihedral.tag[1] << " " << dihedral.tag[2] << " " << dihedral.tag[3]
+            << " incomplete." << endl << endl;
+        throw std::runtime_error("Error in dihedral calculation");
+        }
 
     if (m_prof) m_prof->pop();
     }
@@ -289,8 +289,9 @@ void TwoStepNVTMTK::integrateStepOne(unsigned int timestep)
             }
         }
 
-    // get temperature and advance thermostat
-    advanceThermostat(timestep);
+    // start computing the temperature at the half step, the thermostat is advanced in integrateStepTwo() so that
+    // the reduction over the ranks overlaps with the force computation
+    m_thermo->compute(timestep+1);
 
     // done profiling
     if (m_prof)
@@ -310,6 +311,9 @@ void TwoStepNVTMTK::integrateStepTwo(unsigned int timestep)
     if (m_prof)
         m_prof->push("NVT step 2");
 
+    // get temperature and advance thermostat
+    advanceThermostat(timestep);
+
     ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
     ArrayHandle<Scalar3> h_accel(m_pdata->getAccelerations(), access_location::host, access_mode::readwrite);
 
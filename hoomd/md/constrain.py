@@ -55,6 +55,7 @@ class _constraint_force(hoomd.meta._metadata):
 
         self.force_name = "constraint_force%d" % (id);
         self.enabled = True;
+        hoomd.timing._set_timer_name(self.force_name, self, prefix='force_');
 
         self.composite = False;
         hoomd.context.current.constraint_forces.append(self);
@@ -238,20 +239,37 @@ class distance(_constraint_force):
 
         hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
 
-    def set_params(self,rel_tol=None):
+    def set_params(self,rel_tol=None,solver=None,solver_tol=None):
         R""" Set parameters for constraint computation.
 
         Args:
             rel_tol (float): The relative tolerance with which constraint violations are detected (**optional**).
+            solver (str): The linear solver for the constraint equations, either 'lu' (sparse LU decomposition,
+                the default) or 'iterative' (preconditioned BiCGSTAB) (**optional**).
+            solver_tol (float): The relative residual tolerance of the iterative solver (**optional**).
+
+        The iterative solver starts from the constraint forces of the previous step and can be faster than the LU
+        decomposition for large systems of coupled constraints. On the GPU, it is only used when HOOMD is built without
+        CUSOLVER.
 
         Example::
 
             dist = constrain.distance()
             dist.set_params(rel_tol=0.0001)
+            dist.set_params(solver='iterative', solver_tol=1e-10)
         """
         if rel_tol is not None:
             self.cpp_force.setRelativeTolerance(float(rel_tol))
 
+        if solver is not None:
+            if solver not in ['lu', 'iterative']:
+                hoomd.context.msg.error("constrain.distance: solver must be 'lu' or 'iterative'\n");
+                raise ValueError("Invalid solver");
+            self.cpp_force.setIterative(solver == 'iterative')
+
+        if solver_tol is not None:
+            self.cpp_force.setSolverTolerance(float(solver_tol))
+
 class rigid(_constraint_force):
     R""" Constrain particles in rigid bodies.
 
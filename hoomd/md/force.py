@@ -48,6 +48,7 @@ class _force(hoomd.meta._metadata):
 
         self.force_name = "force%d" % (id);
         self.enabled = True;
+        hoomd.timing._set_timer_name(self.force_name, self, prefix='force_', suffix=self.name);
         self.log =True;
         hoomd.context.current.forces.append(self);
 
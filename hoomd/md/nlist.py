@@ -183,6 +183,50 @@ class nlist:
         if d_max is not None:
             self.cpp_nlist.setMaximumDiameter(d_max);
 
+    def set_autotune(self, enable=True, r_min=0.05, r_max=1.0, period=1000):
+        R""" Tune *r_buff* while the simulation runs.
+
+        Args:
+            enable (bool): Set to False to stop tuning and keep the current *r_buff*
+            r_min (float): Smallest value of *r_buff* to set (in distance units)
+            r_max (float): Largest value of *r_buff* to set (in distance units)
+            period (int): Number of time steps to measure each value of *r_buff* for
+
+        When tuning is enabled, the neighbor list measures the wall time per step and the time spent building the
+        list over every *period* steps and moves *r_buff* within [*r_min*, *r_max*] towards the fastest value. Once
+        the fastest value is found, the neighbor list keeps it and restarts the search only when the simulation
+        becomes noticeably slower, e.g. when the density changes. Unlike :py:meth:`tune()`, no extra time steps
+        are run.
+
+        The current value of *r_buff* is available to :py:class:`hoomd.analyze.log` as ``nlist_r_buff``.
+
+        *period* should be long enough to average over several neighbor list builds. Choose *r_max* such
+        that the neighbor list cutoff plus *r_max* is valid for the box (and the domain size in MPI simulations).
+        The *check_period* set with :py:meth:`set_params()` is not changed by the tuner, leave it at 1 or choose
+        it for the smallest *r_buff* tested.
+
+        Examples::
+
+            nl.set_autotune(r_min=0.1, r_max=0.8, period=2000)
+            nl.set_autotune(enable=False)
+        """
+        hoomd.util.print_status_line();
+
+        if self.cpp_nlist is None:
+            hoomd.context.msg.error('Bug in hoomd_script: cpp_nlist not set, please report\n');
+            raise RuntimeError('Error setting neighbor list parameters');
+
+        if enable and (r_min < 0 or r_max < r_min):
+            hoomd.context.msg.error("nlist.set_autotune: r_min and r_max must satisfy 0 <= r_min <= r_max\n");
+            raise ValueError('Invalid r_buff bounds');
+
+        if enable and period <= 0:
+            hoomd.context.msg.error("nlist.set_autotune: period must be positive\n");
+            raise ValueError('period must be positive');
+
+        self.cpp_nlist.setAutotuneRBuff(enable, float(r_min), float(r_max), int(period));
+        self.r_buff = self.cpp_nlist.getRBuff();
+
     def reset_exclusions(self, exclusions = None):
         R""" Resets all exclusions in the neighborlist.
 
@@ -127,6 +127,72 @@ class analyze_log_query_tests (unittest.TestCase):
         hoomd.context.initialize();
 
 
+# unit tests for analyze.log_binary
+class analyze_log_binary_tests (unittest.TestCase):
+    def setUp(self):
+        deprecated.init.create_random(N=100, phi_p=0.005);
+        nl = hoomd.md.nlist.cell()
+        self.pair = hoomd.md.pair.lj(r_cut=2.5, nlist = nl)
+        self.pair.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        hoomd.md.integrate.mode_standard(dt=0.005);
+        hoomd.md.integrate.langevin(hoomd.group.all(), seed=1, kT=1.0);
+
+        hoomd.context.current.sorter.set_params(grid=8)
+
+        if hoomd.comm.get_rank() == 0:
+            tmp = tempfile.mkstemp(suffix='.test.bin');
+            self.tmp_file = tmp[1];
+        else:
+            self.tmp_file = "invalid";
+
+    # tests that the records match the queried values
+    def test(self):
+        log = hoomd.analyze.log_binary(quantities = ['potential_energy', 'kinetic_energy', 'not_registered'],
+                                       period = 10, filename=self.tmp_file);
+        hoomd.run(11);
+        U0 = log.query('potential_energy');
+        K0 = log.query('kinetic_energy');
+        hoomd.run(10);
+
+        if hoomd.comm.get_rank() == 0:
+            names, data = hoomd.analyze.read_log_binary(self.tmp_file);
+            self.assertEqual(names, ['timestep', 'potential_energy', 'kinetic_energy', 'not_registered']);
+            self.assertEqual(data.shape, (3, 4));
+            numpy.testing.assert_array_equal(data[:,0], [0, 10, 20]);
+            self.assertAlmostEqual(data[1,1], U0, 5);
+            self.assertAlmostEqual(data[1,2], K0, 5);
+            numpy.testing.assert_array_equal(data[:,3], [0, 0, 0]);
+
+    # tests appending to an existing file
+    def test_append(self):
+        log = hoomd.analyze.log_binary(quantities = ['potential_energy'], period = 10, filename=self.tmp_file);
+        hoomd.run(11);
+        log.disable();
+
+        log = hoomd.analyze.log_binary(quantities = ['potential_energy'], period = 10, filename=self.tmp_file);
+        hoomd.run(10);
+
+        if hoomd.comm.get_rank() == 0:
+            names, data = hoomd.analyze.read_log_binary(self.tmp_file);
+            numpy.testing.assert_array_equal(data[:,0], [0, 10, 20]);
+
+        # the quantities must match the file
+        self.assertRaises(RuntimeError, hoomd.analyze.log_binary, quantities = ['kinetic_energy'], period = 10,
+                          filename=self.tmp_file);
+
+    # tests that the quantities cannot be changed
+    def test_set_params(self):
+        log = hoomd.analyze.log_binary(quantities = ['potential_energy'], period = 10, filename=self.tmp_file);
+        log.set_params(quantities = ['potential_energy']);
+        self.assertRaises(RuntimeError, log.set_params, quantities = ['kinetic_energy']);
+
+    def tearDown(self):
+        self.pair = None;
+        hoomd.context.initialize();
+        if (hoomd.comm.get_rank()==0):
+            os.remove(self.tmp_file);
+
+
 try:
     import h5py
 except ImportError:
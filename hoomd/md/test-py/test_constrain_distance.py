@@ -83,6 +83,37 @@ class constrain_distance_tests (unittest.TestCase):
     def test_set_params(self):
         constraint = md.constrain.distance()
         constraint.set_params(rel_tol=0.01)
+        constraint.set_params(solver='iterative', solver_tol=1e-12)
+        constraint.set_params(solver='lu')
+        self.assertRaises(ValueError, constraint.set_params, solver='cg')
+
+    # test the iterative solver
+    def test_constraint_iterative(self):
+        constraint = md.constrain.distance()
+        constraint.set_params(solver='iterative')
+
+        md.integrate.mode_standard(dt=0.005)
+        md.integrate.nve(group=group.all())
+
+        lj = md.pair.lj(r_cut=2.5, nlist = self.nl)
+        lj.pair_coeff.set('A','A',epsilon=1.0,sigma=1.0)
+        lj.set_params(mode="shift")
+
+        run(100)
+
+        # check that distances are maintained
+        box = self.system.box
+        pos0 = self.system.particles[0].position
+        pos1 = self.system.particles[1].position
+        pos2 = self.system.particles[2].position
+
+        pos01 = box.min_image((pos0[0]-pos1[0], pos0[1]-pos1[1], pos0[2]-pos1[2]))
+        pos02 = box.min_image((pos0[0]-pos2[0], pos0[1]-pos2[1], pos0[2]-pos2[2]))
+        pos12 = box.min_image((pos2[0]-pos1[0], pos2[1]-pos1[1], pos2[2]-pos1[2]))
+
+        self.assertAlmostEqual(pos01[0]*pos01[0]+pos01[1]*pos01[1]+pos01[2]*pos01[2],1.5*1.5,4)
+        self.assertAlmostEqual(pos02[0]*pos02[0]+pos02[1]*pos02[1]+pos02[2]*pos02[2],1.5*1.5,4)
+        self.assertAlmostEqual(pos12[0]*pos12[0]+pos12[1]*pos12[1]+pos12[2]*pos12[2],2.0*1.5*1.5,4)
 
     # test remove particle fails
     def test_constraint_fail(self):
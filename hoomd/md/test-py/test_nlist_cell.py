@@ -46,6 +46,24 @@ class nlist_cell_tests (unittest.TestCase):
     def test_tune(self):
         self.nl.tune(warmup=100, r_min=0.1, r_max=0.25, jumps=10, steps=50)
 
+    # test online tuning of r_buff
+    def test_set_autotune(self):
+        lj = md.pair.lj(r_cut = 2.5, nlist = self.nl)
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        md.integrate.mode_standard(dt=0.005)
+        md.integrate.nve(group=group.all())
+
+        self.nl.set_autotune(r_min=0.2, r_max=0.6, period=10)
+        log = analyze.log(filename=None, quantities=['nlist_r_buff'], period=1)
+        run(100)
+        r_buff = log.query('nlist_r_buff')
+        self.assertGreaterEqual(r_buff, 0.2)
+        self.assertLessEqual(r_buff, 0.6)
+
+        self.nl.set_autotune(enable=False)
+        self.assertRaises(ValueError, self.nl.set_autotune, r_min=0.5, r_max=0.2)
+        self.assertRaises(ValueError, self.nl.set_autotune, period=0)
+
     # test multiple neighbor lists can coexist with different parameters
     def test_multi(self):
         self.nl.set_params(r_buff = 0.3)
@@ -84,6 +84,45 @@ class pair_lj_tests (unittest.TestCase):
         lj.pair_coeff.set('B', 'B', epsilon=1.0, sigma=1.0)
         lj.update_coeffs();
 
+    # test that overlapping the ghost update with the force computation gives the same results
+    def test_comm_overlap(self):
+        lj = md.pair.lj(r_cut=3.0, nlist = self.nl);
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0);
+        md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(group=group.all());
+        log = analyze.log(filename=None, quantities=['potential_energy'], period=1);
+        snap = self.s.take_snapshot();
+
+        run(20);
+        pe = log.query('potential_energy');
+
+        self.s.restore_snapshot(snap);
+        comm.set_overlap();
+        run(20);
+        self.assertAlmostEqual(log.query('potential_energy'), pe, 5);
+
+        comm.set_overlap(False);
+
+    # test that exchanging ghosts with all neighbors at once gives the same results
+    def test_comm_ghost_exchange(self):
+        lj = md.pair.lj(r_cut=3.0, nlist = self.nl);
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0);
+        md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(group=group.all());
+        log = analyze.log(filename=None, quantities=['potential_energy'], period=1);
+        snap = self.s.take_snapshot();
+
+        run(20);
+        pe = log.query('potential_energy');
+
+        self.s.restore_snapshot(snap);
+        comm.set_ghost_exchange(neighbors=26);
+        run(20);
+        self.assertAlmostEqual(log.query('potential_energy'), pe, 5);
+
+        self.assertRaises(RuntimeError, comm.set_ghost_exchange, neighbors=8);
+        comm.set_ghost_exchange(neighbors=6);
+
     def tearDown(self):
         del self.s, self.nl
         context.initialize();
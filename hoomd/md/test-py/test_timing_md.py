@@ -0,0 +1,50 @@
+# -*- coding: iso-8859-1 -*-
+
+import hoomd
+from hoomd import md
+hoomd.context.initialize()
+import unittest
+
+# tests for the timers of the integrator, forces, thermo computes, and neighbor lists
+class timing_md_tests(unittest.TestCase):
+
+    def setUp(self):
+        hoomd.init.create_lattice(unitcell=hoomd.lattice.sc(a=1.5), n=[5,5,4]);
+        self.nl = md.nlist.cell();
+        self.lj = md.pair.lj(r_cut=2.5, nlist=self.nl);
+        self.lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0);
+        md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(group=hoomd.group.all());
+
+    # test that the integrator and the computes it triggers are timed
+    def test_record(self):
+        hoomd.timing.enable(steps=5);
+        hoomd.analyze.log(filename=None, quantities=['temperature'], period=1);
+        hoomd.run(10);
+
+        names = hoomd.timing.names();
+        self.assertIn('integrator', names);
+        self.assertIn('force_pair_lj', names);
+        self.assertIn('compute_thermo', names);
+        self.assertIn(self.nl.name, names);
+        self.assertIn('analyze_log', names);
+
+        integrator = hoomd.timing.get('integrator');
+        force = hoomd.timing.get('force_pair_lj');
+        thermo = hoomd.timing.get('compute_thermo');
+        self.assertEqual(len(integrator), 5);
+        for i in range(5):
+            self.assertGreater(integrator[i], 0);
+            self.assertGreater(force[i], 0);
+            self.assertGreater(thermo[i], 0);
+
+            # the integrator time includes the forces
+            self.assertGreaterEqual(integrator[i], force[i]);
+
+    def tearDown(self):
+        del self.lj
+        del self.nl
+        hoomd.context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -19,6 +19,8 @@ HOOMD_UP_MAIN()
 #include "hoomd/ConstForceCompute.h"
 #include "hoomd/md/TwoStepNVE.h"
 #include "hoomd/md/IntegratorTwoStep.h"
+#include "hoomd/md/AllPairPotentials.h"
+#include "hoomd/md/NeighborListTree.h"
 
 #ifdef ENABLE_CUDA
 #include "hoomd/CommunicatorGPU.h"
@@ -3391,6 +3393,423 @@ void test_communicator_ghosts_per_type(communicator_creator comm_creator, std::s
         }
     }
 
+//! Test that overlapping the ghost update with the interior pair force computation gives the same trajectory
+void test_communicator_overlap(communicator_creator comm_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    UP_ASSERT_EQUAL(size,8);
+
+    // particles on a jittered simple cubic lattice
+    const unsigned int n_side = 12;
+    const unsigned int n = n_side*n_side*n_side;
+    const Scalar a = 1.5;
+    BoxDim box(a*n_side);
+
+    SnapshotParticleData<Scalar> snap(n);
+    snap.type_mapping.push_back("A");
+
+    Scalar3 lo = box.getLo();
+    srand(12345);
+    for (unsigned int i = 0; i < n; ++i)
+        {
+        unsigned int ix = i % n_side, iy = (i / n_side) % n_side, iz = i / (n_side*n_side);
+        snap.pos[i] = vec3<Scalar>(lo.x + a*(ix + Scalar(0.4) + Scalar(0.2)*rand()/RAND_MAX),
+                                   lo.y + a*(iy + Scalar(0.4) + Scalar(0.2)*rand()/RAND_MAX),
+                                   lo.z + a*(iz + Scalar(0.4) + Scalar(0.2)*rand()/RAND_MAX));
+        snap.vel[i] = vec3<Scalar>(rand()/(Scalar)RAND_MAX - Scalar(0.5),
+                                   rand()/(Scalar)RAND_MAX - Scalar(0.5),
+                                   rand()/(Scalar)RAND_MAX - Scalar(0.5));
+        }
+
+    std::shared_ptr<SystemDefinition> sysdef[2];
+    std::shared_ptr<NeighborListTree> nlist[2];
+    std::shared_ptr<PotentialPairLJ> fc[2];
+    std::shared_ptr<IntegratorTwoStep> integrator[2];
+
+    for (unsigned int k = 0; k < 2; ++k)
+        {
+        sysdef[k] = std::shared_ptr<SystemDefinition>(new SystemDefinition(n, box, 1, 0, 0, 0, 0, exec_conf));
+        std::shared_ptr<ParticleData> pdata = sysdef[k]->getParticleData();
+
+        std::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, box.getL(), 2, 2, 2));
+        pdata->setDomainDecomposition(decomposition);
+        pdata->initializeFromSnapshot(snap);
+
+        std::shared_ptr<Communicator> comm = comm_creator(sysdef[k], decomposition);
+        comm->setGhostUpdateOverlap(k == 1);
+        UP_ASSERT_EQUAL(comm->getGhostUpdateOverlap(), k == 1);
+
+        nlist[k] = std::shared_ptr<NeighborListTree>(new NeighborListTree(sysdef[k], Scalar(2.5), Scalar(0.3)));
+        nlist[k]->setCommunicator(comm);
+
+        fc[k] = std::shared_ptr<PotentialPairLJ>(new PotentialPairLJ(sysdef[k], nlist[k]));
+        fc[k]->setRcut(0, 0, Scalar(2.5));
+        fc[k]->setParams(0, 0, make_scalar2(Scalar(4.0), Scalar(4.0)));
+        fc[k]->setCommunicator(comm);
+
+        std::shared_ptr<ParticleSelector> selector_all(new ParticleSelectorTag(sysdef[k], 0, n-1));
+        std::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef[k], selector_all));
+
+        integrator[k] = std::shared_ptr<IntegratorTwoStep>(new IntegratorTwoStep(sysdef[k], Scalar(0.002)));
+        integrator[k]->addIntegrationMethod(std::shared_ptr<TwoStepNVE>(new TwoStepNVE(sysdef[k], group_all)));
+        integrator[k]->addForceCompute(fc[k]);
+        integrator[k]->setCommunicator(comm);
+        integrator[k]->prepRun(0);
+        }
+
+    for (unsigned int step = 0; step < 200; ++step)
+        {
+        integrator[0]->update(step);
+        integrator[1]->update(step);
+        }
+
+    // the interior and boundary forces are summed in a different order, so allow for round-off
+    for (unsigned int tag = 0; tag < n; ++tag)
+        {
+        Scalar3 pos_0 = sysdef[0]->getParticleData()->getPosition(tag);
+        Scalar3 pos_1 = sysdef[1]->getParticleData()->getPosition(tag);
+        MY_CHECK_SMALL(pos_1.x - pos_0.x, 1e-5);
+        MY_CHECK_SMALL(pos_1.y - pos_0.y, 1e-5);
+        MY_CHECK_SMALL(pos_1.z - pos_0.z, 1e-5);
+        }
+    }
+
+//! Test that exchanging ghosts with all neighbors in a single stage gives the same ghosts and trajectory
+void test_communicator_all_neighbors(communicator_creator comm_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    UP_ASSERT_EQUAL(size,8);
+
+    // particles on a jittered simple cubic lattice
+    const unsigned int n_side = 10;
+    const unsigned int n = n_side*n_side*n_side;
+    const Scalar a = 1.5;
+    BoxDim box(a*n_side);
+
+    SnapshotParticleData<Scalar> snap(n);
+    snap.type_mapping.push_back("A");
+
+    Scalar3 lo = box.getLo();
+    srand(54321);
+    for (unsigned int i = 0; i < n; ++i)
+        {
+        unsigned int ix = i % n_side, iy = (i / n_side) % n_side, iz = i / (n_side*n_side);
+        snap.pos[i] = vec3<Scalar>(lo.x + a*(ix + Scalar(0.4) + Scalar(0.2)*rand()/RAND_MAX),
+                                   lo.y + a*(iy + Scalar(0.4) + Scalar(0.2)*rand()/RAND_MAX),
+                                   lo.z + a*(iz + Scalar(0.4) + Scalar(0.2)*rand()/RAND_MAX));
+        snap.vel[i] = vec3<Scalar>(rand()/(Scalar)RAND_MAX - Scalar(0.5),
+                                   rand()/(Scalar)RAND_MAX - Scalar(0.5),
+                                   rand()/(Scalar)RAND_MAX - Scalar(0.5));
+        }
+
+    // six stages, all neighbors, and all neighbors with overlapping force computation
+    std::shared_ptr<SystemDefinition> sysdef[3];
+    std::shared_ptr<NeighborListTree> nlist[3];
+    std::shared_ptr<PotentialPairLJ> fc[3];
+    std::shared_ptr<IntegratorTwoStep> integrator[3];
+
+    for (unsigned int k = 0; k < 3; ++k)
+        {
+        sysdef[k] = std::shared_ptr<SystemDefinition>(new SystemDefinition(n, box, 1, 0, 0, 0, 0, exec_conf));
+        std::shared_ptr<ParticleData> pdata = sysdef[k]->getParticleData();
+
+        std::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, box.getL(), 2, 2, 2));
+        pdata->setDomainDecomposition(decomposition);
+        pdata->initializeFromSnapshot(snap);
+
+        std::shared_ptr<Communicator> comm = comm_creator(sysdef[k], decomposition);
+        comm->setGhostExchangeAllNeighbors(k > 0);
+        comm->setGhostUpdateOverlap(k == 2);
+        UP_ASSERT_EQUAL(comm->getGhostExchangeAllNeighbors(), k > 0);
+
+        nlist[k] = std::shared_ptr<NeighborListTree>(new NeighborListTree(sysdef[k], Scalar(2.5), Scalar(0.3)));
+        nlist[k]->setCommunicator(comm);
+
+        fc[k] = std::shared_ptr<PotentialPairLJ>(new PotentialPairLJ(sysdef[k], nlist[k]));
+        fc[k]->setRcut(0, 0, Scalar(2.5));
+        fc[k]->setParams(0, 0, make_scalar2(Scalar(4.0), Scalar(4.0)));
+        fc[k]->setCommunicator(comm);
+
+        std::shared_ptr<ParticleSelector> selector_all(new ParticleSelectorTag(sysdef[k], 0, n-1));
+        std::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef[k], selector_all));
+
+        integrator[k] = std::shared_ptr<IntegratorTwoStep>(new IntegratorTwoStep(sysdef[k], Scalar(0.002)));
+        integrator[k]->addIntegrationMethod(std::shared_ptr<TwoStepNVE>(new TwoStepNVE(sysdef[k], group_all)));
+        integrator[k]->addForceCompute(fc[k]);
+        integrator[k]->setCommunicator(comm);
+        integrator[k]->prepRun(0);
+        }
+
+    // the same particles are ghosts, at the same positions, but in a different order
+    for (unsigned int k = 1; k < 3; ++k)
+        {
+        std::shared_ptr<ParticleData> pdata_0 = sysdef[0]->getParticleData();
+        std::shared_ptr<ParticleData> pdata_k = sysdef[k]->getParticleData();
+        UP_ASSERT_EQUAL(pdata_k->getN(), pdata_0->getN());
+        UP_ASSERT_EQUAL(pdata_k->getNGhosts(), pdata_0->getNGhosts());
+
+        ArrayHandle<unsigned int> h_tag_0(pdata_0->getTags(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_pos_0(pdata_0->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag_k(pdata_k->getRTags(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_pos_k(pdata_k->getPositions(), access_location::host, access_mode::read);
+
+        for (unsigned int idx = pdata_0->getN(); idx < pdata_0->getN() + pdata_0->getNGhosts(); ++idx)
+            {
+            unsigned int idx_k = h_rtag_k.data[h_tag_0.data[idx]];
+            UP_ASSERT(idx_k >= pdata_k->getN() && idx_k < pdata_k->getN() + pdata_k->getNGhosts());
+            if (idx_k >= pdata_k->getN() + pdata_k->getNGhosts())
+                continue;
+            MY_CHECK_CLOSE(h_pos_k.data[idx_k].x, h_pos_0.data[idx].x, tol);
+            MY_CHECK_CLOSE(h_pos_k.data[idx_k].y, h_pos_0.data[idx].y, tol);
+            MY_CHECK_CLOSE(h_pos_k.data[idx_k].z, h_pos_0.data[idx].z, tol);
+            }
+        }
+
+    for (unsigned int step = 0; step < 200; ++step)
+        {
+        for (unsigned int k = 0; k < 3; ++k)
+            integrator[k]->update(step);
+        }
+
+    // the forces are summed in a different order, so allow for round-off
+    for (unsigned int k = 1; k < 3; ++k)
+        {
+        for (unsigned int tag = 0; tag < n; ++tag)
+            {
+            Scalar3 pos_0 = sysdef[0]->getParticleData()->getPosition(tag);
+            Scalar3 pos_k = sysdef[k]->getParticleData()->getPosition(tag);
+            MY_CHECK_SMALL(pos_k.x - pos_0.x, 1e-5);
+            MY_CHECK_SMALL(pos_k.y - pos_0.y, 1e-5);
+            MY_CHECK_SMALL(pos_k.z - pos_0.z, 1e-5);
+            }
+        }
+    }
+
+//! Test that repeated migration and ghost exchange draw their transient buffers from the pool
+void test_communicator_buffer_pool(communicator_creator comm_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    UP_ASSERT_EQUAL(size,8);
+
+    // bonded chains on a simple cubic lattice
+    const unsigned int n_side = 8;
+    const unsigned int n = n_side*n_side*n_side;
+    const Scalar a = 1.0;
+    BoxDim box(a*n_side);
+
+    SnapshotParticleData<Scalar> snap(n);
+    snap.type_mapping.push_back("A");
+
+    Scalar3 lo = box.getLo();
+    for (unsigned int i = 0; i < n; ++i)
+        {
+        unsigned int ix = i % n_side, iy = (i / n_side) % n_side, iz = i / (n_side*n_side);
+        snap.pos[i] = vec3<Scalar>(lo.x + a*(ix + Scalar(0.5)),
+                                   lo.y + a*(iy + Scalar(0.5)),
+                                   lo.z + a*(iz + Scalar(0.5)));
+        }
+
+    BondData::Snapshot snap_bdata(n - n/n_side);
+    snap_bdata.type_mapping.push_back("bond");
+    unsigned int n_bonds = 0;
+    for (unsigned int i = 0; i < n; ++i)
+        {
+        if (i % n_side == n_side - 1)
+            continue;
+        snap_bdata.type_id[n_bonds] = 0;
+        snap_bdata.groups[n_bonds].tag[0] = i;
+        snap_bdata.groups[n_bonds].tag[1] = i+1;
+        n_bonds++;
+        }
+
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(n, box, 1, 1, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    std::shared_ptr<BondData> bdata = sysdef->getBondData();
+
+    std::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, box.getL(), 2, 2, 2));
+    pdata->setDomainDecomposition(decomposition);
+    pdata->initializeFromSnapshot(snap);
+    bdata->initializeFromSnapshot(snap_bdata);
+
+    std::shared_ptr<Communicator> comm = comm_creator(sysdef, decomposition);
+
+    CommFlags flags(0);
+    flags[comm_flag::position] = 1;
+    flags[comm_flag::tag] = 1;
+    comm->setFlags(flags);
+
+    ghost_layer_width g(1.2);
+    comm->getGhostLayerWidthRequestSignal().connect<ghost_layer_width, &ghost_layer_width::get>(g);
+
+    // shift all particles by half a lattice spacing, so that every other layer crosses a domain boundary, and back
+    Scalar shift[2] = { Scalar(0.5)*a, -Scalar(0.5)*a };
+
+    HostBufferPool *pool = exec_conf->getHostBufferPool();
+    unsigned int num_allocations = 0;
+    for (unsigned int cycle = 0; cycle < 4; ++cycle)
+        {
+        for (unsigned int k = 0; k < 2; ++k)
+            {
+                {
+                ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+                ArrayHandle<int3> h_image(pdata->getImages(), access_location::host, access_mode::readwrite);
+                for (unsigned int i = 0; i < pdata->getN(); ++i)
+                    {
+                    h_pos.data[i].x += shift[k];
+                    box.wrap(h_pos.data[i], h_image.data[i]);
+                    }
+                }
+
+            comm->migrateParticles();
+            comm->exchangeGhosts();
+            comm->beginUpdateGhosts(0);
+            comm->finishUpdateGhosts(0);
+            }
+
+        // all particles and bonds are retained
+        UP_ASSERT_EQUAL(pdata->getNGlobal(), n);
+        UP_ASSERT_EQUAL(bdata->getNGlobal(), n_bonds);
+
+        // after the first cycle, all buffers have reached their steady state sizes
+        if (cycle == 0)
+            num_allocations = pool->getNumAllocations();
+        else
+            UP_ASSERT_EQUAL(pool->getNumAllocations(), num_allocations);
+        }
+
+    UP_ASSERT(num_allocations > 0);
+    UP_ASSERT(pool->getMaxBytesInUse() > 0);
+    UP_ASSERT(pool->getMaxBytesAllocated() >= pool->getMaxBytesInUse());
+    }
+
+//! Test the persistent ghost update requests when the ghosts change between updates
+/*! The ghost layer width is changed between ghost exchanges, so that the number of ghosts in every direction and
+    the size of the particle data arrays change and the requests need to be recreated. Between exchanges, the local
+    particles are moved several times, and after every update each ghost must have the position and velocity of the
+    particle it mirrors.
+*/
+void test_communicator_ghost_update_requests(communicator_creator comm_creator,
+                                             std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    UP_ASSERT_EQUAL(size,8);
+
+    // particles on a jittered simple cubic lattice
+    const unsigned int n_side = 8;
+    const unsigned int n = n_side*n_side*n_side;
+    const Scalar a = 1.0;
+    BoxDim box(a*n_side);
+
+    SnapshotParticleData<Scalar> snap(n);
+    snap.type_mapping.push_back("A");
+
+    Scalar3 lo = box.getLo();
+    srand(12345);
+    for (unsigned int i = 0; i < n; ++i)
+        {
+        unsigned int ix = i % n_side, iy = (i / n_side) % n_side, iz = i / (n_side*n_side);
+        snap.pos[i] = vec3<Scalar>(lo.x + a*(ix + Scalar(0.4) + Scalar(0.2)*rand()/RAND_MAX),
+                                   lo.y + a*(iy + Scalar(0.4) + Scalar(0.2)*rand()/RAND_MAX),
+                                   lo.z + a*(iz + Scalar(0.4) + Scalar(0.2)*rand()/RAND_MAX));
+        }
+
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(n, box, 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    std::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, box.getL(), 2, 2, 2));
+    pdata->setDomainDecomposition(decomposition);
+    pdata->initializeFromSnapshot(snap);
+
+    std::shared_ptr<Communicator> comm = comm_creator(sysdef, decomposition);
+
+    CommFlags flags(0);
+    flags[comm_flag::position] = 1;
+    flags[comm_flag::velocity] = 1;
+    flags[comm_flag::tag] = 1;
+    comm->setFlags(flags);
+
+    ghost_layer_width g(Scalar(1.2));
+    comm->getGhostLayerWidthRequestSignal().connect<ghost_layer_width, &ghost_layer_width::get>(g);
+
+    // every particle moves along its own direction by a small amount per update
+    auto expected_pos = [&](unsigned int tag, unsigned int update)
+        {
+        Scalar d = Scalar(0.01)*Scalar(update);
+        return make_scalar3(snap.pos[tag].x + d*Scalar(int(tag % 3) - 1),
+                            snap.pos[tag].y + d*Scalar(int(tag % 5) - 2)*Scalar(0.5),
+                            snap.pos[tag].z - d);
+        };
+
+    Scalar widths[] = {Scalar(1.2), Scalar(0.6), Scalar(1.8), Scalar(1.2)};
+    unsigned int update = 0;
+    unsigned int prev_ghosts = 0;
+    for (unsigned int phase = 0; phase < 4; ++phase)
+        {
+        g.w = widths[phase];
+        comm->migrateParticles();
+        comm->exchangeGhosts();
+
+        // the number of ghosts changes with the ghost layer width
+        unsigned int n_ghosts = pdata->getNGhosts();
+        MPI_Allreduce(MPI_IN_PLACE, &n_ghosts, 1, MPI_UNSIGNED, MPI_SUM, exec_conf->getMPICommunicator());
+        UP_ASSERT(n_ghosts > 0);
+        if (phase > 0)
+            UP_ASSERT(n_ghosts != prev_ghosts);
+        prev_ghosts = n_ghosts;
+
+        for (unsigned int k = 0; k < 3; ++k, ++update)
+            {
+            // move the local particles
+                {
+                ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+                ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::readwrite);
+                ArrayHandle<int3> h_image(pdata->getImages(), access_location::host, access_mode::readwrite);
+                ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+                for (unsigned int i = 0; i < pdata->getN(); ++i)
+                    {
+                    unsigned int tag = h_tag.data[i];
+                    Scalar3 pos = expected_pos(tag, update);
+                    h_pos.data[i].x = pos.x;
+                    h_pos.data[i].y = pos.y;
+                    h_pos.data[i].z = pos.z;
+                    h_image.data[i] = make_int3(0,0,0);
+                    box.wrap(h_pos.data[i], h_image.data[i]);
+                    h_vel.data[i].x = Scalar(tag);
+                    h_vel.data[i].y = Scalar(update);
+                    }
+                }
+
+            comm->beginUpdateGhosts(update);
+            comm->finishUpdateGhosts(update);
+
+            // every ghost mirrors the current position and velocity of its particle
+            ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+            for (unsigned int i = pdata->getN(); i < pdata->getN() + pdata->getNGhosts(); ++i)
+                {
+                unsigned int tag = h_tag.data[i];
+                UP_ASSERT(tag < n);
+                Scalar3 pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+                Scalar3 dx = box.minImage(pos - expected_pos(tag, update));
+                MY_CHECK_SMALL(dx.x, tol_small);
+                MY_CHECK_SMALL(dx.y, tol_small);
+                MY_CHECK_SMALL(dx.z, tol_small);
+                UP_ASSERT_EQUAL(h_vel.data[i].x, Scalar(tag));
+                UP_ASSERT_EQUAL(h_vel.data[i].y, Scalar(update));
+                }
+            }
+        }
+    }
+
 //! Communicator creator for unit tests
 std::shared_ptr<Communicator> base_class_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
                                                          std::shared_ptr<DomainDecomposition> decomposition)
@@ -3604,6 +4023,38 @@ UP_TEST( communicator_ghost_layer_per_type_test)
     test_communicator_ghosts_per_type(communicator_creator_base, exec_conf,BoxDim(2.0));
     }
 
+UP_TEST( communicator_overlap_test)
+    {
+    auto exec_conf = std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    communicator_creator communicator_creator_base = bind(base_class_communicator_creator, _1, _2);
+    test_communicator_overlap(communicator_creator_base, exec_conf);
+    }
+
+UP_TEST( communicator_all_neighbors_test)
+    {
+    auto exec_conf = std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU));;
+
+    communicator_creator communicator_creator_base = bind(base_class_communicator_creator, _1, _2);
+    test_communicator_all_neighbors(communicator_creator_base, exec_conf);
+    }
+
+UP_TEST( communicator_buffer_pool_test)
+    {
+    auto exec_conf = std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    communicator_creator communicator_creator_base = bind(base_class_communicator_creator, _1, _2);
+    test_communicator_buffer_pool(communicator_creator_base, exec_conf);
+    }
+
+UP_TEST( communicator_ghost_update_requests_test)
+    {
+    auto exec_conf = std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    communicator_creator communicator_creator_base = bind(base_class_communicator_creator, _1, _2);
+    test_communicator_ghost_update_requests(communicator_creator_base, exec_conf);
+    }
+
 UP_SUITE_END();
 
 #ifdef ENABLE_CUDA
@@ -8,6 +8,7 @@
 #include <iostream>
 
 #include <functional>
+#include <vector>
 
 #include "hoomd/md/AllBondPotentials.h"
 #include "hoomd/ConstForceCompute.h"
@@ -25,6 +26,7 @@ using namespace std::placeholders;
 */
 
 #include "hoomd/test/upp11_config.h"
+#include "hoomd/test/force_compare.h"
 HOOMD_UP_MAIN();
 
 //! Typedef to make using the std::function factory easier
@@ -381,6 +383,66 @@ void bond_force_comparison_tests(bondforce_creator bf_creator1, bondforce_creato
     }
     }
 
+#ifdef ENABLE_TBB
+//! Compare bond forces computed by color with several threads against the serial result
+void bond_force_threads_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 1000;
+
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+    snap->bond_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    std::shared_ptr<PotentialBondHarmonic> fc(new PotentialBondHarmonic(sysdef));
+    fc->setParams(0, make_scalar2(Scalar(300.0), Scalar(1.6)));
+
+    // a chain with cross links, so that particles have up to three bonds
+    for (unsigned int i = 0; i < N-1; i++)
+        sysdef->getBondData()->addBondedGroup(Bond(0, i, i+1));
+    for (unsigned int i = 0; i < N-7; i += 5)
+        sysdef->getBondData()->addBondedGroup(Bond(0, i, i+7));
+
+    for (unsigned int pass = 0; pass < 2; ++pass)
+        {
+        if (pass == 1)
+            {
+            // changing the bonds rebuilds the coloring
+            sysdef->getBondData()->addBondedGroup(Bond(0, 1, 500));
+            }
+
+        // serial reference
+        exec_conf->setNumThreads(1);
+        fc->compute(2*pass);
+        force_result serial = get_force_result(fc, N);
+
+        exec_conf->setNumThreads(4);
+        fc->compute(2*pass+1);
+        check_force_result(serial, get_force_result(fc, N));
+        }
+
+    // restoring a snapshot without bonds must not process the groups of the previous coloring
+    BondData::Snapshot bond_snap;
+    bond_snap.type_mapping.push_back("A");
+    sysdef->getBondData()->initializeFromSnapshot(bond_snap);
+    UP_ASSERT_EQUAL(sysdef->getBondData()->getN(), (unsigned int)0);
+
+    exec_conf->setNumThreads(4);
+    fc->compute(4);
+
+    ArrayHandle<Scalar4> h_force(fc->getForceArray(),access_location::host,access_mode::read);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        UP_ASSERT_EQUAL(h_force.data[i].x, Scalar(0.0));
+        UP_ASSERT_EQUAL(h_force.data[i].y, Scalar(0.0));
+        UP_ASSERT_EQUAL(h_force.data[i].z, Scalar(0.0));
+        UP_ASSERT_EQUAL(h_force.data[i].w, Scalar(0.0));
+        }
+    }
+#endif
+
 //! Check ConstForceCompute to see that it operates properly
 void const_force_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
     {
@@ -482,6 +544,14 @@ UP_TEST( PotentialBondHarmonicGPU_compare )
 
 #endif
 
+#ifdef ENABLE_TBB
+//! test case for threaded bond forces on the CPU
+UP_TEST( PotentialBondHarmonic_threads )
+    {
+    bond_force_threads_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
+
 //! test case for constant forces
 UP_TEST( ConstForceCompute_basic )
     {
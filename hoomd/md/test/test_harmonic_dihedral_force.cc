@@ -24,6 +24,7 @@ using namespace std;
 using namespace std::placeholders;
 
 #include "hoomd/test/upp11_config.h"
+#include "hoomd/test/force_compare.h"
 HOOMD_UP_MAIN();
 
 //! Typedef to make using the std::function factory easier
@@ -440,6 +441,48 @@ void dihedral_force_comparison_tests(dihedralforce_creator tf_creator1,
     }
     }
 
+#ifdef ENABLE_TBB
+//! Compare dihedral forces computed by color with several threads against the serial result
+void dihedral_force_threads_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 1000;
+
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+    snap->dihedral_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    std::shared_ptr<HarmonicDihedralForceCompute> fc(new HarmonicDihedralForceCompute(sysdef));
+    fc->setParams(0, Scalar(3.0), -1, 3);
+
+    // a chain with cross links, so that particles are members of several dihedrals
+    for (unsigned int i = 0; i < N-3; i++)
+        sysdef->getDihedralData()->addBondedGroup(Dihedral(0, i, i+1, i+2, i+3));
+    for (unsigned int i = 0; i < N-21; i += 5)
+        sysdef->getDihedralData()->addBondedGroup(Dihedral(0, i, i+7, i+14, i+21));
+
+    for (unsigned int pass = 0; pass < 2; ++pass)
+        {
+        if (pass == 1)
+            {
+            // changing the dihedrals rebuilds the coloring
+            sysdef->getDihedralData()->addBondedGroup(Dihedral(0, 1, 500, 700, 900));
+            }
+
+        // serial reference
+        exec_conf->setNumThreads(1);
+        fc->compute(2*pass);
+        force_result serial = get_force_result(fc, N);
+
+        exec_conf->setNumThreads(4);
+        fc->compute(2*pass+1);
+        check_force_result(serial, get_force_result(fc, N));
+        }
+    }
+#endif
+
 //! HarmonicDihedralForceCompute creator for dihedral_force_basic_tests()
 std::shared_ptr<HarmonicDihedralForceCompute> base_class_tf_creator(std::shared_ptr<SystemDefinition> sysdef)
     {
@@ -462,6 +505,14 @@ UP_TEST( HarmonicDihedralForceCompute_basic )
     dihedral_force_basic_tests(tf_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+#ifdef ENABLE_TBB
+//! test case for threaded dihedral forces on the CPU
+UP_TEST( HarmonicDihedralForceCompute_threads )
+    {
+    dihedral_force_threads_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
+
 #ifdef ENABLE_CUDA
 //! test case for dihedral forces on the GPU
 UP_TEST( HarmonicDihedralForceComputeGPU_basic )
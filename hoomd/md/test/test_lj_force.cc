@@ -15,6 +15,7 @@
 
 #include "hoomd/md/NeighborListTree.h"
 #include "hoomd/Initializers.h"
+#include "hoomd/SnapshotSystemData.h"
 
 #include <math.h>
 
@@ -27,6 +28,7 @@ using namespace std::placeholders;
 */
 
 #include "hoomd/test/upp11_config.h"
+#include "hoomd/test/force_compare.h"
 
 HOOMD_UP_MAIN();
 
@@ -531,6 +533,100 @@ void lj_force_shift_test(ljforce_creator lj_creator, std::shared_ptr<ExecutionCo
     }
     }
 
+#ifdef ENABLE_TBB
+//! Compare threaded LJ forces against the serial result, for both neighbor list storage modes
+void lj_force_threads_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 5000;
+
+    // create a random particle system to sum forces on
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    std::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(3.0), Scalar(0.8)));
+    std::shared_ptr<PotentialPairLJ> fc(new PotentialPairLJ(sysdef, nlist));
+    fc->setRcut(0, 0, Scalar(3.0));
+    fc->setParams(0,0,make_scalar2(Scalar(4.0)*pow(Scalar(1.2),Scalar(12.0)), Scalar(4.0)*pow(Scalar(1.2),Scalar(6.0))));
+
+    NeighborList::storageMode modes[] = {NeighborList::half, NeighborList::full};
+    for (unsigned int m = 0; m < 2; ++m)
+        {
+        nlist->setStorageMode(modes[m]);
+
+        // serial reference
+        exec_conf->setNumThreads(1);
+        fc->compute(3*m);
+        force_result serial = get_force_result(fc, N);
+
+        // threaded result, computed twice to check that it is reproducible
+        exec_conf->setNumThreads(4);
+        fc->compute(3*m+1);
+        force_result first = get_force_result(fc, N);
+        fc->compute(3*m+2);
+        force_result second = get_force_result(fc, N);
+        check_force_result(serial, second);
+
+        // repeated evaluations with the same number of threads are bitwise identical
+        for (unsigned int i = 0; i < N; i++)
+            {
+            MY_ASSERT_EQUAL(second.force[i].x, first.force[i].x);
+            MY_ASSERT_EQUAL(second.force[i].y, first.force[i].y);
+            MY_ASSERT_EQUAL(second.force[i].z, first.force[i].z);
+            MY_ASSERT_EQUAL(second.force[i].w, first.force[i].w);
+            }
+        }
+    }
+#endif
+
+//! Compares the batched evaluation of the LJ potential to the per pair evaluation
+void lj_force_batch_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 2000;
+
+    // create a random two component system, with a vanishing A-B interaction
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+    snap->particle_data.type_mapping.push_back("B");
+    for (unsigned int i = 0; i < N; i += 3)
+        snap->particle_data.type[i] = 1;
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    std::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(3.0), Scalar(0.8)));
+    std::shared_ptr<PotentialPairLJ> fc(new PotentialPairLJ(sysdef, nlist));
+    fc->setRcut(0, 0, Scalar(3.0));
+    fc->setRcut(0, 1, Scalar(2.5));
+    fc->setRcut(1, 1, Scalar(1.5));
+    fc->setParams(0,0,make_scalar2(Scalar(4.0)*pow(Scalar(1.2),Scalar(12.0)), Scalar(4.0)*pow(Scalar(1.2),Scalar(6.0))));
+    fc->setParams(0,1,make_scalar2(Scalar(0.0), Scalar(0.0)));
+    fc->setParams(1,1,make_scalar2(Scalar(4.0)*pow(Scalar(1.0),Scalar(12.0)), Scalar(4.0)*pow(Scalar(1.0),Scalar(6.0))));
+
+    NeighborList::storageMode modes[] = {NeighborList::half, NeighborList::full};
+    unsigned int timestep = 0;
+    for (unsigned int m = 0; m < 2; ++m)
+        {
+        nlist->setStorageMode(modes[m]);
+        for (unsigned int shift = 0; shift < 2; ++shift)
+            {
+            fc->setShiftMode(shift ? PotentialPairLJ::shift : PotentialPairLJ::no_shift);
+
+            // per pair reference
+            fc->setBatchEvaluation(false);
+            fc->compute(timestep++);
+            force_result per_pair = get_force_result(fc, N);
+
+            // the pairs are summed in the same order, only the instruction selection may differ
+            fc->setBatchEvaluation(true);
+            fc->compute(timestep++);
+            check_force_result(per_pair, get_force_result(fc, N));
+            }
+        }
+    }
+
 //! LJForceCompute creator for unit tests
 std::shared_ptr<PotentialPairLJ> base_class_lj_creator(std::shared_ptr<SystemDefinition> sysdef,
                                                   std::shared_ptr<NeighborList> nlist)
@@ -570,6 +666,20 @@ UP_TEST( PotentialPairLJ_shift )
     lj_force_shift_test(lj_creator_base, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test case for comparing the batched and per pair evaluation on the CPU
+UP_TEST( PotentialPairLJ_batch )
+    {
+    lj_force_batch_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+#ifdef ENABLE_TBB
+//! test case for threaded execution on the CPU
+UP_TEST( PotentialPairLJ_threads )
+    {
+    lj_force_threads_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
+
 # ifdef ENABLE_CUDA
 //! test case for particle test on GPU
 UP_TEST( LJForceGPU_particle )
@@ -1075,6 +1075,68 @@ void neighborlist_cutoff_exclude_tests(std::shared_ptr<ExecutionConfiguration> e
         }
     }
 
+//! Tests that the buffer radius tuner stays within its bounds and provides the log quantity
+template <class NL>
+void neighborlist_autotune_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(2, BoxDim(25.0), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+
+    h_pos.data[0].x = h_pos.data[0].y = h_pos.data[0].z = 0.0;
+    h_pos.data[1].x = h_pos.data[1].y = h_pos.data[1].z = 1.0;
+
+    h_pos.data[0].w = 0.0; h_pos.data[1].w = 0.0;
+    pdata->notifyParticleSort();
+    }
+
+    std::shared_ptr<NeighborList> nlist(new NL(sysdef, 3.0, 0.4));
+    nlist->setRCutPair(0,0,3.0);
+
+    // no log quantity until tuning is enabled
+    UP_ASSERT(nlist->getProvidedLogQuantities().empty());
+
+    // invalid bounds and periods are rejected
+    UP_ASSERT_EXCEPTION(std::runtime_error, [&]{ nlist->setAutotuneRBuff(true, 0.5, 0.2, 10); });
+    UP_ASSERT_EXCEPTION(std::runtime_error, [&]{ nlist->setAutotuneRBuff(true, 0.1, 0.5, 0); });
+
+    // the current value is moved into the bounds
+    nlist->setAutotuneRBuff(true, 0.5, 1.5, 10);
+    MY_CHECK_CLOSE(nlist->getRBuff(), 0.5, tol_small);
+    std::vector<std::string> quantities = nlist->getProvidedLogQuantities();
+    UP_ASSERT_EQUAL(quantities.size(), 1);
+    UP_ASSERT_EQUAL(quantities[0], "nlist_r_buff");
+
+    // after the first window the buffer radius takes one step of (1.5-0.5)/8 away from the lower bound, regardless
+    // of the measured direction, since a step below r_min is turned around
+    for (unsigned int timestep = 0; timestep <= 10; timestep++)
+        nlist->compute(timestep);
+    Scalar r_buff = nlist->getRBuff();
+    MY_CHECK_CLOSE(r_buff, 0.625, tol_small);
+    MY_CHECK_CLOSE(nlist->getLogValue("nlist_r_buff", 10), r_buff, tol_small);
+
+    // the buffer radius never leaves the bounds and the list stays correct
+    for (unsigned int timestep = 11; timestep <= 500; timestep++)
+        {
+        nlist->compute(timestep);
+        UP_ASSERT(nlist->getRBuff() >= Scalar(0.5) - tol_small);
+        UP_ASSERT(nlist->getRBuff() <= Scalar(1.5) + tol_small);
+
+        ArrayHandle<unsigned int> h_n_neigh(nlist->getNNeighArray(), access_location::host, access_mode::read);
+        CHECK_EQUAL_UINT(h_n_neigh.data[0] + h_n_neigh.data[1], 1);
+        }
+
+    // disabling keeps the current value
+    r_buff = nlist->getRBuff();
+    nlist->setAutotuneRBuff(false, 0, 0, 0);
+    for (unsigned int timestep = 501; timestep <= 600; timestep++)
+        nlist->compute(timestep);
+    MY_CHECK_CLOSE(nlist->getRBuff(), r_buff, tol_small);
+    UP_ASSERT(nlist->getProvidedLogQuantities().empty());
+    }
+
 ///////////////
 // BINNED CPU
 ///////////////
@@ -1118,6 +1180,11 @@ UP_TEST( NeighborListBinned_type )
     {
     neighborlist_type_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! buffer tuning test case for binned class
+UP_TEST( NeighborListBinned_autotune )
+    {
+    neighborlist_autotune_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
 
 ////////////////////
 // STENCIL CPU
@@ -1169,6 +1236,16 @@ UP_TEST( NeighborListStencil_comparison )
     neighborlist_comparison_test<NeighborListBinned, NeighborListStencil>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+#ifdef ENABLE_TBB
+//! comparison test case for the threaded binned class
+UP_TEST( NeighborListBinned_threads )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    exec_conf->setNumThreads(4);
+    neighborlist_comparison_test<NeighborListTree, NeighborListBinned>(exec_conf);
+    }
+#endif
+
 ///////////////
 // TREE CPU
 ///////////////
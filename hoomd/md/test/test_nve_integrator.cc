@@ -449,6 +449,75 @@ void nve_updater_aniso_test(std::shared_ptr<ExecutionConfiguration> exec_conf, t
         }
     }
 
+#ifdef ENABLE_TBB
+//! Check that the threaded net force sum adds up all force computes
+void integrator_net_force_threads_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 2000;
+
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    std::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(3.0), Scalar(0.8)));
+    std::shared_ptr<PotentialPairLJ> fc_lj(new PotentialPairLJ(sysdef, nlist));
+    fc_lj->setRcut(0, 0, Scalar(3.0));
+    fc_lj->setParams(0,0,make_scalar2(Scalar(4.0), Scalar(4.0)));
+
+    // a constant force on half of the particles and a constant force and torque on all of them
+    std::shared_ptr<ParticleSelector> selector_half(new ParticleSelectorTag(sysdef, 0, N/2-1));
+    std::shared_ptr<ParticleGroup> group_half(new ParticleGroup(sysdef, selector_half));
+    std::shared_ptr<ParticleSelector> selector_all(new ParticleSelectorTag(sysdef, 0, N-1));
+    std::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef, selector_all));
+    std::shared_ptr<ConstForceCompute> fc_half(new ConstForceCompute(sysdef, group_half, 1.0, -2.0, 3.0));
+    std::shared_ptr<ConstForceCompute> fc_all(new ConstForceCompute(sysdef, group_all, 0.5, 0.25, -0.125));
+    fc_all->setForce(0.5, 0.25, -0.125, 0.1, 0.2, 0.3);
+
+    std::shared_ptr<IntegratorTwoStep> integrator(new IntegratorTwoStep(sysdef, Scalar(0.005)));
+    integrator->addIntegrationMethod(std::shared_ptr<TwoStepNVE>(new TwoStepNVE(sysdef, group_all)));
+    integrator->addForceCompute(fc_lj);
+    integrator->addForceCompute(fc_half);
+    integrator->addForceCompute(fc_all);
+
+    exec_conf->setNumThreads(4);
+    integrator->prepRun(0);
+
+    ArrayHandle<Scalar4> h_net_force(pdata->getNetForce(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_net_torque(pdata->getNetTorqueArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_net_virial(pdata->getNetVirial(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_force_lj(fc_lj->getForceArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_virial_lj(fc_lj->getVirialArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_force_half(fc_half->getForceArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_force_all(fc_all->getForceArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_torque_all(fc_all->getTorqueArray(), access_location::host, access_mode::read);
+    unsigned int net_pitch = pdata->getNetVirial().getPitch();
+    unsigned int lj_pitch = fc_lj->getVirialArray().getPitch();
+
+    // the force computes are summed in the order they were added, so the results are exact
+    for (unsigned int i = 0; i < N; ++i)
+        {
+        MY_ASSERT_EQUAL(h_net_force.data[i].x, Scalar(0.0) + h_force_lj.data[i].x + h_force_half.data[i].x + h_force_all.data[i].x);
+        MY_ASSERT_EQUAL(h_net_force.data[i].y, Scalar(0.0) + h_force_lj.data[i].y + h_force_half.data[i].y + h_force_all.data[i].y);
+        MY_ASSERT_EQUAL(h_net_force.data[i].z, Scalar(0.0) + h_force_lj.data[i].z + h_force_half.data[i].z + h_force_all.data[i].z);
+        MY_ASSERT_EQUAL(h_net_force.data[i].w, Scalar(0.0) + h_force_lj.data[i].w + h_force_half.data[i].w + h_force_all.data[i].w);
+        MY_ASSERT_EQUAL(h_net_torque.data[i].x, h_torque_all.data[i].x);
+        MY_ASSERT_EQUAL(h_net_torque.data[i].y, h_torque_all.data[i].y);
+        MY_ASSERT_EQUAL(h_net_torque.data[i].z, h_torque_all.data[i].z);
+        for (unsigned int k = 0; k < 6; ++k)
+            MY_ASSERT_EQUAL(h_net_virial.data[k*net_pitch+i], h_virial_lj.data[k*lj_pitch+i]);
+        }
+
+    // half of the particles have the extra force
+    unsigned int n_half = 0;
+    for (unsigned int i = 0; i < N; ++i)
+        if (h_force_half.data[i].x == Scalar(1.0))
+            n_half++;
+    UP_ASSERT_EQUAL(n_half, N/2);
+    }
+#endif
+
 //! TwoStepNVE factory for the unit tests
 std::shared_ptr<TwoStepNVE> base_class_nve_creator(std::shared_ptr<SystemDefinition> sysdef, std::shared_ptr<ParticleGroup> group)
     {
@@ -491,6 +560,14 @@ UP_TEST( TwoStepNVE_aniso_test )
     nve_updater_aniso_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)),bind(base_class_nve_creator, _1, _2));
     }
 
+#ifdef ENABLE_TBB
+//! Checks the threaded net force sum
+UP_TEST( Integrator_net_force_threads_test )
+    {
+    integrator_net_force_threads_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
+
 //! Need work on NVEUpdaterGPU with rigid bodies to test these cases
 #ifdef ENABLE_CUDA
 //! test case for base class integration tests
@@ -413,6 +413,107 @@ void nvt_updater_compare_test(twostepnvt_creator nvt_creator1, twostepnvt_creato
         }
     }
 
+//! Checks the single pass ComputeThermo against a direct summation, with one and with several threads
+void test_compute_thermo(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // enough particles for several blocks, with a group that skips every third particle
+    const unsigned int N = 5000;
+    BoxDim box(Scalar(20.0));
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(N, box, 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    std::vector<unsigned int> member_tags;
+    for (unsigned int i = 0; i < N; ++i)
+        if (i % 3 != 0)
+            member_tags.push_back(i);
+    std::shared_ptr<ParticleGroup> group(new ParticleGroup(sysdef, member_tags));
+
+    PDataFlags flags;
+    flags[pdata_flag::isotropic_virial] = 1;
+    flags[pdata_flag::pressure_tensor] = 1;
+    flags[pdata_flag::rotational_kinetic_energy] = 1;
+    flags[pdata_flag::potential_energy] = 1;
+    pdata->setFlags(flags);
+
+    // random velocities, angular momenta, energies and virials
+    double ke_ref = 0.0, ke_rot_ref = 0.0, pe_ref = 0.0, p_xy_ref = 0.0, W_ref = 0.0;
+    srand(12345);
+        {
+        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_angmom(pdata->getAngularMomentumArray(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar3> h_inertia(pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_net_force(pdata->getNetForce(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_net_virial(pdata->getNetVirial(), access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+        unsigned int virial_pitch = pdata->getNetVirial().getPitch();
+
+        for (unsigned int i = 0; i < N; ++i)
+            {
+            Scalar mass = Scalar(1.0) + rand()/(Scalar)RAND_MAX;
+            h_vel.data[i] = make_scalar4(rand()/(Scalar)RAND_MAX - Scalar(0.5),
+                                         rand()/(Scalar)RAND_MAX - Scalar(0.5),
+                                         rand()/(Scalar)RAND_MAX - Scalar(0.5), mass);
+
+            // identity orientation, one axis without moment of inertia
+            h_inertia.data[i] = make_scalar3(Scalar(1.0), Scalar(2.0), Scalar(0.0));
+            h_angmom.data[i] = make_scalar4(Scalar(0.0), rand()/(Scalar)RAND_MAX, rand()/(Scalar)RAND_MAX,
+                                            rand()/(Scalar)RAND_MAX);
+            h_net_force.data[i].w = rand()/(Scalar)RAND_MAX;
+            for (unsigned int k = 0; k < 6; ++k)
+                h_net_virial.data[k*virial_pitch+i] = rand()/(Scalar)RAND_MAX - Scalar(0.5);
+
+            if (h_tag.data[i] % 3 == 0)
+                continue;
+
+            Scalar4 v = h_vel.data[i];
+            ke_ref += 0.5*v.w*(v.x*v.x + v.y*v.y + v.z*v.z);
+            p_xy_ref += v.w*v.x*v.y + h_net_virial.data[1*virial_pitch+i];
+
+            // with q = 1, the body frame angular momentum is half the vector part of p
+            Scalar sx = Scalar(0.5)*h_angmom.data[i].y;
+            Scalar sy = Scalar(0.5)*h_angmom.data[i].z;
+            ke_rot_ref += 0.5*(sx*sx/h_inertia.data[i].x + sy*sy/h_inertia.data[i].y);
+
+            pe_ref += h_net_force.data[i].w;
+            W_ref += (h_net_virial.data[0*virial_pitch+i] + h_net_virial.data[3*virial_pitch+i]
+                + h_net_virial.data[5*virial_pitch+i])/3.0;
+            }
+        }
+
+    Scalar volume = box.getVolume();
+    Scalar pressure_ref = (2.0*ke_ref/3.0 + W_ref)/volume;
+
+    std::shared_ptr<ComputeThermo> thermo(new ComputeThermo(sysdef, group));
+    thermo->compute(0);
+
+    MY_CHECK_CLOSE(thermo->getTranslationalKineticEnergy(), ke_ref, tol);
+    MY_CHECK_CLOSE(thermo->getRotationalKineticEnergy(), ke_rot_ref, tol);
+    MY_CHECK_CLOSE(thermo->getPotentialEnergy(), pe_ref, tol);
+    MY_CHECK_CLOSE(thermo->getPressure(), pressure_ref, tol);
+    MY_CHECK_CLOSE(thermo->getPressureTensor().xy, p_xy_ref/volume, tol);
+
+    #ifdef ENABLE_TBB
+    // the blocks are summed in order, so the result does not depend on the number of threads
+    std::shared_ptr<ComputeThermo> thermo_threads(new ComputeThermo(sysdef, group));
+    exec_conf->setNumThreads(4);
+    thermo_threads->compute(0);
+    exec_conf->setNumThreads(1);
+
+    UP_ASSERT_EQUAL(thermo_threads->getTranslationalKineticEnergy(), thermo->getTranslationalKineticEnergy());
+    UP_ASSERT_EQUAL(thermo_threads->getRotationalKineticEnergy(), thermo->getRotationalKineticEnergy());
+    UP_ASSERT_EQUAL(thermo_threads->getPotentialEnergy(), thermo->getPotentialEnergy());
+    UP_ASSERT_EQUAL(thermo_threads->getPressure(), thermo->getPressure());
+    PressureTensor P = thermo->getPressureTensor();
+    PressureTensor P_threads = thermo_threads->getPressureTensor();
+    UP_ASSERT_EQUAL(P_threads.xx, P.xx);
+    UP_ASSERT_EQUAL(P_threads.xy, P.xy);
+    UP_ASSERT_EQUAL(P_threads.xz, P.xz);
+    UP_ASSERT_EQUAL(P_threads.yy, P.yy);
+    UP_ASSERT_EQUAL(P_threads.yz, P.yz);
+    UP_ASSERT_EQUAL(P_threads.zz, P.zz);
+    #endif
+    }
+
 //! Performs a basic equilibration test of TwoStepNVTMTK
 UP_TEST( TwoStepNVTMTK_basic_test )
     {
@@ -425,6 +526,12 @@ UP_TEST( TwoStepNVTMTK_basic_aniso_test )
     test_nvt_mtk_integrator_aniso(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)),bind(base_class_nvt_creator, _1, _2, _3, _4, _5));
     }
 
+//! Checks the thermodynamic properties computed on the CPU
+UP_TEST( ComputeThermo_test )
+    {
+    test_compute_thermo(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_CUDA
 //! Performs a basic equilibration test of TwoStepNVTMTKGPU
 UP_TEST( TwoStepNVTMTKGPU_basic_test )
@@ -233,6 +233,18 @@ UP_TEST( PPPMForceCompute_triclinic )
     pppm_force_particle_test_triclinic(pppm_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+#ifdef ENABLE_TBB
+//! test case for particle test on CPU with threaded charge assignment and force interpolation
+UP_TEST( PPPMForceCompute_threads )
+    {
+    pppmforce_creator pppm_creator = bind(base_class_pppm_creator, _1, _2, _3);
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    exec_conf->setNumThreads(4);
+    pppm_force_particle_test(pppm_creator, exec_conf);
+    pppm_force_particle_test_triclinic(pppm_creator, exec_conf);
+    }
+#endif
+
 
 #ifdef ENABLE_CUDA
 //! test case for bond forces on the GPU
@@ -0,0 +1,82 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <iostream>
+
+#include <vector>
+
+#include "hoomd/md/AllTripletPotentials.h"
+#include "hoomd/md/NeighborListTree.h"
+#include "hoomd/Initializers.h"
+
+using namespace std;
+
+/*! \file test_tersoff_force.cc
+    \brief Implements unit tests for PotentialTersoff
+    \ingroup unit_tests
+*/
+
+#include "hoomd/test/upp11_config.h"
+#include "hoomd/test/force_compare.h"
+HOOMD_UP_MAIN();
+
+#ifdef ENABLE_TBB
+//! Compare Tersoff forces computed with several threads against the serial result
+void tersoff_force_threads_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 1000;
+    const Scalar r_cut = Scalar(2.0);
+
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    rand_init.setSeed(12345);
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    // the Tersoff potential requires a full neighbor list
+    std::shared_ptr<NeighborList> nlist(new NeighborListTree(sysdef, r_cut, Scalar(0.4)));
+    nlist->setStorageMode(NeighborList::full);
+
+    // nonzero angular terms, so that every triplet contributes
+    std::shared_ptr<PotentialTripletTersoff> fc(new PotentialTripletTersoff(sysdef, nlist));
+    Scalar n = Scalar(1.0);
+    Scalar gamma = Scalar(0.5);
+    Scalar lambda3 = Scalar(0.5);
+    fc->setParams(0, 0, make_tersoff_params(Scalar(0.2),
+                                            make_scalar2(Scalar(1.0), Scalar(1.0)),
+                                            make_scalar2(Scalar(2.0), Scalar(1.0)),
+                                            Scalar(1.5),
+                                            n,
+                                            pow(gamma, n),
+                                            lambda3*lambda3*lambda3,
+                                            make_scalar3(Scalar(1.0), Scalar(1.0), Scalar(1.0)),
+                                            Scalar(3.0)));
+    fc->setRcut(0, 0, r_cut);
+
+    // serial reference, PotentialTersoff does not compute the virial
+    exec_conf->setNumThreads(1);
+    fc->compute(0);
+    force_result serial = get_force_result(fc, N, false);
+
+    // sanity check: the particles interact
+    double pe = 0.0;
+    for (unsigned int i = 0; i < N; i++)
+        pe += serial.force[i].w;
+    UP_ASSERT(pe != 0.0);
+
+    exec_conf->setNumThreads(4);
+    fc->compute(1);
+    check_force_result(serial, get_force_result(fc, N, false));
+    }
+
+//! one thread vs. several threads on the CPU
+UP_TEST( PotentialTersoff_threads )
+    {
+    tersoff_force_threads_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
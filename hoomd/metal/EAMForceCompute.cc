@@ -3,6 +3,10 @@
 
 #include "EAMForceCompute.h"
 
+#ifdef ENABLE_MPI
+#include "hoomd/Communicator.h"
+#endif
+
 #include <vector>
 using namespace std;
 #include <stdexcept>
@@ -239,7 +243,64 @@ void EAMForceCompute::loadFile(char *filename, int type_of_file)
 
         }
 
+    packTables();
+    }
+
+/*! The tables read from the file are copied into blocks of interleaved (value, slope) pairs, one block per type pair
+    for rho(r) and Z(r) and one block per type for F(rho). Every block is padded to a multiple of 64 bytes and to at
+    least one entry past the end of the table, so that a clamped index never reads into the next block. The padding
+    holds the last value of the table with zero slope.
+*/
+void EAMForceCompute::packTables()
+    {
+    // number of table entries that fill 64 bytes
+    const unsigned int align = 64 / sizeof(Scalar2);
+    m_r_pitch = ((nr + 1 + align - 1) / align) * align;
+    m_rho_pitch = ((nrho + 1 + align - 1) / align) * align;
+
+    const unsigned int n_pairs = (unsigned int)(0.5 * (m_ntypes + 1) * m_ntypes);
+
+    GPUArray<Scalar2> rho_table(m_r_pitch * m_ntypes * m_ntypes, m_exec_conf);
+    m_rho_table.swap(rho_table);
+    GPUArray<Scalar2> F_table(m_rho_pitch * m_ntypes, m_exec_conf);
+    m_F_table.swap(F_table);
+    GPUArray<Scalar2> pair_table(m_r_pitch * n_pairs, m_exec_conf);
+    m_pair_table.swap(pair_table);
+
+    ArrayHandle<Scalar2> h_rho_table(m_rho_table, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar2> h_F_table(m_F_table, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar2> h_pair_table(m_pair_table, access_location::host, access_mode::overwrite);
+
+    for (unsigned int b = 0; b < m_ntypes * m_ntypes; b++)
+        {
+        for (unsigned int i = 0; i < m_r_pitch; i++)
+            {
+            h_rho_table.data[b * m_r_pitch + i] = (i < nr) ?
+                make_scalar2(electronDensity[b * nr + i], derivativeElectronDensity[b * nr + i]) :
+                make_scalar2(electronDensity[b * nr + nr - 1], Scalar(0.0));
+            }
+        }
+
+    for (unsigned int b = 0; b < m_ntypes; b++)
+        {
+        for (unsigned int i = 0; i < m_rho_pitch; i++)
+            {
+            h_F_table.data[b * m_rho_pitch + i] = (i < nrho) ?
+                make_scalar2(embeddingFunction[b * nrho + i], derivativeEmbeddingFunction[b * nrho + i]) :
+                make_scalar2(embeddingFunction[b * nrho + nrho - 1], Scalar(0.0));
+            }
+        }
+
+    for (unsigned int b = 0; b < n_pairs; b++)
+        {
+        for (unsigned int i = 0; i < m_r_pitch; i++)
+            {
+            h_pair_table.data[b * m_r_pitch + i] = (i < nr) ? pairPotential[b * nr + i] :
+                make_scalar2(pairPotential[b * nr + nr - 1].x, Scalar(0.0));
+            }
+        }
     }
+
 std::vector< std::string > EAMForceCompute::getProvidedLogQuantities()
     {
     vector<string> list;
@@ -261,10 +322,14 @@ Scalar EAMForceCompute::getLogValue(const std::string& quantity, unsigned int ti
         }
     }
 
-/*! \post The lennard jones forces are computed for the given timestep. The neighborlist's
+/*! \post The EAM forces are computed for the given timestep. The neighborlist's
      compute method is called to ensure that it is up to date.
 
     \param timestep specifies the current time step of the simulation
+
+    The electron densities are accumulated in a first pass over the neighbor list, which also stores the separation of
+    every pair for the second pass. The derivative of the embedding function is evaluated per particle and, in MPI
+    simulations, communicated to the ghost particles before the forces are computed in the second pass.
 */
 void EAMForceCompute::computeForces(unsigned int timestep)
     {
@@ -279,6 +344,20 @@ void EAMForceCompute::computeForces(unsigned int timestep)
     // to reduce computations at the cost of memory access complexity: set that flag now
     bool third_law = m_nlist->getStorageMode() == NeighborList::half;
 
+    const unsigned int N = m_pdata->getN();
+    const unsigned int nghosts = m_pdata->getNGhosts();
+
+    // the derivative of the embedding function is needed for the ghost particles as well
+    if (m_dF.getNumElements() < N + nghosts)
+        {
+        GPUArray<Scalar> dF(N + nghosts, m_exec_conf);
+        m_dF.swap(dF);
+        }
+
+    // the separations are stored by neighbor list entry
+    if (m_neigh_dx.size() < m_nlist->getNListArray().getNumElements())
+        m_neigh_dx.resize(m_nlist->getNListArray().getNumElements());
+
     // access the neighbor list
     assert(m_nlist);
     ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
@@ -291,6 +370,11 @@ void EAMForceCompute::computeForces(unsigned int timestep)
     ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::overwrite);
     unsigned int virial_pitch = m_virial.getPitch();
 
+    // access the tables
+    ArrayHandle<Scalar2> h_rho_table(m_rho_table, access_location::host, access_mode::read);
+    ArrayHandle<Scalar2> h_F_table(m_F_table, access_location::host, access_mode::read);
+    ArrayHandle<Scalar2> h_pair_table(m_pair_table, access_location::host, access_mode::read);
+
     // there are enough other checks on the input data: but it doesn't hurt to be safe
     assert(h_force.data);
     assert(h_virial.data);
@@ -308,178 +392,354 @@ void EAMForceCompute::computeForces(unsigned int timestep)
 
     // tally up the number of forces calculated
     int64_t n_calc = 0;
+    for (unsigned int i = 0; i < N; i++)
+        n_calc += h_n_neigh.data[i];
 
-
-    // for each particle
-    vector<Scalar> atomElectronDensity;
-    atomElectronDensity.resize(m_pdata->getN());
-    vector<Scalar> atomDerivativeEmbeddingFunction;
-    atomDerivativeEmbeddingFunction.resize(m_pdata->getN());
-    vector<Scalar> atomEmbeddingFunction;
-    atomEmbeddingFunction.resize(m_pdata->getN());
     unsigned int ntypes = m_pdata->getNTypes();
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    const unsigned int num_threads = m_exec_conf->getNumThreads();
+
+    #ifdef ENABLE_TBB
+    // with a half neighbor list, every thread accumulates the third law contributions of its range of particles
+    // into its own buffers. The buffers only span the local neighbors [j_first, j_last) of the range, which is
+    // little more than the range itself when the particles are spatially sorted.
+    vector<unsigned int> j_first(num_threads, 0);
+    vector<unsigned int> j_last(num_threads, 0);
+    if (num_threads > 1 && third_law)
         {
-        // access the particle's position and type (MEM TRANSFER: 4 scalars)
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        const unsigned int head_i = h_head_list.data[i];
-
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
+        if (m_thread_rho.size() < num_threads)
+            {
+            m_thread_rho.resize(num_threads);
+            m_thread_force.resize(num_threads);
+            m_thread_virial.resize(num_threads);
+            }
 
-        // loop over all of the neighbors of this particle
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
+        tbb::parallel_for((unsigned int)0, num_threads, [&](unsigned int chunk)
+            {
+            unsigned int lo = N;
+            unsigned int hi = 0;
+            for (unsigned int i = chunk*N/num_threads; i < (chunk+1)*N/num_threads; i++)
+                {
+                const unsigned int head_i = h_head_list.data[i];
+                const unsigned int size = (unsigned int)h_n_neigh.data[i];
+                for (unsigned int j = 0; j < size; j++)
+                    {
+                    unsigned int k = h_nlist.data[head_i + j];
+                    if (k < N)
+                        {
+                        lo = min(lo, k);
+                        hi = max(hi, k+1);
+                        }
+                    }
+                }
+            if (lo >= hi)
+                lo = hi = 0;
+            j_first[chunk] = lo;
+            j_last[chunk] = hi;
+            });
+        }
+    #endif
 
-        for (unsigned int j = 0; j < size; j++)
+    // accumulate the electron densities of the particles [begin, end) into atomElectronDensity, and the third law
+    // contributions into rho_k, which holds the particles starting at index offset_k
+    vector<Scalar> atomElectronDensity(N, Scalar(0.0));
+    auto compute_density = [&](unsigned int begin, unsigned int end, Scalar *rho_k, unsigned int offset_k)
+        {
+        for (unsigned int i = begin; i < end; i++)
             {
-            // increment our calculation counter
-            n_calc++;
+            // access the particle's position and type (MEM TRANSFER: 4 scalars)
+            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            const unsigned int head_i = h_head_list.data[i];
 
-            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int k = h_nlist.data[head_i + j];
             // sanity check
-            assert(k < m_pdata->getN());
+            assert(typei < ntypes);
 
-            // calculate dr (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
-            Scalar3 dx = pi - pk;
+            Scalar rhoi = 0.0;
 
-            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar
-            unsigned int typej = __scalar_as_int(h_pos.data[k].w);
-            // sanity check
-            assert(typej < m_pdata->getNTypes());
+            // loop over all of the neighbors of this particle
+            const unsigned int size = (unsigned int)h_n_neigh.data[i];
+            for (unsigned int j = 0; j < size; j++)
+                {
+                // access the index of this neighbor (MEM TRANSFER: 1 scalar)
+                unsigned int k = h_nlist.data[head_i + j];
+                // sanity check
+                assert(k < N + nghosts);
 
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
+                // calculate dr (MEM TRANSFER: 3 scalars / FLOPS: 3)
+                Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
+                Scalar3 dx = pi - pk;
 
-            // start computing the force
-            // calculate r squared (FLOPS: 5)
-            Scalar rsq = dot(dx, dx);;
-            // only compute the force if the particles are closer than the cuttoff (FLOPS: 1)
-            if (rsq < r_cut_sq)
-                {
-                 Scalar position_scalar = sqrt(rsq) * rdr;
-                 Scalar position = position_scalar;
-                 unsigned int r_index = (unsigned int)position;
-                 r_index = min(r_index,nr);
-                 position -= r_index;
-                 atomElectronDensity[i] += electronDensity[r_index + nr * (typei * ntypes + typej)] + derivativeElectronDensity[r_index + nr * (typei * ntypes + typej)] * position * dr;
-                 if(third_law)
+                // access the type of the neighbor particle (MEM TRANSFER: 1 scalar
+                unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+                // sanity check
+                assert(typej < ntypes);
+
+                // apply periodic boundary conditions
+                dx = box.minImage(dx);
+
+                // calculate r squared (FLOPS: 5)
+                Scalar rsq = dot(dx, dx);
+
+                // store the separation for the force pass, a negative distance marks a pair beyond the cutoff
+                if (rsq >= r_cut_sq)
+                    {
+                    m_neigh_dx[head_i + j] = make_scalar4(dx.x, dx.y, dx.z, Scalar(-1.0));
+                    continue;
+                    }
+
+                Scalar r = sqrt(rsq);
+                m_neigh_dx[head_i + j] = make_scalar4(dx.x, dx.y, dx.z, r);
+
+                Scalar position = r * rdr;
+                unsigned int r_index = (unsigned int)position;
+                r_index = min(r_index,nr);
+                position -= r_index;
+
+                const Scalar2 rho_ij = h_rho_table.data[r_index + m_r_pitch * (typei * ntypes + typej)];
+                rhoi += rho_ij.x + rho_ij.y * position * dr;
+
+                // only add the density to local particles
+                if (third_law && k < N)
                     {
-                    atomElectronDensity[k] += electronDensity[r_index + nr * (typej * ntypes + typei)]
-                        + derivativeElectronDensity[r_index + nr * (typej * ntypes + typei)] * position * dr;
+                    const Scalar2 rho_ji = h_rho_table.data[r_index + m_r_pitch * (typej * ntypes + typei)];
+                    rho_k[k - offset_k] += rho_ji.x + rho_ji.y * position * dr;
                     }
                 }
+
+            atomElectronDensity[i] += rhoi;
             }
+        };
+
+    if (num_threads == 1)
+        {
+        compute_density(0, N, &atomElectronDensity.front(), 0);
+        }
+    #ifdef ENABLE_TBB
+    else if (!third_law)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                compute_density(r.begin(), r.end(), NULL, 0);
+                });
+        }
+    else
+        {
+        tbb::parallel_for((unsigned int)0, num_threads, [&](unsigned int chunk)
+            {
+            const unsigned int width = j_last[chunk] - j_first[chunk];
+            vector<Scalar>& rho_k = m_thread_rho[chunk];
+            if (rho_k.size() < width)
+                rho_k.resize(width);
+            memset((void*)rho_k.data(), 0, sizeof(Scalar)*width);
+            compute_density(chunk*N/num_threads, (chunk+1)*N/num_threads, rho_k.data(), j_first[chunk]);
+            });
+
+        // sum the buffers, always in the same order
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                    for (unsigned int chunk = 0; chunk < num_threads; ++chunk)
+                        if (i >= j_first[chunk] && i < j_last[chunk])
+                            atomElectronDensity[i] += m_thread_rho[chunk][i - j_first[chunk]];
+                });
         }
+    #endif
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
         {
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+        // evaluate the embedding function and its derivative
+        ArrayHandle<Scalar> h_dF(m_dF, access_location::host, access_mode::overwrite);
 
-        Scalar position = atomElectronDensity[i] * rdrho;
-        unsigned int r_index = (unsigned int)position;
-        r_index = min(r_index,nrho);
-        position -= (Scalar)r_index;
-        atomDerivativeEmbeddingFunction[i] = derivativeEmbeddingFunction[r_index + typei * nrho];
+        auto compute_embedding = [&](unsigned int begin, unsigned int end)
+            {
+            for (unsigned int i = begin; i < end; i++)
+                {
+                unsigned int typei = __scalar_as_int(h_pos.data[i].w);
 
-        h_force.data[i].w += embeddingFunction[r_index + typei * nrho] + derivativeEmbeddingFunction[r_index + typei * nrho] * position * drho;
-        }
+                Scalar position = atomElectronDensity[i] * rdrho;
+                unsigned int r_index = (unsigned int)position;
+                r_index = min(r_index,nrho);
+                position -= (Scalar)r_index;
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        {
-        // access the particle's position and type (MEM TRANSFER: 4 scalars)
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        const unsigned int head_i = h_head_list.data[i];
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
-
-        // initialize current particle force, potential energy, and virial to 0
-        Scalar fxi = 0.0;
-        Scalar fyi = 0.0;
-        Scalar fzi = 0.0;
-        Scalar pei = 0.0;
-        Scalar viriali[6];
-        for (int k = 0; k < 6; k++)
-            viriali[k] = 0.0;
-
-        // loop over all of the neighbors of this particle
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        for (unsigned int j = 0; j < size; j++)
+                const Scalar2 F = h_F_table.data[r_index + typei * m_rho_pitch];
+                h_dF.data[i] = F.y;
+                h_force.data[i].w += F.x + F.y * position * drho;
+                }
+            };
+
+        if (num_threads == 1)
             {
-            // increment our calculation counter
-            n_calc++;
+            compute_embedding(0, N);
+            }
+        #ifdef ENABLE_TBB
+        else
+            {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                    {
+                    compute_embedding(r.begin(), r.end());
+                    });
+            }
+        #endif
+        }
 
-            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int k = h_nlist.data[head_i + j];
-            // sanity check
-            assert(k < m_pdata->getN());
+    #ifdef ENABLE_MPI
+    // the force on a particle depends on F'(rho) of its neighbors
+    if (m_comm)
+        m_comm->updateGhostField(m_dF);
+    #endif
 
-            // calculate dr (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
-            Scalar3 dx = pi - pk;
+    ArrayHandle<Scalar> h_dF(m_dF, access_location::host, access_mode::read);
 
-            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar
-            unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+    // compute the forces on the particles [begin, end), the third law forces are subtracted from force_k and the
+    // third law virials are added to virial_k, which hold the particles starting at index offset_k
+    auto compute_force = [&](unsigned int begin, unsigned int end, Scalar4 *force_k, Scalar *virial_k,
+        unsigned int virial_k_pitch, unsigned int offset_k)
+        {
+        for (unsigned int i = begin; i < end; i++)
+            {
+            // access the particle's type (MEM TRANSFER: 1 scalar)
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            const unsigned int head_i = h_head_list.data[i];
             // sanity check
-            assert(typej < m_pdata->getNTypes());
-
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
-
-            // start computing the force
-            // calculate r squared (FLOPS: 5)
-            Scalar rsq = dot(dx, dx);
-
-            if (rsq >= r_cut_sq) continue;
-            Scalar r = sqrt(rsq);
-            Scalar inverseR = 1.0 / r;
-            Scalar position = r * rdr;
-            unsigned int r_index = (unsigned int)position;
-            position = position - (Scalar)r_index;
-            int shift = (typei>=typej)?(int)(0.5 * (2 * ntypes - typej -1)*typej + typei) * nr:(int)(0.5 * (2 * ntypes - typei -1)*typei + typej) * nr;
-            //r_index = min(r_index,nr - 1);
-            Scalar pair_eng = (pairPotential[r_index + shift].x +
-                pairPotential[r_index + shift].y * position * dr) * inverseR;
-            Scalar derivativePhi = (pairPotential[r_index + shift].y - pair_eng) * inverseR;
-            Scalar derivativeRhoI = derivativeElectronDensity[r_index + typei * nr];
-            Scalar derivativeRhoJ = derivativeElectronDensity[r_index + typej * nr];
-            Scalar fullDerivativePhi = atomDerivativeEmbeddingFunction[i] * derivativeRhoJ +
-                atomDerivativeEmbeddingFunction[k] * derivativeRhoI + derivativePhi;
-            Scalar pairForce = - fullDerivativePhi * inverseR;
-            // are the virial and potential energy correctly calculated
-            // with respect to double counting?
-            viriali[0] += dx.x*dx.x * pairForce;
-            viriali[1] += dx.x*dx.y * pairForce;
-            viriali[2] += dx.x*dx.z * pairForce;
-            viriali[3] += dx.y*dx.y * pairForce;
-            viriali[4] += dx.y*dx.z * pairForce;
-            viriali[5] += dx.z*dx.z * pairForce;
-            fxi += dx.x * pairForce;
-            fyi += dx.y * pairForce;
-            fzi += dx.z * pairForce;
-            pei += pair_eng;
-
-            if (third_law)
+            assert(typei < ntypes);
+
+            // initialize current particle force, potential energy, and virial to 0
+            Scalar fxi = 0.0;
+            Scalar fyi = 0.0;
+            Scalar fzi = 0.0;
+            Scalar pei = 0.0;
+            Scalar viriali[6];
+            for (int l = 0; l < 6; l++)
+                viriali[l] = 0.0;
+
+            // loop over all of the neighbors of this particle
+            const unsigned int size = (unsigned int)h_n_neigh.data[i];
+            for (unsigned int j = 0; j < size; j++)
                 {
-                h_force.data[k].x -= dx.x * pairForce;
-                h_force.data[k].y -= dx.y * pairForce;
-                h_force.data[k].z -= dx.z * pairForce;
+                // reuse the separation from the density pass (MEM TRANSFER: 4 scalars)
+                const Scalar4 dxr = m_neigh_dx[head_i + j];
+                if (dxr.w < Scalar(0.0)) continue;
+
+                // access the index and type of this neighbor (MEM TRANSFER: 2 scalars)
+                unsigned int k = h_nlist.data[head_i + j];
+                unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+                // sanity check
+                assert(typej < ntypes);
+
+                Scalar3 dx = make_scalar3(dxr.x, dxr.y, dxr.z);
+                Scalar r = dxr.w;
+                Scalar inverseR = 1.0 / r;
+                Scalar position = r * rdr;
+                unsigned int r_index = (unsigned int)position;
+                position = position - (Scalar)r_index;
+                int shift = (typei>=typej)?(int)(0.5 * (2 * ntypes - typej -1)*typej + typei) * m_r_pitch:(int)(0.5 * (2 * ntypes - typei -1)*typei + typej) * m_r_pitch;
+                const Scalar2 pair = h_pair_table.data[r_index + shift];
+                Scalar pair_eng = (pair.x + pair.y * position * dr) * inverseR;
+                Scalar derivativePhi = (pair.y - pair_eng) * inverseR;
+                Scalar derivativeRhoI = h_rho_table.data[r_index + typei * m_r_pitch].y;
+                Scalar derivativeRhoJ = h_rho_table.data[r_index + typej * m_r_pitch].y;
+                Scalar fullDerivativePhi = h_dF.data[i] * derivativeRhoJ +
+                    h_dF.data[k] * derivativeRhoI + derivativePhi;
+                Scalar pairForce = - fullDerivativePhi * inverseR;
+                // the pair energy and virial are split evenly between the two particles, the half of a pair with a
+                // ghost particle is computed on the rank that owns the ghost
+                Scalar pair_virial[6];
+                pair_virial[0] = Scalar(0.5) * dx.x*dx.x * pairForce;
+                pair_virial[1] = Scalar(0.5) * dx.x*dx.y * pairForce;
+                pair_virial[2] = Scalar(0.5) * dx.x*dx.z * pairForce;
+                pair_virial[3] = Scalar(0.5) * dx.y*dx.y * pairForce;
+                pair_virial[4] = Scalar(0.5) * dx.y*dx.z * pairForce;
+                pair_virial[5] = Scalar(0.5) * dx.z*dx.z * pairForce;
+                for (int l = 0; l < 6; l++)
+                    viriali[l] += pair_virial[l];
+                fxi += dx.x * pairForce;
+                fyi += dx.y * pairForce;
+                fzi += dx.z * pairForce;
+                pei += Scalar(0.5) * pair_eng;
+
+                // only add force to local particles
+                if (third_law && k < N)
+                    {
+                    const unsigned int idx = k - offset_k;
+                    force_k[idx].x -= dx.x * pairForce;
+                    force_k[idx].y -= dx.y * pairForce;
+                    force_k[idx].z -= dx.z * pairForce;
+                    force_k[idx].w += Scalar(0.5) * pair_eng;
+                    for (int l = 0; l < 6; l++)
+                        virial_k[l*virial_k_pitch+idx] += pair_virial[l];
+                    }
                 }
+            h_force.data[i].x += fxi;
+            h_force.data[i].y += fyi;
+            h_force.data[i].z += fzi;
+            h_force.data[i].w += pei;
+            for (int l = 0; l < 6; l++)
+                h_virial.data[l*virial_pitch+i] += viriali[l];
             }
-        h_force.data[i].x += fxi;
-        h_force.data[i].y += fyi;
-        h_force.data[i].z += fzi;
-        h_force.data[i].w += pei;
-        for (int k = 0; k < 6; k++)
-            h_virial.data[k*virial_pitch+i] += viriali[k];
+        };
+
+    if (num_threads == 1)
+        {
+        compute_force(0, N, h_force.data, h_virial.data, virial_pitch, 0);
+        }
+    #ifdef ENABLE_TBB
+    else if (!third_law)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                compute_force(r.begin(), r.end(), NULL, NULL, 0, 0);
+                });
+        }
+    else
+        {
+        tbb::parallel_for((unsigned int)0, num_threads, [&](unsigned int chunk)
+            {
+            const unsigned int width = j_last[chunk] - j_first[chunk];
+            vector<Scalar4>& force_k = m_thread_force[chunk];
+            vector<Scalar>& virial_k = m_thread_virial[chunk];
+            if (force_k.size() < width)
+                {
+                force_k.resize(width);
+                virial_k.resize(6*width);
+                }
+            memset((void*)force_k.data(), 0, sizeof(Scalar4)*width);
+            memset((void*)virial_k.data(), 0, sizeof(Scalar)*6*width);
+            compute_force(chunk*N/num_threads, (chunk+1)*N/num_threads, force_k.data(), virial_k.data(), width,
+                j_first[chunk]);
+            });
+
+        // sum the buffers into the output array, always in the same order
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                    {
+                    for (unsigned int chunk = 0; chunk < num_threads; ++chunk)
+                        {
+                        if (i < j_first[chunk] || i >= j_last[chunk])
+                            continue;
+
+                        const unsigned int width = j_last[chunk] - j_first[chunk];
+                        const unsigned int idx = i - j_first[chunk];
+                        const Scalar4& f = m_thread_force[chunk][idx];
+                        h_force.data[i].x += f.x;
+                        h_force.data[i].y += f.y;
+                        h_force.data[i].z += f.z;
+                        h_force.data[i].w += f.w;
+                        for (unsigned int l = 0; l < 6; ++l)
+                            h_virial.data[l*virial_pitch+i] += m_thread_virial[chunk][l*width+idx];
+                        }
+                    }
+                });
         }
+    #endif
 
-    int64_t flops = m_pdata->getN() * 5 + n_calc * (3+5+9+1+9+6+8);
+    int64_t flops = N * 5 + n_calc * (3+5+9+1+9+6+8);
     if (third_law) flops += n_calc * 8;
-    int64_t mem_transfer = m_pdata->getN() * (5+4+10)*sizeof(Scalar) + n_calc * (1+3+1)*sizeof(Scalar);
+    int64_t mem_transfer = N * (5+4+10)*sizeof(Scalar) + n_calc * (1+3+1+4)*sizeof(Scalar);
     if (third_law) mem_transfer += n_calc*10*sizeof(Scalar);
     if (m_prof) m_prof->pop(flops, mem_transfer);
     }
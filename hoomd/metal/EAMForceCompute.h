@@ -5,6 +5,11 @@
 #include "hoomd/md/NeighborList.h"
 
 #include <memory>
+#include <vector>
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
 
 /*! \file EAMForceCompute.h
     \brief Declares the EAMForceCompute class
@@ -31,6 +36,12 @@
     Forces can be computed directly by calling compute() and then retrieved with a call to acquire(), but
     a more typical usage will be to add the force compute to NVEUpdater or NVTUpdater.
 
+    On the CPU, the tables are stored as interleaved (value, slope) pairs with one block per type (pair) whose length
+    is padded to a multiple of 64 bytes. The density and force passes are threaded, and the separations computed in
+    the density pass are cached for the force pass. With a half neighbor list, the third law contributions are
+    accumulated into per-thread buffers that only span the local neighbors of each thread's particles. In MPI
+    simulations, the derivative of the embedding function is communicated to the ghost particles.
+
     \ingroup computes
 */
 class EAMForceCompute : public ForceCompute
@@ -82,6 +93,21 @@ class EAMForceCompute : public ForceCompute
         std::vector<Scalar> derivativePairPotential;        //!< array Z'(r)
         std::vector<Scalar> derivativeEmbeddingFunction;    //!< array F'(rho)
 
+        GPUArray<Scalar2> m_rho_table;                 //!< Interleaved rho(r) and rho'(r), per type pair
+        GPUArray<Scalar2> m_F_table;                   //!< Interleaved F(rho) and F'(rho), per type
+        GPUArray<Scalar2> m_pair_table;                //!< Interleaved Z(r) and Z'(r), per unordered type pair
+        unsigned int m_r_pitch;                        //!< Padded length of a block in m_rho_table and m_pair_table
+        unsigned int m_rho_pitch;                      //!< Padded length of a block in m_F_table
+
+        std::vector<Scalar4> m_neigh_dx;               //!< Separation and distance of every neighbor list entry
+        GPUArray<Scalar> m_dF;                         //!< F'(rho) of the local and ghost particles
+        std::vector< std::vector<Scalar> > m_thread_rho;     //!< Per-thread third law density buffers
+        std::vector< std::vector<Scalar4> > m_thread_force;  //!< Per-thread third law force buffers
+        std::vector< std::vector<Scalar> > m_thread_virial;  //!< Per-thread third law virial buffers
+
+        //! Build the interleaved tables from the tables read from the file
+        void packTables();
+
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
 
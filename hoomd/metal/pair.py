@@ -35,7 +35,7 @@ class eam(force._force):
     and are also described here: http://enpub.fulton.asu.edu/cms/potentials/submain/format.htm
 
     .. attention::
-        EAM is **NOT** supported in MPI parallel simulations.
+        EAM is **NOT** supported in MPI parallel simulations on the GPU.
 
     .. danger::
         HOOMD-blue's EAM implementation is known to be broken.
@@ -61,10 +61,10 @@ class eam(force._force):
 
         hoomd.util.print_status_line();
 
-        # Error out in MPI simulations
+        # Error out in MPI simulations on the GPU
         if (_hoomd.is_MPI_available()):
-            if hoomd.context.current.system_definition.getParticleData().getDomainDecomposition():
-                hoomd.context.msg.error("pair.eam is not supported in multi-processor simulations.\n\n")
+            if hoomd.context.exec_conf.isCUDAEnabled() and hoomd.context.current.system_definition.getParticleData().getDomainDecomposition():
+                hoomd.context.msg.error("pair.eam is not supported in multi-processor GPU simulations.\n\n")
                 raise RuntimeError("Error setting up pair potential.")
 
         # initialize the base class
@@ -0,0 +1,58 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __EAM_TEST_POTENTIAL_H__
+#define __EAM_TEST_POTENTIAL_H__
+
+#include <cmath>
+#include <cstdio>
+
+/*! \file eam_test_potential.h
+    \brief Writes a synthetic single type EAM/Alloy potential file for the EAM unit tests
+    \ingroup unit_tests
+*/
+
+//! Cutoff of the test potential
+const double eam_test_r_cut = 3.0;
+
+//! Write a smooth single type EAM/Alloy potential for type A to \a filename
+/*! rho(r) = (1-r/r_cut)^2, F(rho) = -sqrt(rho) and r*phi(r) = (r_cut-r)^3, all tabulated in the EAM/Alloy format
+    read by EAMForceCompute with type_of_file = 0.
+*/
+inline void write_eam_test_potential(const char *filename)
+    {
+    const unsigned int nrho = 2001;
+    const double drho = 0.05;
+    const unsigned int nr = 601;
+    const double dr = eam_test_r_cut / double(nr - 1);
+
+    FILE *fp = fopen(filename, "w");
+    fprintf(fp, "synthetic EAM potential for unit tests\n");
+    fprintf(fp, "rho(r) = (1-r/rc)^2, F(rho) = -sqrt(rho), r*phi(r) = (rc-r)^3\n");
+    fprintf(fp, "\n");
+    fprintf(fp, "1 A\n");
+    fprintf(fp, "%u %.16g %u %.16g %.16g\n", nrho, drho, nr, dr, eam_test_r_cut);
+    fprintf(fp, "29 63.55 3.615 fcc\n");
+
+    // embedding function
+    for (unsigned int i = 0; i < nrho; i++)
+        fprintf(fp, "%.16g\n", -sqrt(double(i) * drho));
+
+    // electron density
+    for (unsigned int i = 0; i < nr; i++)
+        {
+        double x = 1.0 - double(i) * dr / eam_test_r_cut;
+        fprintf(fp, "%.16g\n", x * x);
+        }
+
+    // pair potential times r
+    for (unsigned int i = 0; i < nr; i++)
+        {
+        double x = eam_test_r_cut - double(i) * dr;
+        fprintf(fp, "%.16g\n", x * x * x);
+        }
+
+    fclose(fp);
+    }
+
+#endif
@@ -0,0 +1,114 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <iostream>
+
+#include <cstdio>
+#include <vector>
+
+#include "hoomd/metal/EAMForceCompute.h"
+#include "hoomd/md/NeighborListTree.h"
+#include "hoomd/Initializers.h"
+
+#include "eam_test_potential.h"
+
+using namespace std;
+
+/*! \file test_eam_force.cc
+    \brief Implements unit tests for EAMForceCompute
+    \ingroup unit_tests
+*/
+
+#include "hoomd/test/upp11_config.h"
+#include "hoomd/test/force_compare.h"
+HOOMD_UP_MAIN();
+
+#ifdef SINGLE_PRECISION
+
+//! Name of the potential file written by the tests
+char eam_file[] = "test_eam_force.eam.alloy";
+
+//! Compute the EAM forces of the system with the given neighbor list storage mode and number of threads
+force_result compute_eam(std::shared_ptr<SystemDefinition> sysdef, std::shared_ptr<ExecutionConfiguration> exec_conf,
+    NeighborList::storageMode mode, unsigned int num_threads)
+    {
+    exec_conf->setNumThreads(num_threads);
+
+    std::shared_ptr<NeighborList> nlist(new NeighborListTree(sysdef, Scalar(eam_test_r_cut), Scalar(0.4)));
+    nlist->setStorageMode(mode);
+
+    std::shared_ptr<EAMForceCompute> fc(new EAMForceCompute(sysdef, eam_file, 0));
+    fc->set_neighbor_list(nlist);
+    fc->compute(0);
+
+    return get_force_result(fc, sysdef->getParticleData()->getN());
+    }
+
+//! Create a random single type system to compute the EAM forces on
+std::shared_ptr<SystemDefinition> eam_random_system(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    RandomInitializer rand_init(1000, Scalar(0.2), Scalar(0.9), "A");
+    rand_init.setSeed(12345);
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    sysdef->getParticleData()->setFlags(~PDataFlags(0));
+    return sysdef;
+    }
+
+//! Check that the half and full neighbor lists give the same forces, energies and virials
+void eam_force_half_full_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    write_eam_test_potential(eam_file);
+    std::shared_ptr<SystemDefinition> sysdef = eam_random_system(exec_conf);
+
+    force_result half = compute_eam(sysdef, exec_conf, NeighborList::half, 1);
+    force_result full = compute_eam(sysdef, exec_conf, NeighborList::full, 1);
+    check_force_result(half, full);
+
+    // sanity check: the particles interact
+    double pe = 0.0;
+    for (unsigned int i = 0; i < half.force.size(); i++)
+        pe += half.force[i].w;
+    UP_ASSERT(pe != 0.0);
+
+    remove(eam_file);
+    }
+
+#ifdef ENABLE_TBB
+//! Compare the forces computed with several threads against the serial result
+void eam_force_threads_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    write_eam_test_potential(eam_file);
+    std::shared_ptr<SystemDefinition> sysdef = eam_random_system(exec_conf);
+
+    NeighborList::storageMode modes[] = {NeighborList::half, NeighborList::full};
+    for (unsigned int m = 0; m < 2; m++)
+        {
+        force_result serial = compute_eam(sysdef, exec_conf, modes[m], 1);
+        force_result threaded = compute_eam(sysdef, exec_conf, modes[m], 4);
+        check_force_result(serial, threaded);
+        }
+
+    remove(eam_file);
+    }
+#endif
+
+//! half and full neighbor lists on the CPU
+UP_TEST( EAMForceCompute_half_full )
+    {
+    eam_force_half_full_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+#ifdef ENABLE_TBB
+//! one thread vs. several threads on the CPU
+UP_TEST( EAMForceCompute_threads )
+    {
+    eam_force_threads_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
+
+#endif
@@ -0,0 +1,106 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <iostream>
+
+#include <cstdio>
+#include <vector>
+
+#include "hoomd/metal/EAMForceCompute.h"
+#include "hoomd/md/NeighborListTree.h"
+#include "hoomd/Communicator.h"
+#include "hoomd/Initializers.h"
+
+#include "eam_test_potential.h"
+
+using namespace std;
+
+/*! \file test_eam_force_mpi.cc
+    \brief Compares EAMForceCompute on eight MPI ranks with a single rank
+    \ingroup unit_tests
+*/
+
+#include "hoomd/test/upp11_config.h"
+#include "hoomd/test/force_compare.h"
+HOOMD_UP_MAIN();
+
+#if defined(ENABLE_MPI) && defined(SINGLE_PRECISION)
+
+//! Name of the potential file written by the test
+char eam_file[] = "test_eam_force_mpi.eam.alloy";
+
+//! Compare the forces, energies and virials on eight ranks against a single rank reference
+/*! The force on a particle depends on F'(rho) of its neighbors, so this tests the exchange of F'(rho) with the ghost
+    particles. With a half neighbor list, the energy and virial of a pair with a ghost particle are split between the
+    two ranks that own the particles.
+*/
+void eam_force_mpi_test(std::shared_ptr<ExecutionConfiguration> exec_conf_1,
+                        std::shared_ptr<ExecutionConfiguration> exec_conf_8)
+    {
+    // the root rank writes the potential file for all ranks
+    if (exec_conf_8->getRank() == 0)
+        write_eam_test_potential(eam_file);
+    MPI_Barrier(exec_conf_8->getMPICommunicator());
+
+    // all ranks generate the same configuration
+    RandomInitializer rand_init(1000, Scalar(0.2), Scalar(0.9), "A");
+    rand_init.setSeed(12345);
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+    const unsigned int n = snap->particle_data.size;
+
+    // single rank reference, every rank computes it in its own partition
+    std::shared_ptr<SystemDefinition> sysdef_1(new SystemDefinition(snap, exec_conf_1));
+    sysdef_1->getParticleData()->setFlags(~PDataFlags(0));
+    std::shared_ptr<NeighborList> nlist_1(new NeighborListTree(sysdef_1, Scalar(eam_test_r_cut), Scalar(0.4)));
+    std::shared_ptr<EAMForceCompute> fc_1(new EAMForceCompute(sysdef_1, eam_file, 0));
+    fc_1->set_neighbor_list(nlist_1);
+    fc_1->compute(0);
+
+    NeighborList::storageMode modes[] = {NeighborList::half, NeighborList::full};
+    for (unsigned int m = 0; m < 2; m++)
+        {
+        // decompose the box into 2x2x2 domains
+        const BoxDim& box = snap->global_box;
+        std::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf_8, box.getL(), 2, 2, 2));
+        std::shared_ptr<SystemDefinition> sysdef_8(new SystemDefinition(snap, exec_conf_8, decomposition));
+        sysdef_8->getParticleData()->setFlags(~PDataFlags(0));
+        std::shared_ptr<Communicator> comm(new Communicator(sysdef_8, decomposition));
+
+        std::shared_ptr<NeighborList> nlist_8(new NeighborListTree(sysdef_8, Scalar(eam_test_r_cut), Scalar(0.4)));
+        nlist_8->setStorageMode(modes[m]);
+        nlist_8->setCommunicator(comm);
+
+        std::shared_ptr<EAMForceCompute> fc_8(new EAMForceCompute(sysdef_8, eam_file, 0));
+        fc_8->set_neighbor_list(nlist_8);
+        fc_8->setCommunicator(comm);
+
+        // exchange the ghost particles and compute
+        comm->communicate(0);
+        fc_8->compute(0);
+
+        // the getters broadcast the values from the rank that owns the particle
+        check_force_result(get_force_result_by_tag(fc_1, n), get_force_result_by_tag(fc_8, n));
+
+        // the total energy counts every pair exactly once
+        MY_CHECK_CLOSE(fc_1->calcEnergySum(), fc_8->calcEnergySum(), tol_small);
+        }
+
+    MPI_Barrier(exec_conf_8->getMPICommunicator());
+    if (exec_conf_8->getRank() == 0)
+        remove(eam_file);
+    }
+
+//! eight ranks vs. one rank on the CPU
+UP_TEST( EAMForceCompute_mpi )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf_8(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    std::shared_ptr<ExecutionConfiguration> exec_conf_1(new ExecutionConfiguration(ExecutionConfiguration::CPU,
+        -1, false, false, std::shared_ptr<Messenger>(), 1));
+    eam_force_mpi_test(exec_conf_1, exec_conf_8);
+    }
+
+#endif
@@ -28,6 +28,7 @@
 #include "GSDDumpWriter.h"
 #include "Logger.h"
 #include "LogPlainTXT.h"
+#include "LogBinary.h"
 #include "LogMatrix.h"
 #include "LogHDF5.h"
 #include "CallbackAnalyzer.h"
@@ -36,6 +37,7 @@
 #include "SFCPackUpdater.h"
 #include "BoxResizeUpdater.h"
 #include "System.h"
+#include "StepTimer.h"
 #include "Variant.h"
 #include "Messenger.h"
 #include "SnapshotSystemData.h"
@@ -356,6 +358,7 @@ PYBIND11_PLUGIN(_hoomd)
     // computes
     export_Compute(m);
     export_ComputeThermo(m);
+    export_StepTimer(m);
     export_CellList(m);
     export_CellListStencil(m);
     export_ForceCompute(m);
@@ -375,6 +378,7 @@ PYBIND11_PLUGIN(_hoomd)
     export_GSDDumpWriter(m);
     export_Logger(m);
     export_LogPlainTXT(m);
+    export_LogBinary(m);
     export_LogMatrix(m);
     export_LogHDF5(m);
     export_CallbackAnalyzer(m);
@@ -40,6 +40,9 @@ class options:
         self.nz = None;
         self.linear = None;
         self.onelevel = None;
+        self.nthreads = None;
+        self.huge_pages = None;
+        self.first_touch = False;
         self.autotuner_enable = True;
         self.autotuner_period = 100000;
 
@@ -58,7 +61,10 @@ class options:
                    ny=self.ny,
                    nz=self.nz,
                    linear=self.linear,
-                   onelevel=self.onelevel)
+                   onelevel=self.onelevel,
+                   nthreads=self.nthreads,
+                   huge_pages=self.huge_pages,
+                   first_touch=self.first_touch)
         return str(tmp);
 
 ## Parses command line options
@@ -81,6 +87,7 @@ def _parse_command_line(arg_string=None):
     parser.add_option("--nz", dest="nz", help="(MPI) Number of domains along the z-direction");
     parser.add_option("--linear", dest="linear", action="store_true", default=False, help="(MPI only) Force a slab (1D) decomposition along the z-direction");
     parser.add_option("--onelevel", dest="onelevel", action="store_true", default=False, help="(MPI only) Disable two-level (node-local) decomposition");
+    parser.add_option("--nthreads", dest="nthreads", help="(TBB only) Number of CPU threads to use per rank (default: the cores of the node divided by the ranks on it)");
     parser.add_option("--user", dest="user", help="User options");
 
     input_args = None;
@@ -146,6 +153,16 @@ def _parse_command_line(arg_string=None):
        except ValueError:
             parser.error('--nz must be an integer')
 
+    # Convert nthreads to an integer
+    if cmd_options.nthreads is not None:
+        try:
+            cmd_options.nthreads = int(cmd_options.nthreads);
+        except ValueError:
+            parser.error('--nthreads must be an integer')
+
+        if cmd_options.nthreads < 1:
+            parser.error('--nthreads must be positive')
+
     # copy command line options over to global options
     hoomd.context.options.mode = cmd_options.mode;
     hoomd.context.options.gpu = cmd_options.gpu;
@@ -158,6 +175,7 @@ def _parse_command_line(arg_string=None):
     hoomd.context.options.nz = cmd_options.nz;
     hoomd.context.options.linear = cmd_options.linear
     hoomd.context.options.onelevel = cmd_options.onelevel
+    hoomd.context.options.nthreads = cmd_options.nthreads
 
     if cmd_options.notice_level is not None:
         hoomd.context.options.notice_level = cmd_options.notice_level;
@@ -259,6 +277,81 @@ def set_autotuner_params(enable=True, period=100000):
     hoomd.context.options.autotuner_period = period;
     hoomd.context.options.autotuner_enable = enable;
 
+def set_num_threads(num_threads):
+    R""" Set the number of CPU threads.
+
+    Args:
+        num_threads (int): Number of CPU threads each rank uses in threaded compute kernels.
+
+    The number of threads may be changed before or after initialization. Results are reproducible
+    for a fixed number of threads. Builds without TBB support only run with one thread. By default,
+    the cores of a node are divided evenly among the MPI ranks running on it.
+
+    Note:
+        Overrides ``--nthreads`` on the command line.
+
+    """
+    _verify_init();
+
+    try:
+        num_threads = int(num_threads);
+    except ValueError:
+        hoomd.context.msg.error("num_threads must be an integer\n");
+        raise RuntimeError('Error setting option');
+
+    if hoomd.context.exec_conf is not None:
+        hoomd.context.exec_conf.setNumThreads(num_threads);
+
+    hoomd.context.options.nthreads = num_threads;
+
+def set_host_alloc(huge_pages=None, first_touch=False):
+    R""" Set the policy for allocating particle data and other arrays in host memory.
+
+    Args:
+        huge_pages (str): Set to ``'transparent'`` to back arrays of 2MB or larger with transparent huge pages,
+            or to ``'explicit'`` to map them from the huge page pool reserved by the administrator
+            (``vm.nr_hugepages``). Set to None to use regular pages.
+        first_touch (bool): Set to True to clear new arrays with all CPU threads, so that the operating system
+            places their pages on the NUMA nodes of the threads that work on them.
+
+    Huge pages reduce TLB misses in large simulations. When the huge page pool is exhausted, ``'explicit'``
+    falls back to transparent huge pages with a warning. First touch placement helps threaded runs on multi-socket
+    nodes with one rank per node.
+
+    The policy applies to arrays allocated after the call, so call :py:func:`set_host_alloc` before
+    initializing the system. The number of bytes allocated for each named array is available from
+    ``hoomd.context.exec_conf.getHostMemoryUsage()``.
+
+    Example::
+
+        option.set_host_alloc(huge_pages='transparent', first_touch=True)
+
+    """
+    _verify_init();
+
+    if huge_pages not in (None, 'transparent', 'explicit'):
+        hoomd.context.msg.error("huge_pages must be None, 'transparent' or 'explicit'\n");
+        raise RuntimeError('Error setting option');
+
+    if hoomd.context.exec_conf is not None:
+        _apply_host_alloc(hoomd.context.exec_conf, huge_pages, first_touch);
+
+    hoomd.context.options.huge_pages = huge_pages;
+    hoomd.context.options.first_touch = bool(first_touch);
+
+## \internal
+# \brief Apply the host allocation options to an execution configuration
+def _apply_host_alloc(exec_conf, huge_pages, first_touch):
+    if huge_pages == 'transparent':
+        policy = _hoomd.ExecutionConfiguration.hostAllocPolicy.host_alloc_huge_pages;
+    elif huge_pages == 'explicit':
+        policy = _hoomd.ExecutionConfiguration.hostAllocPolicy.host_alloc_huge_pages_explicit;
+    else:
+        policy = _hoomd.ExecutionConfiguration.hostAllocPolicy.host_alloc_default;
+
+    exec_conf.setHostAllocPolicy(policy);
+    exec_conf.setFirstTouch(bool(first_touch));
+
 ## \internal
 # \brief Throw an error if the context is not initialized
 def _verify_init():
@@ -148,6 +148,61 @@ class gsd_write_tests (unittest.TestCase):
         if comm.get_rank() == 0:
             self.assertRaises(RuntimeError, data.gsd_snapshot, self.tmp_file, frame=1);
 
+    # test that frames written in the background are identical to frames written synchronously
+    def test_queue_depth(self):
+        if comm.get_rank() == 0:
+            tmp = tempfile.mkstemp(suffix='.test.gsd');
+            async_file = tmp[1];
+        else:
+            async_file = "invalid";
+
+        d1 = dump.gsd(filename=self.tmp_file, group=group.all(), period=1, overwrite=True, static=[]);
+        d2 = dump.gsd(filename=async_file, group=group.all(), period=1, overwrite=True, static=[], queue_depth=2);
+        run(5);
+        d2.write_restart();
+
+        if comm.get_rank() == 0:
+            with open(self.tmp_file, 'rb') as f:
+                sync_bytes = f.read();
+            with open(async_file, 'rb') as f:
+                async_bytes = f.read();
+
+            # the restart frame is written only to the second file
+            self.assertLess(len(sync_bytes), len(async_bytes));
+
+        d1.write_restart();
+        d2.flush();
+
+        if comm.get_rank() == 0:
+            with open(self.tmp_file, 'rb') as f:
+                sync_bytes = f.read();
+            with open(async_file, 'rb') as f:
+                async_bytes = f.read();
+            self.assertEqual(sync_bytes, async_bytes);
+            os.remove(async_file);
+
+    # test that distributed writes produce the same file as serial writes
+    def test_distributed(self):
+        if comm.get_rank() == 0:
+            tmp = tempfile.mkstemp(suffix='.test.gsd');
+            dist_file = tmp[1];
+        else:
+            dist_file = "invalid";
+
+        for g in [group.all(), group.tags(1,2)]:
+            dump.gsd(filename=self.tmp_file, group=g, period=None, time_step=10, overwrite=True, static=[]);
+            dump.gsd(filename=dist_file, group=g, period=None, time_step=10, overwrite=True, static=[], distributed=True);
+
+            if comm.get_rank() == 0:
+                with open(self.tmp_file, 'rb') as f:
+                    serial_bytes = f.read();
+                with open(dist_file, 'rb') as f:
+                    dist_bytes = f.read();
+                self.assertEqual(serial_bytes, dist_bytes);
+
+        if comm.get_rank() == 0:
+            os.remove(dist_file);
+
     # tests init.read_gsd
     def test_read_gsd(self):
         dump.gsd(filename=self.tmp_file, group=group.all(), period=1, overwrite=True);
@@ -379,6 +434,38 @@ class gsd_read_tests (unittest.TestCase):
 
         init.read_gsd(filename=self.tmp_file);
 
+    # tests init.read_gsd with every rank reading its own particles
+    def test_read_gsd_distributed(self):
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=None, overwrite=True);
+        context.initialize();
+
+        s = init.read_gsd(filename=self.tmp_file, distributed=True);
+        snap = s.take_snapshot(all=True);
+        if comm.get_rank() == 0:
+            self.assertEqual(snap.particles.N, self.snapshot.particles.N);
+            self.assertEqual(snap.particles.types, self.snapshot.particles.types);
+
+            numpy.testing.assert_array_equal(snap.particles.typeid, self.snapshot.particles.typeid);
+            numpy.testing.assert_array_equal(snap.particles.mass, self.snapshot.particles.mass);
+            numpy.testing.assert_array_equal(snap.particles.charge, self.snapshot.particles.charge);
+            numpy.testing.assert_array_equal(snap.particles.diameter, self.snapshot.particles.diameter);
+            numpy.testing.assert_array_equal(snap.particles.body, self.snapshot.particles.body);
+            numpy.testing.assert_array_equal(snap.particles.moment_inertia, self.snapshot.particles.moment_inertia);
+            numpy.testing.assert_array_equal(snap.particles.position, self.snapshot.particles.position);
+            numpy.testing.assert_array_equal(snap.particles.orientation, self.snapshot.particles.orientation);
+            numpy.testing.assert_array_equal(snap.particles.velocity, self.snapshot.particles.velocity);
+            numpy.testing.assert_array_equal(snap.particles.angmom, self.snapshot.particles.angmom);
+            numpy.testing.assert_array_equal(snap.particles.image, self.snapshot.particles.image);
+
+            self.assertEqual(snap.bonds.N, self.snapshot.bonds.N);
+            self.assertEqual(snap.bonds.types, self.snapshot.bonds.types);
+            numpy.testing.assert_array_equal(snap.bonds.typeid, self.snapshot.bonds.typeid);
+            numpy.testing.assert_array_equal(snap.bonds.group, self.snapshot.bonds.group);
+
+            self.assertEqual(snap.constraints.N, self.snapshot.constraints.N);
+            numpy.testing.assert_array_equal(snap.constraints.group, self.snapshot.constraints.group);
+            numpy.testing.assert_array_equal(snap.constraints.value, self.snapshot.constraints.value);
+
     def tearDown(self):
         if comm.get_rank() == 0:
             os.remove(self.tmp_file);
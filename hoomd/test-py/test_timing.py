@@ -0,0 +1,92 @@
+# -*- coding: iso-8859-1 -*-
+
+import hoomd
+hoomd.context.initialize()
+import unittest
+import json
+import os
+import tempfile
+
+class timing_tests(unittest.TestCase):
+
+    def setUp(self):
+        sysdef = hoomd.init.create_lattice(unitcell=hoomd.lattice.sq(a=2.0),
+                                           n=[1,2]);
+        hoomd.analyze.callback(callback=lambda step: None, period=1);
+        if hoomd.comm.get_rank() == 0:
+            tmp = tempfile.mkstemp(suffix='.json');
+            self.tmp_file = tmp[1];
+        else:
+            self.tmp_file = "invalid";
+
+    # test that timings are recorded for the most recent steps
+    def test_record(self):
+        hoomd.timing.enable(steps=5);
+        hoomd.run(10);
+
+        self.assertIn('analyze_callback', hoomd.timing.names());
+        self.assertIn('update_sort', hoomd.timing.names());
+        self.assertIn('compute_thermo', hoomd.timing.names());
+        self.assertEqual(hoomd.timing.timesteps(), [5, 6, 7, 8, 9]);
+
+        t = hoomd.timing.get('analyze_callback');
+        self.assertEqual(len(t), 5);
+        for v in t:
+            self.assertGreaterEqual(v, 0);
+
+        self.assertRaises(RuntimeError, hoomd.timing.get, 'not_a_timer');
+
+    # test that timings are recorded when synchronizing with the GPU
+    def test_sync_gpu(self):
+        hoomd.timing.enable(steps=5, sync_gpu=True);
+        hoomd.run(10);
+
+        self.assertEqual(hoomd.timing.timesteps(), [5, 6, 7, 8, 9]);
+        for v in hoomd.timing.get('compute_thermo'):
+            self.assertGreaterEqual(v, 0);
+
+    # test that timings are available to the logger
+    def test_log(self):
+        hoomd.timing.enable();
+        log = hoomd.analyze.log(filename=None, quantities=['time_analyze_callback'], period=1);
+        hoomd.run(10);
+        self.assertGreaterEqual(log.query('time_analyze_callback'), 0);
+
+    # test writing the json and trace files
+    def test_write(self):
+        hoomd.timing.enable(steps=3);
+        hoomd.run(5);
+
+        hoomd.timing.write(self.tmp_file);
+        if hoomd.comm.get_rank() == 0:
+            with open(self.tmp_file) as f:
+                data = json.load(f);
+            self.assertIn('analyze_callback', data['timers']);
+            self.assertEqual([s['timestep'] for s in data['steps']], [2, 3, 4]);
+            self.assertEqual(len(data['steps'][0]['timers']), len(data['timers']));
+
+        hoomd.timing.write(self.tmp_file, format='trace');
+        if hoomd.comm.get_rank() == 0:
+            with open(self.tmp_file) as f:
+                data = json.load(f);
+            names = [e['name'] for e in data['traceEvents']];
+            self.assertEqual(names.count('step'), 3);
+            self.assertEqual(names.count('analyze_callback'), 3);
+
+        self.assertRaises(ValueError, hoomd.timing.write, self.tmp_file, format='xml');
+
+    # test that disabling removes the timings
+    def test_disable(self):
+        hoomd.timing.enable();
+        hoomd.run(2);
+        hoomd.timing.disable();
+        hoomd.run(2);
+        self.assertRaises(RuntimeError, hoomd.timing.names);
+
+    def tearDown(self):
+        if hoomd.comm.get_rank() == 0:
+            os.remove(self.tmp_file);
+        hoomd.context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
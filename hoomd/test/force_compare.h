@@ -0,0 +1,94 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+/*! \file force_compare.h
+    \brief Helpers for unit tests that compare the forces of two ForceComputes
+    \note Include this file after upp11_config.h
+*/
+
+#ifndef __FORCE_COMPARE_H__
+#define __FORCE_COMPARE_H__
+
+#include "hoomd/ForceCompute.h"
+
+#include <memory>
+#include <vector>
+
+//! Forces, energies and virials of a set of particles
+struct force_result
+    {
+    std::vector<Scalar4> force;     //!< Force (x, y, z) and energy (w) of every particle
+    std::vector<Scalar> virial;     //!< Component j of the virial of particle i at j*N+i, empty if not compared
+    };
+
+//! Copy the forces, energies and, optionally, virials of the first N local particles of a ForceCompute
+inline force_result get_force_result(std::shared_ptr<ForceCompute> fc, unsigned int N, bool virial=true)
+    {
+    force_result result;
+    ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+    result.force.assign(h_force.data, h_force.data+N);
+
+    if (virial)
+        {
+        unsigned int pitch = fc->getVirialArray().getPitch();
+        ArrayHandle<Scalar> h_virial(fc->getVirialArray(), access_location::host, access_mode::read);
+        for (unsigned int j = 0; j < 6; j++)
+            result.virial.insert(result.virial.end(), h_virial.data+j*pitch, h_virial.data+j*pitch+N);
+        }
+    return result;
+    }
+
+//! Get the forces, energies and virials of the particles with tags 0 to n-1, on every rank
+/*! The getters of ForceCompute broadcast the values from the rank that owns the particle, so the results of
+    ForceComputes on different domain decompositions can be compared.
+*/
+inline force_result get_force_result_by_tag(std::shared_ptr<ForceCompute> fc, unsigned int n)
+    {
+    force_result result;
+    result.force.resize(n);
+    result.virial.resize(6*n);
+    for (unsigned int tag = 0; tag < n; tag++)
+        {
+        Scalar3 f = fc->getForce(tag);
+        result.force[tag] = make_scalar4(f.x, f.y, f.z, fc->getEnergy(tag));
+        for (unsigned int j = 0; j < 6; j++)
+            result.virial[j*n+tag] = fc->getVirial(tag, j);
+        }
+    return result;
+    }
+
+//! Check that two results agree
+/*! The average squared deviation per particle of the forces, energies and virials must be below tol_small. This
+    allows for the rounding differences of a different summation order. The virials are only compared if both
+    results have them.
+*/
+inline void check_force_result(const force_result& a, const force_result& b)
+    {
+    const unsigned int N = a.force.size();
+    CHECK_EQUAL_UINT(b.force.size(), N);
+
+    double deltaf2 = 0.0;
+    double deltape2 = 0.0;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        deltaf2 += double(a.force[i].x - b.force[i].x) * double(a.force[i].x - b.force[i].x);
+        deltaf2 += double(a.force[i].y - b.force[i].y) * double(a.force[i].y - b.force[i].y);
+        deltaf2 += double(a.force[i].z - b.force[i].z) * double(a.force[i].z - b.force[i].z);
+        deltape2 += double(a.force[i].w - b.force[i].w) * double(a.force[i].w - b.force[i].w);
+        }
+    CHECK_SMALL(deltaf2 / double(N), double(tol_small));
+    CHECK_SMALL(deltape2 / double(N), double(tol_small));
+
+    if (a.virial.empty() || b.virial.empty())
+        return;
+
+    CHECK_EQUAL_UINT(a.virial.size(), 6*N);
+    CHECK_EQUAL_UINT(b.virial.size(), 6*N);
+    double deltav2 = 0.0;
+    for (unsigned int i = 0; i < 6*N; i++)
+        deltav2 += double(a.virial[i] - b.virial[i]) * double(a.virial[i] - b.virial[i]);
+    CHECK_SMALL(deltav2 / double(N), double(tol_small));
+    }
+
+#endif
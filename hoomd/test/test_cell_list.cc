@@ -582,3 +582,67 @@ UP_TEST( CellListGPU_large )
     celllist_large_test<CellListGPU>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
 #endif
+
+#ifdef ENABLE_TBB
+//! Validate that the threaded cell list is identical to the serial one
+void celllist_threads_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    unsigned int N = 10000;
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap;
+    snap = rand_init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    // ********* compute the cell list in serial *********
+    std::shared_ptr<CellList> cl(new CellList(sysdef));
+    cl->setNominalWidth(Scalar(3.0));
+    cl->setRadius(1);
+    cl->setFlagIndex();
+    cl->setComputeTDB(true);
+    exec_conf->setNumThreads(1);
+    cl->compute(0);
+
+    unsigned int ncell = cl->getCellIndexer().getNumElements();
+    Index2D cli = cl->getCellListIndexer();
+    std::vector<unsigned int> cell_size;
+    std::vector<Scalar4> xyzf;
+    std::vector<Scalar4> tdb;
+        {
+        ArrayHandle<unsigned int> h_cell_size(cl->getCellSizeArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_xyzf(cl->getXYZFArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_tdb(cl->getTDBArray(), access_location::host, access_mode::read);
+        cell_size.assign(h_cell_size.data, h_cell_size.data + ncell);
+        xyzf.assign(h_xyzf.data, h_xyzf.data + cli.getNumElements());
+        tdb.assign(h_tdb.data, h_tdb.data + cli.getNumElements());
+        }
+
+    // ********* recompute with several threads *********
+    exec_conf->setNumThreads(4);
+    cl->compute(1);
+
+    // the cell list must be identical, including the order of particles in each cell
+    UP_ASSERT_EQUAL(cl->getCellIndexer().getNumElements(), ncell);
+    ArrayHandle<unsigned int> h_cell_size(cl->getCellSizeArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_xyzf(cl->getXYZFArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_tdb(cl->getTDBArray(), access_location::host, access_mode::read);
+    for (unsigned int cell = 0; cell < ncell; cell++)
+        {
+        CHECK_EQUAL_UINT(h_cell_size.data[cell], cell_size[cell]);
+        for (unsigned int offset = 0; offset < h_cell_size.data[cell]; offset++)
+            {
+            unsigned int idx = cli(offset, cell);
+            CHECK_EQUAL_UINT(__scalar_as_int(h_xyzf.data[idx].w), __scalar_as_int(xyzf[idx].w));
+            MY_ASSERT_EQUAL(h_xyzf.data[idx].x, xyzf[idx].x);
+            MY_ASSERT_EQUAL(h_xyzf.data[idx].y, xyzf[idx].y);
+            MY_ASSERT_EQUAL(h_xyzf.data[idx].z, xyzf[idx].z);
+            MY_ASSERT_EQUAL(h_tdb.data[idx].y, tdb[idx].y);
+            }
+        }
+    }
+
+//! test case for celllist_threads_test
+UP_TEST( CellList_threads )
+    {
+    celllist_threads_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
@@ -11,6 +11,7 @@
 
 #include "hoomd/GPUArray.h"
 #include "hoomd/GPUVector.h"
+#include "hoomd/HostBufferPool.h"
 
 #ifdef ENABLE_CUDA
 #include "test_gpu_array.cuh"
@@ -89,6 +90,142 @@ UP_TEST( GPUArray_basic_tests )
 
     }
 
+//! test case for the accounting of host memory by array name
+UP_TEST( GPUArray_host_memory_usage_tests )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+        {
+        GPUArray<int> a(100, exec_conf);
+        a.setName("a");
+        GPUArray<int> b(50, 2, exec_conf);
+        b.setName("b");
+
+        std::map<std::string, uint64_t> usage = exec_conf->getHostMemoryUsage();
+        UP_ASSERT_EQUAL(usage["a"], (uint64_t)(100*sizeof(int)));
+        UP_ASSERT_EQUAL(usage["b"], (uint64_t)(64*2*sizeof(int)));
+
+        // resizing keeps the name
+        a.resize(200);
+        b.resize(50, 3);
+        usage = exec_conf->getHostMemoryUsage();
+        UP_ASSERT_EQUAL(usage["a"], (uint64_t)(200*sizeof(int)));
+        UP_ASSERT_EQUAL(usage["b"], (uint64_t)(64*3*sizeof(int)));
+
+        // swapping exchanges the names along with the data
+        a.swap(b);
+        UP_ASSERT_EQUAL(a.getName(), std::string("b"));
+        usage = exec_conf->getHostMemoryUsage();
+        UP_ASSERT_EQUAL(usage["a"], (uint64_t)(200*sizeof(int)));
+        UP_ASSERT_EQUAL(usage["b"], (uint64_t)(64*3*sizeof(int)));
+        }
+
+    // all memory is returned
+    UP_ASSERT(exec_conf->getHostMemoryUsage().empty());
+    }
+
+//! test case for the huge page and first touch host allocation policies
+UP_TEST( GPUArray_host_alloc_policy_tests )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    #ifdef ENABLE_TBB
+    exec_conf->setNumThreads(4);
+    #endif
+    exec_conf->setFirstTouch(true);
+
+    ExecutionConfiguration::hostAllocPolicy policies[] = {ExecutionConfiguration::host_alloc_default,
+                                                          ExecutionConfiguration::host_alloc_huge_pages,
+                                                          ExecutionConfiguration::host_alloc_huge_pages_explicit};
+    for (unsigned int p = 0; p < 3; ++p)
+        {
+        exec_conf->setHostAllocPolicy(policies[p]);
+
+        // large arrays are aligned to huge pages, unless they come from the explicit pool, which is aligned anyway
+        GPUArray<Scalar> large(1000000, exec_conf);
+        GPUArray<Scalar> small(100, exec_conf);
+            {
+            ArrayHandle<Scalar> h_large(large, access_location::host, access_mode::readwrite);
+            ArrayHandle<Scalar> h_small(small, access_location::host, access_mode::readwrite);
+            UP_ASSERT_EQUAL((size_t)h_small.data % 64, (size_t)0);
+            if (p > 0)
+                UP_ASSERT_EQUAL((size_t)h_large.data % (2*1024*1024), (size_t)0);
+            else
+                UP_ASSERT_EQUAL((size_t)h_large.data % 64, (size_t)0);
+
+            // the memory is cleared
+            for (unsigned int i = 0; i < large.getNumElements(); i++)
+                {
+                UP_ASSERT_EQUAL(h_large.data[i], Scalar(0.0));
+                h_large.data[i] = Scalar(i);
+                }
+            }
+
+        // resizing preserves the data and clears the new part
+        large.resize(1500000);
+        ArrayHandle<Scalar> h_large(large, access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < large.getNumElements(); i++)
+            UP_ASSERT_EQUAL(h_large.data[i], i < 1000000 ? Scalar(i) : Scalar(0.0));
+        }
+    }
+
+//! test case for recycling transient host buffers through the HostBufferPool
+UP_TEST( HostBufferPool_tests )
+    {
+    HostBufferPool pool;
+
+    // the first round of buffers comes from the heap
+    unsigned int *a_data = NULL;
+    Scalar4 *b_data = NULL;
+    unsigned int num_allocations = 0;
+    for (unsigned int round = 0; round < 3; ++round)
+        {
+        pooled_vector<unsigned int> a(&pool);
+        pooled_vector<Scalar4> b(&pool);
+        a.reserve(1000);
+        b.reserve(1000);
+        for (unsigned int i = 0; i < 1000; ++i)
+            {
+            a.push_back(i);
+            b.push_back(make_scalar4(Scalar(i),0,0,0));
+            }
+        UP_ASSERT_EQUAL((size_t)a.data() % 64, (size_t)0);
+        UP_ASSERT_EQUAL((size_t)b.data() % 64, (size_t)0);
+        for (unsigned int i = 0; i < 1000; ++i)
+            {
+            UP_ASSERT_EQUAL(a[i], i);
+            UP_ASSERT_EQUAL(b[i].x, Scalar(i));
+            }
+
+        // later rounds reuse the blocks returned by the first one
+        if (round == 0)
+            {
+            UP_ASSERT(pool.getNumAllocations() > 0);
+            num_allocations = pool.getNumAllocations();
+            a_data = a.data();
+            b_data = b.data();
+            }
+        else
+            {
+            UP_ASSERT_EQUAL(pool.getNumAllocations(), num_allocations);
+            UP_ASSERT(a.data() == a_data);
+            UP_ASSERT(b.data() == b_data);
+            }
+        }
+
+    pooled_vector<unsigned int> c(&pool);
+    c.resize(1000);
+    UP_ASSERT_EQUAL(pool.getNumAllocations(), num_allocations);
+
+    // both vectors were in use at the same time
+    UP_ASSERT(pool.getMaxBytesInUse() >= 1000*(sizeof(Scalar4)+sizeof(unsigned int)));
+    UP_ASSERT(pool.getMaxBytesAllocated() >= pool.getMaxBytesInUse());
+
+    // trimming keeps the blocks in use
+    pool.trim();
+    c[999] = 42;
+    UP_ASSERT_EQUAL(c[999], (unsigned int)42);
+    }
+
 #ifdef ENABLE_CUDA
 //! test case for testing device to/from host transfers
 UP_TEST( GPUArray_transfer_tests )
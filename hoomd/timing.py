@@ -0,0 +1,164 @@
+# Copyright (c) 2009-2017 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+""" Per-step timing
+
+Use methods in this module to record the wall time spent in each part of every time step during a run, query the
+recorded times, and write them to a file.
+
+While timing is enabled, :py:func:`hoomd.run()` records the time spent in every analyzer, updater, force, the
+integrator, :py:class:`hoomd.compute.thermo`, neighbor list builds, and the MPI communication phases in each time
+step. The times of the most recent steps are kept in memory. Unlike ``hoomd.run(profile=True)``, timing adds little
+overhead and can be left enabled in production simulations.
+
+Each part of the step has a timer name. Forces are named ``force_<module>_<class>``, analyzers and updaters
+``<module>_<class>`` (e.g. ``force_pair_lj``, ``dump_gsd``, ``update_sort``). When a force is given a *name*, it is
+appended to the timer name, otherwise all forces of the same type share one timer. All thermo computes share the
+timer ``compute_thermo``, and a neighbor list timer has the name of the neighbor list (e.g. ``cell_nlist_0``). The
+integrator is named ``integrator`` and the communication phases ``comm_migrate``, ``comm_exchange_ghosts``, and
+``comm_update_ghosts``.
+
+Timers nest, and the time of a nested timer is also counted in every timer that encloses it. The time of
+``integrator`` includes the forces, thermo computes, neighbor list builds, and ghost updates it triggers, and the time
+of a pair force includes the neighbor list build it triggers. The times of all timers therefore add up to more than
+the duration of the step. Computes that are not listed above are not timed on their own.
+
+Note:
+    GPU kernels run asynchronously. By default, the timers of GPU code measure the time to launch the kernels and
+    to wait for any results the CPU needs, so kernel time may be attributed to a later timer. Enable timing with
+    ``sync_gpu=True`` to synchronize with the GPU at the start and end of every timer. This attributes the kernel time
+    correctly, but prevents the overlap of CPU and GPU work and slows down the simulation.
+
+The time in seconds each timer spent in the most recently completed step is available to :py:class:`hoomd.analyze.log`
+as the quantity ``time_<name>`` (e.g. ``time_force_pair_lj``).
+
+Note:
+    Times are measured on the local rank. In MPI simulations, the logged values and the files written are those
+    of the root rank.
+
+Example::
+
+    hoomd.timing.enable(steps=1000)
+    hoomd.analyze.log(filename='timing.log', quantities=['time_force_pair_lj', 'time_integrator'], period=100)
+    hoomd.run(10000)
+    print(hoomd.timing.get('force_pair_lj'))
+    hoomd.timing.write('timing.json', format='trace')
+"""
+
+from hoomd import _hoomd
+import hoomd;
+
+def enable(steps=1000, sync_gpu=False):
+    """ Enable per-step timing.
+
+    Args:
+        steps (int): Number of most recent steps to keep the timings of.
+        sync_gpu (bool): Synchronize with the GPU at the start and end of every timer.
+
+    Calling :py:func:`enable()` again with a different number of *steps* discards the recorded timings.
+    """
+    hoomd.util.print_status_line();
+
+    if not hoomd.init.is_initialized():
+        hoomd.context.msg.error("Cannot enable timing before initialization\n");
+        raise RuntimeError('Error enabling timing');
+
+    if steps <= 0:
+        hoomd.context.msg.error("timing: steps must be positive\n");
+        raise ValueError('steps must be positive');
+
+    hoomd.context.current.system.enableStepTimer(int(steps));
+    hoomd.context.current.system.getStepTimer().setSyncGPU(bool(sync_gpu));
+
+def disable():
+    """ Disable per-step timing.
+
+    The recorded timings are discarded.
+    """
+    hoomd.util.print_status_line();
+
+    if not hoomd.init.is_initialized():
+        hoomd.context.msg.error("Cannot disable timing before initialization\n");
+        raise RuntimeError('Error disabling timing');
+
+    hoomd.context.current.system.enableStepTimer(0);
+
+## \internal
+# \brief Get the C++ step timer, or raise an error when timing is not enabled
+def _get_timer():
+    if not hoomd.init.is_initialized():
+        hoomd.context.msg.error("Cannot query timings before initialization\n");
+        raise RuntimeError('Error getting timings');
+
+    timer = hoomd.context.current.system.getStepTimer();
+    if timer is None:
+        hoomd.context.msg.error("timing: Timing is not enabled, call hoomd.timing.enable() first\n");
+        raise RuntimeError('Error getting timings');
+
+    return timer;
+
+## \internal
+# \brief Set the timer name of a force, compute, analyzer, or updater
+#
+# \param name Name of the object in the System
+# \param obj Python object
+# \param prefix Prefix for the timer name
+# \param suffix Suffix for the timer name
+def _set_timer_name(name, obj, prefix='', suffix=''):
+    module = obj.__class__.__module__.split('.')[-1];
+    hoomd.context.current.system.setTimerName(name, prefix + module + '_' + obj.__class__.__name__ + suffix);
+
+def names():
+    """ Get the names of all timers.
+
+    Returns:
+        A list of timer names.
+
+    Note:
+        Timers are registered at the start of each :py:func:`hoomd.run()`.
+    """
+    return list(_get_timer().getTimerNames());
+
+def timesteps():
+    """ Get the time steps that timings are recorded for.
+
+    Returns:
+        A list of time steps, oldest first.
+    """
+    return list(_get_timer().getTimesteps());
+
+def get(name):
+    """ Get the recorded times of a timer.
+
+    Args:
+        name (str): Name of the timer.
+
+    Returns:
+        A list with the time in seconds spent in the timer in each recorded time step, oldest first. The
+        corresponding time steps are given by :py:func:`timesteps()`.
+    """
+    return list(_get_timer().getTimes(name));
+
+def write(filename, format='json'):
+    """ Write the recorded timings to a file.
+
+    Args:
+        filename (str): File name to write.
+        format (str): ``'json'`` or ``'trace'``.
+
+    With ``format='json'``, the file holds the list of timer names and, for every recorded step, the time step, the
+    duration of the step, and the time spent in each timer in seconds.
+
+    With ``format='trace'``, every recorded step and every timed interval is written in the Chrome trace event
+    format, which can be viewed with ``chrome://tracing``.
+    """
+    hoomd.util.print_status_line();
+    timer = _get_timer();
+
+    if format == 'json':
+        timer.writeJSON(filename);
+    elif format == 'trace':
+        timer.writeTrace(filename);
+    else:
+        hoomd.context.msg.error("timing: format must be 'json' or 'trace'\n");
+        raise ValueError("format must be 'json' or 'trace'");
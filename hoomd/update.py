@@ -40,6 +40,7 @@ class _updater(hoomd.meta._metadata):
 
         self.updater_name = "updater%d" % (id);
         self.enabled = True;
+        hoomd.timing._set_timer_name(self.updater_name, self);
 
         # Store a reference in global simulation variables
         hoomd.context.current.updaters.append(self)